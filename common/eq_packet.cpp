@@ -36,6 +36,8 @@
 #include <cstdlib>
 #include <cstring>
 
+EQ_SLAB_POOLED_IMPL(EQApplicationPacket, "EQApplicationPacket", 512)
+
 EQPacket::EQPacket(EmuOpcode op, const unsigned char *buf, uint32 len)
 :	BasePacket(buf, len),
 	emu_opcode(op)
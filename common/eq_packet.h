@@ -20,6 +20,7 @@
 
 #include "base_packet.h"
 #include "platform.h"
+#include "util/slab_pool.h"
 #include <iostream>
 
 #ifdef STATIC_OPCODE
@@ -104,6 +105,9 @@ public:
 		{ app_opcode_size = GetExecutablePlatform() == ExePlatformUCS ? 1 : 2; }
 	EQApplicationPacket(const EmuOpcode op, const unsigned char *buf, const uint32 len) : EQPacket(op, buf, len), opcode_bypass(0)
 		{ app_opcode_size = GetExecutablePlatform() == ExePlatformUCS ? 1 : 2; }
+
+	EQ_SLAB_POOLED()
+
 	bool combine(const EQApplicationPacket *rhs);
 	uint32 serialize (uint16 opcode, unsigned char *dest) const;
 	uint32 Size() const { return size+app_opcode_size; }
@@ -152,6 +152,11 @@ namespace EQEmu {
 			return max_elements_;
 		}
 
+		//! Returns the element storage, size() elements long.
+		const value_type *data() const {
+			return elements_;
+		}
+
 		//! Returns the maximum key one can use with the set.
 		key_type max_key() const {
 			return offset_count_ > 0 ? (offset_count_ - 1) : 0;
@@ -205,6 +210,19 @@ namespace EQEmu {
 			return true;
 		}
 
+		/*!
+			Returns the position of a key's value in element storage, 0xFFFFFFFF if there is none.
+			Positions never change once inserted so parallel tables can be kept by position.
+		\param i Index to look up
+		*/
+		key_type index_of(const key_type& i) const {
+			if(i >= offset_count_) {
+				return 0xFFFFFFFFU;
+			}
+
+			return offsets_[i];
+		}
+
 		/*!
 			Inserts a value into the set at a specific index
 		\param i Index to insert the value at
@@ -94,27 +94,27 @@ EQEmu::ItemInstance* ItemInstQueue::peek_front() const
 EQEmu::InventoryProfile::~InventoryProfile()
 {
 	for (auto iter = m_worn.begin(); iter != m_worn.end(); ++iter) {
-		safe_delete(iter->second);
+		delete iter->second;
 	}
 	m_worn.clear();
 
 	for (auto iter = m_inv.begin(); iter != m_inv.end(); ++iter) {
-		safe_delete(iter->second);
+		delete iter->second;
 	}
 	m_inv.clear();
 
 	for (auto iter = m_bank.begin(); iter != m_bank.end(); ++iter) {
-		safe_delete(iter->second);
+		delete iter->second;
 	}
 	m_bank.clear();
 
 	for (auto iter = m_shbank.begin(); iter != m_shbank.end(); ++iter) {
-		safe_delete(iter->second);
+		delete iter->second;
 	}
 	m_shbank.clear();
 
 	for (auto iter = m_trade.begin(); iter != m_trade.end(); ++iter) {
-		safe_delete(iter->second);
+		delete iter->second;
 	}
 	m_trade.clear();
 }
@@ -365,28 +365,22 @@ EQEmu::ItemInstance* EQEmu::InventoryProfile::PopItem(int16 slot_id)
 		p = m_cursor.pop();
 	}
 	else if ((slot_id >= legacy::EQUIPMENT_BEGIN && slot_id <= legacy::EQUIPMENT_END) || (slot_id == inventory::slotPowerSource)) {
-		p = m_worn[slot_id];
-		m_worn.erase(slot_id);
+		p = m_worn.Take(slot_id);
 	}
 	else if ((slot_id >= legacy::GENERAL_BEGIN && slot_id <= legacy::GENERAL_END)) {
-		p = m_inv[slot_id];
-		m_inv.erase(slot_id);
+		p = m_inv.Take(slot_id);
 	}
 	else if (slot_id >= legacy::TRIBUTE_BEGIN && slot_id <= legacy::TRIBUTE_END) {
-		p = m_worn[slot_id];
-		m_worn.erase(slot_id);
+		p = m_worn.Take(slot_id);
 	}
 	else if (slot_id >= legacy::BANK_BEGIN && slot_id <= legacy::BANK_END) {
-		p = m_bank[slot_id];
-		m_bank.erase(slot_id);
+		p = m_bank.Take(slot_id);
 	}
 	else if (slot_id >= legacy::SHARED_BANK_BEGIN && slot_id <= legacy::SHARED_BANK_END) {
-		p = m_shbank[slot_id];
-		m_shbank.erase(slot_id);
+		p = m_shbank.Take(slot_id);
 	}
 	else if (slot_id >= legacy::TRADE_BEGIN && slot_id <= legacy::TRADE_END) {
-		p = m_trade[slot_id];
-		m_trade.erase(slot_id);
+		p = m_trade.Take(slot_id);
 	}
 	else {
 		// Is slot inside bag?
@@ -705,7 +699,7 @@ int16 EQEmu::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst
 	// step 1: find room for bags (caller should really ask for slots for bags first to avoid sending them to cursor..and bag item loss)
 	if (inst->IsClassBag()) {
 		for (int16 free_slot = general_start; free_slot <= legacy::GENERAL_END; ++free_slot) {
-			if (!m_inv[free_slot])
+			if (!m_inv.Get(free_slot))
 				return free_slot;
 		}
 
@@ -715,7 +709,7 @@ int16 EQEmu::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst
 	// step 2: find partial room for stackables
 	if (inst->IsStackable()) {
 		for (int16 free_slot = general_start; free_slot <= legacy::GENERAL_END; ++free_slot) {
-			const ItemInstance* main_inst = m_inv[free_slot];
+			const ItemInstance* main_inst = m_inv.Get(free_slot);
 
 			if (!main_inst)
 				continue;
@@ -725,7 +719,7 @@ int16 EQEmu::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst
 		}
 
 		for (int16 free_slot = general_start; free_slot <= legacy::GENERAL_END; ++free_slot) {
-			const ItemInstance* main_inst = m_inv[free_slot];
+			const ItemInstance* main_inst = m_inv.Get(free_slot);
 
 			if (!main_inst)
 				continue;
@@ -748,7 +742,7 @@ int16 EQEmu::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst
 	// step 3a: find room for container-specific items (ItemClassArrow)
 	if (inst->GetItem()->ItemType == item::ItemTypeArrow) {
 		for (int16 free_slot = general_start; free_slot <= legacy::GENERAL_END; ++free_slot) {
-			const ItemInstance* main_inst = m_inv[free_slot];
+			const ItemInstance* main_inst = m_inv.Get(free_slot);
 
 			if (!main_inst || (main_inst->GetItem()->BagType != item::BagTypeQuiver) || !main_inst->IsClassBag())
 				continue;
@@ -764,7 +758,7 @@ int16 EQEmu::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst
 	// step 3b: find room for container-specific items (ItemClassSmallThrowing)
 	if (inst->GetItem()->ItemType == item::ItemTypeSmallThrowing) {
 		for (int16 free_slot = general_start; free_slot <= legacy::GENERAL_END; ++free_slot) {
-			const ItemInstance* main_inst = m_inv[free_slot];
+			const ItemInstance* main_inst = m_inv.Get(free_slot);
 
 			if (!main_inst || (main_inst->GetItem()->BagType != item::BagTypeBandolier) || !main_inst->IsClassBag())
 				continue;
@@ -779,14 +773,14 @@ int16 EQEmu::InventoryProfile::FindFreeSlotForTradeItem(const ItemInstance* inst
 
 	// step 4: just find an empty slot
 	for (int16 free_slot = general_start; free_slot <= legacy::GENERAL_END; ++free_slot) {
-		const ItemInstance* main_inst = m_inv[free_slot];
+		const ItemInstance* main_inst = m_inv.Get(free_slot);
 
 		if (!main_inst)
 			return free_slot;
 	}
 
 	for (int16 free_slot = general_start; free_slot <= legacy::GENERAL_END; ++free_slot) {
-		const ItemInstance* main_inst = m_inv[free_slot];
+		const ItemInstance* main_inst = m_inv.Get(free_slot);
 
 		if (main_inst && main_inst->IsClassBag()) {
 			if ((main_inst->GetItem()->BagSize < inst->GetItem()->Size) || (main_inst->GetItem()->BagType == item::BagTypeBandolier) || (main_inst->GetItem()->BagType == item::BagTypeQuiver))
@@ -1034,6 +1028,21 @@ int EQEmu::InventoryProfile::GetSlotByItemInst(ItemInstance *inst) {
 	return INVALID_INDEX;
 }
 
+void EQEmu::InventoryProfile::JournalSlot(int16 slot_id)
+{
+	// tribute slots are never saved
+	if (slot_id >= legacy::TRIBUTE_BEGIN && slot_id <= legacy::TRIBUTE_END)
+		return;
+
+	// the cursor is saved as a whole queue, the same way SaveCursor does it
+	if (slot_id == inventory::slotCursor || (slot_id >= legacy::CURSOR_BAG_BEGIN && slot_id <= legacy::CURSOR_BAG_END) || (slot_id >= 8000 && slot_id <= 8999)) {
+		m_journal_cursor = true;
+		return;
+	}
+
+	m_journal_slots.insert(slot_id);
+}
+
 uint8 EQEmu::InventoryProfile::FindBrightestLightType()
 {
 	uint8 brightest_light_type = 0;
@@ -1105,7 +1114,7 @@ void EQEmu::InventoryProfile::dumpSharedBankItems() {
 	dumpItemCollection(m_shbank);
 }
 
-int EQEmu::InventoryProfile::GetSlotByItemInstCollection(const std::map<int16, ItemInstance*> &collection, ItemInstance *inst) {
+int EQEmu::InventoryProfile::GetSlotByItemInstCollection(const ItemBucket &collection, ItemInstance *inst) {
 	for (auto iter = collection.begin(); iter != collection.end(); ++iter) {
 		ItemInstance *t_inst = iter->second;
 		if (t_inst == inst) {
@@ -1124,7 +1133,7 @@ int EQEmu::InventoryProfile::GetSlotByItemInstCollection(const std::map<int16, I
 	return -1;
 }
 
-void EQEmu::InventoryProfile::dumpItemCollection(const std::map<int16, ItemInstance*> &collection)
+void EQEmu::InventoryProfile::dumpItemCollection(const ItemBucket &collection)
 {
 	for (auto it = collection.cbegin(); it != collection.cend(); ++it) {
 		auto inst = it->second;
@@ -1138,7 +1147,7 @@ void EQEmu::InventoryProfile::dumpItemCollection(const std::map<int16, ItemInsta
 	}
 }
 
-void EQEmu::InventoryProfile::dumpBagContents(ItemInstance *inst, std::map<int16, ItemInstance*>::const_iterator *it)
+void EQEmu::InventoryProfile::dumpBagContents(ItemInstance *inst, ItemBucket::const_iterator *it)
 {
 	if (!inst || !inst->IsClassBag())
 		return;
@@ -1157,15 +1166,9 @@ void EQEmu::InventoryProfile::dumpBagContents(ItemInstance *inst, std::map<int16
 }
 
 // Internal Method: Retrieves item within an inventory bucket
-EQEmu::ItemInstance* EQEmu::InventoryProfile::_GetItem(const std::map<int16, ItemInstance*>& bucket, int16 slot_id) const
+EQEmu::ItemInstance* EQEmu::InventoryProfile::_GetItem(const ItemBucket& bucket, int16 slot_id) const
 {
-	auto it = bucket.find(slot_id);
-	if (it != bucket.end()) {
-		return it->second;
-	}
-
-	// Not found!
-	return nullptr;
+	return bucket.Get(slot_id);
 }
 
 // Internal Method: "put" item into bucket, without regard for what is currently in bucket
@@ -1191,27 +1194,27 @@ int16 EQEmu::InventoryProfile::_PutItem(int16 slot_id, ItemInstance* inst)
 		result = slot_id;
 	}
 	else if ((slot_id >= legacy::EQUIPMENT_BEGIN && slot_id <= legacy::EQUIPMENT_END) || (slot_id == inventory::slotPowerSource)) {
-		m_worn[slot_id] = inst;
+		m_worn.Set(slot_id, inst);
 		result = slot_id;
 	}
 	else if ((slot_id >= legacy::GENERAL_BEGIN && slot_id <= legacy::GENERAL_END)) {
-		m_inv[slot_id] = inst;
+		m_inv.Set(slot_id, inst);
 		result = slot_id;
 	}
 	else if (slot_id >= legacy::TRIBUTE_BEGIN && slot_id <= legacy::TRIBUTE_END) {
-		m_worn[slot_id] = inst;
+		m_worn.Set(slot_id, inst);
 		result = slot_id;
 	}
 	else if (slot_id >= legacy::BANK_BEGIN && slot_id <= legacy::BANK_END) {
-		m_bank[slot_id] = inst;
+		m_bank.Set(slot_id, inst);
 		result = slot_id;
 	}
 	else if (slot_id >= legacy::SHARED_BANK_BEGIN && slot_id <= legacy::SHARED_BANK_END) {
-		m_shbank[slot_id] = inst;
+		m_shbank.Set(slot_id, inst);
 		result = slot_id;
 	}
 	else if (slot_id >= legacy::TRADE_BEGIN && slot_id <= legacy::TRADE_END) {
-		m_trade[slot_id] = inst;
+		m_trade.Set(slot_id, inst);
 		result = slot_id;
 	}
 	else {
@@ -1234,45 +1237,127 @@ int16 EQEmu::InventoryProfile::_PutItem(int16 slot_id, ItemInstance* inst)
 }
 
 // Internal Method: Checks an inventory bucket for a particular item
-int16 EQEmu::InventoryProfile::_HasItem(std::map<int16, ItemInstance*>& bucket, uint32 item_id, uint8 quantity)
+int16 EQEmu::InventoryProfile::_HasItem(ItemBucket& bucket, uint32 item_id, uint8 quantity)
 {
 	uint32 quantity_found = 0;
 
-	for (auto iter = bucket.begin(); iter != bucket.end(); ++iter) {
-		auto inst = iter->second;
+	// empty sockets report id 0, keep the full walk for that so results don't change
+	if (item_id == 0) {
+		for (auto iter = bucket.begin(); iter != bucket.end(); ++iter) {
+			int16 result = _HasItemInSlot(iter->first, iter->second, item_id, quantity, quantity_found);
+			if (result != INVALID_INDEX)
+				return result;
+		}
+
+		return INVALID_INDEX;
+	}
+
+	// only slots known to hold the item can contribute, walked in the same (ascending) order as the bucket
+	const std::vector<int16>* item_slots = _GetItemSlots(item_id);
+	if (item_slots == nullptr)
+		return INVALID_INDEX;
+
+	for (auto slot_id : *item_slots) {
+		auto inst = bucket.Get(slot_id);
 		if (inst == nullptr) { continue; }
 
-		if (inst->GetID() == item_id) {
-			quantity_found += (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
+		int16 result = _HasItemInSlot(slot_id, inst, item_id, quantity, quantity_found);
+		if (result != INVALID_INDEX)
+			return result;
+	}
+
+	return INVALID_INDEX;
+}
+
+// Internal Method: Checks one top level slot, its augments and bag contents for a particular item
+int16 EQEmu::InventoryProfile::_HasItemInSlot(int16 slot_id, ItemInstance* inst, uint32 item_id, uint8 quantity, uint32& quantity_found)
+{
+	if (inst->GetID() == item_id) {
+		quantity_found += (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
+		if (quantity_found >= quantity)
+			return slot_id;
+	}
+
+	for (int index = inventory::socketBegin; index < inventory::SocketCount; ++index) {
+		if (inst->GetAugmentItemID(index) == item_id && quantity <= 1)
+			return legacy::SLOT_AUGMENT;
+	}
+
+	if (!inst->IsClassBag())
+		return INVALID_INDEX;
+
+	for (auto bag_iter = inst->_cbegin(); bag_iter != inst->_cend(); ++bag_iter) {
+		auto bag_inst = bag_iter->second;
+		if (bag_inst == nullptr) { continue; }
+
+		if (bag_inst->GetID() == item_id) {
+			quantity_found += (bag_inst->GetCharges() <= 0) ? 1 : bag_inst->GetCharges();
 			if (quantity_found >= quantity)
-				return iter->first;
+				return InventoryProfile::CalcSlotId(slot_id, bag_iter->first);
 		}
 
 		for (int index = inventory::socketBegin; index < inventory::SocketCount; ++index) {
-			if (inst->GetAugmentItemID(index) == item_id && quantity <= 1)
+			if (bag_inst->GetAugmentItemID(index) == item_id && quantity <= 1)
 				return legacy::SLOT_AUGMENT;
 		}
-		
+	}
+
+	return INVALID_INDEX;
+}
+
+// Internal Method: Top level slots (any bucket but the cursor) whose item, augments or bag contents include item_id
+const std::vector<int16>* EQEmu::InventoryProfile::_GetItemSlots(uint32 item_id)
+{
+	uint32 serial = GetContentsSerial();
+	if (!m_item_slots_built || m_item_slots_serial != serial) {
+		for (auto iter = m_item_slots.begin(); iter != m_item_slots.end(); ++iter)
+			iter->second.clear();
+
+		_BuildItemSlots(m_worn);
+		_BuildItemSlots(m_inv);
+		_BuildItemSlots(m_bank);
+		_BuildItemSlots(m_shbank);
+		_BuildItemSlots(m_trade);
+
+		m_item_slots_serial = serial;
+		m_item_slots_built = true;
+	}
+
+	auto iter = m_item_slots.find(item_id);
+	if (iter == m_item_slots.end() || iter->second.empty())
+		return nullptr;
+
+	return &iter->second;
+}
+
+void EQEmu::InventoryProfile::_BuildItemSlots(const ItemBucket& bucket)
+{
+	auto add = [this](uint32 item_id, int16 slot_id) {
+		if (item_id == 0)
+			return;
+
+		std::vector<int16>& slots = m_item_slots[item_id];
+		if (slots.empty() || slots.back() != slot_id)
+			slots.push_back(slot_id);
+	};
+
+	for (auto iter = bucket.cbegin(); iter != bucket.cend(); ++iter) {
+		auto inst = iter->second;
+
+		add(inst->GetID(), iter->first);
+		for (int index = inventory::socketBegin; index < inventory::SocketCount; ++index)
+			add(inst->GetAugmentItemID(index), iter->first);
+
 		if (!inst->IsClassBag()) { continue; }
 
 		for (auto bag_iter = inst->_cbegin(); bag_iter != inst->_cend(); ++bag_iter) {
 			auto bag_inst = bag_iter->second;
-			if (bag_inst == nullptr) { continue; }
 
-			if (bag_inst->GetID() == item_id) {
-				quantity_found += (bag_inst->GetCharges() <= 0) ? 1 : bag_inst->GetCharges();
-				if (quantity_found >= quantity)
-					return InventoryProfile::CalcSlotId(iter->first, bag_iter->first);
-			}
-
-			for (int index = inventory::socketBegin; index < inventory::SocketCount; ++index) {
-				if (bag_inst->GetAugmentItemID(index) == item_id && quantity <= 1)
-					return legacy::SLOT_AUGMENT;
-			}
+			add(bag_inst->GetID(), iter->first);
+			for (int index = inventory::socketBegin; index < inventory::SocketCount; ++index)
+				add(bag_inst->GetAugmentItemID(index), iter->first);
 		}
 	}
-
-	return INVALID_INDEX;
 }
 
 // Internal Method: Checks an inventory queue type bucket for a particular item
@@ -1327,7 +1412,7 @@ int16 EQEmu::InventoryProfile::_HasItem(ItemInstQueue& iqueue, uint32 item_id, u
 }
 
 // Internal Method: Checks an inventory bucket for a particular item
-int16 EQEmu::InventoryProfile::_HasItemByUse(std::map<int16, ItemInstance*>& bucket, uint8 use, uint8 quantity)
+int16 EQEmu::InventoryProfile::_HasItemByUse(ItemBucket& bucket, uint8 use, uint8 quantity)
 {
 	uint32 quantity_found = 0;
 
@@ -1393,7 +1478,7 @@ int16 EQEmu::InventoryProfile::_HasItemByUse(ItemInstQueue& iqueue, uint8 use, u
 	return INVALID_INDEX;
 }
 
-int16 EQEmu::InventoryProfile::_HasItemByLoreGroup(std::map<int16, ItemInstance*>& bucket, uint32 loregroup)
+int16 EQEmu::InventoryProfile::_HasItemByLoreGroup(ItemBucket& bucket, uint32 loregroup)
 {
 	for (auto iter = bucket.begin(); iter != bucket.end(); ++iter) {
 		auto inst = iter->second;
@@ -28,6 +28,9 @@
 #include "item_instance.h"
 
 #include <list>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 
 //FatherNitwit: location bits for searching specific
@@ -85,7 +88,18 @@ namespace EQEmu
 		// Public Methods
 		///////////////////////////////
 
-		InventoryProfile() {
+		InventoryProfile() :
+			m_worn(legacy::EQUIPMENT_BEGIN, legacy::EQUIPMENT_END),
+			m_inv(legacy::GENERAL_BEGIN, legacy::GENERAL_END),
+			m_bank(legacy::BANK_BEGIN, legacy::BANK_END),
+			m_shbank(legacy::SHARED_BANK_BEGIN, legacy::SHARED_BANK_END),
+			m_trade(legacy::TRADE_BEGIN, legacy::TRADE_END),
+			m_item_slots_serial(0),
+			m_item_slots_built(false),
+			m_journal_cursor(false)
+		{
+			m_worn.AddRange(legacy::TRIBUTE_BEGIN, legacy::TRIBUTE_END);
+			m_worn.AddRange(inventory::slotPowerSource, inventory::slotPowerSource);
 			m_mob_version = versions::MobVersion::Unknown;
 			m_mob_version_set = false;
 			m_lookup = inventory::Lookup(versions::MobVersion::Unknown);
@@ -183,8 +197,19 @@ namespace EQEmu
 
 		int GetSlotByItemInst(ItemInstance *inst);
 
+		// Slots changed since the last save, written as they are at flush time (see SharedDatabase::SaveInventoryJournal)
+		void JournalSlot(int16 slot_id);
+		void JournalCursor() { m_journal_cursor = true; }
+		bool JournalEmpty() const { return m_journal_slots.empty() && !m_journal_cursor; }
+		const std::set<int16>& GetJournalSlots() const { return m_journal_slots; }
+		bool IsCursorJournaled() const { return m_journal_cursor; }
+		void ClearJournal() { m_journal_slots.clear(); m_journal_cursor = false; }
+
 		uint8 FindBrightestLightType();
 
+		// Moves whenever an item in worn, general, bank, shared bank or trade slots (or inside one) changes
+		uint32 GetContentsSerial() const { return m_worn.GetSerial() + m_inv.GetSerial() + m_bank.GetSerial() + m_shbank.GetSerial() + m_trade.GetSerial(); }
+
 		void dumpEntireInventory();
 		void dumpWornItems();
 		void dumpInventory();
@@ -201,33 +226,50 @@ namespace EQEmu
 		// Protected Methods
 		///////////////////////////////
 
-		int GetSlotByItemInstCollection(const std::map<int16, ItemInstance*> &collection, ItemInstance *inst);
-		void dumpItemCollection(const std::map<int16, ItemInstance*> &collection);
-		void dumpBagContents(ItemInstance *inst, std::map<int16, ItemInstance*>::const_iterator *it);
+		// Worn holds equipment, tribute and power source, the other buckets use one range
+		typedef InventorySlots<int16, 3> ItemBucket;
+
+		int GetSlotByItemInstCollection(const ItemBucket &collection, ItemInstance *inst);
+		void dumpItemCollection(const ItemBucket &collection);
+		void dumpBagContents(ItemInstance *inst, ItemBucket::const_iterator *it);
 
 		// Retrieves item within an inventory bucket
-		ItemInstance* _GetItem(const std::map<int16, ItemInstance*>& bucket, int16 slot_id) const;
+		ItemInstance* _GetItem(const ItemBucket& bucket, int16 slot_id) const;
 
 		// Private "put" item into bucket, without regard for what is currently in bucket
 		int16 _PutItem(int16 slot_id, ItemInstance* inst);
 
 		// Checks an inventory bucket for a particular item
-		int16 _HasItem(std::map<int16, ItemInstance*>& bucket, uint32 item_id, uint8 quantity);
+		int16 _HasItem(ItemBucket& bucket, uint32 item_id, uint8 quantity);
 		int16 _HasItem(ItemInstQueue& iqueue, uint32 item_id, uint8 quantity);
-		int16 _HasItemByUse(std::map<int16, ItemInstance*>& bucket, uint8 use, uint8 quantity);
+		int16 _HasItemInSlot(int16 slot_id, ItemInstance* inst, uint32 item_id, uint8 quantity, uint32& quantity_found);
+		int16 _HasItemByUse(ItemBucket& bucket, uint8 use, uint8 quantity);
 		int16 _HasItemByUse(ItemInstQueue& iqueue, uint8 use, uint8 quantity);
-		int16 _HasItemByLoreGroup(std::map<int16, ItemInstance*>& bucket, uint32 loregroup);
+		int16 _HasItemByLoreGroup(ItemBucket& bucket, uint32 loregroup);
 		int16 _HasItemByLoreGroup(ItemInstQueue& iqueue, uint32 loregroup);
 
+		// Item id -> top level slots holding it (directly, as an augment or inside a bag)
+		const std::vector<int16>* _GetItemSlots(uint32 item_id);
+		void _BuildItemSlots(const ItemBucket& bucket);
+
 
 		// Player inventory
-		std::map<int16, ItemInstance*>	m_worn;		// Items worn by character
-		std::map<int16, ItemInstance*>	m_inv;		// Items in character personal inventory
-		std::map<int16, ItemInstance*>	m_bank;		// Items in character bank
-		std::map<int16, ItemInstance*>	m_shbank;	// Items in character shared bank
-		std::map<int16, ItemInstance*>	m_trade;	// Items in a trade session
+		ItemBucket						m_worn;		// Items worn by character
+		ItemBucket						m_inv;		// Items in character personal inventory
+		ItemBucket						m_bank;		// Items in character bank
+		ItemBucket						m_shbank;	// Items in character shared bank
+		ItemBucket						m_trade;	// Items in a trade session
 		::ItemInstQueue					m_cursor;	// Items on cursor: FIFO
 
+		// Rebuilt lazily whenever something in this profile's buckets changed since it was built
+		std::unordered_map<uint32, std::vector<int16>>	m_item_slots;
+		uint32							m_item_slots_serial;
+		bool							m_item_slots_built;
+
+		// Save journal
+		std::set<int16>					m_journal_slots;
+		bool							m_journal_cursor;
+
 	private:
 		// Active mob version
 		versions::MobVersion m_mob_version;
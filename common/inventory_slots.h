@@ -0,0 +1,262 @@
+/*	EQEMu: Everquest Server Emulator
+
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  04111-1307  USA
+*/
+
+#ifndef COMMON_INVENTORY_SLOTS_H
+#define COMMON_INVENTORY_SLOTS_H
+
+#include "types.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+
+namespace EQEmu
+{
+	class ItemInstance;
+
+	/*
+	 * Change counter for one slot array. The contents of an item count up
+	 * into the slot array holding that item, so a profile's buckets move when
+	 * anything under them changes, bags and augments included, and arrays
+	 * that belong to other profiles or loose instances never touch them.
+	 */
+	class InventorySlotsSerial
+	{
+	public:
+		InventorySlotsSerial() : m_serial(0), m_holder(nullptr) { }
+		// a copied array is a different array, it starts its own count and has no holder
+		InventorySlotsSerial(const InventorySlotsSerial&) : m_serial(0), m_holder(nullptr) { }
+		InventorySlotsSerial& operator=(const InventorySlotsSerial&) { return *this; }
+
+		uint32 Get() const { return m_serial; }
+		void Bump() {
+			for (InventorySlotsSerial* serial = this; serial != nullptr; serial = serial->m_holder)
+				++serial->m_serial;
+		}
+
+	private:
+		template<typename K, size_t R> friend class InventorySlots;
+
+		uint32 m_serial;
+		InventorySlotsSerial* m_holder;
+	};
+
+	// Serial of an item's contents, defined next to ItemInstance
+	InventorySlotsSerial* GetContentsSerial(ItemInstance* inst);
+
+	/*
+	 * Item slots backed by a flat array of pointers, replacing the
+	 * std::map<slot, ItemInstance*> buckets. A slot array covers up to R
+	 * contiguous slot id ranges (worn is equipment + tribute + power source),
+	 * a null entry is an empty slot and slot ids outside the ranges are
+	 * rejected. Storage is only allocated on the first put, item instances
+	 * that never hold anything stay small.
+	 *
+	 * Iteration visits occupied slots in ascending slot id order and yields
+	 * (slot id, pointer) pairs, same as walking the old maps.
+	 *
+	 * An item put in a slot is linked to this array's serial until it is
+	 * taken or erased back out. Items still held when the array goes away
+	 * must be deleted by the owner first, clear() does not look at them.
+	 */
+	template<typename K, size_t R = 1>
+	class InventorySlots
+	{
+	public:
+		typedef std::pair<K, ItemInstance*> value_type;
+
+		class const_iterator
+		{
+		public:
+			const_iterator() : m_owner(nullptr), m_index(0) { }
+			const_iterator(const InventorySlots* owner, size_t index) : m_owner(owner), m_index(index) { Settle(); }
+
+			const value_type& operator*() const { return m_value; }
+			const value_type* operator->() const { return &m_value; }
+			const_iterator& operator++() { ++m_index; Settle(); return *this; }
+			const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+			bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+			bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+
+		private:
+			friend class InventorySlots;
+
+			void Settle() {
+				const std::vector<ItemInstance*>& slots = m_owner->m_slots;
+				while (m_index < slots.size() && slots[m_index] == nullptr)
+					++m_index;
+				if (m_index < slots.size())
+					m_value = value_type(m_owner->SlotAt(m_index), slots[m_index]);
+				else
+					m_index = slots.size();
+			}
+
+			const InventorySlots* m_owner;
+			size_t m_index;
+			value_type m_value;
+		};
+		typedef const_iterator iterator;
+
+		InventorySlots() : m_range_count(0), m_capacity(0), m_count(0) { }
+		InventorySlots(K begin, K end) : m_range_count(0), m_capacity(0), m_count(0) { AddRange(begin, end); }
+
+		void AddRange(K begin, K end) {
+			if (m_range_count >= R || end < begin)
+				return;
+
+			m_ranges[m_range_count].begin = begin;
+			m_ranges[m_range_count].end = end;
+			m_ranges[m_range_count].offset = m_capacity;
+			m_capacity += static_cast<uint16>(end - begin) + 1;
+			++m_range_count;
+		}
+
+		bool Contains(K slot) const { return IndexOf(slot) != NoIndex; }
+
+		ItemInstance* Get(K slot) const {
+			size_t index = IndexOf(slot);
+			if (index == NoIndex || index >= m_slots.size())
+				return nullptr;
+			return m_slots[index];
+		}
+
+		// Puts inst in slot without regard for what is there, nullptr empties it
+		bool Set(K slot, ItemInstance* inst) {
+			size_t index = IndexOf(slot);
+			if (index == NoIndex)
+				return false;
+
+			if (m_slots.empty()) {
+				if (inst == nullptr)
+					return true;
+				m_slots.resize(m_capacity, nullptr);
+			}
+
+			ItemInstance* old = m_slots[index];
+			if (old == nullptr && inst != nullptr)
+				++m_count;
+			else if (old != nullptr && inst == nullptr)
+				--m_count;
+
+			m_slots[index] = inst;
+			if (old != inst) {
+				if (old)
+					Release(old);
+				if (inst)
+					GetContentsSerial(inst)->m_holder = &m_serial;
+			}
+			m_serial.Bump();
+			return true;
+		}
+
+		// Empties slot and hands back what was in it
+		ItemInstance* Take(K slot) {
+			ItemInstance* inst = Get(slot);
+			if (inst)
+				Set(slot, nullptr);
+			return inst;
+		}
+
+		// Bumped by any change here or in the contents of anything held here
+		uint32 GetSerial() const { return m_serial.Get(); }
+
+		const_iterator begin() const { return const_iterator(this, 0); }
+		const_iterator end() const { return const_iterator(this, m_slots.size()); }
+		const_iterator cbegin() const { return begin(); }
+		const_iterator cend() const { return end(); }
+
+		const_iterator find(K slot) const {
+			size_t index = IndexOf(slot);
+			if (index == NoIndex || index >= m_slots.size() || m_slots[index] == nullptr)
+				return end();
+			return const_iterator(this, index);
+		}
+
+		const_iterator erase(const_iterator it) {
+			if (it.m_index < m_slots.size() && m_slots[it.m_index] != nullptr) {
+				ItemInstance* inst = m_slots[it.m_index];
+				m_slots[it.m_index] = nullptr;
+				--m_count;
+				Release(inst);
+				m_serial.Bump();
+			}
+			return const_iterator(this, it.m_index + 1);
+		}
+
+		void erase(K slot) { Set(slot, nullptr); }
+
+		// Forgets every pointer, deleting them is up to the owner
+		void clear() {
+			if (m_count)
+				m_serial.Bump();
+			m_slots.clear();
+			m_count = 0;
+		}
+
+		size_t size() const { return m_count; }
+		bool empty() const { return m_count == 0; }
+
+	private:
+		friend InventorySlotsSerial* GetContentsSerial(ItemInstance* inst);
+
+		static const size_t NoIndex = static_cast<size_t>(-1);
+
+		struct Range {
+			K begin;
+			K end;
+			uint16 offset;
+		};
+
+		size_t IndexOf(K slot) const {
+			for (size_t i = 0; i < m_range_count; ++i) {
+				if (slot >= m_ranges[i].begin && slot <= m_ranges[i].end)
+					return m_ranges[i].offset + static_cast<size_t>(slot - m_ranges[i].begin);
+			}
+			return NoIndex;
+		}
+
+		// unlinks an item that left this array, unless it still sits in another slot here (a swap in progress)
+		void Release(ItemInstance* inst) {
+			InventorySlotsSerial* serial = GetContentsSerial(inst);
+			if (serial->m_holder != &m_serial)
+				return;
+			if (std::find(m_slots.begin(), m_slots.end(), inst) == m_slots.end())
+				serial->m_holder = nullptr;
+		}
+
+		K SlotAt(size_t index) const {
+			for (size_t i = 0; i < m_range_count; ++i) {
+				size_t count = static_cast<size_t>(m_ranges[i].end - m_ranges[i].begin) + 1;
+				if (index < m_ranges[i].offset + count)
+					return static_cast<K>(m_ranges[i].begin + (index - m_ranges[i].offset));
+			}
+			return static_cast<K>(-1);
+		}
+
+		Range m_ranges[R];
+		uint8 m_range_count;
+		uint16 m_capacity;
+		uint16 m_count;
+		std::vector<ItemInstance*> m_slots;
+		InventorySlotsSerial m_serial;
+	};
+}
+
+#endif /*COMMON_INVENTORY_SLOTS_H*/
@@ -0,0 +1,186 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "item_hot_table.h"
+#include "item_data.h"
+#include "eqemu_exception.h"
+
+#include <string.h>
+
+namespace {
+	const uint32 ItemHotTableMagic = 0x49485431; // IHT1
+
+	struct ItemHotTableHeader {
+		uint32 magic;
+		uint32 stats_size;
+		uint32 flags_size;
+		uint32 count;
+	};
+}
+
+void EQEmu::ItemHotStats::Set(const ItemData &item)
+{
+	memset(this, 0, sizeof(ItemHotStats));
+
+	AC = item.AC;
+	HP = item.HP;
+	Mana = item.Mana;
+	Endur = item.Endur;
+	Attack = item.Attack;
+	AStr = item.AStr;
+	ASta = item.ASta;
+	AAgi = item.AAgi;
+	ADex = item.ADex;
+	ACha = item.ACha;
+	AInt = item.AInt;
+	AWis = item.AWis;
+	CR = item.CR;
+	DR = item.DR;
+	PR = item.PR;
+	MR = item.MR;
+	FR = item.FR;
+	SVCorruption = item.SVCorruption;
+	HeroicStr = item.HeroicStr;
+	HeroicInt = item.HeroicInt;
+	HeroicWis = item.HeroicWis;
+	HeroicAgi = item.HeroicAgi;
+	HeroicDex = item.HeroicDex;
+	HeroicSta = item.HeroicSta;
+	HeroicCha = item.HeroicCha;
+	HeroicMR = item.HeroicMR;
+	HeroicFR = item.HeroicFR;
+	HeroicCR = item.HeroicCR;
+	HeroicDR = item.HeroicDR;
+	HeroicPR = item.HeroicPR;
+	HeroicSVCorrup = item.HeroicSVCorrup;
+	Haste = item.Haste;
+	Regen = item.Regen;
+	ManaRegen = item.ManaRegen;
+	EnduranceRegen = item.EnduranceRegen;
+	DamageShield = item.DamageShield;
+	DotShielding = item.DotShielding;
+	DSMitigation = item.DSMitigation;
+	Clairvoyance = item.Clairvoyance;
+	HealAmt = item.HealAmt;
+	SpellDmg = item.SpellDmg;
+	SpellShield = item.SpellShield;
+	Shielding = item.Shielding;
+	StunResist = item.StunResist;
+	StrikeThrough = item.StrikeThrough;
+	Avoidance = item.Avoidance;
+	Accuracy = item.Accuracy;
+	CombatEffects = item.CombatEffects;
+	WornType = item.Worn.Type;
+	WornEffect = item.Worn.Effect;
+	WornLevel = item.Worn.Level;
+	FocusType = item.Focus.Type;
+	FocusLevel = item.Focus.Level;
+	FocusEffect = item.Focus.Effect;
+	BardType = item.BardType;
+	BardValue = item.BardValue;
+	FactionMod1 = item.FactionMod1;
+	FactionMod2 = item.FactionMod2;
+	FactionMod3 = item.FactionMod3;
+	FactionMod4 = item.FactionMod4;
+	FactionAmt1 = item.FactionAmt1;
+	FactionAmt2 = item.FactionAmt2;
+	FactionAmt3 = item.FactionAmt3;
+	FactionAmt4 = item.FactionAmt4;
+	ExtraDmgSkill = item.ExtraDmgSkill;
+	ExtraDmgAmt = item.ExtraDmgAmt;
+	SkillModValue = item.SkillModValue;
+	SkillModMax = item.SkillModMax;
+	SkillModType = item.SkillModType;
+}
+
+void EQEmu::ItemHotFlags::Set(const ItemData &item)
+{
+	memset(this, 0, sizeof(ItemHotFlags));
+
+	ID = item.ID;
+	Slots = item.Slots;
+	Classes = item.Classes;
+	Races = item.Races;
+	LoreGroup = item.LoreGroup;
+	Damage = item.Damage;
+	BaneDmgBody = item.BaneDmgBody;
+	BaneDmgRace = item.BaneDmgRace;
+	BaneDmgRaceAmt = item.BaneDmgRaceAmt;
+	BaneDmgAmt = item.BaneDmgAmt;
+	ItemClass = item.ItemClass;
+	ItemType = item.ItemType;
+	Delay = item.Delay;
+	ElemDmgType = item.ElemDmgType;
+	ElemDmgAmt = item.ElemDmgAmt;
+	Range = item.Range;
+	ReqLevel = item.ReqLevel;
+	RecLevel = item.RecLevel;
+	NoDrop = item.NoDrop;
+	LoreFlag = item.LoreFlag;
+	Magic = item.Magic;
+}
+
+size_t EQEmu::ItemHotTable::estimated_size(uint32 element_count)
+{
+	return sizeof(ItemHotTableHeader) + (sizeof(ItemHotStats) + sizeof(ItemHotFlags)) * static_cast<size_t>(element_count);
+}
+
+EQEmu::ItemHotTable::ItemHotTable(void *data, size_t size, uint32 element_count)
+{
+	if (size < estimated_size(element_count))
+		EQ_EXCEPT("ItemHotTable", "Not enough room for the table.");
+
+	uint8 *bytes = reinterpret_cast<uint8*>(data);
+	ItemHotTableHeader *header = reinterpret_cast<ItemHotTableHeader*>(bytes);
+	header->magic = ItemHotTableMagic;
+	header->stats_size = sizeof(ItemHotStats);
+	header->flags_size = sizeof(ItemHotFlags);
+	header->count = element_count;
+
+	count = element_count;
+	stats = reinterpret_cast<ItemHotStats*>(bytes + sizeof(ItemHotTableHeader));
+	flags = reinterpret_cast<ItemHotFlags*>(bytes + sizeof(ItemHotTableHeader) + sizeof(ItemHotStats) * static_cast<size_t>(count));
+	memset(stats, 0, estimated_size(count) - sizeof(ItemHotTableHeader));
+}
+
+EQEmu::ItemHotTable::ItemHotTable(const void *data, size_t size)
+{
+	if (size < sizeof(ItemHotTableHeader))
+		EQ_EXCEPT("ItemHotTable", "Table is smaller than its header.");
+
+	uint8 *bytes = reinterpret_cast<uint8*>(const_cast<void*>(data));
+	const ItemHotTableHeader *header = reinterpret_cast<const ItemHotTableHeader*>(bytes);
+	if (header->magic != ItemHotTableMagic || header->stats_size != sizeof(ItemHotStats) || header->flags_size != sizeof(ItemHotFlags))
+		EQ_EXCEPT("ItemHotTable", "Table is missing or was written by an incompatible version.");
+
+	if (estimated_size(header->count) > size)
+		EQ_EXCEPT("ItemHotTable", "Table is truncated.");
+
+	count = header->count;
+	stats = reinterpret_cast<ItemHotStats*>(bytes + sizeof(ItemHotTableHeader));
+	flags = reinterpret_cast<ItemHotFlags*>(bytes + sizeof(ItemHotTableHeader) + sizeof(ItemHotStats) * static_cast<size_t>(count));
+}
+
+void EQEmu::ItemHotTable::Set(uint32 index, const ItemData &item)
+{
+	if (index >= count)
+		return;
+
+	stats[index].Set(item);
+	flags[index].Set(item);
+}
@@ -0,0 +1,172 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef COMMON_ITEM_HOT_TABLE_H
+#define COMMON_ITEM_HOT_TABLE_H
+
+#include "types.h"
+
+#include <stddef.h>
+
+
+namespace EQEmu
+{
+	struct ItemData;
+
+	/*
+	 * Everything Client::AddItemBonuses reads, with the same names and types
+	 * as ItemData so the two read the same.
+	 */
+	struct ItemHotStats {
+		int32	AC;
+		int32	HP;
+		int32	Mana;
+		uint32	Endur;
+		uint32	Attack;
+		int8	AStr;
+		int8	ASta;
+		int8	AAgi;
+		int8	ADex;
+		int8	ACha;
+		int8	AInt;
+		int8	AWis;
+		int8	CR;
+		int8	DR;
+		int8	PR;
+		int8	MR;
+		int8	FR;
+		int32	SVCorruption;
+		int32	HeroicStr;
+		int32	HeroicInt;
+		int32	HeroicWis;
+		int32	HeroicAgi;
+		int32	HeroicDex;
+		int32	HeroicSta;
+		int32	HeroicCha;
+		int32	HeroicMR;
+		int32	HeroicFR;
+		int32	HeroicCR;
+		int32	HeroicDR;
+		int32	HeroicPR;
+		int32	HeroicSVCorrup;
+		uint32	Haste;
+		uint32	Regen;
+		uint32	ManaRegen;
+		uint32	EnduranceRegen;
+		uint32	DamageShield;
+		uint32	DotShielding;
+		uint32	DSMitigation;
+		uint32	Clairvoyance;
+		int32	HealAmt;
+		int32	SpellDmg;
+		int8	SpellShield;
+		int8	Shielding;
+		int8	StunResist;
+		int8	StrikeThrough;
+		int8	Avoidance;
+		int8	Accuracy;
+		int8	CombatEffects;
+		uint8	WornType;
+		int32	WornEffect;
+		uint8	WornLevel;
+		uint8	FocusType;
+		uint8	FocusLevel;
+		int32	FocusEffect;
+		uint32	BardType;
+		int32	BardValue;
+		int32	FactionMod1;
+		int32	FactionMod2;
+		int32	FactionMod3;
+		int32	FactionMod4;
+		int32	FactionAmt1;
+		int32	FactionAmt2;
+		int32	FactionAmt3;
+		int32	FactionAmt4;
+		uint32	ExtraDmgSkill;
+		uint32	ExtraDmgAmt;
+		int32	SkillModValue;
+		int32	SkillModMax;
+		uint32	SkillModType;
+
+		void Set(const ItemData &item);
+	};
+
+	// Equip checks, lore group and the weapon damage inputs
+	struct ItemHotFlags {
+		uint32	ID;
+		uint32	Slots;
+		uint32	Classes;
+		uint32	Races;
+		uint32	LoreGroup;
+		uint32	Damage;
+		uint32	BaneDmgBody;
+		uint32	BaneDmgRace;
+		uint32	BaneDmgRaceAmt;
+		int8	BaneDmgAmt;
+		uint8	ItemClass;
+		uint8	ItemType;
+		uint8	Delay;
+		uint8	ElemDmgType;
+		uint8	ElemDmgAmt;
+		uint8	Range;
+		uint8	ReqLevel;
+		uint8	RecLevel;
+		uint8	NoDrop;
+		bool	LoreFlag;
+		bool	Magic;
+
+		void Set(const ItemData &item);
+	};
+
+	/*
+	 * Packed copy of the item fields the bonus and melee code reads, written
+	 * by the shared memory loader right behind the items hash set. The two
+	 * groups are kept apart (all stats rows, then all flags rows) and are
+	 * indexed by the item's element index in the hash set, so a lookup is the
+	 * id offset the hash set already keeps plus one small row instead of a
+	 * walk over a 1KB ItemData full of name and file strings.
+	 *
+	 * Each group is a row per item rather than an array per field: the bonus
+	 * pass reads nearly every stat of one item at a time, so one ~200 byte row
+	 * is a few cache lines where seventy field arrays would be seventy misses.
+	 */
+	class ItemHotTable
+	{
+	public:
+		static size_t estimated_size(uint32 element_count);
+
+		// lays out an empty table for element_count rows
+		ItemHotTable(void *data, size_t size, uint32 element_count);
+		// maps a table that was already written, throws if it is missing or from another version
+		ItemHotTable(const void *data, size_t size);
+
+		void Set(uint32 index, const ItemData &item);
+
+		const ItemHotStats *GetStats(uint32 index) const { return index < count ? &stats[index] : nullptr; }
+		const ItemHotFlags *GetFlags(uint32 index) const { return index < count ? &flags[index] : nullptr; }
+
+		uint32 GetCount() const { return count; }
+
+	private:
+		ItemHotStats *stats;
+		ItemHotFlags *flags;
+		uint32 count;
+	};
+}
+
+#endif /*COMMON_ITEM_HOT_TABLE_H*/
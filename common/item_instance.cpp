@@ -33,6 +33,22 @@
 
 int32 NextItemInstSerialNumber = 1;
 
+// the items file mapped now, only changed from the main loop
+static const EQEmu::ItemData *ItemSourceBegin = nullptr;
+static const EQEmu::ItemData *ItemSourceEnd = nullptr;
+static uint32 ItemSourceGeneration = 0;
+
+static inline uint32 GetItemSourceGeneration(const EQEmu::ItemData *item) {
+	return (item && item >= ItemSourceBegin && item < ItemSourceEnd) ? ItemSourceGeneration : 0;
+}
+
+EQEmu::InventorySlotsSerial* EQEmu::GetContentsSerial(ItemInstance* inst)
+{
+	return &inst->m_contents.m_serial;
+}
+
+EQ_SLAB_POOLED_IMPL(EQEmu::ItemInstance, "ItemInstance", 256)
+
 static inline int32 GetNextItemInstSerialNumber() {
 
 	// The Bazaar relies on each item a client has up for Trade having a unique
@@ -58,6 +74,7 @@ static inline int32 GetNextItemInstSerialNumber() {
 //
 EQEmu::ItemInstance::ItemInstance(const ItemData* item, int16 charges) {
 	m_use_type = ItemInstNormal;
+	m_item_generation = GetItemSourceGeneration(item);
 	if(item) {
 		m_item = new ItemData(*item);
 	} else {
@@ -89,6 +106,7 @@ EQEmu::ItemInstance::ItemInstance(const ItemData* item, int16 charges) {
 EQEmu::ItemInstance::ItemInstance(SharedDatabase *db, uint32 item_id, int16 charges) {
 	m_use_type = ItemInstNormal;
 	m_item = db->GetItem(item_id);
+	m_item_generation = GetItemSourceGeneration(m_item);
 	if(m_item) {
 		m_item = new ItemData(*m_item);
 	}
@@ -122,6 +140,7 @@ EQEmu::ItemInstance::ItemInstance(SharedDatabase *db, uint32 item_id, int16 char
 EQEmu::ItemInstance::ItemInstance(ItemInstTypes use_type) {
 	m_use_type = use_type;
 	m_item = nullptr;
+	m_item_generation = 0;
 	m_charges = 0;
 	m_price = 0;
 	m_attuned = false;
@@ -148,6 +167,7 @@ EQEmu::ItemInstance::ItemInstance(const ItemInstance& copy)
 		m_item = new ItemData(*copy.m_item);
 	else
 		m_item = nullptr;
+	m_item_generation = copy.m_item_generation;
 
 	m_charges=copy.m_charges;
 	m_price=copy.m_price;
@@ -166,7 +186,7 @@ EQEmu::ItemInstance::ItemInstance(const ItemInstance& copy)
 		}
 
 		if (inst_new != nullptr) {
-			m_contents[it->first] = inst_new;
+			m_contents.Set(it->first, inst_new);
 		}
 	}
 	std::map<std::string, std::string>::const_iterator iter;
@@ -380,14 +400,17 @@ void EQEmu::ItemInstance::DeleteItem(uint8 index)
 // Hands over memory ownership to client of this function call
 EQEmu::ItemInstance* EQEmu::ItemInstance::PopItem(uint8 index)
 {
-	auto iter = m_contents.find(index);
-	if (iter != m_contents.end()) {
-		ItemInstance* inst = iter->second;
-		m_contents.erase(index);
-		return inst; // Return pointer that needs to be deleted (or otherwise managed)
+	// Return pointer that needs to be deleted (or otherwise managed)
+	return m_contents.Take(index);
+}
+
+// Internal Method: "put" item into container, without regard for what is currently there
+void EQEmu::ItemInstance::_PutItem(uint8 index, ItemInstance* inst)
+{
+	if (!m_contents.Set(index, inst)) {
+		Log(Logs::General, Logs::Error, "ItemInstance::_PutItem: Invalid index specified (%u)", index);
+		safe_delete(inst);
 	}
-	
-	return nullptr;
 }
 
 // Remove all items from container
@@ -395,7 +418,7 @@ void EQEmu::ItemInstance::Clear()
 {
 	// Destroy container contents
 	for (auto iter = m_contents.begin(); iter != m_contents.end(); ++iter) {
-		safe_delete(iter->second);
+		delete iter->second;
 	}
 	m_contents.clear();
 }
@@ -406,7 +429,7 @@ void EQEmu::ItemInstance::ClearByFlags(byFlagSetting is_nodrop, byFlagSetting is
 	// TODO: This needs work...
 
 	// Destroy container contents
-	std::map<uint8, ItemInstance*>::const_iterator cur, end, del;
+	InventorySlots<uint8>::const_iterator cur, end, del;
 	cur = m_contents.begin();
 	end = m_contents.end();
 	for (; cur != end;) {
@@ -428,15 +451,15 @@ void EQEmu::ItemInstance::ClearByFlags(byFlagSetting is_nodrop, byFlagSetting is
 		switch (is_nodrop) {
 		case byFlagSet:
 			if (item->NoDrop == 0) {
-				safe_delete(inst);
 				m_contents.erase(del->first);
+				safe_delete(inst);
 				continue;
 			}
 			// no 'break;' deletes 'byFlagNotSet' type - can't add at the moment because it really *breaks* the process somewhere
 		case byFlagNotSet:
 			if (item->NoDrop != 0) {
-				safe_delete(inst);
 				m_contents.erase(del->first);
+				safe_delete(inst);
 				continue;
 			}
 		default:
@@ -446,15 +469,15 @@ void EQEmu::ItemInstance::ClearByFlags(byFlagSetting is_nodrop, byFlagSetting is
 		switch (is_norent) {
 		case byFlagSet:
 			if (item->NoRent == 0) {
-				safe_delete(inst);
 				m_contents.erase(del->first);
+				safe_delete(inst);
 				continue;
 			}
 			// no 'break;' deletes 'byFlagNotSet' type - can't add at the moment because it really *breaks* the process somewhere
 		case byFlagNotSet:
 			if (item->NoRent != 0) {
-				safe_delete(inst);
 				m_contents.erase(del->first);
+				safe_delete(inst);
 				continue;
 			}
 		default:
@@ -739,6 +762,14 @@ const EQEmu::ItemData* EQEmu::ItemInstance::GetUnscaledItem() const
 	return m_item;
 }
 
+// instances made before this keep the old generation, so nothing matches them against the new file's rows
+uint32 EQEmu::ItemInstance::SetItemSource(const ItemData *items, size_t count)
+{
+	ItemSourceBegin = items;
+	ItemSourceEnd = items ? items + count : nullptr;
+	return ++ItemSourceGeneration;
+}
+
 std::string EQEmu::ItemInstance::GetCustomDataString() const {
 	std::string ret_val;
 	auto iter = m_custom_data.begin();
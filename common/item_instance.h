@@ -30,10 +30,12 @@ class EvolveInfo;			// Stores information about an evolving item family
 
 #include "../common/eq_constants.h"
 #include "../common/item_data.h"
+#include "../common/inventory_slots.h"
 #include "../common/timer.h"
 #include "../common/bodytypes.h"
 #include "../common/deity.h"
 #include "../common/memory_buffer.h"
+#include "../common/util/slab_pool.h"
 
 #include <map>
 
@@ -79,6 +81,8 @@ namespace EQEmu
 
 		~ItemInstance();
 
+		EQ_SLAB_POOLED()
+
 		// Query item type
 		bool IsType(item::ItemClass item_class) const;
 
@@ -120,7 +124,7 @@ namespace EQEmu
 		uint8 FirstOpenSlot() const;
 		uint8 GetTotalItemCount() const;
 		bool IsNoneEmptyContainer();
-		std::map<uint8, ItemInstance*>* GetContents() { return &m_contents; }
+		InventorySlots<uint8>* GetContents() { return &m_contents; }
 
 		//
 		// Augments
@@ -145,6 +149,11 @@ namespace EQEmu
 		const uint32 GetItemScriptID() const { return ((m_item) ? m_item->ScriptFileID : 0); }
 		const ItemData* GetItem() const;
 		const ItemData* GetUnscaledItem() const;
+		// items file generation the unscaled item data was copied out of, 0 if it came from anywhere else
+		uint32 GetItemGeneration() const { return m_item_generation; }
+
+		// Called whenever an items file is mapped, returns the generation instances copied from it are stamped with
+		static uint32 SetItemSource(const ItemData *items, size_t count);
 
 		int16 GetCharges() const				{ return m_charges; }
 		void SetCharges(int16 charges)			{ m_charges = charges; }
@@ -282,14 +291,16 @@ namespace EQEmu
 		// Protected Members
 		//////////////////////////
 		friend class InventoryProfile;
+		friend InventorySlotsSerial* GetContentsSerial(ItemInstance* inst);
 
-		std::map<uint8, ItemInstance*>::const_iterator _cbegin() { return m_contents.cbegin(); }
-		std::map<uint8, ItemInstance*>::const_iterator _cend() { return m_contents.cend(); }
+		InventorySlots<uint8>::const_iterator _cbegin() { return m_contents.cbegin(); }
+		InventorySlots<uint8>::const_iterator _cend() { return m_contents.cend(); }
 
-		void _PutItem(uint8 index, ItemInstance* inst) { m_contents[index] = inst; }
+		void _PutItem(uint8 index, ItemInstance* inst);
 
 		ItemInstTypes		m_use_type;	// Usage type for item
 		const ItemData*		m_item;		// Ptr to item data
+		uint32				m_item_generation;
 		int16				m_charges;	// # of charges for chargeable items
 		uint32				m_price;	// Bazaar /trader price
 		uint32				m_color;
@@ -311,7 +322,7 @@ namespace EQEmu
 
 		//
 		// Items inside of this item (augs or contents);
-		std::map<uint8, ItemInstance*>		m_contents; // Zero-based index: min=0, max=9
+		InventorySlots<uint8>		m_contents = InventorySlots<uint8>(inventory::containerBegin, inventory::ContainerCount - 1); // Zero-based index: min=0, max=9
 		std::map<std::string, std::string>	m_custom_data;
 		std::map<std::string, Timer>		m_timers;
 	};
@@ -0,0 +1,91 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "loot_alias_table.h"
+
+#include <vector>
+
+namespace {
+	// Vose's alias method over weights, which must sum to more than zero
+	void BuildAliasTable(const std::vector<double> &weights, double total, LootDropAlias_Struct *table)
+	{
+		uint32 bins = static_cast<uint32>(weights.size());
+		std::vector<double> scaled(bins);
+		std::vector<uint32> small;
+		std::vector<uint32> large;
+		for (uint32 i = 0; i < bins; ++i) {
+			scaled[i] = weights[i] * bins / total;
+			if (scaled[i] < 1.0)
+				small.push_back(i);
+			else
+				large.push_back(i);
+		}
+
+		while (!small.empty() && !large.empty()) {
+			uint32 s = small.back();
+			uint32 l = large.back();
+			small.pop_back();
+			large.pop_back();
+
+			table[s].threshold = static_cast<float>(scaled[s]);
+			table[s].alias = static_cast<uint16>(l);
+
+			scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+			if (scaled[l] < 1.0)
+				small.push_back(l);
+			else
+				large.push_back(l);
+		}
+
+		// whatever is left is full, give or take rounding
+		for (auto i : large) {
+			table[i].threshold = 1.0f;
+			table[i].alias = static_cast<uint16>(i);
+		}
+
+		for (auto i : small) {
+			table[i].threshold = 1.0f;
+			table[i].alias = static_cast<uint16>(i);
+		}
+	}
+}
+
+size_t EQEmu::LootDropSize(uint32 entries)
+{
+	return sizeof(LootDrop_Struct) + sizeof(LootDropEntries_Struct) * entries + sizeof(LootDropAlias_Struct) * 2 * (entries + 1);
+}
+
+void EQEmu::BuildLootDropAliasTables(LootDrop_Struct *ld)
+{
+	uint32 count = ld->NumEntries;
+	std::vector<double> weights(count + 1, 0.0);
+
+	double sum = 0.0;
+	for (uint32 i = 0; i < count; ++i) {
+		weights[i] = ld->Entries[i].chance > 0.0f ? ld->Entries[i].chance : 0.0;
+		sum += weights[i];
+	}
+
+	// past mindrop the roll is over at least 100, anything short of that drops nothing
+	weights[count] = sum < 100.0 ? 100.0 - sum : 0.0;
+	BuildAliasTable(weights, sum + weights[count], const_cast<LootDropAlias_Struct*>(GetLootDropAlias(ld)));
+
+	// mindrop draws roll over the chances alone and only come up empty if they are all zero
+	weights[count] = sum > 0.0 ? 0.0 : 1.0;
+	BuildAliasTable(weights, sum + weights[count], const_cast<LootDropAlias_Struct*>(GetLootDropMinAlias(ld)));
+}
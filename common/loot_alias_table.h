@@ -0,0 +1,68 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef COMMON_LOOT_ALIAS_TABLE_H
+#define COMMON_LOOT_ALIAS_TABLE_H
+
+#include "types.h"
+#include "loottable.h"
+
+#include <stddef.h>
+
+namespace EQEmu
+{
+	/*
+	 * Lootdrops with a droplimit or mindrop pick one entry per draw, with
+	 * each entry weighted by its chance and, outside the mindrop draws, a
+	 * "nothing" outcome making up the rest to 100. The shared memory loader
+	 * writes two alias tables (Vose) behind every lootdrop's entries, one
+	 * for each kind of draw, so a draw is one roll and one bin instead of a
+	 * walk over the entries. Both have NumEntries + 1 bins, the last outcome
+	 * being no drop.
+	 */
+
+	// bytes a lootdrop with this many entries takes in shared memory
+	size_t LootDropSize(uint32 entries);
+
+	// fills in both tables from the lootdrop's entries
+	void BuildLootDropAliasTables(LootDrop_Struct *ld);
+
+	// table for the draws past mindrop, where the chances fill out to 100
+	inline const LootDropAlias_Struct *GetLootDropAlias(const LootDrop_Struct *ld) {
+		return reinterpret_cast<const LootDropAlias_Struct*>(&ld->Entries[ld->NumEntries]);
+	}
+
+	// table for the mindrop draws, where something always drops if anything can
+	inline const LootDropAlias_Struct *GetLootDropMinAlias(const LootDrop_Struct *ld) {
+		return GetLootDropAlias(ld) + ld->NumEntries + 1;
+	}
+
+	/*
+	 * Returns the entry picked by roll, which is uniform over [0, bins),
+	 * or bins - 1 for no drop.
+	 */
+	inline uint32 DrawLootDropAlias(const LootDropAlias_Struct *table, uint32 bins, double roll) {
+		uint32 bin = static_cast<uint32>(roll);
+		if (bin >= bins)
+			bin = bins - 1;
+
+		return (roll - bin) < table[bin].threshold ? bin : table[bin].alias;
+	}
+}
+
+#endif /*COMMON_LOOT_ALIAS_TABLE_H*/
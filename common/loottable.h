@@ -51,7 +51,20 @@ struct LootDropEntries_Struct {
 struct LootDrop_Struct {
 	uint32	NumEntries;
 	LootDropEntries_Struct Entries[0];
+	// followed by the alias tables in loot_alias_table.h
+};
+
+struct LootDropAlias_Struct {
+	float	threshold;	// part of the bin that keeps its own entry
+	uint16	alias;		// entry the rest of the bin goes to
 };
 #pragma pack()
 
+// which entries of a lootdrop point at items this process has, worked out once per items and loot load
+struct LootDropItemSummary {
+	float	chance_total;	// chances of the entries whose item exists
+	bool	all_items_found;
+	bool	any_item_found;
+};
+
 #endif
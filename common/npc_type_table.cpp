@@ -0,0 +1,113 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "npc_type_table.h"
+#include "eqemu_exception.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace {
+	const uint32 NPCTypeTableMagic = 0x4E505431; // NPT1
+
+	struct NPCTypeTableHeader {
+		uint32 magic;
+		uint32 record_size;
+		uint32 count;
+		uint32 string_bytes;
+	};
+}
+
+EQEmu::NPCTypeTableBuilder::NPCTypeTableBuilder() : raw_string_bytes(0)
+{
+	// offset 0 is always the empty string
+	strings.push_back('\0');
+	interned[std::string()] = 0;
+}
+
+uint32 EQEmu::NPCTypeTableBuilder::Intern(const char *str)
+{
+	if (!str || !str[0])
+		return 0;
+
+	std::string value(str);
+	raw_string_bytes += value.length() + 1;
+
+	auto it = interned.find(value);
+	if (it != interned.end())
+		return it->second;
+
+	uint32 offset = static_cast<uint32>(strings.size());
+	strings.append(value);
+	strings.push_back('\0');
+	interned[value] = offset;
+	return offset;
+}
+
+void EQEmu::NPCTypeTableBuilder::Write(std::vector<uint8> &out)
+{
+	std::stable_sort(records.begin(), records.end(), [](const NPCTypeRecord &a, const NPCTypeRecord &b) {
+		return a.npc_id < b.npc_id;
+	});
+	records.erase(std::unique(records.begin(), records.end(), [](const NPCTypeRecord &a, const NPCTypeRecord &b) {
+		return a.npc_id == b.npc_id;
+	}), records.end());
+
+	NPCTypeTableHeader header;
+	header.magic = NPCTypeTableMagic;
+	header.record_size = sizeof(NPCTypeRecord);
+	header.count = static_cast<uint32>(records.size());
+	header.string_bytes = static_cast<uint32>(strings.size());
+
+	size_t record_bytes = records.size() * sizeof(NPCTypeRecord);
+	out.resize(sizeof(header) + record_bytes + strings.size());
+	memcpy(&out[0], &header, sizeof(header));
+	if (record_bytes > 0)
+		memcpy(&out[sizeof(header)], &records[0], record_bytes);
+	memcpy(&out[sizeof(header) + record_bytes], strings.data(), strings.size());
+}
+
+EQEmu::NPCTypeTable::NPCTypeTable(const void *data, size_t size) : size(size)
+{
+	if (size < sizeof(NPCTypeTableHeader))
+		EQ_EXCEPT("NPCTypeTable", "Table is smaller than its header.");
+
+	const uint8 *bytes = reinterpret_cast<const uint8*>(data);
+	const NPCTypeTableHeader *header = reinterpret_cast<const NPCTypeTableHeader*>(bytes);
+	if (header->magic != NPCTypeTableMagic || header->record_size != sizeof(NPCTypeRecord))
+		EQ_EXCEPT("NPCTypeTable", "Table was written by an incompatible version.");
+
+	size_t record_bytes = static_cast<size_t>(header->count) * sizeof(NPCTypeRecord);
+	if (sizeof(NPCTypeTableHeader) + record_bytes + header->string_bytes > size)
+		EQ_EXCEPT("NPCTypeTable", "Table is truncated.");
+
+	count = header->count;
+	string_bytes = header->string_bytes;
+	records = reinterpret_cast<const NPCTypeRecord*>(bytes + sizeof(NPCTypeTableHeader));
+	strings = reinterpret_cast<const char*>(bytes + sizeof(NPCTypeTableHeader) + record_bytes);
+}
+
+const EQEmu::NPCTypeRecord *EQEmu::NPCTypeTable::Find(uint32 npc_id) const
+{
+	auto end = records + count;
+	auto it = std::lower_bound(records, end, npc_id, [](const NPCTypeRecord &r, uint32 id) { return r.npc_id < id; });
+	if (it == end || it->npc_id != npc_id)
+		return nullptr;
+
+	return it;
+}
@@ -0,0 +1,183 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef COMMON_NPC_TYPE_TABLE_H
+#define COMMON_NPC_TYPE_TABLE_H
+
+#include "types.h"
+#include "textures.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace EQEmu {
+
+	/*
+	 * One npc_types row as it is kept in shared memory. The text columns are
+	 * offsets into the table's string pool, where every distinct string is
+	 * stored once; most rows share their special_abilities, lastname and
+	 * ammo_idfile with many others.
+	 */
+	struct NPCTypeRecord {
+		uint32	npc_id;
+		uint32	name;
+		uint32	lastname;
+		uint32	special_abilities;
+		uint32	ammo_idfile;
+		int32	max_hp;
+		uint32	mana;
+		float	size;
+		float	runspeed;
+		float	attack_speed;
+		float	spellscale;
+		float	healscale;
+		uint16	race;
+		uint8	gender;
+		uint8	class_;
+		uint8	bodytype;
+		uint8	level;
+		uint8	texture;
+		uint8	helmtexture;
+		uint32	herosforgemodel;
+		uint32	loottable_id;
+		uint32	npc_spells_id;
+		uint32	npc_spells_effects_id;
+		int32	npc_faction_id;
+		uint32	merchanttype;
+		uint32	alt_currency_type;
+		uint32	adventure_template;
+		uint32	trap_template;
+		uint32	AC;
+		uint32	ATK;
+		uint32	STR;
+		uint32	STA;
+		uint32	DEX;
+		uint32	AGI;
+		uint32	INT;
+		uint32	WIS;
+		uint32	CHA;
+		int32	MR;
+		int32	FR;
+		int32	CR;
+		int32	PR;
+		int32	DR;
+		int32	Corrup;
+		int32	PhR;
+		uint32	drakkin_heritage;
+		uint32	drakkin_tattoo;
+		uint32	drakkin_details;
+		TintProfile	armor_tint;
+		uint32	min_dmg;
+		uint32	max_dmg;
+		int16	attack_count;
+		uint16	d_melee_texture1;
+		uint16	d_melee_texture2;
+		int16	slow_mitigation;
+		int32	hp_regen;
+		int32	mana_regen;
+		int32	aggroradius;
+		int32	assistradius;
+		int32	attack_delay;
+		int32	accuracy_rating;
+		int32	avoidance_rating;
+		uint32	scalerate;
+		uint32	emoteid;
+		uint8	haircolor;
+		uint8	beardcolor;
+		uint8	eyecolor1;
+		uint8	eyecolor2;
+		uint8	hairstyle;
+		uint8	luclinface;
+		uint8	beard;
+		uint8	light;
+		uint8	prim_melee_type;
+		uint8	sec_melee_type;
+		uint8	ranged_type;
+		uint8	see_invis;
+		uint8	spawn_limit;
+		uint8	maxlevel;
+		uint8	armtexture;
+		uint8	bracertexture;
+		uint8	handtexture;
+		uint8	legtexture;
+		uint8	feettexture;
+		bool	see_invis_undead;
+		bool	see_hide;
+		bool	see_improved_hide;
+		bool	qglobal;
+		bool	npc_aggro;
+		bool	findable;
+		bool	trackable;
+		bool	private_corpse;
+		bool	unique_spawn_by_name;
+		bool	underwater;
+		bool	no_target_hotkey;
+		bool	raid_target;
+		bool	ignore_despawn;
+		bool	show_name;
+		bool	untargetable;
+	};
+
+	// collects records and interns their strings, then writes the flat table
+	class NPCTypeTableBuilder {
+	public:
+		NPCTypeTableBuilder();
+
+		uint32 Intern(const char *str);
+		const char *GetString(uint32 offset) const { return &strings[offset]; }
+		void Add(const NPCTypeRecord &record) { records.push_back(record); }
+
+		size_t GetRecordCount() const { return records.size(); }
+		size_t GetInternedCount() const { return interned.size(); }
+		uint64 GetRawStringBytes() const { return raw_string_bytes; }
+		size_t GetStringBytes() const { return strings.size(); }
+		const std::vector<NPCTypeRecord> &GetRecords() const { return records; }
+
+		// records sorted by npc_id, duplicates after the first dropped
+		void Write(std::vector<uint8> &out);
+
+	private:
+		std::vector<NPCTypeRecord> records;
+		std::string strings;
+		std::unordered_map<std::string, uint32> interned;
+		uint64 raw_string_bytes;
+	};
+
+	// read only view of a table written by NPCTypeTableBuilder, usually in shared memory
+	class NPCTypeTable {
+	public:
+		NPCTypeTable(const void *data, size_t size);
+
+		const NPCTypeRecord *Find(uint32 npc_id) const;
+		const char *GetString(uint32 offset) const { return offset < string_bytes ? &strings[offset] : ""; }
+
+		uint32 GetCount() const { return count; }
+		size_t GetSize() const { return size; }
+
+	private:
+		const NPCTypeRecord *records;
+		const char *strings;
+		uint32 count;
+		uint32 string_bytes;
+		size_t size;
+	};
+
+} /*EQEmu*/
+
+#endif /*COMMON_NPC_TYPE_TABLE_H*/
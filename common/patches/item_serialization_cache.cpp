@@ -0,0 +1,91 @@
+/*	EQEMu: Everquest Server Emulator
+
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "../global_define.h"
+#include "../item_data.h"
+#include "../rulesys.h"
+#include "item_serialization_cache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+
+namespace
+{
+	// encoders run wherever packets get queued, keep it safe to share; the counters ride along under the lookup's lock
+	std::mutex s_mutex;
+	std::unordered_map<uint64, std::string> s_entries;
+	uint32 s_hits = 0;
+	uint32 s_misses = 0;
+
+	inline uint64 MakeKey(EQEmu::versions::ClientVersion client_version, uint32 item_id)
+	{
+		return (static_cast<uint64>(client_version) << 32) | item_id;
+	}
+}
+
+void EQEmu::ItemSerializationCache::Write(OutBuffer& ob, versions::ClientVersion client_version, const ItemData *item, EncodeFunction encode)
+{
+	size_t max_entries = static_cast<size_t>(std::max(RuleI(Inventory, ItemSerializationCacheSize), 0));
+	if (!item || max_entries == 0) {
+		encode(ob, item);
+		return;
+	}
+
+	uint64 key = MakeKey(client_version, item->ID);
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		auto iter = s_entries.find(key);
+		if (iter != s_entries.end()) {
+			++s_hits;
+			ob.write(iter->second.data(), iter->second.size());
+			return;
+		}
+		++s_misses;
+	}
+
+	OutBuffer encoded;
+	encode(encoded, item);
+	std::string data = encoded.str();
+	ob.write(data.data(), data.size());
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	if (s_entries.size() < max_entries)
+		s_entries.insert(std::make_pair(key, std::move(data)));
+}
+
+void EQEmu::ItemSerializationCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_entries.clear();
+	s_hits = 0;
+	s_misses = 0;
+}
+
+EQEmu::ItemSerializationCache::Stats EQEmu::ItemSerializationCache::GetStats()
+{
+	std::lock_guard<std::mutex> lock(s_mutex);
+	Stats s;
+	s.entries = s_entries.size();
+	s.hits = s_hits;
+	s.misses = s_misses;
+	return s;
+}
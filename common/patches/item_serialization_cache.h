@@ -0,0 +1,61 @@
+/*	EQEMu: Everquest Server Emulator
+
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+	
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef COMMON_PATCHES_ITEM_SERIALIZATION_CACHE_H
+#define COMMON_PATCHES_ITEM_SERIALIZATION_CACHE_H
+
+#include "../emu_versions.h"
+#include "../memory_buffer.h"
+
+
+namespace EQEmu
+{
+	struct ItemData;
+
+	/*
+	 * Encoded static item data, per client version and item id.
+	 *
+	 * Every patch's SerializeItem writes the instance fields (charges, slot,
+	 * serial, ornamentation...) itself, the rest of an item record only
+	 * depends on the ItemData and is encoded once here and copied on every
+	 * later send. Must be cleared whenever item data is reloaded.
+	 */
+	class ItemSerializationCache
+	{
+	public:
+		typedef void(*EncodeFunction)(OutBuffer& ob, const ItemData *item);
+
+		struct Stats
+		{
+			size_t entries;
+			uint32 hits;
+			uint32 misses;
+		};
+
+		// Writes the static encoding of item for client_version to ob, running encode and caching its output on a miss
+		static void Write(OutBuffer& ob, versions::ClientVersion client_version, const ItemData *item, EncodeFunction encode);
+
+		// Drops every entry and resets the hit/miss counters
+		static void Clear();
+
+		static Stats GetStats();
+	};
+}
+
+#endif /*COMMON_PATCHES_ITEM_SERIALIZATION_CACHE_H*/
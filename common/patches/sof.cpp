@@ -30,6 +30,7 @@
 #include "../misc_functions.h"
 #include "../string_util.h"
 #include "../item_instance.h"
+#include "item_serialization_cache.h"
 #include "sof_structs.h"
 #include "../rulesys.h"
 
@@ -44,6 +45,7 @@ namespace SoF
 	static Strategy struct_strategy;
 
 	void SerializeItem(EQEmu::OutBuffer& ob, const EQEmu::ItemInstance *inst, int16 slot_id, uint8 depth);
+	static void SerializeItemBody(EQEmu::OutBuffer& ob, const EQEmu::ItemData *item);
 
 	// server to client inventory location converters
 	static inline uint32 ServerToSoFSlot(uint32 serverSlot);
@@ -2943,6 +2945,41 @@ namespace SoF
 
 		ob.write((const char*)&hdr, sizeof(SoF::structs::ItemSerializationHeader));
 
+		EQEmu::ItemSerializationCache::Write(ob, EQEmu::versions::ClientVersion::SoF, item, SerializeItemBody);
+
+		EQEmu::OutBuffer::pos_type count_pos = ob.tellp();
+		uint32 subitem_count = 0;
+
+		ob.write((const char*)&subitem_count, sizeof(uint32));
+
+		for (uint32 index = EQEmu::inventory::containerBegin; index < EQEmu::inventory::ContainerCount; ++index) {
+			EQEmu::ItemInstance* sub = inst->GetItem(index);
+			if (!sub)
+				continue;
+
+			int SubSlotNumber = INVALID_INDEX;
+			if (slot_id_in >= EQEmu::legacy::GENERAL_BEGIN && slot_id_in <= EQEmu::legacy::GENERAL_END)
+				SubSlotNumber = (((slot_id_in + 3) * EQEmu::inventory::ContainerCount) + index + 1);
+			else if (slot_id_in >= EQEmu::legacy::BANK_BEGIN && slot_id_in <= EQEmu::legacy::BANK_END)
+				SubSlotNumber = (((slot_id_in - EQEmu::legacy::BANK_BEGIN) * EQEmu::inventory::ContainerCount) + EQEmu::legacy::BANK_BAGS_BEGIN + index);
+			else if (slot_id_in >= EQEmu::legacy::SHARED_BANK_BEGIN && slot_id_in <= EQEmu::legacy::SHARED_BANK_END)
+				SubSlotNumber = (((slot_id_in - EQEmu::legacy::SHARED_BANK_BEGIN) * EQEmu::inventory::ContainerCount) + EQEmu::legacy::SHARED_BANK_BAGS_BEGIN + index);
+			else
+				SubSlotNumber = slot_id_in;
+
+			ob.write((const char*)&index, sizeof(uint32));
+
+			SerializeItem(ob, sub, SubSlotNumber, (depth + 1));
+			++subitem_count;
+		}
+
+		if (subitem_count)
+			ob.overwrite(count_pos, (const char*)&subitem_count, sizeof(uint32));
+	}
+
+	// Everything in the item record that only depends on the item data, cached per client version
+	static void SerializeItemBody(EQEmu::OutBuffer& ob, const EQEmu::ItemData *item)
+	{
 		if (strlen(item->Name) > 0)
 			ob.write(item->Name, strlen(item->Name));
 		ob.write("\0", 1);
@@ -3099,7 +3136,7 @@ namespace SoF
 
 		itbs.potion_belt_enabled = item->PotionBelt;
 		itbs.potion_belt_slots = item->PotionBeltSlots;
-		itbs.stacksize = (inst->IsStackable() ? item->StackSize : 0);
+		itbs.stacksize = (item->Stackable ? item->StackSize : 0);
 		itbs.no_transfer = item->NoTransfer;
 		itbs.expendablearrow = item->ExpendableArrow;
 
@@ -3221,35 +3258,6 @@ namespace SoF
 		iqbs.SpellDmg = item->SpellDmg;
 		
 		ob.write((const char*)&iqbs, sizeof(SoF::structs::ItemQuaternaryBodyStruct));
-
-		EQEmu::OutBuffer::pos_type count_pos = ob.tellp();
-		uint32 subitem_count = 0;
-
-		ob.write((const char*)&subitem_count, sizeof(uint32));
-
-		for (uint32 index = EQEmu::inventory::containerBegin; index < EQEmu::inventory::ContainerCount; ++index) {
-			EQEmu::ItemInstance* sub = inst->GetItem(index);
-			if (!sub)
-				continue;
-
-			int SubSlotNumber = INVALID_INDEX;
-			if (slot_id_in >= EQEmu::legacy::GENERAL_BEGIN && slot_id_in <= EQEmu::legacy::GENERAL_END)
-				SubSlotNumber = (((slot_id_in + 3) * EQEmu::inventory::ContainerCount) + index + 1);
-			else if (slot_id_in >= EQEmu::legacy::BANK_BEGIN && slot_id_in <= EQEmu::legacy::BANK_END)
-				SubSlotNumber = (((slot_id_in - EQEmu::legacy::BANK_BEGIN) * EQEmu::inventory::ContainerCount) + EQEmu::legacy::BANK_BAGS_BEGIN + index);
-			else if (slot_id_in >= EQEmu::legacy::SHARED_BANK_BEGIN && slot_id_in <= EQEmu::legacy::SHARED_BANK_END)
-				SubSlotNumber = (((slot_id_in - EQEmu::legacy::SHARED_BANK_BEGIN) * EQEmu::inventory::ContainerCount) + EQEmu::legacy::SHARED_BANK_BAGS_BEGIN + index);
-			else
-				SubSlotNumber = slot_id_in;
-
-			ob.write((const char*)&index, sizeof(uint32));
-
-			SerializeItem(ob, sub, SubSlotNumber, (depth + 1));
-			++subitem_count;
-		}
-
-		if (subitem_count)
-			ob.overwrite(count_pos, (const char*)&subitem_count, sizeof(uint32));
 	}
 
 	static inline uint32 ServerToSoFSlot(uint32 serverSlot)
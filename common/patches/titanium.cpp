@@ -31,6 +31,7 @@
 #include "../misc_functions.h"
 #include "../string_util.h"
 #include "../item_instance.h"
+#include "item_serialization_cache.h"
 #include "titanium_structs.h"
 
 #include <sstream>
@@ -43,6 +44,7 @@ namespace Titanium
 	static Strategy struct_strategy;
 
 	void SerializeItem(EQEmu::OutBuffer& ob, const EQEmu::ItemInstance *inst, int16 slot_id_in, uint8 depth);
+	static void SerializeItemBody(EQEmu::OutBuffer& ob, const EQEmu::ItemData *item);
 
 	// server to client inventory location converters
 	static inline int16 ServerToTitaniumSlot(uint32 serverSlot);
@@ -2230,6 +2232,30 @@ namespace Titanium
 		ob << StringFormat("%.*s\"", depth, protection); // Quotes (and protection, if needed) around static data
 
 		// Item data
+		EQEmu::ItemSerializationCache::Write(ob, EQEmu::versions::ClientVersion::Titanium, item, SerializeItemBody);
+
+		ob << StringFormat("%.*s\"", depth, protection); // Quotes (and protection, if needed) around static data
+
+		// Sub data
+		for (int index = EQEmu::inventory::containerBegin; index < invbag::ItemBagSize; ++index) {
+			ob << '|';
+
+			EQEmu::ItemInstance* sub = inst->GetItem(index);
+			if (!sub)
+				continue;
+			
+			SerializeItem(ob, sub, 0, (depth + 1));
+		}
+
+		ob << StringFormat("%.*s%s", (depth ? (depth - 1) : 0), protection, (depth ? "\"" : "")); // For trailing quotes (and protection) if a subitem;
+
+		if (!depth)
+			ob.write("\0", 1);
+	}
+
+	// Everything in the item record that only depends on the item data, cached per client version
+	static void SerializeItemBody(EQEmu::OutBuffer& ob, const EQEmu::ItemData *item)
+	{
 		ob << itoa(item->ItemClass);
 		ob << '|' << item->Name;
 		ob << '|' << item->Lore;
@@ -2423,24 +2449,6 @@ namespace Titanium
 		ob << '|' << itoa(item->Scroll.Level2);
 		ob << '|' << itoa(item->Scroll.Level);
 		ob << '|' << "0"; // Scroll name
-
-		ob << StringFormat("%.*s\"", depth, protection); // Quotes (and protection, if needed) around static data
-
-		// Sub data
-		for (int index = EQEmu::inventory::containerBegin; index < invbag::ItemBagSize; ++index) {
-			ob << '|';
-
-			EQEmu::ItemInstance* sub = inst->GetItem(index);
-			if (!sub)
-				continue;
-			
-			SerializeItem(ob, sub, 0, (depth + 1));
-		}
-
-		ob << StringFormat("%.*s%s", (depth ? (depth - 1) : 0), protection, (depth ? "\"" : "")); // For trailing quotes (and protection) if a subitem;
-
-		if (!depth)
-			ob.write("\0", 1);
 	}
 
 	static inline int16 ServerToTitaniumSlot(uint32 serverSlot)
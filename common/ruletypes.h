@@ -232,6 +232,7 @@ RULE_BOOL (World, IPLimitDisconnectAll, false)
 RULE_BOOL(World, MaxClientsSimplifiedLogic, false) // New logic that only uses ExemptMaxClientsStatus and MaxClientsPerIP. Done on the loginserver. This mimics the P99-style special IP rules.
 RULE_INT (World, TellQueueSize, 20)
 RULE_BOOL(World, StartZoneSameAsBindOnCreation, true) //Should the start zone ALWAYS be the same location as your bind?
+RULE_INT(World, SharedMemoryRetireMS, 300000) // How long item and spell files replaced by a hotfix stay mapped after world and zones switch off them
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Zone)
@@ -265,6 +266,18 @@ RULE_INT(Zone, MinOfflineTimeToReplenishments, 21600) // 21600 seconds is 6 Hour
 RULE_BOOL(Zone, UseZoneController, true) // Enables the ability to use persistent quest based zone controllers (zone_controller.pl/lua)
 RULE_BOOL(Zone, EnableZoneControllerGlobals, false) // Enables the ability to use quest globals with the zone controller NPC
 RULE_INT(Zone, GlobalLootMultiplier, 1) // Sets Global Loot drop multiplier for database based drops, useful for double, triple loot etc.
+RULE_INT(Zone, WorkerThreads, 0) // Worker threads used for the aggro broadphase grid queries (Aggro:UseBroadphase) each tick, 0 runs everything on the main thread. NPC movement, LOS and regen always run on the main thread
+RULE_INT(Zone, BroadphaseParallelClients, 256) // Minimum number of clients queued for an aggro broadphase scan in one tick before their grid queries are split across the worker threads
+RULE_BOOL(Zone, PerlExportUsageScan, false) // Only export the perl event variables a quest script (or a plugin) references, found by scanning scripts as they load. Scripts that require, do or use other files get everything
+RULE_BOOL(Zone, PreloadQuests, false) // Resolve and compile the quest scripts of every npc type in the zone's spawn groups at boot (and of loaded scripts on #reloadquest) instead of on their first event
+RULE_INT(Zone, PreloadQuestsPerTick, 8) // Scripts compiled per quest tick while a preload is running
+RULE_BOOL(Zone, LuaBytecodeCache, false) // Cache compiled lua quest chunks under the shared memory directory, keyed by source file mtime and size
+RULE_BOOL(Zone, QuestProfiling, false) // Accounts the run time of every quest event handler by script and event, see #questprofile
+RULE_INT(Zone, QuestSlowScriptMS, 50) // Log any single quest event handler that runs at least this many ms, 0 disables the warning
+RULE_INT(Zone, LuaInstructionBudget, 0) // Lua VM instructions a quest event (including anything it triggers) may run before it is aborted with an error, 0 is unlimited
+RULE_BOOL(Zone, LuaReuseEventTables, false) // Reuse the event table handed to NPC and player lua event handlers instead of creating one per event. A script that keeps a reference to an event table after its handler returns sees it emptied
+RULE_BOOL(Zone, SharedNPCTypes, false) // Read npc types from the shared memory table built by shared_memory instead of querying npc_types, zones only map the table when this is on at boot. Edits to npc_types (#npcedit, #setfaction, editors) only show up after shared_memory is run again, except for types cleared with #npctype_cache
+RULE_INT(Zone, QuestWatchInterval, 0) // Seconds between checks for edited npc, global npc and player quest scripts, changed ones are reloaded in place. 0 disables watching
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Map)
@@ -280,6 +293,9 @@ RULE_REAL(Map, FixPathingZMaxDeltaWaypoint, 20)	//at runtime at each waypoint: m
 RULE_REAL(Map, FixPathingZMaxDeltaSendTo, 20)	//at runtime in SendTo: max change in Z to allow the BestZ code to apply.
 RULE_REAL(Map, FixPathingZMaxDeltaLoading, 45)	//while loading each waypoint: max change in Z to allow the BestZ code to apply.
 RULE_INT(Map, FindBestZHeightAdjust, 1)		// Adds this to the current Z before seeking the best Z position
+RULE_INT(Map, LoSCacheTTL, 1000)		// How long (ms) a line of sight result is reused for the same endpoints, 0 disables the cache
+RULE_REAL(Map, LoSCacheGridSize, 2.0)		// LoS endpoints are snapped to a grid of this size when looking up cached results
+RULE_INT(Map, LoSCacheMaxEntries, 50000)		// Cap on cached LoS results per zone
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Pathing)
@@ -525,6 +541,12 @@ RULE_INT(NPC, NPCToNPCAggroTimerMin, 500)
 RULE_INT(NPC, NPCToNPCAggroTimerMax, 6000)
 RULE_BOOL(NPC, UseClassAsLastName, true) // Uses class archetype as LastName for npcs with none
 RULE_BOOL(NPC, NewLevelScaling, true) // Better level scaling, use old if new formulas would break your server
+RULE_BOOL(NPC, AISleepEnabled, true) // Idle NPCs with no clients nearby are only processed every AISleepTickInterval ms, NPCs with npc_aggro set never sleep
+RULE_INT(NPC, AISleepRadius, 600) // NPCs with a client within roughly this distance are never put to sleep
+RULE_INT(NPC, AISleepTickInterval, 1000) // How often (ms) a sleeping NPC is still processed so its timers keep advancing
+RULE_INT(NPC, AISleepWakeGrace, 5000) // How long (ms) an NPC stays awake after being damaged, signaled or depopped
+RULE_INT(NPC, SignalsPerTick, 200) // Quest signals by npc type (signal, SignalMobsByNPCID) delivered per quest tick, past that they are queued for the following ticks. 0 delivers all of them right away
+RULE_BOOL(NPC, CoalesceSignals, false) // Drop a signal when the same NPC is still waiting on an identical one from the signal queue
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Aggro)
@@ -542,6 +564,10 @@ RULE_INT(Aggro, IntAggroThreshold, 75) // Int <= this will aggro regardless of l
 RULE_BOOL(Aggro, AllowTickPulling, false) // tick pulling is an exploit in an NPC's call for help fixed sometime in 2006 on live
 RULE_BOOL(Aggro, UseLevelAggro, true) // Level 18+ and Undead will aggro regardless of level difference. (this will disabled Rule:IntAggroThreshold if set to true)
 RULE_INT(Aggro, ClientAggroCheckInterval, 6) // Interval in which clients actually check for aggro - in seconds
+RULE_BOOL(Aggro, UseBroadphase, false) // Resolve client proximity aggro and NPC to NPC aggro through a shared NPC grid instead of per client/per NPC scans. NPC to NPC aggro may pick a different first match than the npc_list walk
+RULE_INT(Aggro, BroadphaseCellSize, 200) // Grid cell size used by the aggro broadphase
+RULE_INT(Aggro, BroadphaseNPCGridInterval, 1000) // How often (ms) the NPC grid used for NPC to NPC aggro is rebuilt
+RULE_INT(Aggro, BroadphaseStaleMargin, 50) // Extra range added to NPC grid queries to cover movement since the last rebuild
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(TaskSystem)
@@ -706,6 +732,8 @@ RULE_BOOL(Inventory, EnforceAugmentWear, true) // Forces augment wear slot valid
 RULE_BOOL(Inventory, DeleteTransformationMold, true) //False if you want mold to last forever
 RULE_BOOL(Inventory, AllowAnyWeaponTransformation, false) //Weapons can use any weapon transformation
 RULE_BOOL(Inventory, TransformSummonedBags, false) //Transforms summoned bags into disenchanted ones instead of deleting
+RULE_BOOL(Inventory, JournalSaves, true) // Queue client inventory slot saves and write them once per client process pass (and on save/zone out) instead of per change
+RULE_INT(Inventory, ItemSerializationCacheSize, 50000) // Max encoded items kept per zone/world for item packets (all client versions combined), 0 disables the cache
 RULE_CATEGORY_END()
 
 RULE_CATEGORY(Client)
@@ -91,6 +91,7 @@
 #define	ServerOP_WebInterfaceEvent  0x0068
 #define ServerOP_WebInterfaceSubscribe 0x0069
 #define ServerOP_WebInterfaceUnsubscribe 0x0070
+#define ServerOP_SharedMemGeneration	0x0071 // world tells zones a new set of shared memory files is ready
 
 #define ServerOP_RaidAdd			0x0100 //in use
 #define ServerOP_RaidRemove			0x0101 //in use
@@ -390,6 +391,7 @@ struct ServerClientList_Struct {
 	uint8	LFGToLevel;
 	bool	LFGMatchFilter;
 	char	LFGComments[64];
+	uint32	raid_id;
 };
 
 struct ServerClientListKeepAlive_Struct {
@@ -1278,6 +1280,11 @@ struct ServerRequestTellQueue_Struct {
 	char	name[64];
 };
 
+struct ServerSharedMemGeneration_Struct {
+	uint32	generation;
+	char	prefix[64];
+};
+
 #pragma pack()
 
 #endif
@@ -16,13 +16,10 @@
 	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 */
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 
-#if defined(_MSC_VER) && _MSC_VER >= 1800
-	#include <algorithm>
-#endif
-
 #include "classes.h"
 #include "eq_packet_structs.h"
 #include "eqemu_exception.h"
@@ -30,13 +27,18 @@
 #include "features.h"
 #include "ipc_mutex.h"
 #include "inventory_profile.h"
+#include "item_hot_table.h"
+#include "loot_alias_table.h"
 #include "loottable.h"
 #include "memory_mapped_file.h"
 #include "mysql.h"
+#include "npc_type_table.h"
+#include "patches/item_serialization_cache.h"
 #include "rulesys.h"
 #include "shareddb.h"
 #include "string_util.h"
 #include "eqemu_config.h"
+#include "timer.h"
 
 namespace ItemField
 {
@@ -50,12 +52,12 @@ namespace ItemField
 }
 
 SharedDatabase::SharedDatabase()
-: Database()
+: Database(), items_generation(0)
 {
 }
 
 SharedDatabase::SharedDatabase(const char* host, const char* user, const char* passwd, const char* database, uint32 port)
-: Database(host, user, passwd, database, port)
+: Database(host, user, passwd, database, port), items_generation(0)
 {
 }
 
@@ -346,6 +348,188 @@ bool SharedDatabase::DeleteSharedBankSlot(uint32 char_id, int16 slot_id) {
     return true;
 }
 
+// Row values for a REPLACE INTO inventory, same columns as UpdateInventorySlot
+static std::string InventoryRowValues(uint32 char_id, const EQEmu::ItemInstance* inst, int16 slot_id)
+{
+	uint32 augslot[EQEmu::inventory::SocketCount] = { 0, 0, 0, 0, 0, 0 };
+	if (inst->IsClassCommon()) {
+		for (int i = EQEmu::inventory::socketBegin; i < EQEmu::inventory::SocketCount; i++) {
+			EQEmu::ItemInstance *auginst = inst->GetItem(i);
+			augslot[i] = (auginst && auginst->GetItem()) ? auginst->GetItem()->ID : 0;
+		}
+	}
+
+	uint16 charges = (inst->GetCharges() >= 0) ? inst->GetCharges() : 0x7FFF;
+
+	return StringFormat("(%lu, %lu, %lu, %lu, %lu, '%s', %lu, %lu, %lu, %lu, %lu, %lu, %lu, %lu, %lu, %lu)",
+		(unsigned long)char_id, (unsigned long)slot_id, (unsigned long)inst->GetItem()->ID,
+		(unsigned long)charges, (unsigned long)(inst->IsAttuned() ? 1 : 0),
+		inst->GetCustomDataString().c_str(), (unsigned long)inst->GetColor(),
+		(unsigned long)augslot[0], (unsigned long)augslot[1], (unsigned long)augslot[2],
+		(unsigned long)augslot[3], (unsigned long)augslot[4], (unsigned long)augslot[5], (unsigned long)inst->GetOrnamentationIcon(),
+		(unsigned long)inst->GetOrnamentationIDFile(), (unsigned long)inst->GetOrnamentHeroModel());
+}
+
+// Row values for a REPLACE INTO sharedbank, same columns as UpdateSharedBankSlot
+static std::string SharedBankRowValues(uint32 account_id, const EQEmu::ItemInstance* inst, int16 slot_id)
+{
+	uint32 augslot[EQEmu::inventory::SocketCount] = { 0, 0, 0, 0, 0, 0 };
+	if (inst->IsClassCommon()) {
+		for (int i = EQEmu::inventory::socketBegin; i < EQEmu::inventory::SocketCount; i++) {
+			EQEmu::ItemInstance *auginst = inst->GetItem(i);
+			augslot[i] = (auginst && auginst->GetItem()) ? auginst->GetItem()->ID : 0;
+		}
+	}
+
+	uint16 charges = (inst->GetCharges() >= 0) ? inst->GetCharges() : 0x7FFF;
+
+	return StringFormat("(%lu, %lu, %lu, %lu, '%s', %lu, %lu, %lu, %lu, %lu, %lu)",
+		(unsigned long)account_id, (unsigned long)slot_id, (unsigned long)inst->GetItem()->ID,
+		(unsigned long)charges, inst->GetCustomDataString().c_str(), (unsigned long)augslot[0],
+		(unsigned long)augslot[1], (unsigned long)augslot[2], (unsigned long)augslot[3], (unsigned long)augslot[4],
+		(unsigned long)augslot[5]);
+}
+
+// Adds the delete clause for slot_id and the rows for whatever is in it now (bag contents included) to a flush
+static void JournalSlotToQuery(const EQEmu::ItemInstance* inst, int16 slot_id, std::string& where, std::map<int16, const EQEmu::ItemInstance*>& rows)
+{
+	if (!where.empty())
+		where += " OR ";
+	where += StringFormat("slotid = %i", slot_id);
+
+	bool containers = EQEmu::InventoryProfile::SupportsContainers(slot_id);
+	if (containers) {
+		int16 base_slot_id = EQEmu::InventoryProfile::CalcSlotId(slot_id, EQEmu::inventory::containerBegin);
+		where += StringFormat(" OR (slotid >= %i AND slotid < %i)", base_slot_id, (base_slot_id + 10));
+	}
+
+	if (!inst || !inst->GetItem())
+		return;
+
+	rows[slot_id] = inst;
+
+	if (!inst->IsClassBag() || !containers)
+		return;
+
+	// Limiting to bag slot count, same as UpdateInventorySlot
+	for (uint8 idx = EQEmu::inventory::containerBegin; idx < inst->GetItem()->BagSlots && idx < EQEmu::inventory::ContainerCount; idx++) {
+		const EQEmu::ItemInstance* baginst = inst->GetItem(idx);
+		if (baginst && baginst->GetItem())
+			rows[EQEmu::InventoryProfile::CalcSlotId(slot_id, idx)] = baginst;
+	}
+}
+
+/*
+ * Writes every slot journaled in inv as it is now: one DELETE and one
+ * multi-row REPLACE per table instead of a DELETE/REPLACE per slot and bag
+ * slot. The caller owns the transaction and clears the journal once it
+ * committed, so a failed flush is retried in full.
+ */
+bool SharedDatabase::SaveInventoryJournal(uint32 char_id, EQEmu::InventoryProfile* inv, uint32* query_count)
+{
+	uint32 queries = 0;
+	if (query_count)
+		*query_count = 0;
+
+	if (!inv || inv->JournalEmpty())
+		return true;
+
+	std::string inventory_where;
+	std::string sharedbank_where;
+	std::map<int16, const EQEmu::ItemInstance*> inventory_rows;
+	std::map<int16, const EQEmu::ItemInstance*> sharedbank_rows;
+
+	for (auto slot_id : inv->GetJournalSlots()) {
+		if (slot_id >= EQEmu::legacy::SHARED_BANK_BEGIN && slot_id <= EQEmu::legacy::SHARED_BANK_BAGS_END)
+			JournalSlotToQuery(inv->GetItem(slot_id), slot_id, sharedbank_where, sharedbank_rows);
+		else
+			JournalSlotToQuery(inv->GetItem(slot_id), slot_id, inventory_where, inventory_rows);
+	}
+
+	if (inv->IsCursorJournaled()) {
+		if (!inventory_where.empty())
+			inventory_where += " OR ";
+		inventory_where += StringFormat("(slotid >= 8000 AND slotid <= 8999) OR slotid = %i OR (slotid >= %i AND slotid <= %i)",
+			EQEmu::inventory::slotCursor, EQEmu::legacy::CURSOR_BAG_BEGIN, EQEmu::legacy::CURSOR_BAG_END);
+
+		int i = 8000;
+		for (auto it = inv->cursor_cbegin(); it != inv->cursor_cend(); ++it, i++) {
+			if (i > 8999) { break; } // shouldn't be anything in the queue that indexes this high
+			int16 use_slot = (i == 8000) ? EQEmu::inventory::slotCursor : i;
+			std::string unused_where;
+			JournalSlotToQuery(*it, use_slot, unused_where, inventory_rows);
+		}
+	}
+
+	if (!inventory_where.empty()) {
+		std::string query = StringFormat("DELETE FROM inventory WHERE charid = %i AND (%s)", char_id, inventory_where.c_str());
+		auto results = QueryDatabase(query);
+		++queries;
+		if (!results.Success()) {
+			if (query_count)
+				*query_count = queries;
+			return false;
+		}
+	}
+
+	if (!inventory_rows.empty()) {
+		std::string query = "REPLACE INTO inventory "
+			"(charid, slotid, itemid, charges, instnodrop, custom_data, color, "
+			"augslot1, augslot2, augslot3, augslot4, augslot5, augslot6, ornamenticon, ornamentidfile, ornament_hero_model) VALUES ";
+		for (auto iter = inventory_rows.begin(); iter != inventory_rows.end(); ++iter) {
+			if (iter != inventory_rows.begin())
+				query += ", ";
+			query += InventoryRowValues(char_id, iter->second, iter->first);
+		}
+
+		auto results = QueryDatabase(query);
+		++queries;
+		if (!results.Success()) {
+			if (query_count)
+				*query_count = queries;
+			return false;
+		}
+	}
+
+	if (!sharedbank_where.empty()) {
+		uint32 account_id = GetAccountIDByChar(char_id);
+		++queries;
+
+		std::string query = StringFormat("DELETE FROM sharedbank WHERE acctid = %i AND (%s)", account_id, sharedbank_where.c_str());
+		auto results = QueryDatabase(query);
+		++queries;
+		if (!results.Success()) {
+			if (query_count)
+				*query_count = queries;
+			return false;
+		}
+
+		if (!sharedbank_rows.empty()) {
+			query = "REPLACE INTO sharedbank "
+				"(acctid, slotid, itemid, charges, custom_data, "
+				"augslot1, augslot2, augslot3, augslot4, augslot5, augslot6) VALUES ";
+			for (auto iter = sharedbank_rows.begin(); iter != sharedbank_rows.end(); ++iter) {
+				if (iter != sharedbank_rows.begin())
+					query += ", ";
+				query += SharedBankRowValues(account_id, iter->second, iter->first);
+			}
+
+			results = QueryDatabase(query);
+			++queries;
+			if (!results.Success()) {
+				if (query_count)
+					*query_count = queries;
+				return false;
+			}
+		}
+	}
+
+	if (query_count)
+		*query_count = queries;
+
+	return true;
+}
+
 
 int32 SharedDatabase::GetSharedPlatinum(uint32 account_id)
 {
@@ -819,27 +1003,50 @@ void SharedDatabase::GetItemsCount(int32 &item_count, uint32 &max_id)
 }
 
 bool SharedDatabase::LoadItems(const std::string &prefix) {
-	items_mmf.reset(nullptr);
-
+	std::unique_ptr<EQEmu::MemoryMappedFile> mmf;
+	std::unique_ptr<EQEmu::FixedMemoryHashSet<EQEmu::ItemData>> hash;
 	try {
 		auto Config = EQEmuConfig::get();
 		EQEmu::IPCMutex mutex("items");
 		mutex.Lock();
 		std::string file_name = Config->SharedMemDir + prefix + std::string("items");
-		items_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
-		items_hash = std::unique_ptr<EQEmu::FixedMemoryHashSet<EQEmu::ItemData>>(new EQEmu::FixedMemoryHashSet<EQEmu::ItemData>(reinterpret_cast<uint8*>(items_mmf->Get()), items_mmf->Size()));
+		mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
+		hash = std::unique_ptr<EQEmu::FixedMemoryHashSet<EQEmu::ItemData>>(new EQEmu::FixedMemoryHashSet<EQEmu::ItemData>(reinterpret_cast<uint8*>(mmf->Get()), mmf->Size()));
 		mutex.Unlock();
 	} catch(std::exception& ex) {
+		// whatever was loaded before stays in use
 		Log(Logs::General, Logs::Error, "Error Loading Items: %s", ex.what());
 		return false;
 	}
 
+	// the hot field table sits right behind the hash set, item lookups still work without it
+	std::unique_ptr<EQEmu::ItemHotTable> hot_table;
+	try {
+		size_t hash_size = EQEmu::FixedMemoryHashSet<EQEmu::ItemData>::estimated_size(static_cast<uint32>(hash->max_size()), hash->max_key());
+		if (hash_size > mmf->Size())
+			EQ_EXCEPT("Shared Memory", "Items file is smaller than its hash set.");
+
+		hot_table = std::unique_ptr<EQEmu::ItemHotTable>(new EQEmu::ItemHotTable(reinterpret_cast<uint8*>(mmf->Get()) + hash_size, mmf->Size() - hash_size));
+	} catch(std::exception& ex) {
+		Log(Logs::General, Logs::Error, "Item hot field table not loaded, run shared_memory to rebuild it: %s", ex.what());
+	}
+
+	RetireSharedMemory(items_mmf);
+	items_mmf = std::move(mmf);
+	items_hash = std::move(hash);
+	items_hot_table = std::move(hot_table);
+	items_generation = EQEmu::ItemInstance::SetItemSource(items_hash->data(), items_hash->size());
+	// encoded item packets were built from the old data
+	EQEmu::ItemSerializationCache::Clear();
+	loot_drop_summaries.clear();
 	return true;
 }
 
 void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_item_id)
 {
 	EQEmu::FixedMemoryHashSet<EQEmu::ItemData> hash(reinterpret_cast<uint8 *>(data), size, items, max_item_id);
+	size_t hash_size = EQEmu::FixedMemoryHashSet<EQEmu::ItemData>::estimated_size(items, max_item_id);
+	EQEmu::ItemHotTable hot_table(reinterpret_cast<uint8 *>(data) + hash_size, size - hash_size, items);
 
 	std::string ndbuffer;
 	bool disableNoRent = false;
@@ -1090,6 +1297,7 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
 
 		try {
 			hash.insert(item.ID, item);
+			hot_table.Set(hash.index_of(item.ID), item);
 		} catch (std::exception &ex) {
 			Log(Logs::General, Logs::Error, "Database::LoadItems: %s", ex.what());
 			break;
@@ -1116,6 +1324,45 @@ const EQEmu::ItemData* SharedDatabase::GetItem(uint32 id) {
 	return nullptr;
 }
 
+const EQEmu::ItemHotStats* SharedDatabase::GetItemHotStats(uint32 id) const {
+	if (!items_hot_table || !items_hash)
+		return nullptr;
+
+	return items_hot_table->GetStats(items_hash->index_of(id));
+}
+
+const EQEmu::ItemHotFlags* SharedDatabase::GetItemHotFlags(uint32 id) const {
+	if (!items_hot_table || !items_hash)
+		return nullptr;
+
+	return items_hot_table->GetFlags(items_hash->index_of(id));
+}
+
+// element index of the instance's item in the items file that is mapped now, 0xFFFFFFFF when it was copied from an older one
+uint32 SharedDatabase::GetItemHotIndex(const EQEmu::ItemInstance *inst) const {
+	if (!inst || !inst->GetUnscaledItem() || !items_hash || !items_generation)
+		return 0xFFFFFFFFU;
+
+	if (inst->GetItemGeneration() != items_generation)
+		return 0xFFFFFFFFU;
+
+	return items_hash->index_of(inst->GetUnscaledItem()->ID);
+}
+
+const EQEmu::ItemHotStats* SharedDatabase::GetItemHotStats(const EQEmu::ItemInstance *inst) const {
+	if (!items_hot_table)
+		return nullptr;
+
+	return items_hot_table->GetStats(GetItemHotIndex(inst));
+}
+
+const EQEmu::ItemHotFlags* SharedDatabase::GetItemHotFlags(const EQEmu::ItemInstance *inst) const {
+	if (!items_hot_table)
+		return nullptr;
+
+	return items_hot_table->GetFlags(GetItemHotIndex(inst));
+}
+
 const EQEmu::ItemData* SharedDatabase::IterateItems(uint32* id) {
 	if(!items_hash || !id) {
 		return nullptr;
@@ -1243,22 +1490,375 @@ void SharedDatabase::LoadNPCFactionLists(void *data, uint32 size, uint32 list_co
 }
 
 bool SharedDatabase::LoadNPCFactionLists(const std::string &prefix) {
-	faction_mmf.reset(nullptr);
-	faction_hash.reset(nullptr);
-
+	std::unique_ptr<EQEmu::MemoryMappedFile> mmf;
+	std::unique_ptr<EQEmu::FixedMemoryHashSet<NPCFactionList>> hash;
 	try {
 		auto Config = EQEmuConfig::get();
 		EQEmu::IPCMutex mutex("faction");
 		mutex.Lock();
 		std::string file_name = Config->SharedMemDir + prefix + std::string("faction");
-		faction_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
-		faction_hash = std::unique_ptr<EQEmu::FixedMemoryHashSet<NPCFactionList>>(new EQEmu::FixedMemoryHashSet<NPCFactionList>(reinterpret_cast<uint8*>(faction_mmf->Get()), faction_mmf->Size()));
+		mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
+		hash = std::unique_ptr<EQEmu::FixedMemoryHashSet<NPCFactionList>>(new EQEmu::FixedMemoryHashSet<NPCFactionList>(reinterpret_cast<uint8*>(mmf->Get()), mmf->Size()));
 		mutex.Unlock();
 	} catch(std::exception& ex) {
+		// whatever was loaded before stays in use
 		Log(Logs::General, Logs::Error, "Error Loading npc factions: %s", ex.what());
 		return false;
 	}
 
+	RetireSharedMemory(faction_mmf);
+	faction_mmf = std::move(mmf);
+	faction_hash = std::move(hash);
+	return true;
+}
+
+std::string SharedDatabase::GetNPCTypesQuery(const std::string &where)
+{
+	return StringFormat("SELECT "
+		"npc_types.id, "
+		"npc_types.name, "
+		"npc_types.level, "
+		"npc_types.race, "
+		"npc_types.class, "
+		"npc_types.hp, "
+		"npc_types.mana, "
+		"npc_types.gender, "
+		"npc_types.texture, "
+		"npc_types.helmtexture, "
+		"npc_types.herosforgemodel, "
+		"npc_types.size, "
+		"npc_types.loottable_id, "
+		"npc_types.merchant_id, "
+		"npc_types.alt_currency_id, "
+		"npc_types.adventure_template_id, "
+		"npc_types.trap_template, "
+		"npc_types.attack_speed, "
+		"npc_types.STR, "
+		"npc_types.STA, "
+		"npc_types.DEX, "
+		"npc_types.AGI, "
+		"npc_types._INT, "
+		"npc_types.WIS, "
+		"npc_types.CHA, "
+		"npc_types.MR, "
+		"npc_types.CR, "
+		"npc_types.DR, "
+		"npc_types.FR, "
+		"npc_types.PR, "
+		"npc_types.Corrup, "
+		"npc_types.PhR, "
+		"npc_types.mindmg, "
+		"npc_types.maxdmg, "
+		"npc_types.attack_count, "
+		"npc_types.special_abilities, "
+		"npc_types.npc_spells_id, "
+		"npc_types.npc_spells_effects_id, "
+		"npc_types.d_melee_texture1, "
+		"npc_types.d_melee_texture2, "
+		"npc_types.ammo_idfile, "
+		"npc_types.prim_melee_type, "
+		"npc_types.sec_melee_type, "
+		"npc_types.ranged_type, "
+		"npc_types.runspeed, "
+		"npc_types.findable, "
+		"npc_types.trackable, "
+		"npc_types.hp_regen_rate, "
+		"npc_types.mana_regen_rate, "
+		"npc_types.aggroradius, "
+		"npc_types.assistradius, "
+		"npc_types.bodytype, "
+		"npc_types.npc_faction_id, "
+		"npc_types.face, "
+		"npc_types.luclin_hairstyle, "
+		"npc_types.luclin_haircolor, "
+		"npc_types.luclin_eyecolor, "
+		"npc_types.luclin_eyecolor2, "
+		"npc_types.luclin_beardcolor, "
+		"npc_types.luclin_beard, "
+		"npc_types.drakkin_heritage, "
+		"npc_types.drakkin_tattoo, "
+		"npc_types.drakkin_details, "
+		"npc_types.armortint_id, "
+		"npc_types.armortint_red, "
+		"npc_types.armortint_green, "
+		"npc_types.armortint_blue, "
+		"npc_types.see_invis, "
+		"npc_types.see_invis_undead, "
+		"npc_types.lastname, "
+		"npc_types.qglobal, "
+		"npc_types.AC, "
+		"npc_types.npc_aggro, "
+		"npc_types.spawn_limit, "
+		"npc_types.see_hide, "
+		"npc_types.see_improved_hide, "
+		"npc_types.ATK, "
+		"npc_types.Accuracy, "
+		"npc_types.Avoidance, "
+		"npc_types.slow_mitigation, "
+		"npc_types.maxlevel, "
+		"npc_types.scalerate, "
+		"npc_types.private_corpse, "
+		"npc_types.unique_spawn_by_name, "
+		"npc_types.underwater, "
+		"npc_types.emoteid, "
+		"npc_types.spellscale, "
+		"npc_types.healscale, "
+		"npc_types.no_target_hotkey, "
+		"npc_types.raid_target, "
+		"npc_types.attack_delay, "
+		"npc_types.light, "
+		"npc_types.armtexture, "
+		"npc_types.bracertexture, "
+		"npc_types.handtexture, "
+		"npc_types.legtexture, "
+		"npc_types.feettexture, "
+		"npc_types.ignore_despawn, "
+		"npc_types.show_name, "
+		"npc_types.untargetable "
+		"FROM npc_types %s",
+		where.c_str()
+	);
+}
+
+bool SharedDatabase::LoadNPCTypeTint(uint32 tint_id, EQEmu::TintProfile &tint)
+{
+	std::string query = StringFormat(
+		"SELECT red1h, grn1h, blu1h, "
+		"red2c, grn2c, blu2c, "
+		"red3a, grn3a, blu3a, "
+		"red4b, grn4b, blu4b, "
+		"red5g, grn5g, blu5g, "
+		"red6l, grn6l, blu6l, "
+		"red7f, grn7f, blu7f, "
+		"red8x, grn8x, blu8x, "
+		"red9x, grn9x, blu9x "
+		"FROM npc_types_tint WHERE id = %d",
+		tint_id);
+	auto results = QueryDatabase(query);
+	if (!results.Success() || results.RowCount() == 0)
+		return false;
+
+	auto row = results.begin();
+	ReadNPCTypeTint(row, 0, tint);
+	return true;
+}
+
+void SharedDatabase::LoadNPCTypeTints(std::map<uint32, EQEmu::TintProfile> &tints)
+{
+	const std::string query = "SELECT id, red1h, grn1h, blu1h, "
+		"red2c, grn2c, blu2c, "
+		"red3a, grn3a, blu3a, "
+		"red4b, grn4b, blu4b, "
+		"red5g, grn5g, blu5g, "
+		"red6l, grn6l, blu6l, "
+		"red7f, grn7f, blu7f, "
+		"red8x, grn8x, blu8x, "
+		"red9x, grn9x, blu9x "
+		"FROM npc_types_tint";
+	auto results = QueryDatabase(query);
+	if (!results.Success())
+		return;
+
+	for (auto row = results.begin(); row != results.end(); ++row)
+		ReadNPCTypeTint(row, 1, tints[static_cast<uint32>(atoul(row[0]))]);
+}
+
+void SharedDatabase::ReadNPCTypeTint(MySQLRequestRow &row, int first, EQEmu::TintProfile &tint)
+{
+	for (int index = EQEmu::textures::textureBegin; index <= EQEmu::textures::LastTexture; index++) {
+		tint.Slot[index].Color = atoi(row[first + index * 3]) << 16;
+		tint.Slot[index].Color |= atoi(row[first + index * 3 + 1]) << 8;
+		tint.Slot[index].Color |= atoi(row[first + index * 3 + 2]);
+		tint.Slot[index].Color |= (tint.Slot[index].Color) ? (0xFF << 24) : 0;
+	}
+}
+
+/*
+	Fills record from a row of GetNPCTypesQuery, text columns are interned into
+	builder. Armor tints come from tints when given, otherwise they are queried.
+*/
+void SharedDatabase::ReadNPCTypeRow(MySQLRequestRow &row, EQEmu::NPCTypeRecord &record, EQEmu::NPCTypeTableBuilder &builder,
+	const std::map<uint32, EQEmu::TintProfile> *tints)
+{
+	memset(&record, 0, sizeof(record));
+
+	record.npc_id = atoi(row[0]);
+	record.name = builder.Intern(row[1]);
+	record.level = atoi(row[2]);
+	record.race = atoi(row[3]);
+	record.class_ = atoi(row[4]);
+	record.max_hp = atoi(row[5]);
+	record.mana = atoi(row[6]);
+	record.gender = atoi(row[7]);
+	record.texture = atoi(row[8]);
+	record.helmtexture = atoi(row[9]);
+	record.herosforgemodel = atoul(row[10]);
+	record.size = atof(row[11]);
+	record.loottable_id = atoi(row[12]);
+	record.merchanttype = atoi(row[13]);
+	record.alt_currency_type = atoi(row[14]);
+	record.adventure_template = atoi(row[15]);
+	record.trap_template = atoi(row[16]);
+	record.attack_speed = atof(row[17]);
+	record.STR = atoi(row[18]);
+	record.STA = atoi(row[19]);
+	record.DEX = atoi(row[20]);
+	record.AGI = atoi(row[21]);
+	record.INT = atoi(row[22]);
+	record.WIS = atoi(row[23]);
+	record.CHA = atoi(row[24]);
+	record.MR = atoi(row[25]);
+	record.CR = atoi(row[26]);
+	record.DR = atoi(row[27]);
+	record.FR = atoi(row[28]);
+	record.PR = atoi(row[29]);
+	record.Corrup = atoi(row[30]);
+	record.PhR = atoi(row[31]);
+	record.min_dmg = atoi(row[32]);
+	record.max_dmg = atoi(row[33]);
+	record.attack_count = atoi(row[34]);
+	record.special_abilities = builder.Intern(row[35]);
+	record.npc_spells_id = atoi(row[36]);
+	record.npc_spells_effects_id = atoi(row[37]);
+	record.d_melee_texture1 = atoi(row[38]);
+	record.d_melee_texture2 = atoi(row[39]);
+	record.ammo_idfile = builder.Intern(row[40]);
+	record.prim_melee_type = atoi(row[41]);
+	record.sec_melee_type = atoi(row[42]);
+	record.ranged_type = atoi(row[43]);
+	record.runspeed = atof(row[44]);
+	record.findable = atoi(row[45]) == 0 ? false : true;
+	record.trackable = atoi(row[46]) == 0 ? false : true;
+	record.hp_regen = atoi(row[47]);
+	record.mana_regen = atoi(row[48]);
+
+	// set default value for aggroradius
+	record.aggroradius = (int32)atoi(row[49]);
+	if (record.aggroradius <= 0)
+		record.aggroradius = 70;
+
+	record.assistradius = (int32)atoi(row[50]);
+	if (record.assistradius <= 0)
+		record.assistradius = record.aggroradius;
+
+	if (row[51] && strlen(row[51]))
+		record.bodytype = (uint8)atoi(row[51]);
+	else
+		record.bodytype = 0;
+
+	record.npc_faction_id = atoi(row[52]);
+
+	record.luclinface = atoi(row[53]);
+	record.hairstyle = atoi(row[54]);
+	record.haircolor = atoi(row[55]);
+	record.eyecolor1 = atoi(row[56]);
+	record.eyecolor2 = atoi(row[57]);
+	record.beardcolor = atoi(row[58]);
+	record.beard = atoi(row[59]);
+	record.drakkin_heritage = atoi(row[60]);
+	record.drakkin_tattoo = atoi(row[61]);
+	record.drakkin_details = atoi(row[62]);
+
+	uint32 armor_tint_id = atoi(row[63]);
+
+	record.armor_tint.Head.Color = (atoi(row[64]) & 0xFF) << 16;
+	record.armor_tint.Head.Color |= (atoi(row[65]) & 0xFF) << 8;
+	record.armor_tint.Head.Color |= (atoi(row[66]) & 0xFF);
+	record.armor_tint.Head.Color |= (record.armor_tint.Head.Color) ? (0xFF << 24) : 0;
+
+	if (armor_tint_id != 0) {
+		if (tints) {
+			auto it = tints->find(armor_tint_id);
+			if (it != tints->end())
+				record.armor_tint = it->second;
+			else
+				armor_tint_id = 0;
+		}
+		else if (!LoadNPCTypeTint(armor_tint_id, record.armor_tint)) {
+			armor_tint_id = 0;
+		}
+	}
+
+	// Try loading npc_types tint fields if armor tint is 0 or query failed to get results
+	if (armor_tint_id == 0) {
+		for (int index = EQEmu::textures::armorChest; index < EQEmu::textures::materialCount; index++) {
+			record.armor_tint.Slot[index].Color = record.armor_tint.Slot[0].Color; // odd way to 'zero-out' the array...
+		}
+	}
+
+	record.see_invis = atoi(row[67]);
+	record.see_invis_undead = atoi(row[68]) == 0 ? false : true;	// Set see_invis_undead flag
+	record.lastname = builder.Intern(row[69]);
+	record.qglobal = atoi(row[70]) == 0 ? false : true;	// qglobal
+	record.AC = atoi(row[71]);
+	record.npc_aggro = atoi(row[72]) == 0 ? false : true;
+	record.spawn_limit = atoi(row[73]);
+	record.see_hide = atoi(row[74]) == 0 ? false : true;
+	record.see_improved_hide = atoi(row[75]) == 0 ? false : true;
+	record.ATK = atoi(row[76]);
+	record.accuracy_rating = atoi(row[77]);
+	record.avoidance_rating = atoi(row[78]);
+	record.slow_mitigation = atoi(row[79]);
+	record.maxlevel = atoi(row[80]);
+	record.scalerate = atoi(row[81]);
+	record.private_corpse = atoi(row[82]) == 1 ? true : false;
+	record.unique_spawn_by_name = atoi(row[83]) == 1 ? true : false;
+	record.underwater = atoi(row[84]) == 1 ? true : false;
+	record.emoteid = atoi(row[85]);
+	record.spellscale = atoi(row[86]);
+	record.healscale = atoi(row[87]);
+	record.no_target_hotkey = atoi(row[88]) == 1 ? true : false;
+	record.raid_target = atoi(row[89]) == 0 ? false : true;
+	record.attack_delay = atoi(row[90]) * 100; // TODO: fix DB
+	record.light = (atoi(row[91]) & 0x0F);
+
+	record.armtexture = atoi(row[92]);
+	record.bracertexture = atoi(row[93]);
+	record.handtexture = atoi(row[94]);
+	record.legtexture = atoi(row[95]);
+	record.feettexture = atoi(row[96]);
+	record.ignore_despawn = atoi(row[97]) == 1 ? true : false;
+	record.show_name = atoi(row[98]) != 0 ? true : false;
+	record.untargetable = atoi(row[99]) != 0 ? true : false;
+}
+
+void SharedDatabase::LoadNPCTypes(EQEmu::NPCTypeTableBuilder &builder)
+{
+	std::map<uint32, EQEmu::TintProfile> tints;
+	LoadNPCTypeTints(tints);
+
+	auto results = QueryDatabase(GetNPCTypesQuery(""));
+	if (!results.Success())
+		return;
+
+	EQEmu::NPCTypeRecord record;
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		ReadNPCTypeRow(row, record, builder, &tints);
+		builder.Add(record);
+	}
+}
+
+bool SharedDatabase::LoadNPCTypes(const std::string &prefix)
+{
+	std::unique_ptr<EQEmu::MemoryMappedFile> mmf;
+	std::unique_ptr<EQEmu::NPCTypeTable> table;
+	try {
+		auto Config = EQEmuConfig::get();
+		EQEmu::IPCMutex mutex("npc_types");
+		mutex.Lock();
+		std::string file_name = Config->SharedMemDir + prefix + std::string("npc_types");
+		mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
+		table = std::unique_ptr<EQEmu::NPCTypeTable>(new EQEmu::NPCTypeTable(mmf->Get(), mmf->Size()));
+		mutex.Unlock();
+	} catch(std::exception& ex) {
+		// whatever was loaded before stays in use
+		Log(Logs::General, Logs::Error, "Error Loading npc types: %s", ex.what());
+		return false;
+	}
+
+	RetireSharedMemory(npc_types_mmf);
+	npc_types_mmf = std::move(mmf);
+	npc_types_table = std::move(table);
 	return true;
 }
 
@@ -1391,7 +1991,7 @@ bool SharedDatabase::GetCommandSettings(std::map<std::string, std::pair<uint8, s
 }
 
 bool SharedDatabase::LoadSkillCaps(const std::string &prefix) {
-	skill_caps_mmf.reset(nullptr);
+	std::unique_ptr<EQEmu::MemoryMappedFile> mmf;
 
 	uint32 class_count = PLAYER_CLASS_COUNT;
 	uint32 skill_count = EQEmu::skills::HIGHEST_SKILL + 1;
@@ -1403,13 +2003,16 @@ bool SharedDatabase::LoadSkillCaps(const std::string &prefix) {
 		EQEmu::IPCMutex mutex("skill_caps");
 		mutex.Lock();
 		std::string file_name = Config->SharedMemDir + prefix + std::string("skill_caps");
-		skill_caps_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
+		mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
 		mutex.Unlock();
 	} catch(std::exception &ex) {
+		// whatever was loaded before stays in use
 		Log(Logs::General, Logs::Error, "Error loading skill caps: %s", ex.what());
 		return false;
 	}
 
+	RetireSharedMemory(skill_caps_mmf);
+	skill_caps_mmf = std::move(mmf);
 	return true;
 }
 
@@ -1552,26 +2155,53 @@ int SharedDatabase::GetMaxSpellID() {
 }
 
 bool SharedDatabase::LoadSpells(const std::string &prefix, int32 *records, const SPDat_Spell_Struct **sp) {
-	spells_mmf.reset(nullptr);
-
+	std::unique_ptr<EQEmu::MemoryMappedFile> mmf;
 	try {
 		auto Config = EQEmuConfig::get();
 		EQEmu::IPCMutex mutex("spells");
 		mutex.Lock();
 	
 		std::string file_name = Config->SharedMemDir + prefix + std::string("spells");
-		spells_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
-		*records = *reinterpret_cast<uint32*>(spells_mmf->Get());
-		*sp = reinterpret_cast<const SPDat_Spell_Struct*>((char*)spells_mmf->Get() + 4);
+		mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
 		mutex.Unlock();
 	}
 	catch(std::exception& ex) {
+		// whatever was loaded before stays in use
 		Log(Logs::General, Logs::Error, "Error Loading Spells: %s", ex.what());
 		return false;
 	}
+
+	RetireSharedMemory(spells_mmf);
+	spells_mmf = std::move(mmf);
+	*records = *reinterpret_cast<uint32*>(spells_mmf->Get());
+	*sp = reinterpret_cast<const SPDat_Spell_Struct*>((char*)spells_mmf->Get() + 4);
 	return true;
 }
 
+void SharedDatabase::RetireSharedMemory(std::unique_ptr<EQEmu::MemoryMappedFile> &mmf) {
+	if (!mmf)
+		return;
+
+	RetiredSharedMemory retired;
+	retired.mmf = std::move(mmf);
+	retired.retired_at = Timer::GetCurrentTime();
+	retired_mmfs.push_back(std::move(retired));
+}
+
+void SharedDatabase::ReleaseRetiredSharedMemory(uint32 retire_time) {
+	if (retired_mmfs.empty())
+		return;
+
+	uint32 now = Timer::GetCurrentTime();
+	auto released = std::remove_if(retired_mmfs.begin(), retired_mmfs.end(),
+		[now, retire_time](const RetiredSharedMemory &retired) { return now - retired.retired_at >= retire_time; });
+	if (released == retired_mmfs.end())
+		return;
+
+	Log(Logs::General, Logs::Status, "Releasing %u retired shared memory files", static_cast<uint32>(retired_mmfs.end() - released));
+	retired_mmfs.erase(released, retired_mmfs.end());
+}
+
 void SharedDatabase::LoadSpells(void *data, int max_spells) {
 	*(uint32*)data = max_spells;
 	SPDat_Spell_Struct *sp = reinterpret_cast<SPDat_Spell_Struct*>((char*)data + sizeof(uint32));
@@ -1759,21 +2389,23 @@ int SharedDatabase::GetMaxBaseDataLevel() {
 }
 
 bool SharedDatabase::LoadBaseData(const std::string &prefix) {
-	base_data_mmf.reset(nullptr);
-
+	std::unique_ptr<EQEmu::MemoryMappedFile> mmf;
 	try {
 		auto Config = EQEmuConfig::get();
 		EQEmu::IPCMutex mutex("base_data");
 		mutex.Lock();
 
 		std::string file_name = Config->SharedMemDir + prefix + std::string("base_data");
-		base_data_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
+		mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name));
 		mutex.Unlock();
 	} catch(std::exception& ex) {
+		// whatever was loaded before stays in use
 		Log(Logs::General, Logs::Error, "Error Loading Base Data: %s", ex.what());
 		return false;
 	}
 
+	RetireSharedMemory(base_data_mmf);
+	base_data_mmf = std::move(mmf);
 	return true;
 }
 
@@ -1951,7 +2583,7 @@ void SharedDatabase::LoadLootTables(void *data, uint32 size) {
 void SharedDatabase::LoadLootDrops(void *data, uint32 size) {
 
 	EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct> hash(reinterpret_cast<uint8*>(data), size);
-	uint8 loot_drop[sizeof(LootDrop_Struct) + (sizeof(LootDropEntries_Struct) * 1260)];
+	uint8 loot_drop[sizeof(LootDrop_Struct) + (sizeof(LootDropEntries_Struct) * 1260) + (sizeof(LootDropAlias_Struct) * 2 * 1261)];
 	LootDrop_Struct *ld = reinterpret_cast<LootDrop_Struct*>(loot_drop);
 
 	const std::string query = "SELECT lootdrop.id, lootdrop_entries.item_id, lootdrop_entries.item_charges, "
@@ -1969,10 +2601,12 @@ void SharedDatabase::LoadLootDrops(void *data, uint32 size) {
     for (auto row = results.begin(); row != results.end(); ++row) {
         uint32 id = static_cast<uint32>(atoul(row[0]));
         if(id != current_id) {
-            if(current_id != 0)
-                hash.insert(current_id, loot_drop, (sizeof(LootDrop_Struct) +(sizeof(LootDropEntries_Struct) * ld->NumEntries)));
+            if(current_id != 0) {
+                EQEmu::BuildLootDropAliasTables(ld);
+                hash.insert(current_id, loot_drop, EQEmu::LootDropSize(ld->NumEntries));
+            }
 
-            memset(loot_drop, 0, sizeof(LootDrop_Struct) + (sizeof(LootDropEntries_Struct) * 1260));
+            memset(loot_drop, 0, sizeof(loot_drop));
 			current_entry = 0;
 			current_id = id;
         }
@@ -1992,35 +2626,46 @@ void SharedDatabase::LoadLootDrops(void *data, uint32 size) {
         ++current_entry;
     }
 
-    if(current_id != 0)
-        hash.insert(current_id, loot_drop, (sizeof(LootDrop_Struct) + (sizeof(LootDropEntries_Struct) * ld->NumEntries)));
+    if(current_id != 0) {
+        EQEmu::BuildLootDropAliasTables(ld);
+        hash.insert(current_id, loot_drop, EQEmu::LootDropSize(ld->NumEntries));
+    }
 
 }
 
 bool SharedDatabase::LoadLoot(const std::string &prefix) {
-	loot_table_mmf.reset(nullptr);
-	loot_drop_mmf.reset(nullptr);
-
+	std::unique_ptr<EQEmu::MemoryMappedFile> table_mmf;
+	std::unique_ptr<EQEmu::FixedMemoryVariableHashSet<LootTable_Struct>> table_hash;
+	std::unique_ptr<EQEmu::MemoryMappedFile> drop_mmf;
+	std::unique_ptr<EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct>> drop_hash;
 	try {
 		auto Config = EQEmuConfig::get();
 		EQEmu::IPCMutex mutex("loot");
 		mutex.Lock();
 		std::string file_name_lt = Config->SharedMemDir + prefix + std::string("loot_table");
-		loot_table_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name_lt));
-		loot_table_hash = std::unique_ptr<EQEmu::FixedMemoryVariableHashSet<LootTable_Struct>>(new EQEmu::FixedMemoryVariableHashSet<LootTable_Struct>(
-			reinterpret_cast<uint8*>(loot_table_mmf->Get()),
-			loot_table_mmf->Size()));
+		table_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name_lt));
+		table_hash = std::unique_ptr<EQEmu::FixedMemoryVariableHashSet<LootTable_Struct>>(new EQEmu::FixedMemoryVariableHashSet<LootTable_Struct>(
+			reinterpret_cast<uint8*>(table_mmf->Get()),
+			table_mmf->Size()));
 		std::string file_name_ld = Config->SharedMemDir + prefix + std::string("loot_drop");
-		loot_drop_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name_ld));
-		loot_drop_hash = std::unique_ptr<EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct>>(new EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct>(
-			reinterpret_cast<uint8*>(loot_drop_mmf->Get()),
-			loot_drop_mmf->Size()));
+		drop_mmf = std::unique_ptr<EQEmu::MemoryMappedFile>(new EQEmu::MemoryMappedFile(file_name_ld));
+		drop_hash = std::unique_ptr<EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct>>(new EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct>(
+			reinterpret_cast<uint8*>(drop_mmf->Get()),
+			drop_mmf->Size()));
 		mutex.Unlock();
 	} catch(std::exception &ex) {
+		// whatever was loaded before stays in use, tables and drops are only ever switched together
 		Log(Logs::General, Logs::Error, "Error loading loot: %s", ex.what());
 		return false;
 	}
 
+	RetireSharedMemory(loot_table_mmf);
+	RetireSharedMemory(loot_drop_mmf);
+	loot_table_mmf = std::move(table_mmf);
+	loot_table_hash = std::move(table_hash);
+	loot_drop_mmf = std::move(drop_mmf);
+	loot_drop_hash = std::move(drop_hash);
+	loot_drop_summaries.clear();
 	return true;
 }
 
@@ -2052,6 +2697,28 @@ const LootDrop_Struct* SharedDatabase::GetLootDrop(uint32 lootdrop_id) {
 	return nullptr;
 }
 
+const LootDropItemSummary& SharedDatabase::GetLootDropItemSummary(uint32 lootdrop_id, const LootDrop_Struct* lds) {
+	auto iter = loot_drop_summaries.find(lootdrop_id);
+	if(iter != loot_drop_summaries.end())
+		return iter->second;
+
+	LootDropItemSummary summary;
+	summary.chance_total = 0.0f;
+	summary.all_items_found = true;
+	summary.any_item_found = false;
+	for(uint32 i = 0; i < lds->NumEntries; ++i) {
+		if(GetItem(lds->Entries[i].item_id)) {
+			summary.chance_total += lds->Entries[i].chance;
+			summary.any_item_found = true;
+		}
+		else {
+			summary.all_items_found = false;
+		}
+	}
+
+	return loot_drop_summaries[lootdrop_id] = summary;
+}
+
 void SharedDatabase::LoadCharacterInspectMessage(uint32 character_id, InspectMessage_Struct* message) {
 	std::string query = StringFormat("SELECT `inspect_message` FROM `character_inspect_messages` WHERE `id` = %u LIMIT 1", character_id);
 	auto results = QueryDatabase(query);
@@ -27,10 +27,15 @@
 #include "base_data.h"
 #include "fixed_memory_hash_set.h"
 #include "fixed_memory_variable_hash_set.h"
+#include "item_hot_table.h"
+#include "loottable.h"
+#include "npc_type_table.h"
 
 #include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 class EvolveInfo;
 struct BaseDataStruct;
@@ -40,6 +45,7 @@ struct SPDat_Spell_Struct;
 struct NPCFactionList;
 struct LootTable_Struct;
 struct LootDrop_Struct;
+class MySQLRequestRow;
 
 namespace EQEmu
 {
@@ -82,6 +88,7 @@ class SharedDatabase : public Database
 		bool    DeleteInventorySlot(uint32 char_id, int16 slot_id);
 		bool    UpdateInventorySlot(uint32 char_id, const EQEmu::ItemInstance* inst, int16 slot_id);
 		bool    UpdateSharedBankSlot(uint32 char_id, const EQEmu::ItemInstance* inst, int16 slot_id);
+		bool	SaveInventoryJournal(uint32 char_id, EQEmu::InventoryProfile* inv, uint32* query_count = nullptr);
 		bool	VerifyInventory(uint32 account_id, int16 slot_id, const EQEmu::ItemInstance* inst);
 		bool	GetSharedBank(uint32 id, EQEmu::InventoryProfile* inv, bool is_charid);
 		int32	GetSharedPlatinum(uint32 account_id);
@@ -113,6 +120,13 @@ class SharedDatabase : public Database
 		bool LoadItems(const std::string &prefix);
 		const EQEmu::ItemData* IterateItems(uint32* id);
 		const EQEmu::ItemData* GetItem(uint32 id);
+		// hot field rows straight from shared memory, nullptr when the item or the table is missing
+		const EQEmu::ItemHotStats* GetItemHotStats(uint32 id) const;
+		const EQEmu::ItemHotFlags* GetItemHotFlags(uint32 id) const;
+		// same rows for an instance's unscaled item, but only when its data was copied out of the
+		// items file mapped now, so an instance from before a reload never mixes in the newer rows
+		const EQEmu::ItemHotStats* GetItemHotStats(const EQEmu::ItemInstance *inst) const;
+		const EQEmu::ItemHotFlags* GetItemHotFlags(const EQEmu::ItemInstance *inst) const;
 		const EvolveInfo* GetEvolveInfo(uint32 loregroup);
 
 		//faction lists
@@ -129,6 +143,8 @@ class SharedDatabase : public Database
 		bool LoadLoot(const std::string &prefix);
 		const LootTable_Struct* GetLootTable(uint32 loottable_id);
 		const LootDrop_Struct* GetLootDrop(uint32 lootdrop_id);
+		// cached until items or loot are loaded again
+		const LootDropItemSummary& GetLootDropItemSummary(uint32 lootdrop_id, const LootDrop_Struct* lds);
 
 		void LoadSkillCaps(void *data);
 		bool LoadSkillCaps(const std::string &prefix);
@@ -138,8 +154,21 @@ class SharedDatabase : public Database
 		int GetMaxSpellID();
 		bool LoadSpells(const std::string &prefix, int32 *records, const SPDat_Spell_Struct **sp);
 		void LoadSpells(void *data, int max_spells);
+
+		// unmaps shared memory files that were replaced by a reload at least retire_time ms ago
+		void ReleaseRetiredSharedMemory(uint32 retire_time);
 		void LoadDamageShieldTypes(SPDat_Spell_Struct* sp, int32 iMaxSpellID);
 
+		//npc types
+		static std::string GetNPCTypesQuery(const std::string &where);
+		void ReadNPCTypeRow(MySQLRequestRow &row, EQEmu::NPCTypeRecord &record, EQEmu::NPCTypeTableBuilder &builder,
+			const std::map<uint32, EQEmu::TintProfile> *tints = nullptr);
+		bool LoadNPCTypeTint(uint32 tint_id, EQEmu::TintProfile &tint);
+		void LoadNPCTypeTints(std::map<uint32, EQEmu::TintProfile> &tints);
+		void LoadNPCTypes(EQEmu::NPCTypeTableBuilder &builder);
+		bool LoadNPCTypes(const std::string &prefix);
+		const EQEmu::NPCTypeTable *GetNPCTypeTable() const { return npc_types_table.get(); }
+
 		int GetMaxBaseDataLevel();
 		bool LoadBaseData(const std::string &prefix);
 		void LoadBaseData(void *data, int max_level);
@@ -147,17 +176,37 @@ class SharedDatabase : public Database
 
 	protected:
 
+		static void ReadNPCTypeTint(MySQLRequestRow &row, int first, EQEmu::TintProfile &tint);
+		uint32 GetItemHotIndex(const EQEmu::ItemInstance *inst) const;
+
+		/*
+		    A reload maps every new shared memory file before dropping the old
+		    one, and the old mappings are kept for a while so pointers handed
+		    out from them before the switch stay valid until they are done with.
+		*/
+		struct RetiredSharedMemory {
+			std::unique_ptr<EQEmu::MemoryMappedFile> mmf;
+			uint32 retired_at;
+		};
+		void RetireSharedMemory(std::unique_ptr<EQEmu::MemoryMappedFile> &mmf);
+
 		std::unique_ptr<EQEmu::MemoryMappedFile> skill_caps_mmf;
 		std::unique_ptr<EQEmu::MemoryMappedFile> items_mmf;
 		std::unique_ptr<EQEmu::FixedMemoryHashSet<EQEmu::ItemData>> items_hash;
+		std::unique_ptr<EQEmu::ItemHotTable> items_hot_table;
+		uint32 items_generation;
 		std::unique_ptr<EQEmu::MemoryMappedFile> faction_mmf;
 		std::unique_ptr<EQEmu::FixedMemoryHashSet<NPCFactionList>> faction_hash;
 		std::unique_ptr<EQEmu::MemoryMappedFile> loot_table_mmf;
 		std::unique_ptr<EQEmu::FixedMemoryVariableHashSet<LootTable_Struct>> loot_table_hash;
 		std::unique_ptr<EQEmu::MemoryMappedFile> loot_drop_mmf;
 		std::unique_ptr<EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct>> loot_drop_hash;
+		std::unordered_map<uint32, LootDropItemSummary> loot_drop_summaries;
 		std::unique_ptr<EQEmu::MemoryMappedFile> base_data_mmf;
 		std::unique_ptr<EQEmu::MemoryMappedFile> spells_mmf;
+		std::unique_ptr<EQEmu::MemoryMappedFile> npc_types_mmf;
+		std::unique_ptr<EQEmu::NPCTypeTable> npc_types_table;
+		std::vector<RetiredSharedMemory> retired_mmfs;
 };
 
 #endif /*SHAREDDB_H_*/
@@ -0,0 +1,161 @@
+#include "job_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+EQ::JobPool::JobPool() : m_pending(0), m_stop(false)
+{
+	Start(0);
+}
+
+EQ::JobPool::JobPool(size_t threads) : m_pending(0), m_stop(false)
+{
+	Start(threads);
+}
+
+EQ::JobPool::~JobPool()
+{
+	Stop();
+}
+
+void EQ::JobPool::SetThreadCount(size_t threads)
+{
+	if (threads == m_workers.size())
+		return;
+
+	Stop();
+	Start(threads);
+}
+
+void EQ::JobPool::Start(size_t threads)
+{
+	m_stop = false;
+	m_queues.clear();
+	for (size_t i = 0; i <= threads; ++i)
+		m_queues.push_back(std::unique_ptr<Queue>(new Queue()));
+
+	for (size_t i = 0; i < threads; ++i)
+		m_workers.push_back(std::thread(&JobPool::WorkerMain, this, i));
+}
+
+void EQ::JobPool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> l(m_wake_lock);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+
+	for (auto &t : m_workers)
+		t.join();
+
+	m_workers.clear();
+}
+
+void EQ::JobPool::ParallelFor(size_t count, size_t grain, const RangeFunction &fn)
+{
+	if (count == 0)
+		return;
+
+	if (grain == 0)
+		grain = 1;
+
+	if (m_workers.empty() || count <= grain) {
+		fn(0, count);
+		return;
+	}
+
+	Batch batch;
+	batch.fn = &fn;
+	batch.remaining = (count + grain - 1) / grain;
+
+	// counted before anything is queued, a worker may pop (and decrement) a chunk as soon as it is pushed
+	m_pending += batch.remaining.load();
+
+	// deal the chunks out round robin, idle workers steal the rest
+	size_t q = 0;
+	for (size_t begin = 0; begin < count; begin += grain) {
+		Job job;
+		job.batch = &batch;
+		job.begin = begin;
+		job.end = std::min(begin + grain, count);
+
+		Queue &queue = *m_queues[q++ % m_queues.size()];
+		std::lock_guard<std::mutex> l(queue.lock);
+		queue.jobs.push_back(job);
+	}
+
+	{
+		std::lock_guard<std::mutex> l(m_wake_lock);
+	}
+	m_wake.notify_all();
+
+	size_t self = m_workers.size();
+	Job job;
+	while (batch.remaining.load() > 0) {
+		if (PopOrSteal(self, job)) {
+			Run(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> l(batch.lock);
+		batch.done.wait_for(l, std::chrono::milliseconds(1), [&batch]() { return batch.remaining.load() == 0; });
+	}
+
+	// the last worker may still be signaling, don't let batch go out of scope under it
+	std::unique_lock<std::mutex> l(batch.lock);
+	batch.done.wait(l, [&batch]() { return batch.remaining.load() == 0; });
+}
+
+void EQ::JobPool::WorkerMain(size_t index)
+{
+	for (;;) {
+		Job job;
+		if (PopOrSteal(index, job)) {
+			Run(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> l(m_wake_lock);
+		m_wake.wait(l, [this]() { return m_stop || m_pending.load() > 0; });
+		if (m_stop)
+			return;
+	}
+}
+
+bool EQ::JobPool::PopOrSteal(size_t index, Job &job)
+{
+	{
+		Queue &own = *m_queues[index];
+		std::lock_guard<std::mutex> l(own.lock);
+		if (!own.jobs.empty()) {
+			job = own.jobs.back();
+			own.jobs.pop_back();
+			--m_pending;
+			return true;
+		}
+	}
+
+	for (size_t i = 1; i < m_queues.size(); ++i) {
+		Queue &victim = *m_queues[(index + i) % m_queues.size()];
+		std::lock_guard<std::mutex> l(victim.lock);
+		if (!victim.jobs.empty()) {
+			job = victim.jobs.front();
+			victim.jobs.pop_front();
+			--m_pending;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void EQ::JobPool::Run(const Job &job)
+{
+	Batch *batch = job.batch;
+	(*batch->fn)(job.begin, job.end);
+
+	std::lock_guard<std::mutex> l(batch->lock);
+	if (--batch->remaining == 0)
+		batch->done.notify_all();
+}
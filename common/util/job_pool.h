@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EQ {
+	/*
+	 * Small work stealing job pool for splitting independent per entity work
+	 * across cores. Every worker owns a deque, pops its own work from the back
+	 * and steals from the front of the others when it runs dry. The thread that
+	 * calls ParallelFor works on the batch as well and only returns once every
+	 * chunk has run, so a parallel read only phase can be followed directly by
+	 * a serial phase that applies the results.
+	 *
+	 * Jobs must only write to state owned by their own index range; that is
+	 * what keeps the parallel result identical to the serial one. With zero
+	 * worker threads everything runs inline on the caller, in order.
+	 *
+	 * Zone only hands it the aggro broadphase grid queries. NPC movement,
+	 * LOS and regen run inside NPC::Process next to quest events, packets and
+	 * the entity lists, none of which are safe to touch off the main thread.
+	 */
+	class JobPool
+	{
+	public:
+		typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+		static JobPool &Get() {
+			static JobPool inst;
+			return inst;
+		}
+
+		JobPool();
+		explicit JobPool(size_t threads);
+		~JobPool();
+
+		// must not be called while a ParallelFor is running
+		void SetThreadCount(size_t threads);
+		size_t GetThreadCount() const { return m_workers.size(); }
+
+		void ParallelFor(size_t count, size_t grain, const RangeFunction &fn);
+
+	private:
+		struct Batch
+		{
+			const RangeFunction *fn;
+			std::atomic<size_t> remaining;
+			std::mutex lock;
+			std::condition_variable done;
+		};
+
+		struct Job
+		{
+			Batch *batch;
+			size_t begin;
+			size_t end;
+		};
+
+		struct Queue
+		{
+			std::mutex lock;
+			std::deque<Job> jobs;
+		};
+
+		void Start(size_t threads);
+		void Stop();
+		void WorkerMain(size_t index);
+		bool PopOrSteal(size_t index, Job &job);
+		static void Run(const Job &job);
+
+		JobPool(const JobPool&);
+		JobPool& operator=(const JobPool&);
+
+		std::vector<std::thread> m_workers;
+		std::vector<std::unique_ptr<Queue>> m_queues; // one per worker plus one for the calling thread
+		std::mutex m_wake_lock;
+		std::condition_variable m_wake;
+		std::atomic<size_t> m_pending;
+		bool m_stop;
+	};
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../types.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace EQ {
+	/*
+	 * npc type id -> entity ids of the spawned npcs of that type, in the order
+	 * they were added. Types with nothing spawned have no entry. An entity is
+	 * removed from the type it was added under, and an npc whose type id is
+	 * changed while spawned (#npcspawn create) is moved with Change.
+	 */
+	class NPCTypeIndex
+	{
+	public:
+		void Add(uint32 npc_type_id, uint16 entity_id) {
+			Remove(entity_id);
+			index[npc_type_id].push_back(entity_id);
+			types[entity_id] = npc_type_id;
+		}
+
+		void Remove(uint16 entity_id) {
+			auto type_it = types.find(entity_id);
+			if (type_it == types.end())
+				return;
+
+			auto it = index.find(type_it->second);
+			types.erase(type_it);
+			if (it == index.end())
+				return;
+
+			auto &ids = it->second;
+			ids.erase(std::remove(ids.begin(), ids.end(), entity_id), ids.end());
+			if (ids.empty())
+				index.erase(it);
+		}
+
+		// moves an indexed entity to npc_type_id, ids that were never added are left out
+		void Change(uint16 entity_id, uint32 npc_type_id) {
+			auto it = types.find(entity_id);
+			if (it != types.end() && it->second != npc_type_id)
+				Add(npc_type_id, entity_id);
+		}
+
+		// nullptr when nothing of the type is spawned
+		const std::vector<uint16> *Find(uint32 npc_type_id) const {
+			auto it = index.find(npc_type_id);
+			return it == index.end() ? nullptr : &it->second;
+		}
+
+		void Clear() {
+			index.clear();
+			types.clear();
+		}
+
+		size_t Size() const { return types.size(); }
+
+	private:
+		std::unordered_map<uint32, std::vector<uint16>> index;
+		std::unordered_map<uint16, uint32> types;
+	};
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../types.h"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace EQ {
+	/*
+	 * FIFO of (target, signal) pairs that are delivered a limited number per
+	 * tick. Signals come out in the order they were pushed, so one target
+	 * always sees its signals in send order and a fan-out to many targets is
+	 * delivered in the order the targets were queued.
+	 *
+	 * With coalescing a push that matches a signal still waiting for the same
+	 * target is dropped; the pending one keeps its place in the queue.
+	 *
+	 * Senders ask TakeInline first and deliver right away while nothing is
+	 * waiting and the tick's budget is not used up, so signals only queue once
+	 * a tick overflows. BeginTick starts every tick's budget, queue or not, and
+	 * what Pop hands out counts against it.
+	 */
+	class SignalQueue
+	{
+	public:
+		SignalQueue() : delivered(0) { }
+
+		struct Signal {
+			uint32 target;
+			int32 signal_id;
+		};
+
+		// false when the signal was coalesced into one already pending
+		bool Push(uint32 target, int32 signal_id, bool coalesce) {
+			uint32 &count = pending[Key(target, signal_id)];
+			if (coalesce && count > 0)
+				return false;
+
+			++count;
+			Signal s;
+			s.target = target;
+			s.signal_id = signal_id;
+			queue.push_back(s);
+			return true;
+		}
+
+		// true when a signal may be delivered now instead of queued, it is counted against the budget (0 is unlimited)
+		bool TakeInline(size_t budget) {
+			if (!queue.empty() || (budget > 0 && delivered >= budget))
+				return false;
+
+			++delivered;
+			return true;
+		}
+
+		// starts a new tick's budget, call it every tick even when nothing is queued
+		void BeginTick() {
+			delivered = 0;
+		}
+
+		// moves up to budget signals (0 for all of them) to out, oldest first, counting them against this tick
+		size_t Pop(size_t budget, std::vector<Signal> &out) {
+			out.clear();
+			size_t count = queue.size();
+			if (budget > 0 && budget < count)
+				count = budget;
+
+			for (size_t i = 0; i < count; ++i) {
+				const Signal &s = queue.front();
+				Release(s);
+				out.push_back(s);
+				queue.pop_front();
+			}
+			delivered += count;
+			return count;
+		}
+
+		// drops everything still waiting for target, for targets that went away
+		void Remove(uint32 target) {
+			if (queue.empty())
+				return;
+
+			auto end = std::remove_if(queue.begin(), queue.end(), [this, target](const Signal &s) {
+				if (s.target != target)
+					return false;
+				Release(s);
+				return true;
+			});
+			queue.erase(end, queue.end());
+		}
+
+		void Clear() {
+			queue.clear();
+			pending.clear();
+			delivered = 0;
+		}
+
+		size_t Size() const { return queue.size(); }
+		bool Empty() const { return queue.empty(); }
+
+	private:
+		static uint64 Key(uint32 target, int32 signal_id) {
+			return (static_cast<uint64>(target) << 32) | static_cast<uint32>(signal_id);
+		}
+
+		void Release(const Signal &s) {
+			auto it = pending.find(Key(s.target, s.signal_id));
+			if (it != pending.end() && --it->second == 0)
+				pending.erase(it);
+		}
+
+		std::deque<Signal> queue;
+		std::unordered_map<uint64, uint32> pending;
+		size_t delivered;	// this tick, inline and popped
+	};
+}
@@ -0,0 +1,302 @@
+#include "slab_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+/*
+ * A thread's free list for one pool. Only the owning thread touches the list;
+ * the counters are atomics so GetStats can read them from elsewhere, but they
+ * are only ever stored by the owner, which keeps them plain moves.
+ */
+struct EQ::SlabPool::ThreadCache
+{
+	ThreadCache(SlabPool *p) : pool(p), free(nullptr), count(0), allocs(0), frees(0), fallbacks(0) { }
+
+	static void Bump(std::atomic<uint64_t> &counter) {
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	SlabPool *pool;
+	FreeBlock *free;
+	size_t count;
+	std::atomic<uint64_t> allocs;
+	std::atomic<uint64_t> frees;
+	std::atomic<uint64_t> fallbacks;
+};
+
+namespace {
+	std::mutex &RegistryLock() {
+		static std::mutex *lock = new std::mutex();
+		return *lock;
+	}
+
+	std::vector<EQ::SlabPool*> &Registry() {
+		static std::vector<EQ::SlabPool*> *pools = new std::vector<EQ::SlabPool*>();
+		return *pools;
+	}
+
+	// this thread's free lists by pool index; plain pointers so they can still be read after the owner below is gone
+	thread_local std::vector<EQ::SlabPool::ThreadCache*> *t_caches = nullptr;
+	thread_local bool t_caches_gone = false;
+
+	struct ThreadCacheOwner
+	{
+		~ThreadCacheOwner() { EQ::SlabPool::ReleaseThreadCaches(); }
+	};
+	thread_local ThreadCacheOwner t_cache_owner;
+}
+
+EQ::SlabPool::SlabPool(const char *name, size_t block_size, size_t blocks_per_slab)
+	: m_name(name), m_requested_size(block_size), m_empty_slabs(0), m_out(0), m_peak(0), m_released(0),
+	m_allocs(0), m_frees(0), m_fallbacks(0)
+{
+	const size_t align = alignof(std::max_align_t);
+	m_block_size = std::max(block_size, sizeof(FreeBlock));
+	m_block_size = (m_block_size + align - 1) / align * align;
+	m_blocks_per_slab = std::max(blocks_per_slab, static_cast<size_t>(1));
+	// a thread holds at most two batches, so no thread can sit on much of a slab
+	m_batch = std::min(std::max(m_blocks_per_slab / 4, static_cast<size_t>(1)), static_cast<size_t>(64));
+
+	std::lock_guard<std::mutex> l(RegistryLock());
+	m_index = Registry().size();
+	Registry().push_back(this);
+}
+
+void *EQ::SlabPool::Allocate(size_t size)
+{
+	ThreadCache *cache = GetThreadCache();
+
+	if (size != m_requested_size) {
+		if (cache) {
+			ThreadCache::Bump(cache->fallbacks);
+		} else {
+			std::lock_guard<std::mutex> l(m_lock);
+			++m_fallbacks;
+		}
+		return ::operator new(size);
+	}
+
+	if (!cache) {
+		std::lock_guard<std::mutex> l(m_lock);
+		++m_allocs;
+		return TakeBlock();
+	}
+
+	if (!cache->free)
+		Refill(*cache);
+
+	FreeBlock *block = cache->free;
+	cache->free = block->next;
+	--cache->count;
+	ThreadCache::Bump(cache->allocs);
+	return block;
+}
+
+void EQ::SlabPool::Free(void *ptr, size_t size)
+{
+	if (!ptr)
+		return;
+
+	if (size != m_requested_size) {
+		::operator delete(ptr);
+		return;
+	}
+
+	ThreadCache *cache = GetThreadCache();
+	if (!cache) {
+		std::lock_guard<std::mutex> l(m_lock);
+		++m_frees;
+		ReturnBlock(ptr);
+		return;
+	}
+
+	FreeBlock *block = static_cast<FreeBlock*>(ptr);
+	block->next = cache->free;
+	cache->free = block;
+	++cache->count;
+	ThreadCache::Bump(cache->frees);
+
+	if (cache->count >= m_batch * 2)
+		Drain(*cache, m_batch);
+}
+
+// nullptr once this thread's free lists have been torn down at thread exit
+EQ::SlabPool::ThreadCache *EQ::SlabPool::GetThreadCache()
+{
+	if (t_caches_gone)
+		return nullptr;
+
+	if (!t_caches) {
+		// touching the owner registers its destructor for this thread
+		(void)&t_cache_owner;
+		t_caches = new std::vector<ThreadCache*>();
+	}
+
+	if (m_index >= t_caches->size())
+		t_caches->resize(m_index + 1, nullptr);
+
+	ThreadCache *&cache = (*t_caches)[m_index];
+	if (!cache) {
+		cache = new ThreadCache(this);
+		std::lock_guard<std::mutex> l(m_lock);
+		m_caches.push_back(cache);
+	}
+
+	return cache;
+}
+
+void EQ::SlabPool::Refill(ThreadCache &cache)
+{
+	std::lock_guard<std::mutex> l(m_lock);
+	for (size_t i = 0; i < m_batch; ++i) {
+		FreeBlock *block = static_cast<FreeBlock*>(TakeBlock());
+		block->next = cache.free;
+		cache.free = block;
+		++cache.count;
+	}
+}
+
+void EQ::SlabPool::Drain(ThreadCache &cache, size_t keep)
+{
+	std::lock_guard<std::mutex> l(m_lock);
+	while (cache.count > keep) {
+		FreeBlock *block = cache.free;
+		cache.free = block->next;
+		--cache.count;
+		ReturnBlock(block);
+	}
+}
+
+void EQ::SlabPool::DropThreadCache(ThreadCache *cache)
+{
+	Drain(*cache, 0);
+
+	std::lock_guard<std::mutex> l(m_lock);
+	m_allocs += cache->allocs.load(std::memory_order_relaxed);
+	m_frees += cache->frees.load(std::memory_order_relaxed);
+	m_fallbacks += cache->fallbacks.load(std::memory_order_relaxed);
+	m_caches.erase(std::remove(m_caches.begin(), m_caches.end(), cache), m_caches.end());
+	delete cache;
+}
+
+void *EQ::SlabPool::TakeBlock()
+{
+	if (m_available.empty())
+		Grow();
+
+	Slab *slab = m_available.back();
+	FreeBlock *block = slab->free;
+	slab->free = block->next;
+	if (slab->used++ == 0)
+		--m_empty_slabs;
+	if (!slab->free)
+		m_available.pop_back();
+
+	++m_out;
+	m_peak = std::max(m_peak, m_out);
+	return block;
+}
+
+void EQ::SlabPool::ReturnBlock(void *ptr)
+{
+	auto iter = m_slabs.upper_bound(static_cast<const char*>(ptr));
+	--iter;
+	Slab *slab = iter->second.get();
+
+	FreeBlock *block = static_cast<FreeBlock*>(ptr);
+	if (!slab->free)
+		m_available.push_back(slab);
+	block->next = slab->free;
+	slab->free = block;
+	--m_out;
+
+	// keep one empty slab around so a pool hovering at a slab boundary does not thrash
+	if (--slab->used == 0 && ++m_empty_slabs > 1)
+		Release(slab);
+}
+
+// new[] of char is only guaranteed max_align_t alignment, which is what blocks are rounded to
+void EQ::SlabPool::Grow()
+{
+	std::unique_ptr<Slab> slab(new Slab());
+	slab->memory.reset(new char[m_block_size * m_blocks_per_slab]);
+	slab->free = nullptr;
+	slab->used = 0;
+
+	char *base = slab->memory.get();
+	for (size_t i = m_blocks_per_slab; i > 0; --i) {
+		FreeBlock *block = reinterpret_cast<FreeBlock*>(base + (i - 1) * m_block_size);
+		block->next = slab->free;
+		slab->free = block;
+	}
+
+	m_available.push_back(slab.get());
+	++m_empty_slabs;
+	m_slabs[base] = std::move(slab);
+}
+
+void EQ::SlabPool::Release(Slab *slab)
+{
+	m_available.erase(std::remove(m_available.begin(), m_available.end(), slab), m_available.end());
+	--m_empty_slabs;
+	++m_released;
+	m_slabs.erase(slab->memory.get());
+}
+
+EQ::SlabPool::Stats EQ::SlabPool::GetStats()
+{
+	std::lock_guard<std::mutex> l(m_lock);
+
+	Stats s;
+	s.name = m_name;
+	s.block_size = m_block_size;
+	s.blocks_per_slab = m_blocks_per_slab;
+	s.slabs = m_slabs.size();
+	s.peak = m_peak;
+	s.allocs = m_allocs;
+	s.frees = m_frees;
+	s.fallbacks = m_fallbacks;
+	s.released = m_released;
+	for (auto cache : m_caches) {
+		s.allocs += cache->allocs.load(std::memory_order_relaxed);
+		s.frees += cache->frees.load(std::memory_order_relaxed);
+		s.fallbacks += cache->fallbacks.load(std::memory_order_relaxed);
+	}
+
+	// other threads keep counting while this runs, so keep the derived numbers in range
+	s.live = s.allocs > s.frees ? static_cast<size_t>(s.allocs - s.frees) : 0;
+	s.live = std::min(s.live, m_out);
+	s.cached = m_out - s.live;
+	return s;
+}
+
+std::vector<EQ::SlabPool::Stats> EQ::SlabPool::GetAllStats()
+{
+	std::vector<SlabPool*> pools;
+	{
+		std::lock_guard<std::mutex> l(RegistryLock());
+		pools = Registry();
+	}
+
+	std::vector<Stats> ret;
+	for (auto pool : pools)
+		ret.push_back(pool->GetStats());
+
+	return ret;
+}
+
+void EQ::SlabPool::ReleaseThreadCaches()
+{
+	std::vector<ThreadCache*> *caches = t_caches;
+	t_caches = nullptr;
+	t_caches_gone = true;
+	if (!caches)
+		return;
+
+	for (auto cache : *caches) {
+		if (cache)
+			cache->pool->DropThreadCache(cache);
+	}
+	delete caches;
+}
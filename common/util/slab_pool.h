@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace EQ {
+	/*
+	 * Fixed size block allocator for objects that get created and destroyed
+	 * constantly (npcs, corpses, loot, packets). Blocks are carved out of large
+	 * slabs and recycled through a free list, so a long lived zone reuses the
+	 * same few slabs instead of scattering small allocations over the heap.
+	 *
+	 * Every thread keeps a short free list of its own per pool and only takes
+	 * the pool lock to move a batch of blocks in or out of it, so the zone
+	 * thread allocating and freeing packets never contends with anything.
+	 * A slab whose blocks have all come back is given back to the heap once
+	 * another empty one is already being kept.
+	 *
+	 * Requests that are not the pool's block size (derived classes) go straight
+	 * to the global heap and are only counted. Pools are never destroyed, objects
+	 * freed during static teardown still have somewhere to go.
+	 */
+	class SlabPool
+	{
+	public:
+		struct Stats
+		{
+			std::string name;
+			size_t block_size;
+			size_t blocks_per_slab;
+			size_t slabs;
+			size_t live;
+			// most blocks out of the slabs at once, live objects plus thread free lists
+			size_t peak;
+			// free blocks sitting in thread free lists
+			size_t cached;
+			uint64_t allocs;
+			uint64_t frees;
+			uint64_t fallbacks;
+			uint64_t released;
+
+			size_t ReservedBytes() const { return slabs * blocks_per_slab * block_size; }
+			size_t LiveBytes() const { return live * block_size; }
+			// share of reserved slab memory not holding a live object
+			double Fragmentation() const { return slabs ? 1.0 - static_cast<double>(LiveBytes()) / static_cast<double>(ReservedBytes()) : 0.0; }
+		};
+
+		SlabPool(const char *name, size_t block_size, size_t blocks_per_slab);
+
+		void *Allocate(size_t size);
+		void Free(void *ptr, size_t size);
+		Stats GetStats();
+
+		static std::vector<Stats> GetAllStats();
+		// hands the calling thread's free lists back to their pools, runs by itself at thread exit
+		static void ReleaseThreadCaches();
+
+		struct ThreadCache;
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock *next;
+		};
+
+		struct Slab
+		{
+			std::unique_ptr<char[]> memory;
+			FreeBlock *free;
+			size_t used;
+		};
+
+		ThreadCache *GetThreadCache();
+		void Refill(ThreadCache &cache);
+		void Drain(ThreadCache &cache, size_t keep);
+		void DropThreadCache(ThreadCache *cache);
+
+		// callers hold m_lock
+		void *TakeBlock();
+		void ReturnBlock(void *ptr);
+		void Grow();
+		void Release(Slab *slab);
+
+		// never destroyed, thread free lists hand blocks back to their pool at thread exit
+		~SlabPool();
+		SlabPool(const SlabPool&);
+		SlabPool& operator=(const SlabPool&);
+
+		std::mutex m_lock;
+		std::string m_name;
+		size_t m_index;
+		size_t m_block_size;
+		size_t m_requested_size;
+		size_t m_blocks_per_slab;
+		size_t m_batch;
+		// by start address, so a returned block can find its slab
+		std::map<const char*, std::unique_ptr<Slab>> m_slabs;
+		std::vector<Slab*> m_available;
+		size_t m_empty_slabs;
+		size_t m_out;
+		size_t m_peak;
+		uint64_t m_released;
+		std::vector<ThreadCache*> m_caches;
+		// counts folded in from threads that have exited or had no free list
+		uint64_t m_allocs;
+		uint64_t m_frees;
+		uint64_t m_fallbacks;
+	};
+}
+
+/*
+ * Routes a class' new/delete through a SlabPool. Put EQ_SLAB_POOLED() in a
+ * public section of the class body and EQ_SLAB_POOLED_IMPL(Class, "Name",
+ * blocks per slab) in one translation unit.
+ */
+#define EQ_SLAB_POOLED() \
+		static void *operator new(size_t size); \
+		static void operator delete(void *ptr, size_t size); \
+		static EQ::SlabPool &GetSlabPool();
+
+#define EQ_SLAB_POOLED_IMPL(type, name, per_slab) \
+	EQ::SlabPool &type::GetSlabPool() { \
+		static EQ::SlabPool *pool = new EQ::SlabPool(name, sizeof(type), per_slab); \
+		return *pool; \
+	} \
+	void *type::operator new(size_t size) { return GetSlabPool().Allocate(size); } \
+	void type::operator delete(void *ptr, size_t size) { GetSlabPool().Free(ptr, size); }
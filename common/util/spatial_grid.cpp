@@ -0,0 +1,61 @@
+#include "spatial_grid.h"
+#include "job_pool.h"
+
+void EQ::SpatialGrid::Insert(const Entry &e)
+{
+	cells[CellKey(CellCoord(e.x), CellCoord(e.y))].push_back(e);
+}
+
+void EQ::SpatialGrid::Query(float x, float y, float range, std::vector<const Entry *> &out) const
+{
+	out.clear();
+	if (cells.empty())
+		return;
+
+	int min_cx = CellCoord(x - range);
+	int max_cx = CellCoord(x + range);
+	int min_cy = CellCoord(y - range);
+	int max_cy = CellCoord(y + range);
+
+	for (int cx = min_cx; cx <= max_cx; ++cx) {
+		for (int cy = min_cy; cy <= max_cy; ++cy) {
+			auto it = cells.find(CellKey(cx, cy));
+			if (it == cells.end())
+				continue;
+
+			for (auto &e : it->second) {
+				if (std::abs(e.x - x) > range || std::abs(e.y - y) > range)
+					continue;
+				out.push_back(&e);
+			}
+		}
+	}
+}
+
+void EQ::SpatialGrid::QueryEach(const std::vector<Entry> &points, float range, JobPool &pool, size_t min_parallel,
+	std::vector<std::vector<uint16>> &out) const
+{
+	if (out.size() < points.size())
+		out.resize(points.size());
+
+	// every job only writes the out slots of its own range
+	auto query = [this, &points, range, &out](size_t begin, size_t end) {
+		std::vector<const Entry *> local;
+		for (size_t i = begin; i < end; ++i) {
+			const Entry &p = points[i];
+			std::vector<uint16> &ids = out[i];
+			ids.clear();
+
+			Query(p.x, p.y, range, local);
+			for (auto e : local) {
+				if (std::abs(e->z - p.z) <= range)
+					ids.push_back(e->id);
+			}
+		}
+	};
+
+	if (pool.GetThreadCount() > 0 && points.size() >= min_parallel)
+		pool.ParallelFor(points.size(), 16, query);
+	else
+		query(0, points.size());
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../types.h"
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace EQ {
+	class JobPool;
+
+	/*
+	 * Uniform grid over x/y holding entity ids and a position snapshot. It
+	 * never points at the entities themselves, callers resolve the ids back
+	 * through the entity list so a stale cell cannot dangle.
+	 *
+	 * Queries only read the grid, which is what lets QueryEach split a batch
+	 * across the job pool and still hand back exactly what a serial run would.
+	 */
+	class SpatialGrid
+	{
+	public:
+		struct Entry {
+			uint16 id;
+			float x, y, z;
+		};
+
+		SpatialGrid() : cell_size(200.0f) { }
+
+		void Reset(float size) { cell_size = size; cells.clear(); }
+		void Clear() { cells.clear(); }
+		bool Empty() const { return cells.empty(); }
+
+		void Insert(const Entry &e);
+
+		// entries within range of x and y on each axis (a box, not a circle), in cell order
+		void Query(float x, float y, float range, std::vector<const Entry *> &out) const;
+
+		// ids within range of each point on all three axes, out[i] belongs to points[i]
+		void QueryEach(const std::vector<Entry> &points, float range, JobPool &pool, size_t min_parallel,
+			std::vector<std::vector<uint16>> &out) const;
+
+	private:
+		inline int CellCoord(float v) const { return static_cast<int>(std::floor(v / cell_size)); }
+		inline static uint64 CellKey(int cx, int cy) { return (static_cast<uint64>(static_cast<uint32>(cx)) << 32) | static_cast<uint32>(cy); }
+
+		float cell_size;
+		std::unordered_map<uint64, std::vector<Entry>> cells;
+	};
+}
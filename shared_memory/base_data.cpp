@@ -17,6 +17,7 @@
 */
 
 #include "base_data.h"
+#include "segments.h"
 #include "../common/global_define.h"
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
@@ -35,10 +36,11 @@ void LoadBaseData(SharedDatabase *database, const std::string &prefix) {
 
 	auto Config = EQEmuConfig::get();
 	std::string file_name = Config->SharedMemDir + prefix + std::string("base_data");
-	EQEmu::MemoryMappedFile mmf(file_name, size);
+	EQEmu::MemoryMappedFile mmf(GetSegmentBuildName(file_name), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
 	database->LoadBaseData(ptr, records);
+	PublishSegment(file_name);
 	mutex.Unlock();
 }
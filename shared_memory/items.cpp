@@ -17,12 +17,14 @@
 */
 
 #include "items.h"
+#include "segments.h"
 #include "../common/global_define.h"
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
 #include "../common/eqemu_exception.h"
 #include "../common/item_data.h"
+#include "../common/item_hot_table.h"
 
 void LoadItems(SharedDatabase *database, const std::string &prefix) {
 	EQEmu::IPCMutex mutex("items");
@@ -35,14 +37,17 @@ void LoadItems(SharedDatabase *database, const std::string &prefix) {
 		EQ_EXCEPT("Shared Memory", "Unable to get any items from the database.");
 	}
 
-	uint32 size = static_cast<uint32>(EQEmu::FixedMemoryHashSet<EQEmu::ItemData>::estimated_size(items, max_item));
+	// hash set followed by the hot field table
+	uint32 size = static_cast<uint32>(EQEmu::FixedMemoryHashSet<EQEmu::ItemData>::estimated_size(items, max_item) +
+		EQEmu::ItemHotTable::estimated_size(items));
 
 	auto Config = EQEmuConfig::get();
 	std::string file_name = Config->SharedMemDir + prefix + std::string("items");
-	EQEmu::MemoryMappedFile mmf(file_name, size);
+	EQEmu::MemoryMappedFile mmf(GetSegmentBuildName(file_name), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
 	database->LoadItems(ptr, size, items, max_item);
+	PublishSegment(file_name);
 	mutex.Unlock();
 }
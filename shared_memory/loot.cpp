@@ -17,6 +17,7 @@
 */
 
 #include "loot.h"
+#include "segments.h"
 #include "../common/global_define.h"
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
@@ -42,14 +43,15 @@ void LoadLoot(SharedDatabase *database, const std::string &prefix) {
 	uint32 loot_drop_size = (3 * sizeof(uint32)) +					//header
 		((loot_drop_max + 1) * sizeof(uint32)) +					//offset list
 		(loot_drop_count * sizeof(LootDrop_Struct)) +				//loot table headers
-		(loot_drop_entries_count * sizeof(LootDropEntries_Struct));	//number of loot table entries
+		(loot_drop_entries_count * sizeof(LootDropEntries_Struct)) +	//number of loot table entries
+		((loot_drop_count + loot_drop_entries_count) * 2 * sizeof(LootDropAlias_Struct));	//alias tables, two per drop
 
 	auto Config = EQEmuConfig::get();
 	std::string file_name_lt = Config->SharedMemDir + prefix + std::string("loot_table");
 	std::string file_name_ld = Config->SharedMemDir + prefix + std::string("loot_drop");
 
-	EQEmu::MemoryMappedFile mmf_loot_table(file_name_lt, loot_table_size);
-	EQEmu::MemoryMappedFile mmf_loot_drop(file_name_ld, loot_drop_size);
+	EQEmu::MemoryMappedFile mmf_loot_table(GetSegmentBuildName(file_name_lt), loot_table_size);
+	EQEmu::MemoryMappedFile mmf_loot_drop(GetSegmentBuildName(file_name_ld), loot_drop_size);
 	mmf_loot_table.ZeroFile();
 	mmf_loot_drop.ZeroFile();
 
@@ -61,5 +63,7 @@ void LoadLoot(SharedDatabase *database, const std::string &prefix) {
 
 	database->LoadLootTables(mmf_loot_table.Get(), loot_table_max);
 	database->LoadLootDrops(mmf_loot_drop.Get(), loot_drop_max);
+	PublishSegment(file_name_lt);
+	PublishSegment(file_name_ld);
 	mutex.Unlock();
 }
@@ -29,10 +29,26 @@
 #include "../common/string_util.h"
 #include "items.h"
 #include "npc_faction.h"
+#include "npc_types.h"
 #include "loot.h"
 #include "skill_caps.h"
 #include "spells.h"
 #include "base_data.h"
+#include "segments.h"
+#include "../common/item_data.h"
+#include "../common/item_hot_table.h"
+#include "../common/faction.h"
+#include "../common/npc_type_table.h"
+#include "../common/loottable.h"
+#include "../common/spdat.h"
+#include "../common/base_data.h"
+#include "../common/classes.h"
+#include "../common/features.h"
+
+#include <chrono>
+#include <initializer_list>
+#include <thread>
+#include <vector>
 
 EQEmuLogSys LogSys;
 
@@ -69,6 +85,68 @@ inline bool MakeDirectory(const std::string &directory_name)
 	return false;
 }
 
+struct SharedMemorySegment {
+	const char *name;
+	const char *description;
+	void (*load)(SharedDatabase *database, const std::string &prefix);
+	bool selected;
+	std::vector<std::string> files;
+	std::vector<std::string> tables;
+	std::vector<std::string> variables;
+	std::string layout;
+
+	// results, filled in by BuildSegment
+	std::string error;
+	bool skipped;
+	uint32 elapsed_ms;
+};
+
+// struct sizes are part of a segment's signature so a source change to them forces a rebuild
+static std::string Layout(std::initializer_list<size_t> sizes)
+{
+	std::string layout;
+	for(auto size : sizes) {
+		if(!layout.empty()) {
+			layout += ":";
+		}
+		layout += std::to_string(size);
+	}
+	return layout;
+}
+
+static void BuildSegment(SharedMemorySegment *segment, std::string prefix, bool force)
+{
+	auto start = std::chrono::steady_clock::now();
+	auto Config = EQEmuConfig::get();
+	std::string signature_file = Config->SharedMemDir + prefix + segment->name + ".signature";
+
+	{
+		SharedDatabase database;
+		if(!database.Connect(Config->DatabaseHost.c_str(), Config->DatabaseUsername.c_str(),
+			Config->DatabasePassword.c_str(), Config->DatabaseDB.c_str(), Config->DatabasePort)) {
+			segment->error = "Unable to connect to the database";
+		} else {
+			database.LoadVariables();
+			std::string signature = GetSegmentSignature(&database, segment->tables, segment->variables, segment->layout);
+			if(!force && IsSegmentCurrent(signature_file, segment->files, signature)) {
+				segment->skipped = true;
+			} else {
+				try {
+					RemoveSegmentSignature(signature_file);
+					segment->load(&database, prefix);
+					WriteSegmentSignature(signature_file, signature);
+				} catch(std::exception &ex) {
+					segment->error = ex.what();
+				}
+			}
+		}
+	}
+
+	mysql_thread_end();
+	segment->elapsed_ms = static_cast<uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - start).count());
+}
+
 int main(int argc, char **argv) {
 	RegisterExecutablePlatform(ExePlatformSharedMemory);
 	LogSys.LoadLogSettingsDefaults();
@@ -113,9 +191,11 @@ int main(int argc, char **argv) {
 	}
 
 	std::string hotfix_name = "";
+	bool force = false;
 	bool load_all = true;
 	bool load_items = false;
 	bool load_factions = false;
+	bool load_npc_types = false;
 	bool load_loot = false;
 	bool load_skill_caps = false;
 	bool load_spells = false;
@@ -144,6 +224,13 @@ int main(int argc, char **argv) {
 				}
 				break;
 	
+			case 'n':
+				if(strcasecmp("npc_types", argv[i]) == 0) {
+					load_npc_types = true;
+					load_all = false;
+				}
+				break;
+
 			case 'l':
 				if(strcasecmp("loot", argv[i]) == 0) {
 					load_loot = true;
@@ -161,6 +248,11 @@ int main(int argc, char **argv) {
 				}
 				break;
 			case '-': {
+				if(strcasecmp("-force", argv[i]) == 0) {
+					force = true;
+					break;
+				}
+
 				auto split = SplitString(argv[i], '=');
 				if(split.size() >= 2) {
 					auto command = split[0];
@@ -179,67 +271,67 @@ int main(int argc, char **argv) {
 	if(hotfix_name.length() > 0) {
 		Log(Logs::General, Logs::Status, "Writing data for hotfix '%s'", hotfix_name.c_str());
 	}
-	
-	if(load_all || load_items) {
-		Log(Logs::General, Logs::Status, "Loading items...");
-		try {
-			LoadItems(&database, hotfix_name);
-		} catch(std::exception &ex) {
-			Log(Logs::General, Logs::Error, "%s", ex.what());
-			return 1;
-		}
-	}
-	
-	if(load_all || load_factions) {
-		Log(Logs::General, Logs::Status, "Loading factions...");
-		try {
-			LoadFactions(&database, hotfix_name);
-		} catch(std::exception &ex) {
-			Log(Logs::General, Logs::Error, "%s", ex.what());
-			return 1;
-		}
-	}
-	
-	if(load_all || load_loot) {
-		Log(Logs::General, Logs::Status, "Loading loot...");
-		try {
-			LoadLoot(&database, hotfix_name);
-		} catch(std::exception &ex) {
-			Log(Logs::General, Logs::Error, "%s", ex.what());
-			return 1;
+
+	std::string file_prefix = Config->SharedMemDir + hotfix_name;
+	std::vector<SharedMemorySegment> segments = {
+		{ "items", "items", LoadItems, load_all || load_items,
+			{ file_prefix + "items" }, { "items" }, { "disablenorent", "disablenodrop", "disablelore", "disablenotransfer" },
+			Layout({ sizeof(EQEmu::ItemData), sizeof(EQEmu::ItemHotStats), sizeof(EQEmu::ItemHotFlags) }) },
+		{ "factions", "factions", LoadFactions, load_all || load_factions,
+			{ file_prefix + "faction" }, { "npc_faction", "npc_faction_entries" }, { },
+			Layout({ sizeof(NPCFactionList) }) },
+		{ "npc_types", "npc types", LoadNPCTypes, load_all || load_npc_types,
+			{ file_prefix + "npc_types" }, { "npc_types", "npc_types_tint" }, { },
+			Layout({ sizeof(EQEmu::NPCTypeRecord) }) },
+		{ "loot", "loot", LoadLoot, load_all || load_loot,
+			{ file_prefix + "loot_table", file_prefix + "loot_drop" }, { "loottable", "loottable_entries", "lootdrop", "lootdrop_entries" }, { },
+			Layout({ sizeof(LootTable_Struct), sizeof(LootTableEntries_Struct), sizeof(LootDrop_Struct),
+				sizeof(LootDropEntries_Struct), sizeof(LootDropAlias_Struct) }) },
+		{ "skill_caps", "skill caps", LoadSkillCaps, load_all || load_skill_caps,
+			{ file_prefix + "skill_caps" }, { "skill_caps" }, { },
+			Layout({ PLAYER_CLASS_COUNT, EQEmu::skills::HIGHEST_SKILL + 1, HARD_LEVEL_CAP + 1 }) },
+		{ "spells", "spells", LoadSpells, load_all || load_spells,
+			{ file_prefix + "spells" }, { "spells_new", "damageshieldtypes" }, { },
+			Layout({ sizeof(SPDat_Spell_Struct) }) },
+		{ "base_data", "base data", LoadBaseData, load_all || load_bd,
+			{ file_prefix + "base_data" }, { "base_data" }, { },
+			Layout({ sizeof(BaseDataStruct) }) },
+	};
+
+	/*
+		Every segment is built on its own thread with its own connection, the
+		loaders share nothing but the config and each locks its own IPC mutex.
+	*/
+	std::vector<std::thread> workers;
+	for(auto &segment : segments) {
+		if(!segment.selected) {
+			continue;
 		}
+
+		Log(Logs::General, Logs::Status, "Loading %s...", segment.description);
+		workers.push_back(std::thread(BuildSegment, &segment, hotfix_name, force));
 	}
-	
-	if(load_all || load_skill_caps) {
-		Log(Logs::General, Logs::Status, "Loading skill caps...");
-		try {
-			LoadSkillCaps(&database, hotfix_name);
-		} catch(std::exception &ex) {
-			Log(Logs::General, Logs::Error, "%s", ex.what());
-			return 1;
-		}
+
+	for(auto &worker : workers) {
+		worker.join();
 	}
-	
-	if(load_all || load_spells) {
-		Log(Logs::General, Logs::Status, "Loading spells...");
-		try {
-			LoadSpells(&database, hotfix_name);
-		} catch(std::exception &ex) {
-			Log(Logs::General, Logs::Error, "%s", ex.what());
-			return 1;
+
+	int ret = 0;
+	for(auto &segment : segments) {
+		if(!segment.selected) {
+			continue;
 		}
-	}
-	
-	if(load_all || load_bd) {
-		Log(Logs::General, Logs::Status, "Loading base data...");
-		try {
-			LoadBaseData(&database, hotfix_name);
-		} catch(std::exception &ex) {
-			Log(Logs::General, Logs::Error, "%s", ex.what());
-			return 1;
+
+		if(!segment.error.empty()) {
+			Log(Logs::General, Logs::Error, "Failed to load %s: %s", segment.description, segment.error.c_str());
+			ret = 1;
+		} else if(segment.skipped) {
+			Log(Logs::General, Logs::Status, "Skipped %s, source tables are unchanged", segment.description);
+		} else {
+			Log(Logs::General, Logs::Status, "Loaded %s in %u ms", segment.description, segment.elapsed_ms);
 		}
 	}
-	
+
 	LogSys.CloseFileLogs();
-	return 0;
+	return ret;
 }
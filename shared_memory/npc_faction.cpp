@@ -17,6 +17,7 @@
 */
 
 #include "npc_faction.h"
+#include "segments.h"
 #include "../common/global_define.h"
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
@@ -36,10 +37,11 @@ void LoadFactions(SharedDatabase *database, const std::string &prefix) {
 
 	auto Config = EQEmuConfig::get();
 	std::string file_name = Config->SharedMemDir + prefix + std::string("faction");
-	EQEmu::MemoryMappedFile mmf(file_name, size);
+	EQEmu::MemoryMappedFile mmf(GetSegmentBuildName(file_name), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
 	database->LoadNPCFactionLists(ptr, size, lists, max_list);
+	PublishSegment(file_name);
 	mutex.Unlock();
 }
@@ -0,0 +1,56 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "npc_types.h"
+#include "segments.h"
+#include "../common/global_define.h"
+#include "../common/shareddb.h"
+#include "../common/ipc_mutex.h"
+#include "../common/memory_mapped_file.h"
+#include "../common/eqemu_exception.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/npc_type_table.h"
+
+#include <string.h>
+
+void LoadNPCTypes(SharedDatabase *database, const std::string &prefix) {
+	EQEmu::IPCMutex mutex("npc_types");
+	mutex.Lock();
+
+	EQEmu::NPCTypeTableBuilder builder;
+	database->LoadNPCTypes(builder);
+	if(builder.GetRecordCount() == 0) {
+		EQ_EXCEPT("Shared Memory", "Unable to get any npc types from the database.");
+	}
+
+	std::vector<uint8> table;
+	builder.Write(table);
+
+	auto Config = EQEmuConfig::get();
+	std::string file_name = Config->SharedMemDir + prefix + std::string("npc_types");
+	EQEmu::MemoryMappedFile mmf(GetSegmentBuildName(file_name), static_cast<uint32>(table.size()));
+	mmf.ZeroFile();
+	memcpy(mmf.Get(), &table[0], table.size());
+	PublishSegment(file_name);
+	mutex.Unlock();
+
+	Log(Logs::General, Logs::Status, "Wrote %u npc types in %u KB, %u distinct strings in %u KB (%u KB before interning)",
+		static_cast<uint32>(builder.GetRecordCount()), static_cast<uint32>(table.size() / 1024),
+		static_cast<uint32>(builder.GetInternedCount()), static_cast<uint32>(builder.GetStringBytes() / 1024),
+		static_cast<uint32>(builder.GetRawStringBytes() / 1024));
+}
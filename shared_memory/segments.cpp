@@ -0,0 +1,109 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "segments.h"
+#include "../common/global_define.h"
+#include "../common/shareddb.h"
+#include "../common/eqemu_exception.h"
+#include "../common/string_util.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <sys/stat.h>
+
+std::string GetSegmentBuildName(const std::string &file_name) {
+#ifdef _WINDOWS
+	// a mapped file can't be replaced on windows, so it is rewritten in place
+	return file_name;
+#else
+	return file_name + ".new";
+#endif
+}
+
+void PublishSegment(const std::string &file_name) {
+#ifndef _WINDOWS
+	std::string build_name = GetSegmentBuildName(file_name);
+	if(rename(build_name.c_str(), file_name.c_str()) != 0) {
+		EQ_EXCEPT("Shared Memory", "Could not move a finished shared memory segment into place.");
+	}
+#endif
+}
+
+std::string GetSegmentSignature(SharedDatabase *database, const std::vector<std::string> &tables,
+	const std::vector<std::string> &variables, const std::string &layout) {
+	std::vector<std::string> quoted;
+	for(auto &table : tables) {
+		quoted.push_back("`" + table + "`");
+	}
+
+	auto results = database->QueryDatabase("CHECKSUM TABLE " + JoinString(quoted, ", "));
+	if(!results.Success() || results.RowCount() != tables.size()) {
+		return std::string();
+	}
+
+	std::string signature = layout;
+	for(auto row = results.begin(); row != results.end(); ++row) {
+		// a missing table checksums to NULL, which still has to differ from an empty one
+		signature += StringFormat("|%s=%s", row[0], row[1] ? row[1] : "null");
+	}
+
+	for(auto &variable : variables) {
+		std::string value;
+		if(database->GetVariable(variable, value)) {
+			signature += "|" + variable + "=" + value;
+		}
+	}
+
+	return signature;
+}
+
+bool IsSegmentCurrent(const std::string &signature_file, const std::vector<std::string> &files, const std::string &signature) {
+	if(signature.empty()) {
+		return false;
+	}
+
+	for(auto &file : files) {
+		struct stat st;
+		if(stat(file.c_str(), &st) != 0) {
+			return false;
+		}
+	}
+
+	std::ifstream in(signature_file.c_str());
+	if(!in) {
+		return false;
+	}
+
+	std::stringstream stored;
+	stored << in.rdbuf();
+	return stored.str() == signature;
+}
+
+void WriteSegmentSignature(const std::string &signature_file, const std::string &signature) {
+	if(signature.empty()) {
+		return;
+	}
+
+	std::ofstream out(signature_file.c_str(), std::ios::out | std::ios::trunc);
+	out << signature;
+}
+
+void RemoveSegmentSignature(const std::string &signature_file) {
+	remove(signature_file.c_str());
+}
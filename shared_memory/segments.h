@@ -0,0 +1,49 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_SHARED_MEMORY_SEGMENTS_H
+#define __EQEMU_SHARED_MEMORY_SEGMENTS_H
+
+#include <string>
+#include <vector>
+
+class SharedDatabase;
+
+/*
+	Segments are built under a temporary name and renamed over the live file
+	once they are complete. Processes that still have the old file mapped keep
+	the old data until they remap, so a rebuild never changes memory out from
+	under a running zone.
+*/
+std::string GetSegmentBuildName(const std::string &file_name);
+void PublishSegment(const std::string &file_name);
+
+/*
+	Describes the source data of a segment: the checksums of its tables, the
+	values of any variables the loader applies and the layout of the structs
+	it writes. Returns an empty string if the tables could not be checksummed.
+*/
+std::string GetSegmentSignature(SharedDatabase *database, const std::vector<std::string> &tables,
+	const std::vector<std::string> &variables, const std::string &layout);
+
+// true if every file of the segment exists and was built from data with this signature
+bool IsSegmentCurrent(const std::string &signature_file, const std::vector<std::string> &files, const std::string &signature);
+void WriteSegmentSignature(const std::string &signature_file, const std::string &signature);
+void RemoveSegmentSignature(const std::string &signature_file);
+
+#endif
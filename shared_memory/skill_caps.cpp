@@ -17,6 +17,7 @@
 */
 
 #include "skill_caps.h"
+#include "segments.h"
 #include "../common/global_define.h"
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
@@ -36,10 +37,11 @@ void LoadSkillCaps(SharedDatabase *database, const std::string &prefix) {
 
 	auto Config = EQEmuConfig::get();
 	std::string file_name = Config->SharedMemDir + prefix + std::string("skill_caps");
-	EQEmu::MemoryMappedFile mmf(file_name, size);
+	EQEmu::MemoryMappedFile mmf(GetSegmentBuildName(file_name), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
 	database->LoadSkillCaps(ptr);
+	PublishSegment(file_name);
 	mutex.Unlock();
 }
@@ -17,6 +17,7 @@
 */
 
 #include "spells.h"
+#include "segments.h"
 #include "../common/global_define.h"
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
@@ -36,11 +37,12 @@ void LoadSpells(SharedDatabase *database, const std::string &prefix) {
 
 	auto Config = EQEmuConfig::get();
 	std::string file_name = Config->SharedMemDir + prefix + std::string("spells");
-	EQEmu::MemoryMappedFile mmf(file_name, size);
+	EQEmu::MemoryMappedFile mmf(GetSegmentBuildName(file_name), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
 	database->LoadSpells(ptr, records);
+	PublishSegment(file_name);
 	mutex.Unlock();
 }
 
@@ -0,0 +1,105 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_BENCHMARKS_INVENTORY_PROFILE_H
+#define __EQEMU_BENCHMARKS_INVENTORY_PROFILE_H
+
+#include <iostream>
+#include <string.h>
+#include "../../common/inventory_profile.h"
+#include "../../common/item_instance.h"
+#include "../../common/item_data.h"
+#include "../../common/timer.h"
+
+// Fills every worn, general (with full bags) and bank slot of a profile
+inline void FillInventoryProfile(EQEmu::InventoryProfile &inv, EQEmu::ItemData &gear, EQEmu::ItemData &bag) {
+	for (int16 slot_id = EQEmu::legacy::EQUIPMENT_BEGIN; slot_id <= EQEmu::legacy::EQUIPMENT_END; ++slot_id) {
+		gear.ID = 10000 + slot_id;
+		inv.PutItem(slot_id, EQEmu::ItemInstance(&gear));
+	}
+	for (int16 slot_id = EQEmu::legacy::GENERAL_BEGIN; slot_id <= EQEmu::legacy::GENERAL_END; ++slot_id) {
+		inv.PutItem(slot_id, EQEmu::ItemInstance(&bag));
+		for (uint8 bag_idx = 0; bag_idx < 10; ++bag_idx) {
+			gear.ID = 20000 + slot_id * 10 + bag_idx;
+			inv.PutItem(EQEmu::InventoryProfile::CalcSlotId(slot_id, bag_idx), EQEmu::ItemInstance(&gear));
+		}
+	}
+	for (int16 slot_id = EQEmu::legacy::BANK_BEGIN; slot_id <= EQEmu::legacy::BANK_END; ++slot_id) {
+		gear.ID = 30000 + slot_id;
+		inv.PutItem(slot_id, EQEmu::ItemInstance(&gear));
+	}
+}
+
+// HasItem misses on a full character, alone and with another profile being written between
+// lookups (as other clients, loot and merchant instances do in a populated zone), plus a
+// worn slot and augment walk standing in for bonus calculation
+inline void InventoryProfileBenchmark() {
+	EQEmu::ItemData gear;
+	memset(&gear, 0, sizeof(gear));
+	gear.ItemClass = EQEmu::item::ItemClassCommon;
+	EQEmu::ItemData bag;
+	memset(&bag, 0, sizeof(bag));
+	bag.ID = 3001;
+	bag.ItemClass = EQEmu::item::ItemClassBag;
+	bag.BagSlots = 10;
+	bag.BagSize = 4;
+
+	EQEmu::InventoryProfile inv, other;
+	FillInventoryProfile(inv, gear, bag);
+	FillInventoryProfile(other, gear, bag);
+
+	const int iterations = 100000;
+	int found = 0;
+
+	BenchTimer timer;
+	for (int i = 0; i < iterations; ++i) {
+		if (inv.HasItem(50000 + (i % 100)) != INVALID_INDEX)
+			++found;
+	}
+	double has_item_time = timer.elapsed();
+
+	gear.ID = 40000;
+	timer.reset();
+	for (int i = 0; i < iterations; ++i) {
+		other.PutItem(EQEmu::legacy::BANK_BEGIN + (i % 16), EQEmu::ItemInstance(&gear));
+		if (inv.HasItem(50000 + (i % 100)) != INVALID_INDEX)
+			++found;
+	}
+	double churn_time = timer.elapsed();
+
+	uint32 id_sum = 0;
+	timer.reset();
+	for (int i = 0; i < iterations / 100; ++i) {
+		for (int16 slot_id = EQEmu::legacy::EQUIPMENT_BEGIN; slot_id <= EQEmu::legacy::EQUIPMENT_END; ++slot_id) {
+			const EQEmu::ItemInstance *inst = inv.GetItem(slot_id);
+			if (!inst)
+				continue;
+			id_sum += inst->GetID();
+			for (int index = EQEmu::inventory::socketBegin; index < EQEmu::inventory::SocketCount; ++index)
+				id_sum += inst->GetAugmentItemID(index);
+		}
+	}
+	double worn_time = timer.elapsed();
+
+	std::cout << "InventoryProfile: " << iterations << " HasItem misses " << has_item_time << "s, "
+		<< iterations << " with another profile written between " << churn_time << "s, "
+		<< iterations / 100 << " worn walks " << worn_time << "s"
+		<< " (" << found << " found, id sum " << id_sum << ")" << std::endl;
+}
+
+#endif
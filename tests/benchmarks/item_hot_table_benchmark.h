@@ -0,0 +1,88 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_BENCHMARKS_ITEM_HOT_TABLE_H
+#define __EQEMU_BENCHMARKS_ITEM_HOT_TABLE_H
+
+#include <iostream>
+#include <string.h>
+#include <vector>
+#include "../../common/fixed_memory_hash_set.h"
+#include "../../common/item_data.h"
+#include "../../common/item_hot_table.h"
+#include "../../common/timer.h"
+
+/*
+ * Reads the AddItemBonuses fields for a worn set spread through a large
+ * item table, once from the full ItemData and once from the hot rows.
+ */
+inline void ItemHotTableBenchmark() {
+	typedef EQEmu::FixedMemoryHashSet<EQEmu::ItemData> ItemHash;
+	const uint32 count = 50000;
+	const uint32 max_id = count * 3;
+
+	// same layout SharedDatabase::LoadItems writes: hash set, then the hot table behind it
+	size_t hash_size = ItemHash::estimated_size(count, max_id);
+	std::vector<uint8> data(hash_size + EQEmu::ItemHotTable::estimated_size(count), 0);
+	ItemHash hash(&data[0], data.size(), count, max_id);
+	EQEmu::ItemHotTable table(&data[hash_size], data.size() - hash_size, count);
+
+	EQEmu::ItemData item;
+	memset(&item, 0, sizeof(item));
+	for (uint32 i = 0; i < count; ++i) {
+		item.ID = max_id - i * 3;
+		item.AC = item.ID % 50;
+		item.HP = item.ID % 300;
+		item.HeroicStr = item.ID % 7;
+		item.Focus.Effect = item.ID;
+		hash.insert(item.ID, item);
+		table.Set(hash.index_of(item.ID), item);
+	}
+
+	std::vector<uint32> ids;
+	for (uint32 i = 0; i < 4096; ++i)
+		ids.push_back(max_id - ((i * 7919) % count) * 3);
+
+	const int iterations = 200;
+	int64 full_sum = 0;
+	BenchTimer timer;
+	for (int n = 0; n < iterations; ++n) {
+		for (auto id : ids) {
+			const EQEmu::ItemData &item = hash.at(id);
+			full_sum += item.AC + item.HP + item.Mana + item.AStr + item.HeroicStr + item.HeroicSVCorrup +
+				item.Haste + item.Regen + item.Worn.Effect + item.Focus.Effect + item.FactionMod1 + item.SkillModValue;
+		}
+	}
+	double full_time = timer.elapsed();
+
+	int64 hot_sum = 0;
+	timer.reset();
+	for (int n = 0; n < iterations; ++n) {
+		for (auto id : ids) {
+			const EQEmu::ItemHotStats *stats = table.GetStats(hash.index_of(id));
+			hot_sum += stats->AC + stats->HP + stats->Mana + stats->AStr + stats->HeroicStr + stats->HeroicSVCorrup +
+				stats->Haste + stats->Regen + stats->WornEffect + stats->FocusEffect + stats->FactionMod1 + stats->SkillModValue;
+		}
+	}
+	double hot_time = timer.elapsed();
+
+	std::cout << "ItemHotTable: " << iterations * ids.size() << " bonus reads, ItemData " << full_time << "s, hot rows "
+		<< hot_time << "s" << (full_sum == hot_sum ? "" : " (sums differ)") << std::endl;
+}
+
+#endif
@@ -0,0 +1,179 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_INVENTORY_PROFILE_H
+#define __EQEMU_TESTS_INVENTORY_PROFILE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/inventory_profile.h"
+#include <string.h>
+
+class InventoryProfileTest : public Test::Suite {
+	typedef void(InventoryProfileTest::*TestFunction)(void);
+public:
+	InventoryProfileTest() {
+		TEST_ADD(InventoryProfileTest::SlotArrayTest);
+		TEST_ADD(InventoryProfileTest::HasItemTest);
+		TEST_ADD(InventoryProfileTest::HasItemBagChangeTest);
+		TEST_ADD(InventoryProfileTest::SerialScopeTest);
+		TEST_ADD(InventoryProfileTest::JournalTest);
+	}
+
+	~InventoryProfileTest() {
+	}
+
+	private:
+	EQEmu::ItemData MakeItem(uint32 id, uint8 item_class, uint8 bag_slots = 0) {
+		EQEmu::ItemData item;
+		memset(&item, 0, sizeof(item));
+		item.ID = id;
+		item.ItemClass = item_class;
+		item.BagSlots = bag_slots;
+		item.BagSize = 4;
+		return item;
+	}
+
+	void SlotArrayTest() {
+		EQEmu::InventorySlots<int16, 2> slots(0, 21);
+		slots.AddRange(400, 404);
+
+		EQEmu::ItemData data = MakeItem(1001, EQEmu::item::ItemClassCommon);
+		EQEmu::ItemInstance a(&data), b(&data);
+
+		TEST_ASSERT(slots.empty());
+		TEST_ASSERT(slots.begin() == slots.end());
+		TEST_ASSERT(slots.Set(402, &a));
+		TEST_ASSERT(slots.Set(3, &b));
+		TEST_ASSERT(!slots.Set(22, &a));
+		TEST_ASSERT(slots.size() == 2);
+		TEST_ASSERT(slots.Get(402) == &a);
+		TEST_ASSERT(slots.Get(22) == nullptr);
+
+		// ascending slot order, empty slots skipped
+		auto iter = slots.begin();
+		TEST_ASSERT(iter->first == 3 && iter->second == &b);
+		++iter;
+		TEST_ASSERT(iter->first == 402 && iter->second == &a);
+		++iter;
+		TEST_ASSERT(iter == slots.end());
+
+		TEST_ASSERT(slots.Take(3) == &b);
+		TEST_ASSERT(slots.find(3) == slots.end());
+		TEST_ASSERT(slots.size() == 1);
+		slots.clear();
+		TEST_ASSERT(slots.empty());
+	}
+
+	// quantity adds up across stacks of a bucket, the last stack looked at is returned
+	void HasItemTest() {
+		EQEmu::ItemData potion = MakeItem(2001, EQEmu::item::ItemClassCommon);
+		EQEmu::ItemData bag = MakeItem(2002, EQEmu::item::ItemClassBag, 4);
+
+		EQEmu::InventoryProfile inv;
+		inv.PutItem(EQEmu::legacy::GENERAL_BEGIN, EQEmu::ItemInstance(&potion, 5));
+		inv.PutItem(EQEmu::legacy::GENERAL_BEGIN + 1, EQEmu::ItemInstance(&bag));
+		inv.PutItem(EQEmu::InventoryProfile::CalcSlotId(EQEmu::legacy::GENERAL_BEGIN + 1, 2), EQEmu::ItemInstance(&potion, 10));
+		inv.PutItem(EQEmu::legacy::BANK_BEGIN + 3, EQEmu::ItemInstance(&potion, 1));
+
+		TEST_ASSERT(inv.HasItem(2001) == EQEmu::legacy::GENERAL_BEGIN);
+		TEST_ASSERT(inv.HasItem(2001, 12) == EQEmu::InventoryProfile::CalcSlotId(EQEmu::legacy::GENERAL_BEGIN + 1, 2));
+		TEST_ASSERT(inv.HasItem(2001, 20) == INVALID_INDEX);
+		TEST_ASSERT(inv.HasItem(2001, 1, invWhereBank) == EQEmu::legacy::BANK_BEGIN + 3);
+		TEST_ASSERT(inv.HasItem(2002) == EQEmu::legacy::GENERAL_BEGIN + 1);
+		TEST_ASSERT(inv.HasItem(2003) == INVALID_INDEX);
+	}
+
+	// changes made through the bag instance itself have to show up too
+	void HasItemBagChangeTest() {
+		EQEmu::ItemData potion = MakeItem(2001, EQEmu::item::ItemClassCommon);
+		EQEmu::ItemData bag = MakeItem(2002, EQEmu::item::ItemClassBag, 4);
+
+		EQEmu::InventoryProfile inv;
+		inv.PutItem(EQEmu::legacy::GENERAL_BEGIN, EQEmu::ItemInstance(&bag));
+		TEST_ASSERT(inv.HasItem(2001) == INVALID_INDEX);
+
+		EQEmu::ItemInstance *bag_inst = inv.GetItem(EQEmu::legacy::GENERAL_BEGIN);
+		bag_inst->PutItem(1, EQEmu::ItemInstance(&potion, 1));
+		TEST_ASSERT(inv.HasItem(2001) == EQEmu::InventoryProfile::CalcSlotId(EQEmu::legacy::GENERAL_BEGIN, 1));
+
+		bag_inst->DeleteItem(1);
+		TEST_ASSERT(inv.HasItem(2001) == INVALID_INDEX);
+
+		inv.DeleteItem(EQEmu::legacy::GENERAL_BEGIN);
+		TEST_ASSERT(inv.HasItem(2002) == INVALID_INDEX);
+	}
+
+	// only writes under a profile's own buckets move its serial, other profiles and loose items don't
+	void SerialScopeTest() {
+		EQEmu::ItemData potion = MakeItem(2001, EQEmu::item::ItemClassCommon);
+		EQEmu::ItemData bag = MakeItem(2002, EQEmu::item::ItemClassBag, 4);
+
+		EQEmu::InventoryProfile first, second;
+		first.PutItem(EQEmu::legacy::GENERAL_BEGIN, EQEmu::ItemInstance(&bag));
+		second.PutItem(EQEmu::legacy::GENERAL_BEGIN, EQEmu::ItemInstance(&bag));
+		TEST_ASSERT(first.HasItem(2001) == INVALID_INDEX);
+		uint32 serial = first.GetContentsSerial();
+
+		second.PutItem(EQEmu::legacy::GENERAL_BEGIN + 1, EQEmu::ItemInstance(&potion, 1));
+		second.GetItem(EQEmu::legacy::GENERAL_BEGIN)->PutItem(0, EQEmu::ItemInstance(&potion, 1));
+		second.DeleteItem(EQEmu::legacy::GENERAL_BEGIN + 1);
+		EQEmu::ItemInstance loose(&bag);
+		loose.PutItem(0, EQEmu::ItemInstance(&potion, 1));
+		TEST_ASSERT(first.GetContentsSerial() == serial);
+		TEST_ASSERT(first.HasItem(2001) == INVALID_INDEX);
+
+		// swapping within the profile keeps both items linked, a bag write after it still counts
+		first.PutItem(EQEmu::legacy::GENERAL_BEGIN + 1, EQEmu::ItemInstance(&potion, 1));
+		EQEmu::InventoryProfile::SwapItemFailState fail_state;
+		TEST_ASSERT(first.SwapItem(EQEmu::legacy::GENERAL_BEGIN + 1, EQEmu::legacy::GENERAL_BEGIN, fail_state));
+		serial = first.GetContentsSerial();
+		first.GetItem(EQEmu::legacy::GENERAL_BEGIN + 1)->PutItem(2, EQEmu::ItemInstance(&potion, 1));
+		TEST_ASSERT(first.GetContentsSerial() != serial);
+		TEST_ASSERT(first.HasItem(2001, 2) == EQEmu::InventoryProfile::CalcSlotId(EQEmu::legacy::GENERAL_BEGIN + 1, 2));
+
+		// an item taken out no longer counts toward the profile it left
+		EQEmu::ItemInstance *taken = first.PopItem(EQEmu::legacy::GENERAL_BEGIN + 1);
+		serial = first.GetContentsSerial();
+		taken->PutItem(3, EQEmu::ItemInstance(&potion, 1));
+		TEST_ASSERT(first.GetContentsSerial() == serial);
+		delete taken;
+	}
+
+	// cursor slots fold into one cursor flag, tribute is never saved
+	void JournalTest() {
+		EQEmu::InventoryProfile inv;
+		TEST_ASSERT(inv.JournalEmpty());
+
+		inv.JournalSlot(EQEmu::legacy::GENERAL_BEGIN);
+		inv.JournalSlot(EQEmu::legacy::GENERAL_BEGIN);
+		inv.JournalSlot(EQEmu::legacy::SHARED_BANK_BEGIN);
+		inv.JournalSlot(EQEmu::legacy::TRIBUTE_BEGIN);
+		TEST_ASSERT(inv.GetJournalSlots().size() == 2);
+		TEST_ASSERT(!inv.IsCursorJournaled());
+
+		inv.JournalSlot(EQEmu::legacy::CURSOR_BAG_BEGIN);
+		inv.JournalSlot(8001);
+		TEST_ASSERT(inv.GetJournalSlots().size() == 2);
+		TEST_ASSERT(inv.IsCursorJournaled());
+
+		inv.ClearJournal();
+		TEST_ASSERT(inv.JournalEmpty());
+	}
+};
+
+#endif
@@ -0,0 +1,170 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_ITEM_HOT_TABLE_H
+#define __EQEMU_TESTS_ITEM_HOT_TABLE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/fixed_memory_hash_set.h"
+#include "../common/item_data.h"
+#include "../common/item_hot_table.h"
+#include "../common/item_instance.h"
+#include "../common/shareddb.h"
+
+#include <string.h>
+#include <vector>
+
+// takes a hash set and hot table laid out by the test the way LoadItems maps the items file
+class ItemHotTableDatabase : public SharedDatabase {
+public:
+	void MapItems(std::vector<uint8> &data) {
+		items_hash.reset(new EQEmu::FixedMemoryHashSet<EQEmu::ItemData>(&data[0], data.size()));
+		size_t hash_size = EQEmu::FixedMemoryHashSet<EQEmu::ItemData>::estimated_size(static_cast<uint32>(items_hash->max_size()), items_hash->max_key());
+		items_hot_table.reset(new EQEmu::ItemHotTable(&data[hash_size], data.size() - hash_size));
+		items_generation = EQEmu::ItemInstance::SetItemSource(items_hash->data(), items_hash->size());
+	}
+
+	const EQEmu::ItemData &At(uint32 id) { return items_hash->at(id); }
+};
+
+class ItemHotTableTest : public Test::Suite {
+	typedef void(ItemHotTableTest::*TestFunction)(void);
+	typedef EQEmu::FixedMemoryHashSet<EQEmu::ItemData> ItemHash;
+public:
+	ItemHotTableTest() {
+		TEST_ADD(ItemHotTableTest::LayoutTest);
+		TEST_ADD(ItemHotTableTest::VersionTest);
+		TEST_ADD(ItemHotTableTest::InstanceTest);
+	}
+
+	~ItemHotTableTest() {
+	}
+
+	private:
+	EQEmu::ItemData MakeItem(uint32 id) {
+		EQEmu::ItemData item;
+		memset(&item, 0, sizeof(item));
+		item.ID = id;
+		item.AC = id % 50;
+		item.HP = id % 300;
+		item.HeroicStr = id % 7;
+		item.Damage = id % 40;
+		item.Delay = 20 + id % 20;
+		item.ItemType = id % 10;
+		item.LoreGroup = id;
+		item.Focus.Effect = id;
+		return item;
+	}
+
+	// same layout SharedDatabase::LoadItems writes: hash set, then the hot table behind it
+	void Build(std::vector<uint8> &data, uint32 count, uint32 max_id) {
+		size_t hash_size = ItemHash::estimated_size(count, max_id);
+		data.assign(hash_size + EQEmu::ItemHotTable::estimated_size(count), 0);
+
+		ItemHash hash(&data[0], data.size(), count, max_id);
+		EQEmu::ItemHotTable table(&data[hash_size], data.size() - hash_size, count);
+		for (uint32 i = 0; i < count; ++i) {
+			EQEmu::ItemData item = MakeItem(max_id - i * 3);
+			hash.insert(item.ID, item);
+			table.Set(hash.index_of(item.ID), item);
+		}
+	}
+
+	void LayoutTest() {
+		std::vector<uint8> data;
+		Build(data, 100, 1000);
+
+		ItemHash hash(&data[0], data.size());
+		size_t hash_size = ItemHash::estimated_size(static_cast<uint32>(hash.max_size()), hash.max_key());
+		EQEmu::ItemHotTable table(&data[hash_size], data.size() - hash_size);
+		TEST_ASSERT(table.GetCount() == 100);
+
+		const EQEmu::ItemHotStats *stats = table.GetStats(hash.index_of(997));
+		const EQEmu::ItemHotFlags *flags = table.GetFlags(hash.index_of(997));
+		TEST_ASSERT(stats != nullptr && flags != nullptr);
+		TEST_ASSERT(flags->ID == 997);
+		TEST_ASSERT(stats->AC == hash.at(997).AC);
+		TEST_ASSERT(stats->HP == hash.at(997).HP);
+		TEST_ASSERT(stats->HeroicStr == hash.at(997).HeroicStr);
+		TEST_ASSERT(stats->FocusEffect == 997);
+		TEST_ASSERT(flags->Damage == hash.at(997).Damage);
+		TEST_ASSERT(flags->Delay == hash.at(997).Delay);
+		TEST_ASSERT(flags->LoreGroup == 997);
+
+		// ids that were never inserted or are past the hash set have no row
+		TEST_ASSERT(table.GetStats(hash.index_of(998)) == nullptr);
+		TEST_ASSERT(table.GetFlags(hash.index_of(5000)) == nullptr);
+	}
+
+	// an items file from before the table existed has nothing behind the hash set
+	void VersionTest() {
+		std::vector<uint8> data(64, 0);
+		bool thrown = false;
+		try {
+			EQEmu::ItemHotTable table(&data[0], data.size());
+		} catch (std::exception &) {
+			thrown = true;
+		}
+		TEST_ASSERT(thrown);
+	}
+
+	// the same lookup Client::AddItemBonuses does, through instances holding their own copy of the item
+	const EQEmu::ItemHotStats *BonusStats(ItemHotTableDatabase &db, const EQEmu::ItemInstance &inst) {
+		if (inst.GetItem() != inst.GetUnscaledItem())
+			return nullptr;
+		return db.GetItemHotStats(&inst);
+	}
+
+	void InstanceTest() {
+		std::vector<uint8> data;
+		Build(data, 100, 1000);
+		ItemHotTableDatabase db;
+		db.MapItems(data);
+
+		EQEmu::ItemInstance inst(&db.At(997), 1);
+		TEST_ASSERT(inst.GetUnscaledItem() != &db.At(997));
+		const EQEmu::ItemHotStats *stats = BonusStats(db, inst);
+		TEST_ASSERT(stats != nullptr);
+		TEST_ASSERT(stats == db.GetItemHotStats(997));
+		TEST_ASSERT(stats->AC == inst.GetItem()->AC);
+		TEST_ASSERT(stats->HP == inst.GetItem()->HP);
+		TEST_ASSERT(db.GetItemHotFlags(&inst)->ID == 997);
+
+		// copies carry the generation along
+		EQEmu::ItemInstance copy(inst);
+		TEST_ASSERT(BonusStats(db, copy) == stats);
+
+		// item data that never was in the items file has no row even with a matching id
+		EQEmu::ItemData custom = MakeItem(997);
+		custom.AC = 500;
+		EQEmu::ItemInstance custom_inst(&custom, 1);
+		TEST_ASSERT(BonusStats(db, custom_inst) == nullptr);
+
+		// after a reload only instances made from the new file use its rows
+		std::vector<uint8> reloaded;
+		Build(reloaded, 100, 1000);
+		db.MapItems(reloaded);
+		TEST_ASSERT(BonusStats(db, inst) == nullptr);
+		EQEmu::ItemInstance fresh(&db.At(997), 1);
+		TEST_ASSERT(BonusStats(db, fresh) == db.GetItemHotStats(997));
+
+		EQEmu::ItemInstance::SetItemSource(nullptr, 0);
+	}
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_ITEM_SERIALIZATION_CACHE_H
+#define __EQEMU_TESTS_ITEM_SERIALIZATION_CACHE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/eq_packet_structs.h"
+#include "../common/item_instance.h"
+#include "../common/memory_buffer.h"
+#include "../common/rulesys.h"
+#include "../common/patches/item_serialization_cache.h"
+#include <string.h>
+
+// the patch encoders are not in any header, they are only reached through the opcode tables
+namespace Titanium { void SerializeItem(EQEmu::OutBuffer& ob, const EQEmu::ItemInstance *inst, int16 slot_id_in, uint8 depth); }
+namespace SoF { void SerializeItem(EQEmu::OutBuffer& ob, const EQEmu::ItemInstance *inst, int16 slot_id, uint8 depth); }
+namespace SoD { void SerializeItem(EQEmu::OutBuffer& ob, const EQEmu::ItemInstance *inst, int16 slot_id, uint8 depth); }
+namespace UF { void SerializeItem(EQEmu::OutBuffer& ob, const EQEmu::ItemInstance *inst, int16 slot_id, uint8 depth); }
+namespace RoF { void SerializeItem(EQEmu::OutBuffer& ob, const EQEmu::ItemInstance *inst, int16 slot_id, uint8 depth); }
+namespace RoF2 { void SerializeItem(EQEmu::OutBuffer& ob, const EQEmu::ItemInstance *inst, int16 slot_id, uint8 depth, ItemPacketType packet_type); }
+
+class ItemSerializationCacheTest : public Test::Suite {
+	typedef void(ItemSerializationCacheTest::*TestFunction)(void);
+public:
+	ItemSerializationCacheTest() {
+		TEST_ADD(ItemSerializationCacheTest::CachedMatchesUncachedTest);
+	}
+
+	~ItemSerializationCacheTest() {
+	}
+
+	private:
+	enum { ClientCount = 6 };
+
+	void Serialize(const EQEmu::ItemInstance &inst, std::string *out) {
+		EQEmu::OutBuffer ob[ClientCount];
+		Titanium::SerializeItem(ob[0], &inst, 23, 0);
+		SoF::SerializeItem(ob[1], &inst, 23, 0);
+		SoD::SerializeItem(ob[2], &inst, 23, 0);
+		UF::SerializeItem(ob[3], &inst, 23, 0);
+		RoF::SerializeItem(ob[4], &inst, 23, 0);
+		RoF2::SerializeItem(ob[5], &inst, 23, 0, ItemPacketCharInventory);
+		for (int i = 0; i < ClientCount; ++i)
+			out[i] = ob[i].str();
+	}
+
+	// a bag holding two stacks of one item and a weapon, so sub items and per instance fields go through every encoder
+	void CachedMatchesUncachedTest() {
+		EQEmu::ItemData bag, potion, sword;
+		memset(&bag, 0, sizeof(bag));
+		memset(&potion, 0, sizeof(potion));
+		memset(&sword, 0, sizeof(sword));
+		bag.ID = 17005;
+		bag.ItemClass = EQEmu::item::ItemClassBag;
+		bag.BagSlots = 4;
+		bag.BagSize = 3;
+		strcpy(bag.Name, "Backpack");
+		potion.ID = 13003;
+		potion.Stackable = true;
+		potion.StackSize = 20;
+		strcpy(potion.Name, "Potion");
+		sword.ID = 5019;
+		sword.Damage = 8;
+		sword.Delay = 30;
+		strcpy(sword.Name, "Short Sword");
+
+		EQEmu::ItemInstance inst(&bag);
+		inst.PutItem(0, EQEmu::ItemInstance(&potion, 7));
+		inst.PutItem(1, EQEmu::ItemInstance(&potion, 3));
+		inst.PutItem(2, EQEmu::ItemInstance(&sword));
+
+		std::string uncached[ClientCount], first[ClientCount], second[ClientCount];
+
+		RuleManager::Instance()->SetRule("Inventory:ItemSerializationCacheSize", "0");
+		EQEmu::ItemSerializationCache::Clear();
+		Serialize(inst, uncached);
+		TEST_ASSERT(EQEmu::ItemSerializationCache::GetStats().entries == 0);
+
+		RuleManager::Instance()->SetRule("Inventory:ItemSerializationCacheSize", "100");
+		EQEmu::ItemSerializationCache::Clear();
+		Serialize(inst, first);
+		auto stats = EQEmu::ItemSerializationCache::GetStats();
+		TEST_ASSERT(stats.entries == 3 * ClientCount);
+		Serialize(inst, second);
+		stats = EQEmu::ItemSerializationCache::GetStats();
+		TEST_ASSERT(stats.hits > 0);
+
+		for (int i = 0; i < ClientCount; ++i) {
+			TEST_ASSERT(!uncached[i].empty());
+			TEST_ASSERT(first[i] == uncached[i]);
+			TEST_ASSERT(second[i] == uncached[i]);
+		}
+
+		EQEmu::ItemSerializationCache::Clear();
+		RuleManager::Instance()->SetRule("Inventory:ItemSerializationCacheSize", "50000");
+	}
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_JOB_POOL_H
+#define __EQEMU_TESTS_JOB_POOL_H
+
+#include "cppunit/cpptest.h"
+#include "../common/util/job_pool.h"
+
+#include <atomic>
+#include <vector>
+
+class JobPoolTest : public Test::Suite {
+	typedef void(JobPoolTest::*TestFunction)(void);
+public:
+	JobPoolTest() {
+		TEST_ADD(JobPoolTest::InlineTest);
+		TEST_ADD(JobPoolTest::CoverageTest);
+		TEST_ADD(JobPoolTest::ResizeTest);
+	}
+
+	~JobPoolTest() {
+	}
+
+	private:
+	void InlineTest() {
+		EQ::JobPool pool(0);
+		TEST_ASSERT(pool.GetThreadCount() == 0);
+
+		std::vector<int> order;
+		pool.ParallelFor(10, 3, [&order](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+				order.push_back(static_cast<int>(i));
+		});
+
+		TEST_ASSERT(order.size() == 10);
+		for (size_t i = 0; i < order.size(); ++i)
+			TEST_ASSERT(order[i] == static_cast<int>(i));
+	}
+
+	void CoverageTest() {
+		EQ::JobPool pool(4);
+		TEST_ASSERT(pool.GetThreadCount() == 4);
+
+		std::vector<int> seen(10007, 0);
+		std::atomic<size_t> chunks(0);
+		pool.ParallelFor(seen.size(), 16, [&seen, &chunks](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+				++seen[i];
+			++chunks;
+		});
+
+		bool all_once = true;
+		for (auto v : seen) {
+			if (v != 1)
+				all_once = false;
+		}
+
+		TEST_ASSERT(all_once);
+		TEST_ASSERT(chunks.load() == (seen.size() + 15) / 16);
+	}
+
+	void ResizeTest() {
+		EQ::JobPool pool(2);
+		pool.SetThreadCount(6);
+		TEST_ASSERT(pool.GetThreadCount() == 6);
+		pool.SetThreadCount(0);
+		TEST_ASSERT(pool.GetThreadCount() == 0);
+		pool.SetThreadCount(3);
+
+		std::atomic<size_t> total(0);
+		pool.ParallelFor(1000, 10, [&total](size_t begin, size_t end) { total += end - begin; });
+		TEST_ASSERT(total.load() == 1000);
+	}
+};
+
+#endif
@@ -0,0 +1,136 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_LOOT_ALIAS_TABLE_H
+#define __EQEMU_TESTS_LOOT_ALIAS_TABLE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/loot_alias_table.h"
+
+#include <math.h>
+#include <random>
+#include <string.h>
+#include <vector>
+
+class LootAliasTableTest : public Test::Suite {
+	typedef void(LootAliasTableTest::*TestFunction)(void);
+public:
+	LootAliasTableTest() {
+		TEST_ADD(LootAliasTableTest::UnderHundredTest);
+		TEST_ADD(LootAliasTableTest::OverHundredTest);
+		TEST_ADD(LootAliasTableTest::ZeroChanceTest);
+		TEST_ADD(LootAliasTableTest::ManyEntriesTest);
+	}
+
+	~LootAliasTableTest() {
+	}
+
+	private:
+	std::vector<uint8> MakeDrop(const std::vector<float> &chances) {
+		std::vector<uint8> data(EQEmu::LootDropSize(static_cast<uint32>(chances.size())), 0);
+		LootDrop_Struct *ld = reinterpret_cast<LootDrop_Struct*>(&data[0]);
+		ld->NumEntries = static_cast<uint32>(chances.size());
+		for (uint32 i = 0; i < ld->NumEntries; ++i) {
+			ld->Entries[i].item_id = 1000 + i;
+			ld->Entries[i].chance = chances[i];
+		}
+		EQEmu::BuildLootDropAliasTables(ld);
+		return data;
+	}
+
+	// the entry walk AddLootDropToNPC did for every draw before the alias tables
+	uint32 Walk(const LootDrop_Struct *ld, float roll) {
+		for (uint32 j = 0; j < ld->NumEntries; ++j) {
+			if (roll < ld->Entries[j].chance)
+				return j;
+			roll -= ld->Entries[j].chance;
+		}
+		return ld->NumEntries;
+	}
+
+	/*
+	 * Draws the lootdrop a few million times both ways, for the draws past
+	 * mindrop and the mindrop draws, and checks each outcome's share agrees
+	 * to within five standard deviations.
+	 */
+	void Compare(const std::vector<float> &chances) {
+		std::vector<uint8> data = MakeDrop(chances);
+		const LootDrop_Struct *ld = reinterpret_cast<const LootDrop_Struct*>(&data[0]);
+		uint32 bins = ld->NumEntries + 1;
+
+		float roll_t = 0.0f;
+		for (uint32 i = 0; i < ld->NumEntries; ++i)
+			roll_t += ld->Entries[i].chance;
+		float roll_t_min = roll_t;
+		if (roll_t < 100.0f)
+			roll_t = 100.0f;
+
+		const int draws = 2000000;
+		std::mt19937 gen(12345);
+		for (int pass = 0; pass < 2; ++pass) {
+			bool min_draw = pass == 1;
+			float total = min_draw ? roll_t_min : roll_t;
+			const LootDropAlias_Struct *table = min_draw ? EQEmu::GetLootDropMinAlias(ld) : EQEmu::GetLootDropAlias(ld);
+
+			std::vector<int> walked(bins, 0);
+			std::vector<int> aliased(bins, 0);
+			std::uniform_real_distribution<double> walk_roll(0.0, total);
+			std::uniform_real_distribution<double> alias_roll(0.0, bins);
+			for (int n = 0; n < draws; ++n) {
+				++walked[Walk(ld, static_cast<float>(walk_roll(gen)))];
+				++aliased[EQEmu::DrawLootDropAlias(table, bins, alias_roll(gen))];
+			}
+
+			for (uint32 i = 0; i < bins; ++i) {
+				double p = static_cast<double>(walked[i] + aliased[i]) / (2.0 * draws);
+				double sigma = sqrt(2.0 * p * (1.0 - p) / draws);
+				double diff = fabs(static_cast<double>(walked[i] - aliased[i]) / draws);
+				TEST_ASSERT(diff <= 5.0 * sigma + 1e-6);
+			}
+		}
+	}
+
+	void UnderHundredTest() {
+		Compare({ 10.0f, 25.0f, 2.5f, 0.5f, 40.0f });
+	}
+
+	void OverHundredTest() {
+		Compare({ 50.0f, 75.0f, 100.0f, 12.0f });
+	}
+
+	void ZeroChanceTest() {
+		Compare({ 0.0f, 30.0f, 0.0f, 5.0f });
+
+		// nothing can drop at all
+		std::vector<uint8> data = MakeDrop({ 0.0f, 0.0f });
+		const LootDrop_Struct *ld = reinterpret_cast<const LootDrop_Struct*>(&data[0]);
+		for (double roll = 0.0; roll < 3.0; roll += 0.01) {
+			TEST_ASSERT(EQEmu::DrawLootDropAlias(EQEmu::GetLootDropAlias(ld), 3, roll) == 2);
+			TEST_ASSERT(EQEmu::DrawLootDropAlias(EQEmu::GetLootDropMinAlias(ld), 3, roll) == 2);
+		}
+	}
+
+	void ManyEntriesTest() {
+		std::vector<float> chances;
+		for (int i = 0; i < 120; ++i)
+			chances.push_back(static_cast<float>((i * 37) % 11) * 0.25f);
+		Compare(chances);
+	}
+};
+
+#endif
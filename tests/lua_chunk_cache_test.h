@@ -0,0 +1,121 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_LUA_CHUNK_CACHE_H
+#define __EQEMU_TESTS_LUA_CHUNK_CACHE_H
+
+#include "cppunit/cpptest.h"
+#include "../zone/lua_chunk_cache.h"
+
+#ifdef LUA_EQEMU
+#include "lua.hpp"
+#endif
+
+#include <stdio.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+class LuaChunkCacheTest : public Test::Suite {
+	typedef void(LuaChunkCacheTest::*TestFunction)(void);
+public:
+	LuaChunkCacheTest() {
+		TEST_ADD(LuaChunkCacheTest::FormatTest);
+#ifdef LUA_EQEMU
+		TEST_ADD(LuaChunkCacheTest::BytecodeTest);
+#endif
+	}
+
+	~LuaChunkCacheTest() {
+	}
+
+	private:
+	void WriteFile(const std::string &name, const std::string &contents) {
+		std::ofstream out(name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		out << contents;
+	}
+
+	// a cache file is only used for the exact path, mtime and size it was written for
+	void FormatTest() {
+		std::string cache_file = LuaChunkCache::GetCacheFile(".", "quests/zone/npc.lua");
+		std::string code("\x1bLuacode\0more", 13);
+		TEST_ASSERT(LuaChunkCache::Write(cache_file, "quests/zone/npc.lua", 100, 200, code));
+
+		std::string read;
+		TEST_ASSERT(LuaChunkCache::Read(cache_file, "quests/zone/npc.lua", 100, 200, read));
+		TEST_ASSERT(read == code);
+
+		read.clear();
+		TEST_ASSERT(!LuaChunkCache::Read(cache_file, "quests/zone/npc.lua", 101, 200, read));
+		TEST_ASSERT(!LuaChunkCache::Read(cache_file, "quests/zone/npc.lua", 100, 201, read));
+		TEST_ASSERT(!LuaChunkCache::Read(cache_file, "quests/zone/npc2.lua", 100, 200, read));
+		TEST_ASSERT(read.empty());
+
+		// a file cut short by a crash is never handed to the loader
+		std::string whole;
+		{
+			std::ifstream in(cache_file.c_str(), std::ios::in | std::ios::binary);
+			whole.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+		WriteFile(cache_file, whole.substr(0, whole.length() - 4));
+		TEST_ASSERT(!LuaChunkCache::Read(cache_file, "quests/zone/npc.lua", 100, 200, read));
+
+		remove(cache_file.c_str());
+		TEST_ASSERT(!LuaChunkCache::Read(cache_file, "quests/zone/npc.lua", 100, 200, read));
+	}
+
+#ifdef LUA_EQEMU
+	int Run(lua_State *L, const std::string &script, bool &hit) {
+		if(LuaChunkCache::Load(L, script, ".", hit) != 0 || lua_pcall(L, 0, 1, 0) != 0) {
+			lua_pop(L, 1);
+			return -1;
+		}
+
+		int ret = static_cast<int>(lua_tointeger(L, -1));
+		lua_pop(L, 1);
+		return ret;
+	}
+
+	// the second load runs the dumped bytecode, an edited script is compiled again
+	void BytecodeTest() {
+		std::string script = "lua_chunk_cache_test.lua";
+		WriteFile(script, "local t = { 40, 2 }\nreturn t[1] + t[2]\n");
+
+		lua_State *L = luaL_newstate();
+		luaL_openlibs(L);
+
+		bool hit = true;
+		TEST_ASSERT(Run(L, script, hit) == 42);
+		TEST_ASSERT(!hit);
+		TEST_ASSERT(Run(L, script, hit) == 42);
+		TEST_ASSERT(hit);
+
+		WriteFile(script, "local t = { 40, 2, 1 }\nreturn t[1] + t[2] + t[3]\n");
+		TEST_ASSERT(Run(L, script, hit) == 43);
+		TEST_ASSERT(!hit);
+		TEST_ASSERT(Run(L, script, hit) == 43);
+		TEST_ASSERT(hit);
+
+		lua_close(L);
+		remove(LuaChunkCache::GetCacheFile(".", script).c_str());
+		remove(script.c_str());
+	}
+#endif
+};
+
+#endif
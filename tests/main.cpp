@@ -29,9 +29,22 @@
 #include "string_util_test.h"
 #include "data_verification_test.h"
 #include "skills_util_test.h"
+#include "job_pool_test.h"
+#include "spatial_grid_test.h"
+#include "signal_queue_test.h"
+#include "npc_type_index_test.h"
+#include "npc_type_table_test.h"
+#include "inventory_profile_test.h"
+#include "item_hot_table_test.h"
+#include "item_serialization_cache_test.h"
+#include "loot_alias_table_test.h"
+#include "slab_pool_test.h"
+#include "lua_chunk_cache_test.h"
 #include "../common/eqemu_config.h"
+#include "../common/eqemu_logsys.h"
 
 const EQEmuConfig *Config;
+EQEmuLogSys LogSys;
 
 int main() {
 	auto ConfigLoadResult = EQEmuConfig::LoadConfig();
@@ -49,6 +62,17 @@ int main() {
 		tests.add(new StringUtilTest());
 		tests.add(new DataVerificationTest());
 		tests.add(new SkillsUtilsTest());
+		tests.add(new JobPoolTest());
+		tests.add(new SpatialGridTest());
+		tests.add(new SignalQueueTest());
+		tests.add(new NPCTypeIndexTest());
+		tests.add(new NPCTypeTableTest());
+		tests.add(new InventoryProfileTest());
+		tests.add(new ItemHotTableTest());
+		tests.add(new ItemSerializationCacheTest());
+		tests.add(new LootAliasTableTest());
+		tests.add(new SlabPoolTest());
+		tests.add(new LuaChunkCacheTest());
 		tests.run(*output, true);
 	} catch(...) {
 		return -1;
@@ -0,0 +1,127 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_NPC_TYPE_INDEX_H
+#define __EQEMU_TESTS_NPC_TYPE_INDEX_H
+
+#include "cppunit/cpptest.h"
+#include "../common/util/npc_type_index.h"
+
+class NPCTypeIndexTest : public Test::Suite {
+	typedef void(NPCTypeIndexTest::*TestFunction)(void);
+public:
+	NPCTypeIndexTest() {
+		TEST_ADD(NPCTypeIndexTest::SpawnOrderTest);
+		TEST_ADD(NPCTypeIndexTest::DepopTest);
+		TEST_ADD(NPCTypeIndexTest::ReuseTest);
+		TEST_ADD(NPCTypeIndexTest::ChangeTest);
+	}
+
+	~NPCTypeIndexTest() {
+	}
+
+	private:
+	// ids of one type come back in the order they spawned
+	void SpawnOrderTest() {
+		EQ::NPCTypeIndex index;
+		index.Add(1000, 30);
+		index.Add(2000, 31);
+		index.Add(1000, 12);
+		index.Add(1000, 40);
+
+		auto ids = index.Find(1000);
+		TEST_ASSERT(ids != nullptr);
+		TEST_ASSERT(ids->size() == 3);
+		TEST_ASSERT((*ids)[0] == 30 && (*ids)[1] == 12 && (*ids)[2] == 40);
+		TEST_ASSERT(index.Find(2000)->size() == 1);
+		TEST_ASSERT(index.Find(3000) == nullptr);
+	}
+
+	// removing keeps the order of the rest, the last one drops the type, unknown ids are ignored
+	void DepopTest() {
+		EQ::NPCTypeIndex index;
+		index.Add(1000, 1);
+		index.Add(1000, 2);
+		index.Add(1000, 3);
+		index.Add(2000, 4);
+
+		index.Remove(2);
+		auto ids = index.Find(1000);
+		TEST_ASSERT(ids->size() == 2);
+		TEST_ASSERT((*ids)[0] == 1 && (*ids)[1] == 3);
+
+		index.Remove(4);
+		TEST_ASSERT(index.Find(2000) == nullptr);
+		index.Remove(4);
+		index.Remove(99);
+		TEST_ASSERT(index.Size() == 2);
+
+		index.Clear();
+		TEST_ASSERT(index.Find(1000) == nullptr);
+		TEST_ASSERT(index.Size() == 0);
+	}
+
+	// an entity id is only ever listed under the type it was last added with
+	void ReuseTest() {
+		EQ::NPCTypeIndex index;
+		index.Add(1000, 7);
+		index.Remove(7);
+		index.Add(2000, 7);
+		TEST_ASSERT(index.Find(1000) == nullptr);
+		TEST_ASSERT(index.Find(2000)->size() == 1);
+
+		// added again without a removal in between
+		index.Add(3000, 7);
+		TEST_ASSERT(index.Find(2000) == nullptr);
+		TEST_ASSERT(index.Find(3000)->front() == 7);
+		index.Remove(7);
+		TEST_ASSERT(index.Size() == 0);
+		TEST_ASSERT(index.Find(3000) == nullptr);
+	}
+
+	// a spawned npc given a new type id is only found under the new one
+	void ChangeTest() {
+		EQ::NPCTypeIndex index;
+		index.Add(1000, 5);
+		index.Add(1000, 6);
+		index.Add(2000, 8);
+
+		index.Change(5, 2000);
+		TEST_ASSERT(index.Find(1000)->size() == 1);
+		TEST_ASSERT(index.Find(1000)->front() == 6);
+		auto ids = index.Find(2000);
+		TEST_ASSERT(ids->size() == 2);
+		TEST_ASSERT((*ids)[0] == 8 && (*ids)[1] == 5);
+
+		index.Change(6, 3000);
+		TEST_ASSERT(index.Find(1000) == nullptr);
+		TEST_ASSERT(index.Find(3000)->front() == 6);
+
+		// unchanged type and ids that are not spawned are no-ops
+		index.Change(8, 2000);
+		TEST_ASSERT(index.Find(2000)->front() == 8);
+		index.Change(99, 2000);
+		TEST_ASSERT(index.Find(2000)->size() == 2);
+		TEST_ASSERT(index.Size() == 3);
+
+		index.Remove(5);
+		TEST_ASSERT(index.Find(2000)->size() == 1);
+	}
+};
+
+#endif
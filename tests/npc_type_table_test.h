@@ -0,0 +1,100 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_NPC_TYPE_TABLE_H
+#define __EQEMU_TESTS_NPC_TYPE_TABLE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/npc_type_table.h"
+
+#include <string.h>
+#include <vector>
+
+class NPCTypeTableTest : public Test::Suite {
+	typedef void(NPCTypeTableTest::*TestFunction)(void);
+public:
+	NPCTypeTableTest() {
+		TEST_ADD(NPCTypeTableTest::InternTest);
+		TEST_ADD(NPCTypeTableTest::LookupTest);
+	}
+
+	~NPCTypeTableTest() {
+	}
+
+	private:
+	EQEmu::NPCTypeRecord MakeRecord(EQEmu::NPCTypeTableBuilder &builder, uint32 id, const char *name, const char *special) {
+		EQEmu::NPCTypeRecord r;
+		memset(&r, 0, sizeof(r));
+		r.npc_id = id;
+		r.name = builder.Intern(name);
+		r.special_abilities = builder.Intern(special);
+		r.level = static_cast<uint8>(id % 100);
+		return r;
+	}
+
+	void InternTest() {
+		EQEmu::NPCTypeTableBuilder builder;
+		uint32 a = builder.Intern("1,1^2,1");
+		uint32 b = builder.Intern("1,1^2,1");
+		uint32 c = builder.Intern("a_rat");
+
+		TEST_ASSERT(a == b);
+		TEST_ASSERT(a != c);
+		TEST_ASSERT(builder.Intern("") == 0);
+		TEST_ASSERT(builder.Intern(nullptr) == 0);
+		TEST_ASSERT(strcmp(builder.GetString(a), "1,1^2,1") == 0);
+		TEST_ASSERT(strcmp(builder.GetString(0), "") == 0);
+		TEST_ASSERT(builder.GetInternedCount() == 3);
+	}
+
+	// rows come in any order, the first of a duplicate id wins
+	void LookupTest() {
+		EQEmu::NPCTypeTableBuilder builder;
+		builder.Add(MakeRecord(builder, 300, "a_bat", "1,1"));
+		builder.Add(MakeRecord(builder, 10, "a_rat", "1,1"));
+		builder.Add(MakeRecord(builder, 2000, "Fippy_Darkpaw", ""));
+		builder.Add(MakeRecord(builder, 10, "a_duplicate", ""));
+
+		std::vector<uint8> data;
+		builder.Write(data);
+
+		EQEmu::NPCTypeTable table(&data[0], data.size());
+		TEST_ASSERT(table.GetCount() == 3);
+		TEST_ASSERT(table.GetSize() == data.size());
+
+		const EQEmu::NPCTypeRecord *rat = table.Find(10);
+		TEST_ASSERT(rat != nullptr);
+		TEST_ASSERT(strcmp(table.GetString(rat->name), "a_rat") == 0);
+		TEST_ASSERT(strcmp(table.GetString(rat->special_abilities), "1,1") == 0);
+		TEST_ASSERT(rat->level == 10);
+
+		const EQEmu::NPCTypeRecord *bat = table.Find(300);
+		TEST_ASSERT(bat != nullptr);
+		TEST_ASSERT(bat->special_abilities == rat->special_abilities);
+
+		const EQEmu::NPCTypeRecord *fippy = table.Find(2000);
+		TEST_ASSERT(fippy != nullptr);
+		TEST_ASSERT(strcmp(table.GetString(fippy->special_abilities), "") == 0);
+
+		TEST_ASSERT(table.Find(0) == nullptr);
+		TEST_ASSERT(table.Find(11) == nullptr);
+		TEST_ASSERT(table.Find(5000) == nullptr);
+	}
+};
+
+#endif
@@ -0,0 +1,175 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_SIGNAL_QUEUE_H
+#define __EQEMU_TESTS_SIGNAL_QUEUE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/util/signal_queue.h"
+
+#include <vector>
+
+class SignalQueueTest : public Test::Suite {
+	typedef void(SignalQueueTest::*TestFunction)(void);
+public:
+	SignalQueueTest() {
+		TEST_ADD(SignalQueueTest::OrderTest);
+		TEST_ADD(SignalQueueTest::BudgetTest);
+		TEST_ADD(SignalQueueTest::CoalesceTest);
+		TEST_ADD(SignalQueueTest::RemoveTest);
+		TEST_ADD(SignalQueueTest::InlineTest);
+		TEST_ADD(SignalQueueTest::EmptyTickTest);
+	}
+
+	~SignalQueueTest() {
+	}
+
+	private:
+	// signals come out in send order, per target and across targets
+	void OrderTest() {
+		EQ::SignalQueue q;
+		q.Push(10, 1, false);
+		q.Push(20, 1, false);
+		q.Push(10, 2, false);
+		q.Push(10, 1, false);
+
+		std::vector<EQ::SignalQueue::Signal> out;
+		TEST_ASSERT(q.Pop(0, out) == 4);
+		TEST_ASSERT(out[0].target == 10 && out[0].signal_id == 1);
+		TEST_ASSERT(out[1].target == 20 && out[1].signal_id == 1);
+		TEST_ASSERT(out[2].target == 10 && out[2].signal_id == 2);
+		TEST_ASSERT(out[3].target == 10 && out[3].signal_id == 1);
+		TEST_ASSERT(q.Empty());
+	}
+
+	// a fan-out larger than the budget is spread over several pops without reordering
+	void BudgetTest() {
+		EQ::SignalQueue q;
+		for (uint32 i = 0; i < 250; ++i)
+			q.Push(i, 7, true);
+
+		std::vector<EQ::SignalQueue::Signal> out;
+		uint32 next = 0;
+		int pops = 0;
+		while (!q.Empty()) {
+			TEST_ASSERT(q.Pop(100, out) <= 100);
+			for (auto &s : out)
+				TEST_ASSERT(s.target == next++);
+			++pops;
+		}
+
+		TEST_ASSERT(next == 250);
+		TEST_ASSERT(pops == 3);
+	}
+
+	// duplicates only coalesce while the first one is still waiting
+	void CoalesceTest() {
+		EQ::SignalQueue q;
+		TEST_ASSERT(q.Push(5, 1, true));
+		TEST_ASSERT(q.Push(6, 1, true));
+		TEST_ASSERT(!q.Push(5, 1, true));
+		TEST_ASSERT(q.Push(5, 2, true));
+		TEST_ASSERT(q.Push(5, 1, false));
+		TEST_ASSERT(q.Size() == 4);
+
+		std::vector<EQ::SignalQueue::Signal> out;
+		q.Pop(1, out);
+		TEST_ASSERT(out[0].target == 5 && out[0].signal_id == 1);
+		TEST_ASSERT(!q.Push(5, 1, true));
+
+		q.Pop(0, out);
+		TEST_ASSERT(out.size() == 3);
+		TEST_ASSERT(out[0].target == 6);
+		TEST_ASSERT(out[1].target == 5 && out[1].signal_id == 2);
+		TEST_ASSERT(out[2].target == 5 && out[2].signal_id == 1);
+		TEST_ASSERT(q.Push(5, 1, true));
+	}
+
+	void RemoveTest() {
+		EQ::SignalQueue q;
+		q.Push(1, 1, true);
+		q.Push(2, 1, true);
+		q.Push(1, 2, true);
+		q.Push(3, 1, true);
+		q.Remove(1);
+		TEST_ASSERT(q.Size() == 2);
+		TEST_ASSERT(q.Push(1, 1, true));
+
+		std::vector<EQ::SignalQueue::Signal> out;
+		q.Pop(0, out);
+		TEST_ASSERT(out.size() == 3);
+		TEST_ASSERT(out[0].target == 2);
+		TEST_ASSERT(out[1].target == 3);
+		TEST_ASSERT(out[2].target == 1);
+	}
+
+	// inline until the tick's budget is used, then queued, and nothing jumps ahead of a backlog
+	void InlineTest() {
+		EQ::SignalQueue q;
+		std::vector<EQ::SignalQueue::Signal> out;
+		TEST_ASSERT(q.TakeInline(2));
+		TEST_ASSERT(q.TakeInline(2));
+		TEST_ASSERT(!q.TakeInline(2));
+		q.Push(1, 1, false);
+		q.Push(2, 1, false);
+		q.Push(3, 1, false);
+
+		// a new tick hands out the backlog first, it counts against that tick's budget
+		q.BeginTick();
+		TEST_ASSERT(q.Pop(2, out) == 2);
+		TEST_ASSERT(!q.TakeInline(2));
+		q.BeginTick();
+		TEST_ASSERT(q.Pop(2, out) == 1);
+		TEST_ASSERT(out[0].target == 3);
+		TEST_ASSERT(q.TakeInline(2));
+		TEST_ASSERT(!q.TakeInline(2));
+
+		// backlog left over blocks inline delivery even with budget to spare
+		q.Push(4, 1, false);
+		q.Push(5, 1, false);
+		q.Push(6, 1, false);
+		q.BeginTick();
+		q.Pop(2, out);
+		TEST_ASSERT(!q.TakeInline(10));
+		q.BeginTick();
+		q.Pop(0, out);
+		TEST_ASSERT(q.TakeInline(0));
+		TEST_ASSERT(q.TakeInline(0));
+	}
+
+	// ticks with nothing queued still start a fresh budget
+	void EmptyTickTest() {
+		EQ::SignalQueue q;
+		TEST_ASSERT(q.TakeInline(2));
+		TEST_ASSERT(q.TakeInline(2));
+		TEST_ASSERT(!q.TakeInline(2));
+		TEST_ASSERT(q.Empty());
+
+		q.BeginTick();
+		TEST_ASSERT(q.TakeInline(2));
+		TEST_ASSERT(q.TakeInline(2));
+		TEST_ASSERT(!q.TakeInline(2));
+
+		for (int tick = 0; tick < 10; ++tick) {
+			q.BeginTick();
+			TEST_ASSERT(q.TakeInline(2));
+		}
+	}
+};
+
+#endif
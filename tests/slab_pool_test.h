@@ -0,0 +1,142 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_SLAB_POOL_H
+#define __EQEMU_TESTS_SLAB_POOL_H
+
+#include "cppunit/cpptest.h"
+#include "../common/util/slab_pool.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SlabPoolTest : public Test::Suite {
+	typedef void(SlabPoolTest::*TestFunction)(void);
+public:
+	SlabPoolTest() {
+		TEST_ADD(SlabPoolTest::ReuseTest);
+		TEST_ADD(SlabPoolTest::ReleaseTest);
+		TEST_ADD(SlabPoolTest::ThreadTest);
+	}
+
+	~SlabPoolTest() {
+	}
+
+	private:
+	// pools are never destroyed, so every test leaks its own
+	void ReuseTest() {
+		EQ::SlabPool *pool = new EQ::SlabPool("ReuseTest", 40, 16);
+
+		std::vector<void*> blocks;
+		for (int i = 0; i < 10; ++i)
+			blocks.push_back(pool->Allocate(40));
+		for (auto block : blocks)
+			pool->Free(block, 40);
+
+		// the second round comes out of the same slab
+		std::vector<void*> again;
+		for (int i = 0; i < 10; ++i)
+			again.push_back(pool->Allocate(40));
+
+		void *other = pool->Allocate(100);
+		pool->Free(other, 100);
+
+		EQ::SlabPool::Stats s = pool->GetStats();
+		TEST_ASSERT(s.slabs == 1);
+		TEST_ASSERT(s.live == 10);
+		TEST_ASSERT(s.allocs == 20);
+		TEST_ASSERT(s.fallbacks == 1);
+
+		for (auto block : again)
+			pool->Free(block, 40);
+		TEST_ASSERT(pool->GetStats().live == 0);
+	}
+
+	// slabs go back to the heap once everything in them is freed, one empty one is kept
+	void ReleaseTest() {
+		EQ::SlabPool *pool = new EQ::SlabPool("ReleaseTest", 40, 16);
+
+		std::vector<void*> blocks;
+		for (int i = 0; i < 16 * 10; ++i)
+			blocks.push_back(pool->Allocate(40));
+		TEST_ASSERT(pool->GetStats().slabs == 10);
+
+		for (auto block : blocks)
+			pool->Free(block, 40);
+
+		// this thread still holds a short free list, which pins at most one more slab
+		EQ::SlabPool::Stats s = pool->GetStats();
+		TEST_ASSERT(s.live == 0);
+		TEST_ASSERT(s.slabs <= 2);
+		TEST_ASSERT(s.released >= 8);
+		TEST_ASSERT(s.cached < 16);
+	}
+
+	// blocks allocated on one thread and freed on another, free lists handed back at thread exit
+	void ThreadTest() {
+		EQ::SlabPool *pool = new EQ::SlabPool("ThreadTest", 64, 64);
+
+		std::mutex lock;
+		std::vector<void*> handoff;
+		std::vector<std::thread> threads;
+		for (int t = 0; t < 4; ++t) {
+			threads.push_back(std::thread([pool, &lock, &handoff]() {
+				std::vector<void*> mine;
+				for (int n = 0; n < 20000; ++n) {
+					mine.push_back(pool->Allocate(64));
+					if (mine.size() == 50) {
+						std::lock_guard<std::mutex> l(lock);
+						for (size_t i = 0; i < mine.size(); i += 2)
+							handoff.push_back(mine[i]);
+						for (size_t i = 1; i < mine.size(); i += 2)
+							pool->Free(mine[i], 64);
+						mine.clear();
+					}
+
+					void *block = nullptr;
+					{
+						std::lock_guard<std::mutex> l(lock);
+						if (!handoff.empty()) {
+							block = handoff.back();
+							handoff.pop_back();
+						}
+					}
+					if (block)
+						pool->Free(block, 64);
+				}
+				for (auto block : mine)
+					pool->Free(block, 64);
+			}));
+		}
+		for (auto &t : threads)
+			t.join();
+
+		for (auto block : handoff)
+			pool->Free(block, 64);
+
+		EQ::SlabPool::Stats s = pool->GetStats();
+		TEST_ASSERT(s.live == 0);
+		TEST_ASSERT(s.allocs == 80000);
+		TEST_ASSERT(s.frees == 80000);
+		// only this thread's free list is left out of the slabs
+		TEST_ASSERT(s.cached < 64);
+	}
+};
+
+#endif
@@ -0,0 +1,127 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_SPATIAL_GRID_H
+#define __EQEMU_TESTS_SPATIAL_GRID_H
+
+#include "cppunit/cpptest.h"
+#include "../common/util/spatial_grid.h"
+#include "../common/util/job_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class SpatialGridTest : public Test::Suite {
+	typedef void(SpatialGridTest::*TestFunction)(void);
+public:
+	SpatialGridTest() {
+		TEST_ADD(SpatialGridTest::QueryTest);
+		TEST_ADD(SpatialGridTest::DeterminismTest);
+	}
+
+	~SpatialGridTest() {
+	}
+
+	private:
+	// npcs spread over a zone, negative coordinates included, and the clients queued against them
+	void MakeZone(EQ::SpatialGrid &grid, std::vector<EQ::SpatialGrid::Entry> &npcs, std::vector<EQ::SpatialGrid::Entry> &clients) {
+		grid.Reset(200.0f);
+		npcs.clear();
+		for (int i = 0; i < 3000; ++i) {
+			EQ::SpatialGrid::Entry e;
+			e.id = static_cast<uint16>(i + 1);
+			e.x = static_cast<float>((i * 37) % 4000) - 2000.0f;
+			e.y = static_cast<float>((i * 91) % 4000) - 2000.0f;
+			e.z = static_cast<float>((i * 13) % 300) - 150.0f;
+			npcs.push_back(e);
+			grid.Insert(e);
+		}
+
+		clients.clear();
+		for (int i = 0; i < 400; ++i) {
+			EQ::SpatialGrid::Entry e;
+			e.id = static_cast<uint16>(5000 + i);
+			e.x = static_cast<float>((i * 113) % 4000) - 2000.0f;
+			e.y = static_cast<float>((i * 71) % 4000) - 2000.0f;
+			e.z = static_cast<float>((i * 29) % 300) - 150.0f;
+			clients.push_back(e);
+		}
+	}
+
+	// same ids as checking every npc against every client, cell boundaries and negative cells included
+	void QueryTest() {
+		EQ::SpatialGrid grid;
+		std::vector<EQ::SpatialGrid::Entry> npcs, clients;
+		MakeZone(grid, npcs, clients);
+
+		EQ::JobPool pool(0);
+		std::vector<std::vector<uint16>> out;
+		const float range = 175.0f;
+		grid.QueryEach(clients, range, pool, 1, out);
+
+		bool match = true;
+		size_t total = 0;
+		for (size_t i = 0; i < clients.size(); ++i) {
+			std::vector<uint16> expected;
+			for (auto &n : npcs) {
+				if (std::abs(n.x - clients[i].x) <= range && std::abs(n.y - clients[i].y) <= range &&
+					std::abs(n.z - clients[i].z) <= range)
+					expected.push_back(n.id);
+			}
+
+			std::vector<uint16> got = out[i];
+			std::sort(got.begin(), got.end());
+			if (got != expected)
+				match = false;
+			total += got.size();
+		}
+
+		TEST_ASSERT(match);
+		TEST_ASSERT(total > 0);
+	}
+
+	// the aggro broadphase query, split over any number of workers, hands back the serial result in the same order
+	void DeterminismTest() {
+		EQ::SpatialGrid grid;
+		std::vector<EQ::SpatialGrid::Entry> npcs, clients;
+		MakeZone(grid, npcs, clients);
+
+		EQ::JobPool serial(0);
+		std::vector<std::vector<uint16>> expected;
+		grid.QueryEach(clients, 250.0f, serial, 1, expected);
+
+		const size_t thread_counts[] = { 1, 2, 4, 8 };
+		for (auto threads : thread_counts) {
+			EQ::JobPool pool(threads);
+			for (int run = 0; run < 20; ++run) {
+				std::vector<std::vector<uint16>> out;
+				grid.QueryEach(clients, 250.0f, pool, 1, out);
+				TEST_ASSERT(out.size() >= clients.size());
+				bool match = true;
+				for (size_t i = 0; i < clients.size(); ++i) {
+					if (out[i] != expected[i])
+						match = false;
+				}
+				TEST_ASSERT(match);
+			}
+		}
+	}
+};
+
+#endif
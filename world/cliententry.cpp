@@ -113,6 +113,7 @@ ClientListEntry::~ClientListEntry() {
 void ClientListEntry::SetChar(uint32 iCharID, const char* iCharName) {
 	pcharid = iCharID;
 	strn0cpy(pname, iCharName, sizeof(pname));
+	Changed();
 }
 
 void ClientListEntry::SetOnline(ZoneServer* iZS, int8 iOnline) {
@@ -132,6 +133,7 @@ void ClientListEntry::SetOnline(int8 iOnline) {
 		Camp();
 	if (pOnline >= CLE_Status_Online)
 		stale = 0;
+	Changed();
 }
 void ClientListEntry::LSUpdate(ZoneServer* iZS){
 	if(WorldConfig::get()->UpdateStats){
@@ -193,6 +195,7 @@ void ClientListEntry::Update(ZoneServer* iZS, ServerClientList_Struct* scl, int8
 	panon = scl->anon;
 	ptellsoff = scl->tellsoff;
 	pguild_id = scl->guild_id;
+	praid_id = scl->raid_id;
 	pLFG = scl->LFG;
 	gm = scl->gm;
 	pClientVersion = scl->ClientVersion;
@@ -219,6 +222,7 @@ void ClientListEntry::LeavingZone(ZoneServer* iZS, int8 iOnline) {
 	}
 	pzoneserver = 0;
 	pzone = 0;
+	Changed();
 }
 
 void ClientListEntry::ClearVars(bool iAll) {
@@ -245,12 +249,19 @@ void ClientListEntry::ClearVars(bool iAll) {
 	panon = 0;
 	ptellsoff = 0;
 	pguild_id = GUILD_NONE;
+	praid_id = 0;
 	pLFG = 0;
 	gm = 0;
 	pClientVersion = 0;
 	for (auto &elem : tell_queue)
 		safe_delete_array(elem);
 	tell_queue.clear();
+	Changed();
+}
+
+// lets client_list keep its lookup indexes and who list current
+void ClientListEntry::Changed() {
+	client_list.CLEChanged(this);
 }
 
 void ClientListEntry::Camp(ZoneServer* iZS) {
@@ -293,6 +304,7 @@ bool ClientListEntry::CheckAuth(uint32 iLSID, const char* iKey) {
 		if (database.GetVariable("honorlsworldadmin", lsworldadmin))
 			if (atoi(lsworldadmin.c_str()) == 1 && pworldadmin != 0 && (padmin < pworldadmin || padmin == 0))
 				padmin = pworldadmin;
+		Changed();
 		return true;
 	}
 	return false;
@@ -308,6 +320,7 @@ bool ClientListEntry::CheckAuth(uint32 id, const char* iKey, uint32 ip) {
 	if (pIP==ip && strncmp(plskey, iKey,10) == 0){
 		paccountid = id;
 		database.GetAccountFromID(id,paccountname,&padmin);
+		Changed();
 		return true;
 	}
 	return false;
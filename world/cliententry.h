@@ -38,7 +38,7 @@ public:
 	inline int8		Online()		{ return pOnline; }
 	inline const uint32	GetID() const	{ return id; }
 	inline const uint32	GetIP() const	{ return pIP; }
-	inline void			SetIP(const uint32& iIP) { pIP = iIP; }
+	inline void			SetIP(const uint32& iIP) { pIP = iIP; Changed(); }
 	inline void			KeepAlive()		{ stale = 0; }
 	inline uint8			GetStaleCounter() const { return stale; }
 	void	LeavingZone(ZoneServer* iZS = 0, int8 iOnline = CLE_Status_Offline);
@@ -56,11 +56,11 @@ public:
 	inline uint32		AccountID() const		{ return paccountid; }
 	inline const char*	AccountName() const		{ return paccountname; }
 	inline int16		Admin() const			{ return padmin; }
-	inline void			SetAdmin(uint16 iAdmin)	{ padmin = iAdmin; }
+	inline void			SetAdmin(uint16 iAdmin)	{ padmin = iAdmin; Changed(); }
 
 	// Character info
 	inline ZoneServer*	Server() const		{ return pzoneserver; }
-	inline void			ClearServer()		{ pzoneserver = 0; }
+	inline void			ClearServer()		{ pzoneserver = 0; Changed(); }
 	inline uint32		CharID() const		{ return pcharid; }
 	inline const char*	name() const		{ return pname; }
 	inline uint32		zone() const		{ return pzone; }
@@ -71,11 +71,13 @@ public:
 	inline uint8			Anon()				{ return panon; }
 	inline uint8			TellsOff() const	{ return ptellsoff; }
 	inline uint32		GuildID() const	{ return pguild_id; }
-	inline void			SetGuild(uint32 guild_id) { pguild_id = guild_id; }
+	inline void			SetGuild(uint32 guild_id) { pguild_id = guild_id; Changed(); }
+	inline uint32		RaidID() const		{ return praid_id; }
+	inline void			SetRaid(uint32 raid_id) { praid_id = raid_id; Changed(); }
 	inline bool			LFG() const			{ return pLFG; }
 	inline uint8			GetGM() const		{ return gm; }
-	inline void			SetGM(uint8 igm)	{ gm = igm; }
-	inline void			SetZone(uint32 zone) { pzone = zone; }
+	inline void			SetGM(uint8 igm)	{ gm = igm; Changed(); }
+	inline void			SetZone(uint32 zone) { pzone = zone; Changed(); }
 	inline bool	IsLocalClient() const { return plocal; }
 	inline uint8			GetLFGFromLevel() const { return pLFGFromLevel; }
 	inline uint8			GetLFGToLevel() const { return pLFGToLevel; }
@@ -90,6 +92,7 @@ public:
 
 private:
 	void	ClearVars(bool iAll = false);
+	void	Changed();
 
 	const uint32	id;
 	uint32	pIP;
@@ -121,6 +124,7 @@ private:
 	uint8	panon;
 	uint8	ptellsoff;
 	uint32	pguild_id;
+	uint32	praid_id;
 	bool	pLFG;
 	uint8	gm;
 	uint8	pClientVersion;
@@ -33,7 +33,7 @@
 #include "../common/event_sub.h"
 #include "web_interface.h"
 #include "wguild_mgr.h"
-#include <set>
+#include <algorithm>
 
 extern WebInterfaceList web_interface;
 
@@ -51,6 +51,260 @@ ClientList::ClientList()
 ClientList::~ClientList() {
 }
 
+// buckets stay ordered by CLE id so the oldest entry is always found first
+static void IndexInsert(std::vector<ClientListEntry*> &bucket, ClientListEntry* cle) {
+	auto pos = std::upper_bound(bucket.begin(), bucket.end(), cle,
+		[](ClientListEntry* a, ClientListEntry* b) { return a->GetID() < b->GetID(); });
+	bucket.insert(pos, cle);
+}
+
+template<typename K>
+static void IndexErase(std::unordered_map<K, std::vector<ClientListEntry*>> &index, const K &key, ClientListEntry* cle) {
+	auto it = index.find(key);
+	if (it == index.end())
+		return;
+
+	auto pos = std::find(it->second.begin(), it->second.end(), cle);
+	if (pos != it->second.end())
+		it->second.erase(pos);
+	if (it->second.empty())
+		index.erase(it);
+}
+
+static void RouteInsert(std::unordered_map<uint32, std::map<uint32, uint32>> &routes, uint32 key, uint32 zone_server) {
+	routes[key][zone_server]++;
+}
+
+static void RouteErase(std::unordered_map<uint32, std::map<uint32, uint32>> &routes, uint32 key, uint32 zone_server) {
+	auto it = routes.find(key);
+	if (it == routes.end())
+		return;
+
+	auto zs = it->second.find(zone_server);
+	if (zs != it->second.end() && --zs->second == 0)
+		it->second.erase(zs);
+	if (it->second.empty())
+		routes.erase(it);
+}
+
+static std::string CLENameKey(const char* name) {
+	std::string key = name ? name : "";
+	ToLowerString(key);
+	return key;
+}
+
+void ClientList::AddKeys(ClientListEntry* cle, const CLEKeys& keys) {
+	if (!keys.name.empty())
+		IndexInsert(cle_by_name[keys.name], cle);
+	if (keys.account_id)
+		IndexInsert(cle_by_account[keys.account_id], cle);
+	if (keys.char_id)
+		IndexInsert(cle_by_char[keys.char_id], cle);
+	if (keys.ls_id)
+		IndexInsert(cle_by_lsid[keys.ls_id], cle);
+	if (keys.ip)
+		IndexInsert(cle_by_ip[keys.ip], cle);
+	if (keys.zone_server) {
+		if (keys.guild_id != 0 && keys.guild_id != GUILD_NONE)
+			RouteInsert(guild_routes, keys.guild_id, keys.zone_server);
+		if (keys.raid_id)
+			RouteInsert(raid_routes, keys.raid_id, keys.zone_server);
+	}
+}
+
+void ClientList::RemoveKeys(ClientListEntry* cle, const CLEKeys& keys) {
+	if (!keys.name.empty())
+		IndexErase(cle_by_name, keys.name, cle);
+	if (keys.account_id)
+		IndexErase(cle_by_account, keys.account_id, cle);
+	if (keys.char_id)
+		IndexErase(cle_by_char, keys.char_id, cle);
+	if (keys.ls_id)
+		IndexErase(cle_by_lsid, keys.ls_id, cle);
+	if (keys.ip)
+		IndexErase(cle_by_ip, keys.ip, cle);
+	if (keys.zone_server) {
+		if (keys.guild_id != 0 && keys.guild_id != GUILD_NONE)
+			RouteErase(guild_routes, keys.guild_id, keys.zone_server);
+		if (keys.raid_id)
+			RouteErase(raid_routes, keys.raid_id, keys.zone_server);
+	}
+}
+
+ClientList::CLEKeys ClientList::GetCLEKeys(ClientListEntry* cle) {
+	CLEKeys keys;
+	keys.name = CLENameKey(cle->name());
+	keys.account_id = cle->AccountID();
+	keys.char_id = cle->CharID();
+	keys.ls_id = cle->LSID();
+	keys.ip = cle->GetIP();
+	keys.zone_server = cle->Server() ? cle->Server()->GetID() : 0;
+	keys.guild_id = cle->GuildID();
+	keys.raid_id = cle->RaidID();
+	return keys;
+}
+
+void ClientList::AddCLE(ClientListEntry* cle, bool append) {
+	if (append)
+		clientlist.Append(cle);
+	else
+		clientlist.Insert(cle);
+
+	IndexCLE(cle);
+}
+
+// removing from the list deletes the entry, which unindexes it through RemoveCLEReferances
+void ClientList::RemoveCLE(ClientListEntry* cle) {
+	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+
+	iterator.Reset();
+	while(iterator.MoreElements()) {
+		if (iterator.GetData() == cle) {
+			iterator.RemoveCurrent();
+			return;
+		}
+		iterator.Advance();
+	}
+}
+
+void ClientList::IndexCLE(ClientListEntry* cle) {
+	CLEKeys keys = GetCLEKeys(cle);
+
+	cle_by_id[cle->GetID()] = cle;
+	AddKeys(cle, keys);
+	cle_keys[cle] = keys;
+	who_dirty.insert(cle);
+}
+
+void ClientList::UnindexCLE(ClientListEntry* cle) {
+	auto keys = cle_keys.find(cle);
+	if (keys == cle_keys.end())
+		return;
+
+	RemoveKeys(cle, keys->second);
+	cle_keys.erase(keys);
+	cle_by_id.erase(cle->GetID());
+	who_dirty.erase(cle);
+	RemoveWhoEntry(cle);
+}
+
+void ClientList::CLEChanged(ClientListEntry* cle) {
+	auto keys = cle_keys.find(cle);
+	if (keys == cle_keys.end())
+		return;
+
+	CLEKeys now = GetCLEKeys(cle);
+
+	CLEKeys &was = keys->second;
+	if (now.name != was.name || now.account_id != was.account_id || now.char_id != was.char_id ||
+		now.ls_id != was.ls_id || now.ip != was.ip || now.zone_server != was.zone_server ||
+		now.guild_id != was.guild_id || now.raid_id != was.raid_id) {
+		RemoveKeys(cle, was);
+		AddKeys(cle, now);
+		was = now;
+	}
+
+	who_dirty.insert(cle);
+}
+
+/*
+ * Entries filed under key, oldest first. 0 means unset and is never indexed,
+ * so asking for it falls back to walking the list like the lookups used to.
+ */
+template<typename F>
+void ClientList::GetIndexedCLEs(const CLEIndex& index, uint32 key, F field, std::vector<ClientListEntry*>& out) {
+	out.clear();
+	if (key != 0) {
+		auto it = index.find(key);
+		if (it != index.end())
+			out = it->second;
+		return;
+	}
+
+	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+	iterator.Reset();
+	while(iterator.MoreElements()) {
+		if (field(iterator.GetData()) == 0)
+			IndexInsert(out, iterator.GetData());
+		iterator.Advance();
+	}
+}
+
+void ClientList::RemoveWhoEntry(ClientListEntry* cle) {
+	auto slot = who_slot.find(cle);
+	if (slot == who_slot.end())
+		return;
+
+	size_t index = slot->second;
+	who_slot.erase(slot);
+	if (index != who_list.size() - 1) {
+		who_list[index] = std::move(who_list.back());
+		who_slot[who_list[index].cle] = index;
+	}
+	who_list.pop_back();
+}
+
+void ClientList::UpdateWhoList() {
+	for (auto cle : who_dirty) {
+		if (cle->Online() < CLE_Status_Zoning) {
+			RemoveWhoEntry(cle);
+			continue;
+		}
+
+		auto slot = who_slot.find(cle);
+		if (slot == who_slot.end()) {
+			slot = who_slot.insert(std::make_pair(cle, who_list.size())).first;
+			who_list.push_back(WhoEntry());
+		}
+
+		WhoEntry &e = who_list[slot->second];
+		e.cle = cle;
+		e.name = cle->name();
+		e.account_name = cle->AccountName();
+		e.zone = cle->zone();
+		e.zone_name = database.GetZoneName(e.zone);
+		e.guild_id = cle->GuildID();
+		e.admin = cle->Admin();
+		e.race = cle->race();
+		e.level = cle->level();
+		e.class_ = cle->class_();
+		e.anon = cle->Anon();
+		e.gm = cle->GetGM();
+	}
+	who_dirty.clear();
+}
+
+const ClientList::WhoEntry* ClientList::FindWhoEntry(const char* name) {
+	ClientListEntry* cle = FindCharacter(name);
+	if (!cle)
+		return nullptr;
+
+	auto slot = who_slot.find(cle);
+	if (slot == who_slot.end())
+		return nullptr;
+
+	return &who_list[slot->second];
+}
+
+bool ClientList::WhoAllMatches(const WhoEntry& e, int16 admin, Who_All_Struct* whom, int whomlen) {
+	if (e.gm && e.anon == 1 && admin < e.admin)
+		return false;
+
+	if (whom == 0)
+		return true;
+
+	return ((e.admin >= 80 && e.gm) || whom->gmlookup == 0xFFFF) &&
+		(whom->lvllow == 0xFFFF || (e.level >= whom->lvllow && e.level <= whom->lvlhigh && (e.anon == 0 || admin > e.admin))) &&
+		(whom->wclass == 0xFFFF || (e.class_ == whom->wclass && (e.anon == 0 || admin > e.admin))) &&
+		(whom->wrace == 0xFFFF || (e.race == whom->wrace && (e.anon == 0 || admin > e.admin))) &&
+		(whomlen == 0 || (
+			(e.zone_name != 0 && strncasecmp(e.zone_name, whom->whom, whomlen) == 0) ||
+			strncasecmp(e.name.c_str(), whom->whom, whomlen) == 0 ||
+			(strncasecmp(guild_mgr.GetGuildName(e.guild_id), whom->whom, whomlen) == 0) ||
+			(admin >= 100 && strncasecmp(e.account_name.c_str(), whom->whom, whomlen) == 0)
+		));
+}
+
 void ClientList::Process() {
 
 	if (CLStale_timer.Check())
@@ -87,15 +341,9 @@ void ClientList::CLERemoveZSRef(ZoneServer* iZS) {
 }
 
 ClientListEntry* ClientList::GetCLE(uint32 iID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->GetID() == iID) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
-	}
+	auto it = cle_by_id.find(iID);
+	if (it != cle_by_id.end())
+		return it->second;
 	return 0;
 }
 
@@ -104,15 +352,15 @@ void ClientList::EnforceSessionLimit(uint32 iLSAccountID) {
 
 	ClientListEntry* ClientEntry = 0;
 
-	LinkedListIterator<ClientListEntry*> iterator(clientlist, BACKWARD);
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_lsid, iLSAccountID, [](ClientListEntry* cle) { return cle->LSID(); }, entries);
 
 	int CharacterCount = 0;
 
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
+	// newest first, the same order the list used to be walked in
+	for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
 
-		ClientEntry = iterator.GetData();
+		ClientEntry = *it;
 
 		if ((ClientEntry->LSAccountID() == iLSAccountID) &&
 			((ClientEntry->Admin() <= (RuleI(World, ExemptAccountLimitStatus))) || (RuleI(World, ExemptAccountLimitStatus) < 0))) {
@@ -135,12 +383,9 @@ void ClientList::EnforceSessionLimit(uint32 iLSAccountID) {
 
 				ClientEntry->SetOnline(CLE_Status_Offline);
 
-				iterator.RemoveCurrent();
-
-				continue;
+				RemoveCLE(ClientEntry);
 			}
 		}
-		iterator.Advance();
 	}
 }
 
@@ -149,13 +394,13 @@ void ClientList::EnforceSessionLimit(uint32 iLSAccountID) {
 
 void ClientList::GetCLEIP(uint32 iIP) {
 	ClientListEntry* countCLEIPs = 0;
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_ip, iIP, [](ClientListEntry* cle) { return cle->GetIP(); }, entries);
 
 	int IPInstances = 0;
-	iterator.Reset();
 
-	while(iterator.MoreElements()) {
-		countCLEIPs = iterator.GetData();		
+	for (auto entry : entries) {
+		countCLEIPs = entry;
 		if ((countCLEIPs->GetIP() == iIP) && ((countCLEIPs->Admin() < (RuleI(World, ExemptMaxClientsStatus))) || (RuleI(World, ExemptMaxClientsStatus) < 0))) { // If the IP matches, and the connection admin status is below the exempt status, or exempt status is less than 0 (no-one is exempt)
 			IPInstances++; // Increment the occurences of this IP address
 			Log(Logs::General, Logs::Client_Login, "Account ID: %i Account Name: %s IP: %s.", countCLEIPs->LSID(), countCLEIPs->LSName(), long2ip(countCLEIPs->GetIP()).c_str());
@@ -169,7 +414,7 @@ void ClientList::GetCLEIP(uint32 iIP) {
 					} else {
 						Log(Logs::General, Logs::Client_Login, "Disconnect: Account %s on IP %s.", countCLEIPs->LSName(), long2ip(countCLEIPs->GetIP()).c_str());
 						countCLEIPs->SetOnline(CLE_Status_Offline);
-						iterator.RemoveCurrent();
+						RemoveCLE(countCLEIPs);
 						continue;
 					}
 				}
@@ -185,7 +430,7 @@ void ClientList::GetCLEIP(uint32 iIP) {
 							} else {
 								Log(Logs::General, Logs::Client_Login, "Disconnect: Account %s on IP %s.", countCLEIPs->LSName(), long2ip(countCLEIPs->GetIP()).c_str());
 								countCLEIPs->SetOnline(CLE_Status_Offline); // Remove the connection
-								iterator.RemoveCurrent();
+								RemoveCLE(countCLEIPs);
 								continue;
 							}
 						}
@@ -197,7 +442,7 @@ void ClientList::GetCLEIP(uint32 iIP) {
 						} else {
 							Log(Logs::General, Logs::Client_Login, "Disconnect: Account %s on IP %s.", countCLEIPs->LSName(), long2ip(countCLEIPs->GetIP()).c_str());
 							countCLEIPs->SetOnline(CLE_Status_Offline); // Remove the connection
-							iterator.RemoveCurrent();
+							RemoveCLE(countCLEIPs);
 							continue;
 						}
 					} else if (IPInstances > RuleI(World, AddMaxClientsPerIP)) { // else they are eligible for the higher limit, but if they exceed that	
@@ -208,66 +453,64 @@ void ClientList::GetCLEIP(uint32 iIP) {
 						} else {
 							Log(Logs::General, Logs::Client_Login, "Disconnect: Account %s on IP %s.", countCLEIPs->LSName(), long2ip(countCLEIPs->GetIP()).c_str());
 							countCLEIPs->SetOnline(CLE_Status_Offline); // Remove the connection
-							iterator.RemoveCurrent();
+							RemoveCLE(countCLEIPs);
 							continue;
 						}
 					}
 				}
 			}
 		}
-		iterator.Advance();
 	}
 }
 
 uint32 ClientList::GetCLEIPCount(uint32 iIP) {
-	ClientListEntry* countCLEIPs = 0;
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_ip, iIP, [](ClientListEntry* cle) { return cle->GetIP(); }, entries);
 
 	int IPInstances = 0;
-	iterator.Reset();
-
-	while (iterator.MoreElements()) {
-		countCLEIPs = iterator.GetData();
-		if ((countCLEIPs->GetIP() == iIP) && ((countCLEIPs->Admin() < (RuleI(World, ExemptMaxClientsStatus))) || (RuleI(World, ExemptMaxClientsStatus) < 0)) && countCLEIPs->Online() >= CLE_Status_Online) { // If the IP matches, and the connection admin status is below the exempt status, or exempt status is less than 0 (no-one is exempt)
+	for (auto countCLEIPs : entries) {
+		if (((countCLEIPs->Admin() < (RuleI(World, ExemptMaxClientsStatus))) || (RuleI(World, ExemptMaxClientsStatus) < 0)) && countCLEIPs->Online() >= CLE_Status_Online) { // If the connection admin status is below the exempt status, or exempt status is less than 0 (no-one is exempt)
 			IPInstances++; // Increment the occurences of this IP address
 		}
-		iterator.Advance();
 	}
 
 	return IPInstances;
 }
 
 void ClientList::DisconnectByIP(uint32 iIP) {
-	ClientListEntry* countCLEIPs = 0;
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-		countCLEIPs = iterator.GetData();
-		if ((countCLEIPs->GetIP() == iIP)) {
-			if(strlen(countCLEIPs->name())) {
-				auto pack = new ServerPacket(ServerOP_KickPlayer, sizeof(ServerKickPlayer_Struct));
-				ServerKickPlayer_Struct* skp = (ServerKickPlayer_Struct*) pack->pBuffer;
-				strcpy(skp->adminname, "SessionLimit");
-				strcpy(skp->name, countCLEIPs->name());
-				skp->adminrank = 255;
-				zoneserver_list.SendPacket(pack);
-				safe_delete(pack);
-			}
-			countCLEIPs->SetOnline(CLE_Status_Offline);
-			iterator.RemoveCurrent();
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_ip, iIP, [](ClientListEntry* cle) { return cle->GetIP(); }, entries);
+
+	for (auto countCLEIPs : entries) {
+		if(strlen(countCLEIPs->name())) {
+			auto pack = new ServerPacket(ServerOP_KickPlayer, sizeof(ServerKickPlayer_Struct));
+			ServerKickPlayer_Struct* skp = (ServerKickPlayer_Struct*) pack->pBuffer;
+			strcpy(skp->adminname, "SessionLimit");
+			strcpy(skp->name, countCLEIPs->name());
+			skp->adminrank = 255;
+			zoneserver_list.SendPacket(pack);
+			safe_delete(pack);
 		}
-		iterator.Advance();
+		countCLEIPs->SetOnline(CLE_Status_Offline);
+		RemoveCLE(countCLEIPs);
 	}
 }
 
 ClientListEntry* ClientList::FindCharacter(const char* name) {
+	if (name && name[0]) {
+		auto it = cle_by_name.find(CLENameKey(name));
+		if (it != cle_by_name.end())
+			return it->second.front();
+		return 0;
+	}
+
+	// unnamed entries are not indexed
 	LinkedListIterator<ClientListEntry*> iterator(clientlist);
 
 	iterator.Reset();
 	while(iterator.MoreElements())
 	{
-		if (strcasecmp(iterator.GetData()->name(), name) == 0) {
+		if (iterator.GetData()->name()[0] == 0) {
 			return iterator.GetData();
 		}
 		iterator.Advance();
@@ -276,28 +519,18 @@ ClientListEntry* ClientList::FindCharacter(const char* name) {
 }
 
 ClientListEntry* ClientList::FindCLEByAccountID(uint32 iAccID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->AccountID() == iAccID) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
-	}
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_account, iAccID, [](ClientListEntry* cle) { return cle->AccountID(); }, entries);
+	if (!entries.empty())
+		return entries.front();
 	return 0;
 }
 
 ClientListEntry* ClientList::FindCLEByCharacterID(uint32 iCharID) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->CharID() == iCharID) {
-			return iterator.GetData();
-		}
-		iterator.Advance();
-	}
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_char, iCharID, [](ClientListEntry* cle) { return cle->CharID(); }, entries);
+	if (!entries.empty())
+		return entries.front();
 	return 0;
 }
 
@@ -352,7 +585,7 @@ void ClientList::SendCLEList(const int16& admin, const char* to, WorldTCPConnect
 void ClientList::CLEAdd(uint32 iLSID, const char* iLoginName, const char* iLoginKey, int16 iWorldAdmin, uint32 ip, uint8 local) {
 	auto tmp = new ClientListEntry(GetNextCLEID(), iLSID, iLoginName, iLoginKey, iWorldAdmin, ip, local);
 
-	clientlist.Append(tmp);
+	AddCLE(tmp);
 }
 
 void ClientList::CLCheckStale() {
@@ -369,22 +602,16 @@ void ClientList::CLCheckStale() {
 }
 
 void ClientList::ClientUpdate(ZoneServer* zoneserver, ServerClientList_Struct* scl) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	ClientListEntry* cle;
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->GetID() == scl->wid) {
-			cle = iterator.GetData();
-			if (scl->remove == 2){
-				cle->LeavingZone(zoneserver, CLE_Status_Offline);
-			}
-			else if (scl->remove == 1)
-				cle->LeavingZone(zoneserver, CLE_Status_Zoning);
-			else
-				cle->Update(zoneserver, scl);
-			return;
+	ClientListEntry* cle = GetCLE(scl->wid);
+	if (cle) {
+		if (scl->remove == 2){
+			cle->LeavingZone(zoneserver, CLE_Status_Offline);
 		}
-		iterator.Advance();
+		else if (scl->remove == 1)
+			cle->LeavingZone(zoneserver, CLE_Status_Zoning);
+		else
+			cle->Update(zoneserver, scl);
+		return;
 	}
 	if (scl->remove == 2)
 		cle = new ClientListEntry(GetNextCLEID(), zoneserver, scl, CLE_Status_Online);
@@ -392,42 +619,44 @@ void ClientList::ClientUpdate(ZoneServer* zoneserver, ServerClientList_Struct* s
 		cle = new ClientListEntry(GetNextCLEID(), zoneserver, scl, CLE_Status_Zoning);
 	else
 		cle = new ClientListEntry(GetNextCLEID(), zoneserver, scl, CLE_Status_InZone);
-	clientlist.Insert(cle);
+	AddCLE(cle, false);
 	zoneserver->ChangeWID(scl->charid, cle->GetID());
 }
 
 void ClientList::CLEKeepAlive(uint32 numupdates, uint32* wid) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	uint32 i;
-
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		for (i=0; i<numupdates; i++) {
-			if (wid[i] == iterator.GetData()->GetID())
-				iterator.GetData()->KeepAlive();
-		}
-		iterator.Advance();
+	for (uint32 i = 0; i < numupdates; i++) {
+		ClientListEntry* cle = GetCLE(wid[i]);
+		if (cle)
+			cle->KeepAlive();
 	}
 }
 
 
 ClientListEntry* ClientList::CheckAuth(uint32 id, const char* iKey, uint32 ip ) {
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_ip, ip, [](ClientListEntry* cle) { return cle->GetIP(); }, entries);
 
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->CheckAuth(id, iKey, ip))
-			return iterator.GetData();
-		iterator.Advance();
+	for (auto cle : entries) {
+		if (cle->CheckAuth(id, iKey, ip))
+			return cle;
 	}
 	return 0;
 }
 ClientListEntry* ClientList::CheckAuth(uint32 iLSID, const char* iKey) {
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_lsid, iLSID, [](ClientListEntry* cle) { return cle->LSID(); }, entries);
+
+	for (auto cle : entries) {
+		if (cle->CheckAuth(iLSID, iKey))
+			return cle;
+	}
+
+	// the entry check only compares keys, so keep accepting a key filed under another LS id
 	LinkedListIterator<ClientListEntry*> iterator(clientlist);
 
 	iterator.Reset();
 	while(iterator.MoreElements()) {
-		if (iterator.GetData()->CheckAuth(iLSID, iKey))
+		if (iterator.GetData()->LSID() != iLSID && iterator.GetData()->CheckAuth(iLSID, iKey))
 			return iterator.GetData();
 		iterator.Advance();
 	}
@@ -453,7 +682,7 @@ ClientListEntry* ClientList::CheckAuth(const char* iName, const char* iPassword)
 		uint32 lsid = 0;
 		database.GetAccountIDByName(iName, &tmpadmin, &lsid);
 		auto tmp = new ClientListEntry(GetNextCLEID(), lsid, iName, tmpMD5, tmpadmin, 0, 0);
-		clientlist.Append(tmp);
+		AddCLE(tmp);
 		return tmp;
 	}
 	return 0;
@@ -518,10 +747,6 @@ void ClientList::SendOnlineGuildMembers(uint32 FromID, uint32 GuildID)
 
 void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_Struct* whom, WorldTCPConnection* connection) {
 	try{
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
-	LinkedListIterator<ClientListEntry*> countclients(clientlist);
-	ClientListEntry* cle = 0;
-	ClientListEntry* countcle = 0;
 	//char tmpgm[25] = "";
 	//char accinfo[150] = "";
 	char line[300] = "";
@@ -544,38 +769,21 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 		AppendAnyLenString(&output, &outsize, &outlen, "\r\n");
 	else
 		AppendAnyLenString(&output, &outsize, &outlen, "\n");
-	countclients.Reset();
-	while(countclients.MoreElements()){
-		countcle = countclients.GetData();
-		const char* tmpZone = database.GetZoneName(countcle->zone());
-		if (
-	(countcle->Online() >= CLE_Status_Zoning) &&
-	(!countcle->GetGM() || countcle->Anon() != 1 || admin >= countcle->Admin()) &&
-	(whom == 0 || (
-		((countcle->Admin() >= 80 && countcle->GetGM()) || whom->gmlookup == 0xFFFF) &&
-		(whom->lvllow == 0xFFFF || (countcle->level() >= whom->lvllow && countcle->level() <= whom->lvlhigh && (countcle->Anon()==0 || admin > countcle->Admin()))) &&
-		(whom->wclass == 0xFFFF || (countcle->class_() == whom->wclass && (countcle->Anon()==0 || admin > countcle->Admin()))) &&
-		(whom->wrace == 0xFFFF || (countcle->race() == whom->wrace && (countcle->Anon()==0 || admin > countcle->Admin()))) &&
-		(whomlen == 0 || (
-			(tmpZone != 0 && strncasecmp(tmpZone, whom->whom, whomlen) == 0) ||
-			strncasecmp(countcle->name(),whom->whom, whomlen) == 0 ||
-			(strncasecmp(guild_mgr.GetGuildName(countcle->GuildID()), whom->whom, whomlen) == 0) ||
-			(admin >= 100 && strncasecmp(countcle->AccountName(), whom->whom, whomlen) == 0)
-		))
-	))
-) {
-			if((countcle->Anon()>0 && admin>=countcle->Admin() && admin>0) || countcle->Anon()==0 ){
-				totalusers++;
-				if(totalusers<=20 || admin>=100)
-					totallength=totallength+strlen(countcle->name())+strlen(countcle->AccountName())+strlen(guild_mgr.GetGuildName(countcle->GuildID()))+5;
-			}
-			else if((countcle->Anon()>0 && admin<=countcle->Admin()) || (countcle->Anon()==0 && !countcle->GetGM())) {
-				totalusers++;
-				if(totalusers<=20 || admin>=100)
-					totallength=totallength+strlen(countcle->name())+strlen(guild_mgr.GetGuildName(countcle->GuildID()))+5;
-			}
+	UpdateWhoList();
+	for (auto &countcle : who_list) {
+		if (!WhoAllMatches(countcle, admin, whom, whomlen))
+			continue;
+
+		if((countcle.anon>0 && admin>=countcle.admin && admin>0) || countcle.anon==0 ){
+			totalusers++;
+			if(totalusers<=20 || admin>=100)
+				totallength=totallength+countcle.name.length()+countcle.account_name.length()+strlen(guild_mgr.GetGuildName(countcle.guild_id))+5;
+		}
+		else if((countcle.anon>0 && admin<=countcle.admin) || (countcle.anon==0 && !countcle.gm)) {
+			totalusers++;
+			if(totalusers<=20 || admin>=100)
+				totallength=totallength+countcle.name.length()+strlen(guild_mgr.GetGuildName(countcle.guild_id))+5;
 		}
-		countclients.Advance();
 	}
 	uint32 plid=fromid;
 	uint32 playerineqstring=5001;
@@ -622,78 +830,60 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 	memcpy(bufptr,&totalusers, sizeof(uint32));
 	bufptr+=sizeof(uint32);
 
-	iterator.Reset();
 	int idx=-1;
-	while(iterator.MoreElements()) {
-		cle = iterator.GetData();
+	for (auto &cle : who_list) {
+		if (!WhoAllMatches(cle, admin, whom, whomlen))
+			continue;
 
-		const char* tmpZone = database.GetZoneName(cle->zone());
-		if (
-	(cle->Online() >= CLE_Status_Zoning) &&
-	(!cle->GetGM() || cle->Anon() != 1 || admin >= cle->Admin()) &&
-	(whom == 0 || (
-		((cle->Admin() >= 80 && cle->GetGM()) || whom->gmlookup == 0xFFFF) &&
-		(whom->lvllow == 0xFFFF || (cle->level() >= whom->lvllow && cle->level() <= whom->lvlhigh && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whom->wclass == 0xFFFF || (cle->class_() == whom->wclass && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whom->wrace == 0xFFFF || (cle->race() == whom->wrace && (cle->Anon()==0 || admin>cle->Admin()))) &&
-		(whomlen == 0 || (
-			(tmpZone != 0 && strncasecmp(tmpZone, whom->whom, whomlen) == 0) ||
-			strncasecmp(cle->name(),whom->whom, whomlen) == 0 ||
-			(strncasecmp(guild_mgr.GetGuildName(cle->GuildID()), whom->whom, whomlen) == 0) ||
-			(admin >= 100 && strncasecmp(cle->AccountName(), whom->whom, whomlen) == 0)
-		))
-	))
-) {
 			line[0] = 0;
 			uint32 rankstring=0xFFFFFFFF;
-				if((cle->Anon()==1 && cle->GetGM() && cle->Admin()>admin) || (idx>=20 && admin<100)){ //hide gms that are anon from lesser gms and normal players, cut off at 20
+				if((cle.anon==1 && cle.gm && cle.admin>admin) || (idx>=20 && admin<100)){ //hide gms that are anon from lesser gms and normal players, cut off at 20
 					rankstring=0;
-					iterator.Advance();
 					continue;
-				} else if (cle->GetGM()) {
-					if (cle->Admin() >=250)
+				} else if (cle.gm) {
+					if (cle.admin >=250)
 						rankstring=5021;
-					else if (cle->Admin() >= 200)
+					else if (cle.admin >= 200)
 						rankstring=5020;
-					else if (cle->Admin() >= 180)
+					else if (cle.admin >= 180)
 						rankstring=5019;
-					else if (cle->Admin() >= 170)
+					else if (cle.admin >= 170)
 						rankstring=5018;
-					else if (cle->Admin() >= 160)
+					else if (cle.admin >= 160)
 						rankstring=5017;
-					else if (cle->Admin() >= 150)
+					else if (cle.admin >= 150)
 						rankstring=5016;
-					else if (cle->Admin() >= 100)
+					else if (cle.admin >= 100)
 						rankstring=5015;
-					else if (cle->Admin() >= 95)
+					else if (cle.admin >= 95)
 						rankstring=5014;
-					else if (cle->Admin() >= 90)
+					else if (cle.admin >= 90)
 						rankstring=5013;
-					else if (cle->Admin() >= 85)
+					else if (cle.admin >= 85)
 						rankstring=5012;
-					else if (cle->Admin() >= 81)
+					else if (cle.admin >= 81)
 						rankstring=5011;
-					else if (cle->Admin() >= 80)
+					else if (cle.admin >= 80)
 						rankstring=5010;
-					else if (cle->Admin() >= 50)
+					else if (cle.admin >= 50)
 						rankstring=5009;
-					else if (cle->Admin() >= 20)
+					else if (cle.admin >= 20)
 						rankstring=5008;
-					else if (cle->Admin() >= 10)
+					else if (cle.admin >= 10)
 						rankstring=5007;
 				}
 			idx++;
 			char guildbuffer[67]={0};
-			if (cle->GuildID() != GUILD_NONE && cle->GuildID()>0)
-				sprintf(guildbuffer,"<%s>", guild_mgr.GetGuildName(cle->GuildID()));
+			if (cle.guild_id != GUILD_NONE && cle.guild_id>0)
+				sprintf(guildbuffer,"<%s>", guild_mgr.GetGuildName(cle.guild_id));
 			uint32 formatstring=5025;
-			if(cle->Anon()==1 && (admin<cle->Admin() || admin==0))
+			if(cle.anon==1 && (admin<cle.admin || admin==0))
 				formatstring=5024;
-			else if(cle->Anon()==1 && admin>=cle->Admin() && admin>0)
+			else if(cle.anon==1 && admin>=cle.admin && admin>0)
 				formatstring=5022;
-			else if(cle->Anon()==2 && (admin<cle->Admin() || admin==0))
+			else if(cle.anon==2 && (admin<cle.admin || admin==0))
 				formatstring=5023;//display guild
-			else if(cle->Anon()==2 && admin>=cle->Admin() && admin>0)
+			else if(cle.anon==2 && admin>=cle.admin && admin>0)
 				formatstring=5022;//display everything
 
 	//war* wars2 = (war*)pack2->pBuffer;
@@ -705,19 +895,19 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 	uint32 zonestring=0xFFFFFFFF;
 	uint32 plzone=0;
 	uint32 unknown80[2];
-	if(cle->Anon()==0 || (admin>=cle->Admin() && admin>0)){
-		plclass_=cle->class_();
-		pllevel=cle->level();
+	if(cle.anon==0 || (admin>=cle.admin && admin>0)){
+		plclass_=cle.class_;
+		pllevel=cle.level;
 		if(admin>=100)
 			pidstring=5003;
-		plrace=cle->race();
+		plrace=cle.race;
 		zonestring=5006;
-		plzone=cle->zone();
+		plzone=cle.zone;
 	}
 
 
-	if(admin>=cle->Admin() && admin>0)
-		unknown80[0]=cle->Admin();
+	if(admin>=cle.admin && admin>0)
+		unknown80[0]=cle.admin;
 	else
 		unknown80[0]=0xFFFFFFFF;
 	unknown80[1]=0xFFFFFFFF;//1035
@@ -726,11 +916,11 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 	//char plstatus[20]={0};
 	//sprintf(plstatus, "Status %i",cle->Admin());
 	char plname[64]={0};
-	strcpy(plname,cle->name());
+	strcpy(plname,cle.name.c_str());
 
 	char placcount[30]={0};
-	if(admin>=cle->Admin() && admin>0)
-		strcpy(placcount,cle->AccountName());
+	if(admin>=cle.admin && admin>0)
+		strcpy(placcount,cle.account_name.c_str());
 
 	memcpy(bufptr,&formatstring, sizeof(uint32));
 	bufptr+=sizeof(uint32);
@@ -762,8 +952,6 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 	ending=207;
 	memcpy(bufptr,&ending, sizeof(uint32));
 	bufptr+=sizeof(uint32);
-		}
-		iterator.Advance();
 	}
 	//zoneserver_list.SendPacket(pack2); // NO NO NO WHY WOULD YOU SEND IT TO EVERY ZONE SERVER?!?
 	SendPacket(to,pack2);
@@ -778,7 +966,7 @@ void ClientList::SendWhoAll(uint32 fromid,const char* to, int16 admin, Who_All_S
 
 void ClientList::SendFriendsWho(ServerFriendsWho_Struct *FriendsWho, WorldTCPConnection* connection) {
 
-	std::vector<ClientListEntry*> FriendsCLEs;
+	std::vector<const WhoEntry*> FriendsCLEs;
 	FriendsCLEs.reserve(100);
 
 	char Friend_[65];
@@ -794,6 +982,8 @@ void ClientList::SendFriendsWho(ServerFriendsWho_Struct *FriendsWho, WorldTCPCon
 
 	uint32 TotalLength=0;
 
+	UpdateWhoList();
+
 	while(Seperator != nullptr) {
 
 		if((Seperator - FriendsPointer) > 64) return;
@@ -801,11 +991,12 @@ void ClientList::SendFriendsWho(ServerFriendsWho_Struct *FriendsWho, WorldTCPCon
 		strncpy(Friend_, FriendsPointer, Seperator - FriendsPointer);
 		Friend_[Seperator - FriendsPointer] = 0;
 
-		ClientListEntry* CLE = FindCharacter(Friend_);
-		if(CLE && CLE->name() && (CLE->Online() >= CLE_Status_Zoning) && !(CLE->GetGM() && CLE->Anon())) {
+		// only zoning or in zone characters are in the who list
+		const WhoEntry* CLE = FindWhoEntry(Friend_);
+		if(CLE && !(CLE->gm && CLE->anon)) {
 			FriendsCLEs.push_back(CLE);
-			TotalLength += strlen(CLE->name());
-			int GuildNameLength = strlen(guild_mgr.GetGuildName(CLE->GuildID()));
+			TotalLength += CLE->name.length();
+			int GuildNameLength = strlen(guild_mgr.GetGuildName(CLE->guild_id));
 			if(GuildNameLength>0)
 				TotalLength += (GuildNameLength + 2);
 		}
@@ -819,7 +1010,7 @@ void ClientList::SendFriendsWho(ServerFriendsWho_Struct *FriendsWho, WorldTCPCon
 
 
 	try{
-		ClientListEntry* cle;
+		const WhoEntry* cle;
 		int FriendsOnline = FriendsCLEs.size();
 		int PacketLength = sizeof(WhoAllReturnStruct) + (47 * FriendsOnline) + TotalLength;
 		auto pack2 = new ServerPacket(ServerOP_WhoAllReply, PacketLength);
@@ -853,12 +1044,12 @@ void ClientList::SendFriendsWho(ServerFriendsWho_Struct *FriendsWho, WorldTCPCon
 			cle = FriendsCLEs[CLEEntry];
 
 			char GuildName[67]={0};
-			if (cle->GuildID() != GUILD_NONE && cle->GuildID()>0)
-				sprintf(GuildName,"<%s>", guild_mgr.GetGuildName(cle->GuildID()));
+			if (cle->guild_id != GUILD_NONE && cle->guild_id>0)
+				sprintf(GuildName,"<%s>", guild_mgr.GetGuildName(cle->guild_id));
 			uint32 FormatMSGID=5025; // 5025 %T1[%2 %3] %4 (%5) %6 %7 %8 %9
-			if(cle->Anon()==1)
+			if(cle->anon==1)
 				FormatMSGID=5024; // 5024 %T1[ANONYMOUS] %2 %3
-			else if(cle->Anon()==2)
+			else if(cle->anon==2)
 				FormatMSGID=5023; // 5023 %T1[ANONYMOUS] %2 %3 %4
 
 			uint32 PlayerClass=0;
@@ -867,16 +1058,16 @@ void ClientList::SendFriendsWho(ServerFriendsWho_Struct *FriendsWho, WorldTCPCon
 			uint32 ZoneMSGID=0xffffffff;
 			uint32 PlayerZone=0;
 
-			if(cle->Anon()==0) {
-				PlayerClass=cle->class_();
-				PlayerLevel=cle->level();
-				PlayerRace=cle->race();
+			if(cle->anon==0) {
+				PlayerClass=cle->class_;
+				PlayerLevel=cle->level;
+				PlayerRace=cle->race;
 				ZoneMSGID=5006; // 5006 ZONE: %1
-				PlayerZone=cle->zone();
+				PlayerZone=cle->zone;
 			}
 
 			char PlayerName[64]={0};
-			strcpy(PlayerName,cle->name());
+			strcpy(PlayerName,cle->name.c_str());
 
 			WhoAllPlayerPart1* WAPP1 = (WhoAllPlayerPart1*)bufptr;
 
@@ -1211,6 +1402,8 @@ void ClientList::ZoneBootup(ZoneServer* zs) {
 }
 
 void ClientList::RemoveCLEReferances(ClientListEntry* cle) {
+	UnindexCLE(cle);
+
 	LinkedListIterator<Client*> iterator(list);
 
 	iterator.Reset();
@@ -1252,42 +1445,60 @@ bool ClientList::SendPacket(const char* to, ServerPacket* pack) {
 	return false;
 }
 
-void ClientList::SendGuildPacket(uint32 guild_id, ServerPacket* pack) {
-	std::set<uint32> zone_ids;
-
-	LinkedListIterator<ClientListEntry*> iterator(clientlist);
+void ClientList::SendRoutedPacket(const RouteTable& routes, uint32 key, ServerPacket* pack) {
+	auto it = routes.find(key);
+	if (it == routes.end())
+		return;
 
-	iterator.Reset();
-	while(iterator.MoreElements()) {
-		if (iterator.GetData()->GuildID() == guild_id) {
-			zone_ids.insert(iterator.GetData()->zone());
-		}
-		iterator.Advance();
+	for (auto &zs : it->second) {
+		ZoneServer* server = zoneserver_list.FindByID(zs.first);
+		if (server)
+			server->SendPacket(pack);
 	}
+}
+
+void ClientList::SendGuildPacket(uint32 guild_id, ServerPacket* pack) {
+	SendRoutedPacket(guild_routes, guild_id, pack);
+}
 
-	//now we know all the zones, send it to each one... this is kinda a shitty way to do this
-	//since its basically O(n^2)
-	std::set<uint32>::iterator cur, end;
-	cur = zone_ids.begin();
-	end = zone_ids.end();
-	for(; cur != end; cur++) {
-		zoneserver_list.SendPacket(*cur, pack);
+// raid id 0 is a raid world never heard of, so it still goes everywhere
+void ClientList::SendRaidPacket(uint32 raid_id, ServerPacket* pack) {
+	if (raid_id == 0) {
+		zoneserver_list.SendPacket(pack);
+		return;
 	}
+
+	SendRoutedPacket(raid_routes, raid_id, pack);
 }
 
-void ClientList::UpdateClientGuild(uint32 char_id, uint32 guild_id) {
+void ClientList::SetRaidMember(const char* name, uint32 raid_id) {
+	ClientListEntry* cle = FindCharacter(name);
+	if (cle)
+		cle->SetRaid(raid_id);
+}
+
+void ClientList::ClearRaid(uint32 raid_id) {
+	if (raid_id == 0)
+		return;
+
 	LinkedListIterator<ClientListEntry*> iterator(clientlist);
 
 	iterator.Reset();
 	while(iterator.MoreElements()) {
-		ClientListEntry *cle = iterator.GetData();
-		if (cle->CharID() == char_id) {
-			cle->SetGuild(guild_id);
-		}
+		if (iterator.GetData()->RaidID() == raid_id)
+			iterator.GetData()->SetRaid(0);
 		iterator.Advance();
 	}
 }
 
+void ClientList::UpdateClientGuild(uint32 char_id, uint32 guild_id) {
+	std::vector<ClientListEntry*> entries;
+	GetIndexedCLEs(cle_by_char, char_id, [](ClientListEntry* cle) { return cle->CharID(); }, entries);
+
+	for (auto cle : entries)
+		cle->SetGuild(guild_id);
+}
+
 
 
 int ClientList::GetClientCount() {
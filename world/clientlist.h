@@ -10,6 +10,9 @@
 #include "../common/net/console_server_connection.h"
 #include <vector>
 #include <string>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 class Client;
 class ZoneServer;
@@ -47,6 +50,9 @@ public:
 
 	bool	SendPacket(const char* to, ServerPacket* pack);
 	void	SendGuildPacket(uint32 guild_id, ServerPacket* pack);
+	void	SendRaidPacket(uint32 raid_id, ServerPacket* pack);
+	void	SetRaidMember(const char* name, uint32 raid_id);
+	void	ClearRaid(uint32 raid_id);
 
 	void	ClientUpdate(ZoneServer* zoneserver, ServerClientList_Struct* scl);
 	void	CLERemoveZSRef(ZoneServer* iZS);
@@ -65,20 +71,95 @@ public:
 	void	CLEKeepAlive(uint32 numupdates, uint32* wid);
 	void	CLEAdd(uint32 iLSID, const char* iLoginName, const char* iLoginKey, int16 iWorldAdmin = 0, uint32 ip = 0, uint8 local=0);
 	void	UpdateClientGuild(uint32 char_id, uint32 guild_id);
+	void	CLEChanged(ClientListEntry* cle);
 
 	int GetClientCount();
 	void GetClients(const char *zone_name, std::vector<ClientListEntry *> &into);
 
 private:
+	typedef std::unordered_map<uint32, std::vector<ClientListEntry*>> CLEIndex;
+	// guild or raid id -> zone server id -> how many of its members are on that zone server
+	typedef std::unordered_map<uint32, std::map<uint32, uint32>> RouteTable;
+
+	// what a CLE is currently filed under in the lookup indexes, 0 and "" are never indexed
+	struct CLEKeys {
+		std::string name;
+		uint32 account_id;
+		uint32 char_id;
+		uint32 ls_id;
+		uint32 ip;
+		uint32 zone_server;
+		uint32 guild_id;
+		uint32 raid_id;
+	};
+
+	/*
+	 * The parts of an online (zoning or in zone) CLE that /who all and friends
+	 * /who look at. Entries are refreshed from CLEChanged so a who request walks
+	 * this vector instead of the whole clientlist with a zone name lookup per
+	 * entry per pass.
+	 */
+	struct WhoEntry {
+		ClientListEntry* cle;
+		std::string name;
+		std::string account_name;
+		const char* zone_name;
+		uint32 zone;
+		uint32 guild_id;
+		int16 admin;
+		uint16 race;
+		uint8 level;
+		uint8 class_;
+		uint8 anon;
+		uint8 gm;
+	};
+
 	void OnTick(EQ::Timer *t);
 	inline uint32 GetNextCLEID() { return NextCLEID++; }
 
+	void	AddCLE(ClientListEntry* cle, bool append = true);
+	void	RemoveCLE(ClientListEntry* cle);
+	void	IndexCLE(ClientListEntry* cle);
+	void	UnindexCLE(ClientListEntry* cle);
+	static CLEKeys GetCLEKeys(ClientListEntry* cle);
+	void	AddKeys(ClientListEntry* cle, const CLEKeys& keys);
+	void	RemoveKeys(ClientListEntry* cle, const CLEKeys& keys);
+	void	SendRoutedPacket(const RouteTable& routes, uint32 key, ServerPacket* pack);
+	template<typename F>
+	void	GetIndexedCLEs(const CLEIndex& index, uint32 key, F field, std::vector<ClientListEntry*>& out);
+
+	void	UpdateWhoList();
+	void	RemoveWhoEntry(ClientListEntry* cle);
+	const WhoEntry* FindWhoEntry(const char* name);
+	bool	WhoAllMatches(const WhoEntry& e, int16 admin, Who_All_Struct* whom, int whomlen);
+
 	//this is the list of people actively connected to zone
 	LinkedList<Client*> list;
 
 	//this is the list of people in any zone, not nescesarily connected to world
 	Timer	CLStale_timer;
 	uint32 NextCLEID;
+
+	// indexes over clientlist, declared first so they outlive the entries it deletes
+	std::unordered_map<ClientListEntry*, CLEKeys> cle_keys;
+	std::unordered_map<uint32, ClientListEntry*> cle_by_id;
+	std::unordered_map<std::string, std::vector<ClientListEntry*>> cle_by_name;
+	CLEIndex cle_by_account;
+	CLEIndex cle_by_char;
+	CLEIndex cle_by_lsid;
+	CLEIndex cle_by_ip;
+
+	/*
+	 * Zone servers a guild or raid has members on, kept from the same keys so
+	 * guild and raid traffic goes to those zones instead of every zone.
+	 */
+	RouteTable guild_routes;
+	RouteTable raid_routes;
+
+	std::vector<WhoEntry> who_list;
+	std::unordered_map<ClientListEntry*, size_t> who_slot;
+	std::unordered_set<ClientListEntry*> who_dirty;
+
 	LinkedList<ClientListEntry *> clientlist;
 
 	std::unique_ptr<EQ::Timer> m_tick;
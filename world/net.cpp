@@ -545,6 +545,7 @@ int main(int argc, char** argv) {
 		if (InterserverTimer.Check()) {
 			InterserverTimer.Start();
 			database.ping();
+			database.ReleaseRetiredSharedMemory(RuleI(World, SharedMemoryRetireMS));
 		}
 
 		EQ::EventLoop::Get().Process();
@@ -21,8 +21,11 @@
 #include "../common/eq_packet_structs.h"
 #include "../common/inventory_profile.h"
 #include "../common/rulesys.h"
+#include "../common/timer.h"
 #include <iostream>
 #include <cstdlib>
+#include <map>
+#include <tuple>
 #include <vector>
 #include "sof_char_create_data.h"
 
@@ -31,13 +34,28 @@ extern std::vector<RaceClassAllocation> character_create_allocations;
 extern std::vector<RaceClassCombos> character_create_race_class_combos;
 
 
+// same rules as EQEmu::ItemInstance::GetOrnamentHeroModel, char select never builds the instance
+static uint32 CharSelectHeroModel(uint32 hero_model, int32 material_slot)
+{
+	if (hero_model == 0 || material_slot < 0)
+		return 0;
+
+	if (hero_model >= 1000)
+		return hero_model;
+
+	return (hero_model * 100) + material_slot;
+}
+
 // the current stuff is at the bottom of this function
 void WorldDatabase::GetCharSelectInfo(uint32 accountID, EQApplicationPacket **outApp, uint32 clientVersionBit)
 {
+	BenchTimer benchmark;
+	uint32 query_count = 0;
+
 	/* Set Character Creation Limit */
 	EQEmu::versions::ClientVersion client_version = EQEmu::versions::ConvertClientVersionBitToClientVersion(clientVersionBit);
 	size_t character_limit = EQEmu::constants::Lookup(client_version)->CharacterCreationLimit;
-	
+
 	// Validate against absolute server max
 	if (character_limit > EQEmu::constants::CharacterCreationMax)
 		character_limit = EQEmu::constants::CharacterCreationMax;
@@ -73,6 +91,7 @@ void WorldDatabase::GetCharSelectInfo(uint32 accountID, EQApplicationPacket **ou
 		"character_data             "
 		"WHERE `account_id` = %i ORDER BY `name` LIMIT %u", accountID, character_limit);
 	auto results = database.QueryDatabase(cquery);
+	++query_count;
 
 	size_t character_count = results.RowCount();
 	if (character_count == 0) {
@@ -83,6 +102,112 @@ void WorldDatabase::GetCharSelectInfo(uint32 accountID, EQApplicationPacket **ou
 		return;
 	}
 
+	/*
+	 * Binds, tints and equipment are fetched for the whole account with one
+	 * query per table and joined back to each character in memory, instead of
+	 * a round of queries (and a full inventory load) per character
+	 */
+	std::string id_list;
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		if (!id_list.empty())
+			id_list += ",";
+		id_list += std::to_string(atoi(row[0]));
+	}
+
+	struct CharSelectBind {
+		int slot;
+		BindStruct bind;
+	};
+	std::map<uint32, std::vector<CharSelectBind>> character_binds;
+	cquery = StringFormat("SELECT `id`, `zone_id`, `instance_id`, `x`, `y`, `z`, `heading`, `slot` FROM `character_bind` WHERE `id` IN (%s)", id_list.c_str());
+	auto results_bind = database.QueryDatabase(cquery);
+	++query_count;
+	for (auto row_b = results_bind.begin(); row_b != results_bind.end(); ++row_b) {
+		auto &binds = character_binds[(uint32)atoi(row_b[0])];
+		// the per character query this replaces only ever looked at 5 rows
+		if (binds.size() >= 5)
+			continue;
+
+		CharSelectBind b;
+		b.slot = row_b[7] ? atoi(row_b[7]) : -1;
+		b.bind.zoneId = atoi(row_b[1]);
+		b.bind.instance_id = atoi(row_b[2]);
+		b.bind.x = atof(row_b[3]);
+		b.bind.y = atof(row_b[4]);
+		b.bind.z = atof(row_b[5]);
+		b.bind.heading = atof(row_b[6]);
+		binds.push_back(b);
+	}
+
+	std::map<uint32, EQEmu::TintProfile> character_tints;
+	cquery = StringFormat("SELECT `id`, `slot`, `red`, `green`, `blue`, `use_tint` FROM `character_material` WHERE `id` IN (%s)", id_list.c_str());
+	auto results_material = database.QueryDatabase(cquery);
+	++query_count;
+	for (auto row_m = results_material.begin(); row_m != results_material.end(); ++row_m) {
+		uint32 slot = atoi(row_m[1]);
+		if (slot >= EQEmu::textures::materialCount)
+			continue;
+
+		auto tint = character_tints.find((uint32)atoi(row_m[0]));
+		if (tint == character_tints.end()) {
+			tint = character_tints.insert(std::make_pair((uint32)atoi(row_m[0]), EQEmu::TintProfile())).first;
+			memset(&tint->second, 0, sizeof(EQEmu::TintProfile));
+		}
+
+		tint->second.Slot[slot].Red = atoi(row_m[2]);
+		tint->second.Slot[slot].Green = atoi(row_m[3]);
+		tint->second.Slot[slot].Blue = atoi(row_m[4]);
+		tint->second.Slot[slot].UseTint = atoi(row_m[5]);
+	}
+
+	/* Only the worn slots matter here, there is no need to build an inventory */
+	struct CharSelectEquip {
+		uint32 item_id;
+		uint32 color;
+		uint32 ornament_idfile;
+	};
+	std::map<int16, uint8> material_slots;
+	std::string slot_list;
+	for (uint8 matslot = EQEmu::textures::textureBegin; matslot < EQEmu::textures::materialCount; matslot++) {
+		int16 invslot = EQEmu::InventoryProfile::CalcSlotFromMaterial(matslot);
+		if (invslot == INVALID_INDEX)
+			continue;
+
+		material_slots[invslot] = matslot;
+		if (!slot_list.empty())
+			slot_list += ",";
+		slot_list += std::to_string(invslot);
+	}
+
+	std::map<uint32, std::map<uint8, CharSelectEquip>> character_equipment;
+	cquery = StringFormat("SELECT `charid`, `slotid`, `itemid`, `color`, `ornamentidfile` FROM `inventory` WHERE `charid` IN (%s) AND `slotid` IN (%s)",
+		id_list.c_str(), slot_list.c_str());
+	auto results_inventory = database.QueryDatabase(cquery);
+	++query_count;
+	if (!results_inventory.Success())
+		printf("Error loading inventory for account %u\n", accountID);
+
+	for (auto row_i = results_inventory.begin(); row_i != results_inventory.end(); ++row_i) {
+		auto matslot = material_slots.find((int16)atoi(row_i[1]));
+		if (matslot == material_slots.end())
+			continue;
+
+		CharSelectEquip e;
+		e.item_id = atoul(row_i[2]);
+		e.color = atoul(row_i[3]);
+		e.ornament_idfile = atoul(row_i[4]);
+		character_equipment[(uint32)atoi(row_i[0])][matslot->second] = e;
+	}
+
+	/* start_zones lookups are shared by every character of the same class/deity/race */
+	struct CharSelectStartZone {
+		bool found;
+		uint32 zone_id;
+		float x, y, z;
+	};
+	std::map<std::tuple<uint8, uint32, uint32>, CharSelectStartZone> start_zones;
+	std::vector<std::string> bind_fixes;
+
 	size_t packet_size = sizeof(CharacterSelect_Struct) + (sizeof(CharacterSelectEntry_Struct) * character_count);
 	*outApp = new EQApplicationPacket(OP_SendCharInfo, packet_size);
 
@@ -95,13 +220,12 @@ void WorldDatabase::GetCharSelectInfo(uint32 accountID, EQApplicationPacket **ou
 	buff_ptr += sizeof(CharacterSelect_Struct);
 	for (auto row = results.begin(); row != results.end(); ++row) {
 		CharacterSelectEntry_Struct *cse = (CharacterSelectEntry_Struct *)buff_ptr;
-		PlayerProfile_Struct pp;
-		EQEmu::InventoryProfile inv;
+		BindStruct binds[5];
 		uint32 character_id = (uint32)atoi(row[0]);
 		uint8 has_home = 0;
 		uint8 has_bind = 0;
 
-		memset(&pp, 0, sizeof(PlayerProfile_Struct));
+		memset(binds, 0, sizeof(binds));
 		
 		/* Fill CharacterSelectEntry_Struct */
 		memset(cse->Name, 0, sizeof(cse->Name));
@@ -158,59 +282,71 @@ void WorldDatabase::GetCharSelectInfo(uint32 accountID, EQApplicationPacket **ou
 		}
 
 		/* Set Bind Point Data for any character that may possibly be missing it for any reason */
-		cquery = StringFormat("SELECT `zone_id`, `instance_id`, `x`, `y`, `z`, `heading`, `slot` FROM `character_bind`  WHERE `id` = %i LIMIT 5", character_id);
-		auto results_bind = database.QueryDatabase(cquery);
-		auto bind_count = results_bind.RowCount();
-		for (auto row_b = results_bind.begin(); row_b != results_bind.end(); ++row_b) {
-			if (row_b[6] && atoi(row_b[6]) == 4) {
-				has_home = 1;
-				// If our bind count is less than 5, we need to actually make use of this data so lets parse it
-				if (bind_count < 5) {
-					pp.binds[4].zoneId = atoi(row_b[0]);
-					pp.binds[4].instance_id = atoi(row_b[1]);
-					pp.binds[4].x = atof(row_b[2]);
-					pp.binds[4].y = atof(row_b[3]);
-					pp.binds[4].z = atof(row_b[4]);
-					pp.binds[4].heading = atof(row_b[5]);
+		size_t bind_count = 0;
+		auto bind_rows = character_binds.find(character_id);
+		if (bind_rows != character_binds.end()) {
+			bind_count = bind_rows->second.size();
+			for (auto &b : bind_rows->second) {
+				if (b.slot == 4) {
+					has_home = 1;
+					// If our bind count is less than 5, we need to actually make use of this data so lets parse it
+					if (bind_count < 5)
+						binds[4] = b.bind;
 				}
+				if (b.slot == 0) { has_bind = 1; }
 			}
-			if (row_b[6] && atoi(row_b[6]) == 0){ has_bind = 1; }
 		}
 
 		if (has_home == 0 || has_bind == 0) {
-			cquery = StringFormat("SELECT `zone_id`, `bind_id`, `x`, `y`, `z` FROM `start_zones` WHERE `player_class` = %i AND `player_deity` = %i AND `player_race` = %i",
-				cse->Class, cse->Deity, cse->Race);
-			auto results_bind = database.QueryDatabase(cquery);
-			for (auto row_d = results_bind.begin(); row_d != results_bind.end(); ++row_d) {
-				/* If a bind_id is specified, make them start there */
-				if (atoi(row_d[1]) != 0) {
-					pp.binds[4].zoneId = (uint32)atoi(row_d[1]);
-					GetSafePoints(pp.binds[4].zoneId, 0, &pp.binds[4].x, &pp.binds[4].y, &pp.binds[4].z);
-				}
-				/* Otherwise, use the zone and coordinates given */
-				else {
-					pp.binds[4].zoneId = (uint32)atoi(row_d[0]);
-					float x = atof(row_d[2]);
-					float y = atof(row_d[3]);
-					float z = atof(row_d[4]);
-					if (x == 0 && y == 0 && z == 0){ GetSafePoints(pp.binds[4].zoneId, 0, &x, &y, &z); }
-					pp.binds[4].x = x; pp.binds[4].y = y; pp.binds[4].z = z;
+			auto key = std::make_tuple(cse->Class, cse->Deity, cse->Race);
+			auto start_zone = start_zones.find(key);
+			if (start_zone == start_zones.end()) {
+				CharSelectStartZone sz;
+				memset(&sz, 0, sizeof(CharSelectStartZone));
+
+				cquery = StringFormat("SELECT `zone_id`, `bind_id`, `x`, `y`, `z` FROM `start_zones` WHERE `player_class` = %i AND `player_deity` = %i AND `player_race` = %i",
+					cse->Class, cse->Deity, cse->Race);
+				auto results_start = database.QueryDatabase(cquery);
+				++query_count;
+				for (auto row_d = results_start.begin(); row_d != results_start.end(); ++row_d) {
+					sz.found = true;
+					/* If a bind_id is specified, make them start there */
+					if (atoi(row_d[1]) != 0) {
+						sz.zone_id = (uint32)atoi(row_d[1]);
+						GetSafePoints(sz.zone_id, 0, &sz.x, &sz.y, &sz.z);
+						++query_count;
+					}
+					/* Otherwise, use the zone and coordinates given */
+					else {
+						sz.zone_id = (uint32)atoi(row_d[0]);
+						sz.x = atof(row_d[2]);
+						sz.y = atof(row_d[3]);
+						sz.z = atof(row_d[4]);
+						if (sz.x == 0 && sz.y == 0 && sz.z == 0) {
+							GetSafePoints(sz.zone_id, 0, &sz.x, &sz.y, &sz.z);
+							++query_count;
+						}
+					}
 				}
+				start_zone = start_zones.insert(std::make_pair(key, sz)).first;
 			}
-			pp.binds[0] = pp.binds[4];
+
+			if (start_zone->second.found) {
+				binds[4].zoneId = start_zone->second.zone_id;
+				binds[4].x = start_zone->second.x;
+				binds[4].y = start_zone->second.y;
+				binds[4].z = start_zone->second.z;
+			}
+			binds[0] = binds[4];
 			/* If no home bind set, set it */
 			if (has_home == 0) {
-				std::string query = StringFormat("REPLACE INTO `character_bind` (id, zone_id, instance_id, x, y, z, heading, slot)"
-					" VALUES (%u, %u, %u, %f, %f, %f, %f, %i)",
-					character_id, pp.binds[4].zoneId, 0, pp.binds[4].x, pp.binds[4].y, pp.binds[4].z, pp.binds[4].heading, 4);
-				auto results_bset = QueryDatabase(query);
+				bind_fixes.push_back(StringFormat("(%u, %u, %u, %f, %f, %f, %f, %i)",
+					character_id, binds[4].zoneId, 0, binds[4].x, binds[4].y, binds[4].z, binds[4].heading, 4));
 			}
 			/* If no regular bind set, set it */
 			if (has_bind == 0) {
-				std::string query = StringFormat("REPLACE INTO `character_bind` (id, zone_id, instance_id, x, y, z, heading, slot)"
-					" VALUES (%u, %u, %u, %f, %f, %f, %f, %i)",
-					character_id, pp.binds[0].zoneId, 0, pp.binds[0].x, pp.binds[0].y, pp.binds[0].z, pp.binds[0].heading, 0);
-				auto results_bset = QueryDatabase(query);
+				bind_fixes.push_back(StringFormat("(%u, %u, %u, %f, %f, %f, %f, %i)",
+					character_id, binds[0].zoneId, 0, binds[0].x, binds[0].y, binds[0].z, binds[0].heading, 0));
 			}
 		}
 		/* If our bind count is less than 5, then we have null data that needs to be filled in. */
@@ -218,49 +354,30 @@ void WorldDatabase::GetCharSelectInfo(uint32 accountID, EQApplicationPacket **ou
 			// we know that home and main bind must be valid here, so we don't check those
 			// we also use home to fill in the null data like live does.
 			for (int i = 1; i < 4;  i++) {
-				if (pp.binds[i].zoneId != 0) // we assume 0 is the only invalid one ...
+				if (binds[i].zoneId != 0) // we assume 0 is the only invalid one ...
 					continue;
 
-				std::string query = StringFormat("REPLACE INTO `character_bind` (id, zone_id, instance_id, x, y, z, heading, slot)"
-					" VALUES (%u, %u, %u, %f, %f, %f, %f, %i)",
-					character_id, pp.binds[4].zoneId, 0, pp.binds[4].x, pp.binds[4].y, pp.binds[4].z, pp.binds[4].heading, i);
-				auto results_bset = QueryDatabase(query);
+				bind_fixes.push_back(StringFormat("(%u, %u, %u, %f, %f, %f, %f, %i)",
+					character_id, binds[4].zoneId, 0, binds[4].x, binds[4].y, binds[4].z, binds[4].heading, i));
 			}
 		}
 		/* Bind End */
 
-		/* Load Character Material Data for Char Select */
-		cquery = StringFormat("SELECT slot, red, green, blue, use_tint, color FROM `character_material` WHERE `id` = %u", character_id);
-		auto results_b = database.QueryDatabase(cquery); uint8 slot = 0;
-		for (auto row_b = results_b.begin(); row_b != results_b.end(); ++row_b) {
-			slot = atoi(row_b[0]);
-			pp.item_tint.Slot[slot].Red = atoi(row_b[1]);
-			pp.item_tint.Slot[slot].Green = atoi(row_b[2]);
-			pp.item_tint.Slot[slot].Blue = atoi(row_b[3]);
-			pp.item_tint.Slot[slot].UseTint = atoi(row_b[4]);
-		}
-		/* Character Material Data End */
-
-		/* Load Inventory */
-		// If we ensure that the material data is updated appropriately, we can do away with inventory loads
-		if (GetInventory(accountID, cse->Name, &inv)) {
-			const EQEmu::ItemData* item = nullptr;
-			const EQEmu::ItemInstance* inst = nullptr;
-			int16 invslot = 0;
-
-			for (uint32 matslot = EQEmu::textures::textureBegin; matslot < EQEmu::textures::materialCount; matslot++) {
-				invslot = EQEmu::InventoryProfile::CalcSlotFromMaterial(matslot);
-				if (invslot == INVALID_INDEX) { continue; }
-				inst = inv.GetItem(invslot);
-				if (inst == nullptr) { continue; }
-				item = inst->GetItem();
+		/* Equipment appearance from the worn slots and character_material tints */
+		auto equipment = character_equipment.find(character_id);
+		if (equipment != character_equipment.end()) {
+			auto tint = character_tints.find(character_id);
+
+			for (auto &e : equipment->second) {
+				uint8 matslot = e.first;
+				const EQEmu::ItemData* item = GetItem(e.second.item_id);
 				if (item == nullptr) { continue; }
 
 				if (matslot > 6) {
 					uint32 idfile = 0;
 					// Weapon Models 
-					if (inst->GetOrnamentationIDFile() != 0) {
-						idfile = inst->GetOrnamentationIDFile();
+					if (e.second.ornament_idfile != 0) {
+						idfile = e.second.ornament_idfile;
 						cse->Equip[matslot].Material = idfile;
 					}
 					else {
@@ -278,28 +395,41 @@ void WorldDatabase::GetCharSelectInfo(uint32 accountID, EQApplicationPacket **ou
 				}
 				else {
 					uint32 color = 0;
-					if (pp.item_tint.Slot[matslot].UseTint) {
-						color = pp.item_tint.Slot[matslot].Color;
+					if (tint != character_tints.end() && tint->second.Slot[matslot].UseTint) {
+						color = tint->second.Slot[matslot].Color;
 					}
 					else {
-						color = inst->GetColor();
+						// an inventory color of 0 means the item's own color, same as GetInventory
+						color = e.second.color > 0 ? e.second.color : item->Color;
 					}
 
 					// Armor Materials/Models
 					cse->Equip[matslot].Material = item->Material;
 					cse->Equip[matslot].EliteModel = item->EliteMaterial;
-					cse->Equip[matslot].HerosForgeModel = inst->GetOrnamentHeroModel(matslot);
+					cse->Equip[matslot].HerosForgeModel = CharSelectHeroModel(item->HerosForgeModel, matslot);
 					cse->Equip[matslot].Color = color;
 				}
 			}
 		}
-		else {
-			printf("Error loading inventory for %s\n", cse->Name);
-		}
-		/* Load Inventory End */
+		/* Equipment End */
 
 		buff_ptr += sizeof(CharacterSelectEntry_Struct);
 	}
+
+	/* Missing binds for every character go out in one statement */
+	if (!bind_fixes.empty()) {
+		std::string query = "REPLACE INTO `character_bind` (id, zone_id, instance_id, x, y, z, heading, slot) VALUES ";
+		for (size_t i = 0; i < bind_fixes.size(); ++i) {
+			if (i > 0)
+				query += ", ";
+			query += bind_fixes[i];
+		}
+		auto results_bset = QueryDatabase(query);
+		++query_count;
+	}
+
+	Log(Logs::Detail, Logs::World_Server, "Char select info for account %u: %u characters, %u queries, %.3f ms",
+		accountID, (uint32)character_count, query_count, benchmark.elapsed() * 1000.0);
 }
 
 int WorldDatabase::MoveCharacterToBind(int CharID, uint8 bindnum)
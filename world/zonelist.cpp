@@ -34,11 +34,20 @@ extern EQEmu::Random emu_random;
 extern WebInterfaceList web_interface;
 void CatchSignal(int sig_num);
 
+static std::string ZoneNameKey(const char* name) {
+	std::string key = name ? name : "";
+	ToLowerString(key);
+	return key;
+}
+
 ZSList::ZSList()
 {
 	NextID = 1;
 	CurGroupID = 1;
 	LastAllocatedPort = 0;
+	index_dirty = true;
+	// seeded from the clock so zones that outlive a world restart never see a generation number twice
+	CurSharedMemGeneration = static_cast<uint32>(time(nullptr));
 	memset(pLockedZones, 0, sizeof(pLockedZones));
 
 	m_tick.reset(new EQ::Timer(5000, true, std::bind(&ZSList::OnTick, this, std::placeholders::_1)));
@@ -66,6 +75,7 @@ void ZSList::ShowUpTime(WorldTCPConnection* con, const char* adminname) {
 
 void ZSList::Add(ZoneServer* zoneserver) {
 	list.push_back(std::unique_ptr<ZoneServer>(zoneserver));
+	index_dirty = true;
 	zoneserver->SendGroupIDs();
 }
 
@@ -74,6 +84,7 @@ void ZSList::Remove(const std::string &uuid)
 	auto iter = list.begin();
 	while (iter != list.end()) {
 		if ((*iter)->GetUUID().compare(uuid) == 0) {
+			index_dirty = true;
 			list.erase(iter);
 			return;
 		}
@@ -82,6 +93,7 @@ void ZSList::Remove(const std::string &uuid)
 }
 
 void ZSList::KillAll() {
+	index_dirty = true;
 	auto iterator = list.begin();
 	while (iterator != list.end()) {
 		(*iterator)->Disconnect();
@@ -89,6 +101,28 @@ void ZSList::KillAll() {
 	}
 }
 
+void ZSList::UpdateIndex() {
+	if (!index_dirty)
+		return;
+
+	zs_by_id.clear();
+	zs_by_instance.clear();
+	zs_by_port.clear();
+	zs_by_name.clear();
+	zs_by_zone.clear();
+
+	for (auto &iter : list) {
+		ZoneServer* zs = iter.get();
+		zs_by_id.emplace(zs->GetID(), zs);
+		zs_by_instance.emplace(zs->GetInstanceID(), zs);
+		zs_by_port.emplace(zs->GetCPort(), zs);
+		zs_by_name.emplace(ZoneNameKey(zs->GetZoneName()), zs);
+		zs_by_zone[zs->GetZoneID()].push_back(zs);
+	}
+
+	index_dirty = false;
+}
+
 void ZSList::Process() {
 
 	if (shutdowntimer && shutdowntimer->Check()) {
@@ -117,106 +151,63 @@ bool ZSList::SendPacket(ServerPacket* pack) {
 }
 
 bool ZSList::SendPacket(uint32 ZoneID, ServerPacket* pack) {
-	auto iterator = list.begin();
-	while (iterator != list.end()) {
-		if ((*iterator)->GetZoneID() == ZoneID) {
-			ZoneServer* tmp = (*iterator).get();
-			tmp->SendPacket(pack);
-			return true;
-		}
-		iterator++;
-	}
-	return(false);
+	UpdateIndex();
+	auto iter = zs_by_zone.find(ZoneID);
+	if (iter == zs_by_zone.end())
+		return false;
+
+	iter->second.front()->SendPacket(pack);
+	return true;
 }
 
 bool ZSList::SendPacket(uint32 ZoneID, uint16 instanceID, ServerPacket* pack) {
-	if (instanceID != 0)
-	{
-		auto iterator = list.begin();
-		while (iterator != list.end()) {
-			if ((*iterator)->GetInstanceID() == instanceID) {
-				ZoneServer* tmp = (*iterator).get();
-				tmp->SendPacket(pack);
-				return true;
-			}
-			iterator++;
-		}
-	}
-	else
-	{
-		auto iterator = list.begin();
-		while (iterator != list.end()) {
-			if ((*iterator)->GetZoneID() == ZoneID
-				&& (*iterator)->GetInstanceID() == 0) {
-				ZoneServer* tmp = (*iterator).get();
-				tmp->SendPacket(pack);
-				return true;
-			}
-			iterator++;
-		}
-	}
-	return(false);
+	ZoneServer* zs = instanceID != 0 ? FindByInstanceID(instanceID) : FindByZoneID(ZoneID);
+	if (!zs)
+		return false;
+
+	zs->SendPacket(pack);
+	return true;
 }
 
 ZoneServer* ZSList::FindByName(const char* zonename) {
-	auto iterator = list.begin();
-	while (iterator != list.end()) {
-		if (strcasecmp((*iterator)->GetZoneName(), zonename) == 0) {
-			ZoneServer* tmp = (*iterator).get();
-			return tmp;
-		}
-		iterator++;
-	}
-	return 0;
+	if (!zonename)
+		return 0;
+
+	UpdateIndex();
+	auto iter = zs_by_name.find(ZoneNameKey(zonename));
+	return iter != zs_by_name.end() ? iter->second : 0;
 }
 
 ZoneServer* ZSList::FindByID(uint32 ZoneID) {
-	auto iterator = list.begin();
-	while (iterator != list.end()) {
-		if ((*iterator)->GetID() == ZoneID) {
-			ZoneServer* tmp = (*iterator).get();
-			return tmp;
-		}
-		iterator++;
-	}
-	return 0;
+	UpdateIndex();
+	auto iter = zs_by_id.find(ZoneID);
+	return iter != zs_by_id.end() ? iter->second : 0;
 }
 
 ZoneServer* ZSList::FindByZoneID(uint32 ZoneID) {
-	auto iterator = list.begin();
-	while (iterator != list.end()) {
-		ZoneServer* tmp = (*iterator).get();
-		if (tmp->GetZoneID() == ZoneID && tmp->GetInstanceID() == 0) {
-			return tmp;
-		}
-		iterator++;
+	UpdateIndex();
+	auto iter = zs_by_zone.find(ZoneID);
+	if (iter == zs_by_zone.end())
+		return 0;
+
+	for (auto zs : iter->second) {
+		if (zs->GetInstanceID() == 0)
+			return zs;
 	}
 	return 0;
 }
 
 ZoneServer* ZSList::FindByPort(uint16 port) {
-	auto iterator = list.begin();
-	while (iterator != list.end()) {
-		if ((*iterator)->GetCPort() == port) {
-			ZoneServer* tmp = (*iterator).get();
-			return tmp;
-		}
-		iterator++;
-	}
-	return 0;
+	UpdateIndex();
+	auto iter = zs_by_port.find(port);
+	return iter != zs_by_port.end() ? iter->second : 0;
 }
 
 ZoneServer* ZSList::FindByInstanceID(uint32 InstanceID)
 {
-	auto iterator = list.begin();
-	while (iterator != list.end()) {
-		if ((*iterator)->GetInstanceID() == InstanceID) {
-			ZoneServer* tmp = (*iterator).get();
-			return tmp;
-		}
-		iterator++;
-	}
-	return 0;
+	UpdateIndex();
+	auto iter = zs_by_instance.find(InstanceID);
+	return iter != zs_by_instance.end() ? iter->second : 0;
 }
 
 bool ZSList::SetLockedZone(uint16 iZoneID, bool iLock) {
@@ -7,6 +7,9 @@
 #include "../common/event/timer.h"
 #include <vector>
 #include <memory>
+#include <list>
+#include <string>
+#include <unordered_map>
 
 class WorldTCPConnection;
 class ServerPacket;
@@ -43,6 +46,9 @@ public:
 	bool	SendPacket(uint32 zoneid, ServerPacket* pack);
 	bool	SendPacket(uint32 zoneid, uint16 instanceid, ServerPacket* pack);
 	inline uint32	GetNextID()		{ return NextID++; }
+	inline uint32	NextSharedMemGeneration()	{ return ++CurSharedMemGeneration; }
+	// a zone server's id, zone, instance, port or name changed, or one came or went
+	inline void	ZoneServerChanged()	{ index_dirty = true; }
 	void	RebootZone(const char* ip1,uint16 port, const char* ip2, uint32 skipid, uint32 zoneid = 0);
 	uint32	TriggerBootup(uint32 iZoneID, uint32 iInstanceID = 0);
 	void	SOPZoneBootup(const char* adminname, uint32 ZoneServerID, const char* zonename, bool iMakeStatic = false);
@@ -62,11 +68,25 @@ public:
 
 private:
 	void OnTick(EQ::Timer *t);
+	void UpdateIndex();
 	uint32 NextID;
 	std::list<std::unique_ptr<ZoneServer>> list;
+
+	/*
+	 * Lookups over list, rebuilt on the first find after ZoneServerChanged().
+	 * Each key keeps the first server in list order so the answers match the
+	 * walks these replaced; zone id keeps every server on that zone in order.
+	 */
+	bool index_dirty;
+	std::unordered_map<uint32, ZoneServer*> zs_by_id;
+	std::unordered_map<uint32, ZoneServer*> zs_by_instance;
+	std::unordered_map<uint16, ZoneServer*> zs_by_port;
+	std::unordered_map<std::string, ZoneServer*> zs_by_name;
+	std::unordered_map<uint32, std::vector<ZoneServer*>> zs_by_zone;
 	uint16	pLockedZones[MaxLockedZones];
 	uint32 CurGroupID;
 	uint16 LastAllocatedPort;
+	uint32 CurSharedMemGeneration;
 
 	std::unique_ptr<EQ::Timer> m_tick;
 };
@@ -94,6 +94,7 @@ bool ZoneServer::SetZone(uint32 iZoneID, uint32 iInstanceID, bool iStaticZone) {
 
 	zone_server_zone_id = iZoneID;
 	instance_id = iInstanceID;
+	zoneserver_list.ZoneServerChanged();
 	if (iZoneID != 0)
 		zone_server_previous_zone_id = iZoneID;
 	if (zone_server_zone_id == 0) {
@@ -120,6 +121,7 @@ bool ZoneServer::SetZone(uint32 iZoneID, uint32 iInstanceID, bool iStaticZone) {
 		strcpy(zone_name, "");
 		strcpy(long_name, "");
 	}
+	zoneserver_list.ZoneServerChanged();
 
 	client_list.ZoneBootup(this);
 	zone_boot_timer.Start();
@@ -278,7 +280,9 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
+		ServerRaidGeneralAction_Struct* rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
+		client_list.SetRaidMember(rga->playername, rga->rid);
+		client_list.SendRaidPacket(rga->rid, pack);
 		break;
 	}
 
@@ -286,7 +290,10 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
+		// the member's own zone still needs this, so route before dropping them
+		ServerRaidGeneralAction_Struct* rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
+		client_list.SendRaidPacket(rga->rid, pack);
+		client_list.SetRaidMember(rga->playername, 0);
 		break;
 	}
 
@@ -294,89 +301,41 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidLockFlag: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidChangeGroup: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
+		ServerRaidGeneralAction_Struct* rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
+		client_list.SendRaidPacket(rga->rid, pack);
+		client_list.ClearRaid(rga->rid);
 		break;
 	}
 
-	case ServerOP_UpdateGroup: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidGroupDisband: {
+	case ServerOP_RaidLockFlag:
+	case ServerOP_RaidChangeGroup:
+	case ServerOP_UpdateGroup:
+	case ServerOP_RaidGroupDisband:
+	case ServerOP_RaidGroupLeader:
+	case ServerOP_RaidLeader:
+	case ServerOP_DetailsChange: {
 		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidGroupAdd: {
-		if (pack->size != sizeof(ServerRaidGroupAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
+		client_list.SendRaidPacket(((ServerRaidGeneralAction_Struct*)pack->pBuffer)->rid, pack);
 		break;
 	}
 
+	case ServerOP_RaidGroupAdd:
 	case ServerOP_RaidGroupRemove: {
 		if (pack->size != sizeof(ServerRaidGroupAction_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidGroupSay: {
-		zoneserver_list.SendPacket(pack);
+		client_list.SendRaidPacket(((ServerRaidGroupAction_Struct*)pack->pBuffer)->rid, pack);
 		break;
 	}
 
+	case ServerOP_RaidGroupSay:
 	case ServerOP_RaidSay: {
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidGroupLeader: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_RaidLeader: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
-			break;
-
-		zoneserver_list.SendPacket(pack);
-		break;
-	}
-
-	case ServerOP_DetailsChange: {
-		if (pack->size != sizeof(ServerRaidGeneralAction_Struct))
+		if (pack->size < sizeof(ServerRaidMessage_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
+		client_list.SendRaidPacket(((ServerRaidMessage_Struct*)pack->pBuffer)->rid, pack);
 		break;
 	}
 
@@ -384,7 +343,7 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 		if (pack->size < sizeof(ServerRaidMOTD_Struct))
 			break;
 
-		zoneserver_list.SendPacket(pack);
+		client_list.SendRaidPacket(((ServerRaidMOTD_Struct*)pack->pBuffer)->rid, pack);
 		break;
 	}
 
@@ -499,13 +458,19 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 					});
 				}
 			}
-			zoneserver_list.SendPacket(pack);
+			if (scm->chan_num == 0 && scm->guilddbid != 0)
+				client_list.SendGuildPacket(scm->guilddbid, pack);
+			else
+				zoneserver_list.SendPacket(pack);
 		}
 		break;
 	}
 	case ServerOP_EmoteMessage: {
 		ServerEmoteMessage_Struct* sem = (ServerEmoteMessage_Struct*)pack->pBuffer;
-		zoneserver_list.SendEmoteMessageRaw(sem->to, sem->guilddbid, sem->minstatus, sem->type, sem->message);
+		if (sem->to[0] == 0 && sem->guilddbid != 0)
+			client_list.SendGuildPacket(sem->guilddbid, pack);
+		else
+			zoneserver_list.SendEmoteMessageRaw(sem->to, sem->guilddbid, sem->minstatus, sem->type, sem->message);
 		break;
 	}
 	case ServerOP_VoiceMacro: {
@@ -593,6 +558,7 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 			client_port = sci->port;
 			Log(Logs::Detail, Logs::World_Server, "Zone specified port %d.", client_port);
 		}
+		zoneserver_list.ZoneServerChanged();
 
 		if (sci->address[0]) {
 			strn0cpy(client_address, sci->address, 250);
@@ -1311,7 +1277,14 @@ void ZoneServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p) {
 			Log(Logs::General, Logs::World_Server, "Error: Could not load skill cap data. But ignoring");
 		}
 
-		zoneserver_list.SendPacket(pack);
+		// zones switch over at the top of their next tick
+		auto outpack = new ServerPacket(ServerOP_SharedMemGeneration, sizeof(ServerSharedMemGeneration_Struct));
+		auto gen = (ServerSharedMemGeneration_Struct*)outpack->pBuffer;
+		gen->generation = zoneserver_list.NextSharedMemGeneration();
+		strn0cpy(gen->prefix, hotfix_name.c_str(), sizeof(gen->prefix));
+		Log(Logs::General, Logs::World_Server, "Shared memory generation %u available as '%s'", gen->generation, gen->prefix);
+		zoneserver_list.SendPacket(outpack);
+		safe_delete(outpack);
 		break;
 	}
 
@@ -1390,11 +1363,16 @@ void ZoneServer::ChangeWID(uint32 iCharID, uint32 iWID) {
 	delete pack;
 }
 
+void ZoneServer::SetInstanceID(uint32 i) {
+	instance_id = i;
+	zoneserver_list.ZoneServerChanged();
+}
 
 void ZoneServer::TriggerBootup(uint32 iZoneID, uint32 iInstanceID, const char* adminname, bool iMakeStatic) {
 	is_booting_up = true;
 	zone_server_zone_id = iZoneID;
 	instance_id = iInstanceID;
+	zoneserver_list.ZoneServerChanged();
 
 	auto pack = new ServerPacket(ServerOP_ZoneBootup, sizeof(ServerZoneStateChange_struct));
 	ServerZoneStateChange_struct* s = (ServerZoneStateChange_struct *)pack->pBuffer;
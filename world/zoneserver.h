@@ -72,7 +72,7 @@ public:
 	std::string         GetUUID() const { return tcpc->GetUUID(); }
 
 	inline uint32		GetInstanceID() { return instance_id; }
-	inline void			SetInstanceID(uint32 i) { instance_id = i; }
+	void				SetInstanceID(uint32 i);
 
 	inline uint32		GetZoneOSProcessID() { return zone_os_process_id; }
 
@@ -412,6 +412,23 @@ Mob* EntityList::AICheckNPCtoNPCAggro(Mob* sender, float iAggroRange, float iAss
 	if (!sender || !sender->IsNPC())
 		return(nullptr);
 
+	if (RuleB(Aggro, UseBroadphase)) {
+		// the grid hands back everything in the cells around sender, trim that to iAggroRange first
+		float range2 = iAggroRange * iAggroRange;
+		std::vector<uint16> candidates;
+		aggro_broadphase.GetNPCCandidates(sender, iAggroRange, candidates);
+		for (auto id : candidates) {
+			NPC *npc = GetNPCByID(id);
+			if (!npc || DistanceSquared(sender->GetPosition(), npc->GetPosition()) > range2)
+				continue;
+
+			if (sender->CheckWillAggro(npc))
+				return npc;
+		}
+
+		return nullptr;
+	}
+
 	auto it = npc_list.begin();
 	while (it != npc_list.end()) {
 		Mob *mob = it->second;
@@ -1004,7 +1021,7 @@ bool Mob::CheckLosFN(float posX, float posY, float posZ, float mobSize) {
 #if LOSDEBUG>=5
 	Log(Logs::General, Logs::None, "LOS from (%.2f, %.2f, %.2f) to (%.2f, %.2f, %.2f) sizes: (%.2f, %.2f)", myloc.x, myloc.y, myloc.z, oloc.x, oloc.y, oloc.z, GetSize(), mobSize);
 #endif
-	return zone->zonemap->CheckLoS(myloc, oloc);
+	return zone->los_cache.CheckLoS(zone->zonemap, myloc, oloc);
 }
 
 //offensive spell aggro
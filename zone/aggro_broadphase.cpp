@@ -0,0 +1,189 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "../common/global_define.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/rulesys.h"
+#include "../common/util/job_pool.h"
+
+#include "aggro_broadphase.h"
+#include "client.h"
+#include "entity.h"
+#include "mob.h"
+#include "npc.h"
+#include "zone.h"
+
+#include <algorithm>
+
+extern Zone *zone;
+
+AggroBroadphase::AggroBroadphase() :
+	npc_grid_max_range(0.0f),
+	npc_grid_timer(1000),
+	npc_grid_built(false),
+	last_client_count(0),
+	last_npc_count(0),
+	last_pairs_tested(0),
+	last_aggro_count(0)
+{
+}
+
+void AggroBroadphase::Clear()
+{
+	npc_grid.Clear();
+	pending_clients.clear();
+	npc_grid_built = false;
+}
+
+void AggroBroadphase::QueueClientScan(Client *c)
+{
+	if (!c)
+		return;
+
+	uint16 id = c->GetID();
+	if (std::find(pending_clients.begin(), pending_clients.end(), id) == pending_clients.end())
+		pending_clients.push_back(id);
+}
+
+/*
+ * Resolves every client queued since the last call against the NPCs in the
+ * grid cells around it. Checks that only depend on the client (loading, gm,
+ * ld state) are done once per client and the engaged/no aggro range checks
+ * once per pair before CheckWillAggro, which still does the exact range,
+ * faction, level and LOS checks exactly as the close_mobs scan did.
+ *
+ * The grid queries only read the grid, so with Zone:BroadphaseParallelClients
+ * or more clients queued they are handed to the job pool. Aggro itself is
+ * applied afterwards on the main thread in client queue order, which keeps
+ * results identical whatever the thread count. This is the only work the pool
+ * runs; NPC AI, movement and regen all stay on the main thread.
+ */
+void AggroBroadphase::Process()
+{
+	if (pending_clients.empty())
+		return;
+
+	client_scans.clear();
+	for (auto id : pending_clients) {
+		Client *c = entity_list.GetClientByID(id);
+		if (!c || c->GetFeigned())
+			continue;
+
+		if (!c->ClientFinishedLoading() || c->IsHoveringForRespawn() || c->IsZoning())
+			continue;
+
+		if (!c->Connected() || c->IsLD() || c->IsBecomeNPC() || c->GetGM())
+			continue;
+
+		EQ::SpatialGrid::Entry e;
+		e.id = id;
+		e.x = c->GetX();
+		e.y = c->GetY();
+		e.z = c->GetZ();
+		client_scans.push_back(e);
+	}
+	pending_clients.clear();
+
+	last_client_count = static_cast<uint32>(client_scans.size());
+	last_npc_count = 0;
+	last_pairs_tested = 0;
+	last_aggro_count = 0;
+
+	if (client_scans.empty() || !zone->CanDoCombat())
+		return;
+
+	if (!npc_grid_built || npc_grid_timer.Check())
+		BuildNPCGrid();
+
+	// no npc can reach a client from further away than the largest aggro range in the zone
+	auto &pool = EQ::JobPool::Get();
+	pool.SetThreadCount(static_cast<size_t>(std::max(RuleI(Zone, WorkerThreads), 0)));
+	npc_grid.QueryEach(client_scans, npc_grid_max_range + RuleI(Aggro, BroadphaseStaleMargin), pool,
+		static_cast<size_t>(std::max(RuleI(Zone, BroadphaseParallelClients), 1)), client_candidates);
+
+	// everything with side effects stays on the main thread, quest events fired from AddToHateList can spawn or depop
+	for (size_t i = 0; i < client_scans.size(); ++i) {
+		uint16 client_id = client_scans[i].id;
+		last_npc_count += static_cast<uint32>(client_candidates[i].size());
+		for (auto npc_id : client_candidates[i]) {
+			Client *c = entity_list.GetClientByID(client_id);
+			if (!c)
+				break;
+
+			NPC *npc = entity_list.GetNPCByID(npc_id);
+			if (!npc)
+				continue;
+
+			if (npc->IsEngaged() && !npc->GetSpecialAbility(PROX_AGGRO))
+				continue;
+
+			if (npc->GetAggroRange() <= 0.0f)
+				continue;
+
+			++last_pairs_tested;
+			if (npc->CheckWillAggro(c) && !npc->CheckAggro(c)) {
+				npc->AddToHateList(c, 25);
+				++last_aggro_count;
+			}
+		}
+	}
+
+	Log(Logs::General, Logs::Aggro, "Aggro broadphase: clients (%u) npcs near them (%u) pairs tested (%u) aggroed (%u)",
+		last_client_count, last_npc_count, last_pairs_tested, last_aggro_count);
+}
+
+void AggroBroadphase::BuildNPCGrid()
+{
+	npc_grid.Reset(static_cast<float>(std::max(RuleI(Aggro, BroadphaseCellSize), 10)));
+	npc_grid_max_range = 0.0f;
+	for (auto &it : entity_list.GetNPCList()) {
+		NPC *npc = it.second;
+		npc_grid_max_range = std::max(npc_grid_max_range, npc->GetAggroRange());
+
+		EQ::SpatialGrid::Entry e;
+		e.id = it.first;
+		e.x = npc->GetX();
+		e.y = npc->GetY();
+		e.z = npc->GetZ();
+		npc_grid.Insert(e);
+	}
+
+	npc_grid_built = true;
+	npc_grid_timer.Start(std::max(RuleI(Aggro, BroadphaseNPCGridInterval), 100));
+}
+
+/*
+ * NPC ids near sender, positions may be up to one rebuild interval old so the
+ * caller still has to do the exact range check (CheckWillAggro does)
+ */
+void AggroBroadphase::GetNPCCandidates(Mob *sender, float range, std::vector<uint16> &candidates)
+{
+	candidates.clear();
+	if (!sender)
+		return;
+
+	if (!npc_grid_built || npc_grid_timer.Check())
+		BuildNPCGrid();
+
+	range += RuleI(Aggro, BroadphaseStaleMargin);
+	npc_grid.Query(sender->GetX(), sender->GetY(), range, scratch);
+	for (auto e : scratch) {
+		if (e->id != sender->GetID())
+			candidates.push_back(e->id);
+	}
+}
@@ -0,0 +1,76 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef AGGRO_BROADPHASE_H
+#define AGGRO_BROADPHASE_H
+
+#include "../common/types.h"
+#include "../common/timer.h"
+#include "../common/util/spatial_grid.h"
+
+#include <vector>
+
+class Client;
+class Mob;
+
+/*
+ * Zone wide proximity aggro broadphase.
+ *
+ * Clients whose aggro scan timer fired queue themselves here instead of
+ * walking their close_mobs list, and once per tick every queued client looks
+ * up the NPCs in the grid cells around it. NPC to NPC aggro queries the same
+ * NPC grid instead of every npc_aggro NPC walking the whole npc_list. The
+ * grid is rebuilt at most once per interval, so queries are widened by a
+ * margin and the exact range check is left to CheckWillAggro.
+ *
+ * Only the grid queries run on the job pool (Zone:WorkerThreads), everything
+ * that touches an entity stays on the main thread.
+ */
+class AggroBroadphase
+{
+public:
+	AggroBroadphase();
+
+	void	QueueClientScan(Client *c);
+	void	Process();
+	void	GetNPCCandidates(Mob *sender, float range, std::vector<uint16> &candidates);
+	void	Clear();
+
+	inline uint32 GetLastClientCount() const { return last_client_count; }
+	inline uint32 GetLastNPCCount() const { return last_npc_count; }
+	inline uint32 GetLastPairsTested() const { return last_pairs_tested; }
+	inline uint32 GetLastAggroCount() const { return last_aggro_count; }
+
+private:
+	void	BuildNPCGrid();
+
+	EQ::SpatialGrid npc_grid;
+	float npc_grid_max_range;	// largest npc aggro range when the grid was built
+	std::vector<uint16> pending_clients;
+	std::vector<const EQ::SpatialGrid::Entry *> scratch;
+	std::vector<EQ::SpatialGrid::Entry> client_scans;
+	std::vector<std::vector<uint16>> client_candidates;
+	Timer npc_grid_timer;
+	bool npc_grid_built;
+
+	uint32 last_client_count;
+	uint32 last_npc_count;
+	uint32 last_pairs_tested;
+	uint32 last_aggro_count;
+};
+
+#endif /* AGGRO_BROADPHASE_H */
@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "../common/string_util.h"
 #include "../common/data_verification.h"
 #include "../common/misc_functions.h"
+#include "../common/item_hot_table.h"
 #include "queryserv.h"
 #include "quest_parser_collection.h"
 #include "string_ids.h"
@@ -54,15 +55,24 @@ extern EntityList entity_list;
 extern Zone* zone;
 
 EQEmu::skills::SkillType Mob::AttackAnimation(int Hand, const EQEmu::ItemInstance* weapon, EQEmu::skills::SkillType skillinuse)
+{
+	EQEmu::ItemHotFlags weapon_flags;
+	if (weapon && weapon->GetItem()) {
+		weapon_flags.Set(*weapon->GetItem());
+		return AttackAnimation(Hand, &weapon_flags, skillinuse);
+	}
+
+	return AttackAnimation(Hand, (const EQEmu::ItemHotFlags*)nullptr, skillinuse);
+}
+
+EQEmu::skills::SkillType Mob::AttackAnimation(int Hand, const EQEmu::ItemHotFlags* weapon, EQEmu::skills::SkillType skillinuse)
 {
 	// Determine animation
 	int type = 0;
-	if (weapon && weapon->IsClassCommon()) {
-		const EQEmu::ItemData* item = weapon->GetItem();
-
-		Log(Logs::Detail, Logs::Attack, "Weapon skill : %i", item->ItemType);
+	if (weapon && weapon->ItemClass == EQEmu::item::ItemClassCommon) {
+		Log(Logs::Detail, Logs::Attack, "Weapon skill : %i", weapon->ItemType);
 
-		switch (item->ItemType) {
+		switch (weapon->ItemType) {
 		case EQEmu::item::ItemType1HSlash: // 1H Slashing
 			skillinuse = EQEmu::skills::Skill1HSlashing;
 			type = anim1HWeapon;
@@ -929,6 +939,16 @@ void Mob::MeleeMitigation(Mob *attacker, DamageHitInfo &hit, ExtraAttackOptions
 //GetWeaponDamage(mob*, const EQEmu::ItemData*) is intended to be used for mobs or any other situation where we do not have a client inventory item
 //GetWeaponDamage(mob*, const EQEmu::ItemInstance*) is intended to be used for situations where we have a client inventory item
 int Mob::GetWeaponDamage(Mob *against, const EQEmu::ItemData *weapon_item) {
+	if (!weapon_item)
+		return GetWeaponDamage(against, (const EQEmu::ItemHotFlags*)nullptr);
+
+	EQEmu::ItemHotFlags weapon_flags;
+	weapon_flags.Set(*weapon_item);
+	return GetWeaponDamage(against, &weapon_flags);
+}
+
+//Same as above from the packed item row, NPC swings read their weapon straight out of the shared item table
+int Mob::GetWeaponDamage(Mob *against, const EQEmu::ItemHotFlags *weapon_item) {
 	int dmg = 0;
 	int banedmg = 0;
 
@@ -1615,7 +1635,8 @@ bool Client::Death(Mob* killerMob, int32 damage, uint16 spell, EQEmu::skills::Sk
 	if (killerMob != nullptr)
 	{
 		if (killerMob->IsNPC()) {
-			parse->EventNPC(EVENT_SLAY, killerMob->CastToNPC(), this, "", 0);
+			if (parse->HasAnySub(killerMob->CastToNPC(), EVENT_SLAY))
+				parse->EventNPC(EVENT_SLAY, killerMob->CastToNPC(), this, "", 0);
 
 			mod_client_death_npc(killerMob);
 
@@ -1871,16 +1892,27 @@ bool NPC::Attack(Mob* other, int Hand, bool bRiposte, bool IsStrikethrough, bool
 	}
 
 	//figure out what weapon they are using, if any
-	const EQEmu::ItemData* weapon = nullptr;
+	uint32 weapon_id = 0;
 	if (Hand == EQEmu::inventory::slotPrimary && equipment[EQEmu::inventory::slotPrimary] > 0)
-		weapon = database.GetItem(equipment[EQEmu::inventory::slotPrimary]);
+		weapon_id = equipment[EQEmu::inventory::slotPrimary];
 	else if (equipment[EQEmu::inventory::slotSecondary])
-		weapon = database.GetItem(equipment[EQEmu::inventory::slotSecondary]);
+		weapon_id = equipment[EQEmu::inventory::slotSecondary];
+
+	//everything a swing reads from the weapon is in its packed row, only build one if the table is missing
+	EQEmu::ItemHotFlags weapon_flags;
+	const EQEmu::ItemHotFlags* weapon = database.GetItemHotFlags(weapon_id);
+	if (!weapon && weapon_id) {
+		const EQEmu::ItemData* weapon_item = database.GetItem(weapon_id);
+		if (weapon_item) {
+			weapon_flags.Set(*weapon_item);
+			weapon = &weapon_flags;
+		}
+	}
 
 	//We dont factor much from the weapon into the attack.
 	//Just the skill type so it doesn't look silly using punching animations and stuff while wielding weapons
 	if (weapon) {
-		Log(Logs::Detail, Logs::Combat, "Attacking with weapon: %s (%d) (too bad im not using it for much)", weapon->Name, weapon->ID);
+		Log(Logs::Detail, Logs::Combat, "Attacking with weapon: %d (too bad im not using it for much)", weapon->ID);
 
 		if (Hand == EQEmu::inventory::slotSecondary && weapon->ItemType == EQEmu::item::ItemTypeShield) {
 			Log(Logs::Detail, Logs::Combat, "Attack with shield canceled.");
@@ -1922,9 +1954,7 @@ bool NPC::Attack(Mob* other, int Hand, bool bRiposte, bool IsStrikethrough, bool
 	int weapon_damage = GetWeaponDamage(other, weapon);
 
 	//do attack animation regardless of whether or not we can hit below
-	int16 charges = 0;
-	EQEmu::ItemInstance weapon_inst(weapon, charges);
-	my_hit.skill = AttackAnimation(Hand, &weapon_inst, my_hit.skill);
+	my_hit.skill = AttackAnimation(Hand, weapon, my_hit.skill);
 
 	//basically "if not immune" then do the attack
 	if (weapon_damage > 0) {
@@ -2013,10 +2043,11 @@ bool NPC::Attack(Mob* other, int Hand, bool bRiposte, bool IsStrikethrough, bool
 		return true; //We killed them
 
 	if (!bRiposte && !other->HasDied()) {
-		TryWeaponProc(nullptr, weapon, other, Hand);	//no weapon
+		const EQEmu::ItemData* weapon_item = weapon ? database.GetItem(weapon_id) : nullptr;
+		TryWeaponProc(nullptr, weapon_item, other, Hand);	//no weapon
 
 		if (!other->HasDied())
-			TrySpellProc(nullptr, weapon, other, Hand);
+			TrySpellProc(nullptr, weapon_item, other, Hand);
 
 		if (my_hit.damage_done > 0 && HasSkillProcSuccess() && !other->HasDied())
 			TrySkillProc(other, my_hit.skill, 0, true, Hand);
@@ -2036,8 +2067,10 @@ void NPC::Damage(Mob* other, int32 damage, uint16 spell_id, EQEmu::skills::Skill
 	if (spell_id == 0)
 		spell_id = SPELL_UNKNOWN;
 
+	WakeAI();
+
 	//handle EVENT_ATTACK. Resets after we have not been attacked for 12 seconds
-	if (attacked_timer.Check())
+	if (attacked_timer.Check() && parse->HasAnySub(this, EVENT_ATTACK))
 	{
 		Log(Logs::Detail, Logs::Combat, "Triggering EVENT_ATTACK due to attack by %s", other ? other->GetName() : "nullptr");
 		parse->EventNPC(EVENT_ATTACK, this, other, "", 0);
@@ -2084,14 +2117,16 @@ bool NPC::Death(Mob* killer_mob, int32 damage, uint16 spell, EQEmu::skills::Skil
 	if (killer_mob) {
 		oos = killer_mob->GetOwnerOrSelf();
 
-		char buffer[48] = { 0 };
-		snprintf(buffer, 47, "%d %d %d %d", killer_mob->GetID(), damage, spell, static_cast<int>(attack_skill));
+		if (parse->HasAnySub(this, EVENT_DEATH)) {
+			char buffer[48] = { 0 };
+			snprintf(buffer, 47, "%d %d %d %d", killer_mob->GetID(), damage, spell, static_cast<int>(attack_skill));
 
-		if (parse->EventNPC(EVENT_DEATH, this, oos, buffer, 0) != 0) {
-			if (GetHP() < 0) {
-				SetHP(0);
+			if (parse->EventNPC(EVENT_DEATH, this, oos, buffer, 0) != 0) {
+				if (GetHP() < 0) {
+					SetHP(0);
+				}
+				return false;
 			}
-			return false;
 		}
 
 		if (killer_mob->IsClient() && (spell != SPELL_UNKNOWN) && damage > 0) {
@@ -2109,7 +2144,7 @@ bool NPC::Death(Mob* killer_mob, int32 damage, uint16 spell, EQEmu::skills::Skil
 				);
 		}
 	}
-	else {
+	else if (parse->HasAnySub(this, EVENT_DEATH)) {
 		char buffer[48] = { 0 };
 		snprintf(buffer, 47, "%d %d %d %d", 0, damage, spell, static_cast<int>(attack_skill));
 
@@ -2221,6 +2256,7 @@ bool NPC::Death(Mob* killer_mob, int32 damage, uint16 spell, EQEmu::skills::Skil
 	if (give_exp_client && !IsCorpse()) {
 		Group *kg = entity_list.GetGroupByClient(give_exp_client);
 		Raid *kr = entity_list.GetRaidByClient(give_exp_client);
+		bool has_killed_merit = parse->HasAnySub(this, EVENT_KILLED_MERIT);
 
 		int32 finalxp = give_exp_client->GetExperienceForKill(this);
 		finalxp = give_exp_client->mod_client_xp(finalxp, this);
@@ -2236,7 +2272,8 @@ bool NPC::Death(Mob* killer_mob, int32 damage, uint16 spell, EQEmu::skills::Skil
 			for (int i = 0; i < MAX_RAID_MEMBERS; i++) {
 				if (kr->members[i].member != nullptr && kr->members[i].member->IsClient()) { // If Group Member is Client
 					Client *c = kr->members[i].member;
-					parse->EventNPC(EVENT_KILLED_MERIT, this, c, "killed", 0);
+					if (has_killed_merit)
+						parse->EventNPC(EVENT_KILLED_MERIT, this, c, "killed", 0);
 
 					if (RuleB(NPC, EnableMeritBasedFaction))
 						c->SetFactionLevel(c->CharacterID(), GetNPCFactionID(), c->GetBaseClass(), c->GetBaseRace(), c->GetDeity());
@@ -2285,7 +2322,8 @@ bool NPC::Death(Mob* killer_mob, int32 damage, uint16 spell, EQEmu::skills::Skil
 			for (int i = 0; i < MAX_GROUP_MEMBERS; i++) {
 				if (kg->members[i] != nullptr && kg->members[i]->IsClient()) { // If Group Member is Client
 					Client *c = kg->members[i]->CastToClient();
-					parse->EventNPC(EVENT_KILLED_MERIT, this, c, "killed", 0);
+					if (has_killed_merit)
+						parse->EventNPC(EVENT_KILLED_MERIT, this, c, "killed", 0);
 
 					if (RuleB(NPC, EnableMeritBasedFaction))
 						c->SetFactionLevel(c->CharacterID(), GetNPCFactionID(), c->GetBaseClass(), c->GetBaseRace(), c->GetDeity());
@@ -2335,7 +2373,8 @@ bool NPC::Death(Mob* killer_mob, int32 damage, uint16 spell, EQEmu::skills::Skil
 			}
 
 			/* Send the EVENT_KILLED_MERIT event */
-			parse->EventNPC(EVENT_KILLED_MERIT, this, give_exp_client, "killed", 0);
+			if (has_killed_merit)
+				parse->EventNPC(EVENT_KILLED_MERIT, this, give_exp_client, "killed", 0);
 
 			if (RuleB(NPC, EnableMeritBasedFaction))
 				give_exp_client->SetFactionLevel(give_exp_client->CharacterID(), GetNPCFactionID(), give_exp_client->GetBaseClass(),
@@ -2478,7 +2517,8 @@ bool NPC::Death(Mob* killer_mob, int32 damage, uint16 spell, EQEmu::skills::Skil
 		if (emoteid != 0)
 			this->DoNPCEmote(ONDEATH, emoteid);
 		if (oos->IsNPC()) {
-			parse->EventNPC(EVENT_NPC_SLAY, oos->CastToNPC(), this, "", 0);
+			if (parse->HasAnySub(oos->CastToNPC(), EVENT_NPC_SLAY))
+				parse->EventNPC(EVENT_NPC_SLAY, oos->CastToNPC(), this, "", 0);
 			uint16 emoteid = oos->GetEmoteID();
 			if (emoteid != 0)
 				oos->CastToNPC()->DoNPCEmote(KILLEDNPC, emoteid);
@@ -2494,16 +2534,19 @@ bool NPC::Death(Mob* killer_mob, int32 damage, uint16 spell, EQEmu::skills::Skil
 
 	entity_list.UpdateFindableNPCState(this, true);
 
-	char buffer[48] = { 0 };
-	snprintf(buffer, 47, "%d %d %d %d", killer_mob ? killer_mob->GetID() : 0, damage, spell, static_cast<int>(attack_skill));
-	parse->EventNPC(EVENT_DEATH_COMPLETE, this, oos, buffer, 0);
+	if (parse->HasAnySub(this, EVENT_DEATH_COMPLETE)) {
+		char buffer[48] = { 0 };
+		snprintf(buffer, 47, "%d %d %d %d", killer_mob ? killer_mob->GetID() : 0, damage, spell, static_cast<int>(attack_skill));
+		parse->EventNPC(EVENT_DEATH_COMPLETE, this, oos, buffer, 0);
+	}
 
 	/* Zone controller process EVENT_DEATH_ZONE (Death events) */
 	if (RuleB(Zone, UseZoneController)) {
-		if (entity_list.GetNPCByNPCTypeID(ZONE_CONTROLLER_NPC_ID) && this->GetNPCTypeID() != ZONE_CONTROLLER_NPC_ID) {
+		NPC *controller = entity_list.GetNPCByNPCTypeID(ZONE_CONTROLLER_NPC_ID);
+		if (controller && this->GetNPCTypeID() != ZONE_CONTROLLER_NPC_ID && parse->HasAnySub(controller, EVENT_DEATH_ZONE)) {
 			char data_pass[100] = { 0 };
 			snprintf(data_pass, 99, "%d %d %d %d %d", killer_mob ? killer_mob->GetID() : 0, damage, spell, static_cast<int>(attack_skill), this->GetNPCTypeID());
-			parse->EventNPC(EVENT_DEATH_ZONE, entity_list.GetNPCByNPCTypeID(ZONE_CONTROLLER_NPC_ID)->CastToNPC(), nullptr, data_pass, 0);
+			parse->EventNPC(EVENT_DEATH_ZONE, controller, nullptr, data_pass, 0);
 		}
 	}
 
@@ -2678,7 +2721,7 @@ void Mob::AddToHateList(Mob* other, uint32 hate /*= 0*/, int32 damage /*= 0*/, b
 		entity_list.AddTempPetsToHateList(other, this, bFrenzy);
 
 	if (!wasengaged) {
-		if (IsNPC() && other->IsClient() && other->CastToClient())
+		if (IsNPC() && other->IsClient() && other->CastToClient() && parse->HasAnySub(CastToNPC(), EVENT_AGGRO))
 			parse->EventNPC(EVENT_AGGRO, this->CastToNPC(), other, "", 0);
 		AI_Event_Engaged(other, iYellForHelp);
 	}
@@ -17,6 +17,7 @@
 */
 #include "../common/classes.h"
 #include "../common/global_define.h"
+#include "../common/item_hot_table.h"
 #include "../common/item_instance.h"
 #include "../common/rulesys.h"
 #include "../common/skills.h"
@@ -237,6 +238,16 @@ void Client::AddItemBonuses(const EQEmu::ItemInstance *inst, StatBonuses *newbon
 	if (GetLevel() < inst->GetItemRequiredLevel(true)) {
 		return;
 	}
+
+	// read the packed shared memory row unless this instance carries its own (scaled) item data
+	EQEmu::ItemHotStats item_stats;
+	const EQEmu::ItemHotStats *stats = nullptr;
+	if (item == inst->GetUnscaledItem())
+		stats = database.GetItemHotStats(inst);
+	if (!stats) {
+		item_stats.Set(*item);
+		stats = &item_stats;
+	}
 	
 	// So there isn't a very nice way to get the real rec level from the aug's inst, so we just pass it in, only
 	// used for augs
@@ -244,294 +255,294 @@ void Client::AddItemBonuses(const EQEmu::ItemInstance *inst, StatBonuses *newbon
 
 	if (!ammo_slot_item) {
 		if (GetLevel() >= rec_level) {
-			newbon->AC += item->AC;
-			newbon->HP += item->HP;
-			newbon->Mana += item->Mana;
-			newbon->Endurance += item->Endur;
-			newbon->ATK += item->Attack;
-			newbon->STR += (item->AStr + item->HeroicStr);
-			newbon->STA += (item->ASta + item->HeroicSta);
-			newbon->DEX += (item->ADex + item->HeroicDex);
-			newbon->AGI += (item->AAgi + item->HeroicAgi);
-			newbon->INT += (item->AInt + item->HeroicInt);
-			newbon->WIS += (item->AWis + item->HeroicWis);
-			newbon->CHA += (item->ACha + item->HeroicCha);
-
-			newbon->MR += (item->MR + item->HeroicMR);
-			newbon->FR += (item->FR + item->HeroicFR);
-			newbon->CR += (item->CR + item->HeroicCR);
-			newbon->PR += (item->PR + item->HeroicPR);
-			newbon->DR += (item->DR + item->HeroicDR);
-			newbon->Corrup += (item->SVCorruption + item->HeroicSVCorrup);
-
-			newbon->STRCapMod += item->HeroicStr;
-			newbon->STACapMod += item->HeroicSta;
-			newbon->DEXCapMod += item->HeroicDex;
-			newbon->AGICapMod += item->HeroicAgi;
-			newbon->INTCapMod += item->HeroicInt;
-			newbon->WISCapMod += item->HeroicWis;
-			newbon->CHACapMod += item->HeroicCha;
-			newbon->MRCapMod += item->HeroicMR;
-			newbon->CRCapMod += item->HeroicFR;
-			newbon->FRCapMod += item->HeroicCR;
-			newbon->PRCapMod += item->HeroicPR;
-			newbon->DRCapMod += item->HeroicDR;
-			newbon->CorrupCapMod += item->HeroicSVCorrup;
-
-			newbon->HeroicSTR += item->HeroicStr;
-			newbon->HeroicSTA += item->HeroicSta;
-			newbon->HeroicDEX += item->HeroicDex;
-			newbon->HeroicAGI += item->HeroicAgi;
-			newbon->HeroicINT += item->HeroicInt;
-			newbon->HeroicWIS += item->HeroicWis;
-			newbon->HeroicCHA += item->HeroicCha;
-			newbon->HeroicMR += item->HeroicMR;
-			newbon->HeroicFR += item->HeroicFR;
-			newbon->HeroicCR += item->HeroicCR;
-			newbon->HeroicPR += item->HeroicPR;
-			newbon->HeroicDR += item->HeroicDR;
-			newbon->HeroicCorrup += item->HeroicSVCorrup;
+			newbon->AC += stats->AC;
+			newbon->HP += stats->HP;
+			newbon->Mana += stats->Mana;
+			newbon->Endurance += stats->Endur;
+			newbon->ATK += stats->Attack;
+			newbon->STR += (stats->AStr + stats->HeroicStr);
+			newbon->STA += (stats->ASta + stats->HeroicSta);
+			newbon->DEX += (stats->ADex + stats->HeroicDex);
+			newbon->AGI += (stats->AAgi + stats->HeroicAgi);
+			newbon->INT += (stats->AInt + stats->HeroicInt);
+			newbon->WIS += (stats->AWis + stats->HeroicWis);
+			newbon->CHA += (stats->ACha + stats->HeroicCha);
+
+			newbon->MR += (stats->MR + stats->HeroicMR);
+			newbon->FR += (stats->FR + stats->HeroicFR);
+			newbon->CR += (stats->CR + stats->HeroicCR);
+			newbon->PR += (stats->PR + stats->HeroicPR);
+			newbon->DR += (stats->DR + stats->HeroicDR);
+			newbon->Corrup += (stats->SVCorruption + stats->HeroicSVCorrup);
+
+			newbon->STRCapMod += stats->HeroicStr;
+			newbon->STACapMod += stats->HeroicSta;
+			newbon->DEXCapMod += stats->HeroicDex;
+			newbon->AGICapMod += stats->HeroicAgi;
+			newbon->INTCapMod += stats->HeroicInt;
+			newbon->WISCapMod += stats->HeroicWis;
+			newbon->CHACapMod += stats->HeroicCha;
+			newbon->MRCapMod += stats->HeroicMR;
+			newbon->CRCapMod += stats->HeroicFR;
+			newbon->FRCapMod += stats->HeroicCR;
+			newbon->PRCapMod += stats->HeroicPR;
+			newbon->DRCapMod += stats->HeroicDR;
+			newbon->CorrupCapMod += stats->HeroicSVCorrup;
+
+			newbon->HeroicSTR += stats->HeroicStr;
+			newbon->HeroicSTA += stats->HeroicSta;
+			newbon->HeroicDEX += stats->HeroicDex;
+			newbon->HeroicAGI += stats->HeroicAgi;
+			newbon->HeroicINT += stats->HeroicInt;
+			newbon->HeroicWIS += stats->HeroicWis;
+			newbon->HeroicCHA += stats->HeroicCha;
+			newbon->HeroicMR += stats->HeroicMR;
+			newbon->HeroicFR += stats->HeroicFR;
+			newbon->HeroicCR += stats->HeroicCR;
+			newbon->HeroicPR += stats->HeroicPR;
+			newbon->HeroicDR += stats->HeroicDR;
+			newbon->HeroicCorrup += stats->HeroicSVCorrup;
 
 		}
 		else {
 			int lvl = GetLevel();
 
-			newbon->AC += CalcRecommendedLevelBonus(lvl, rec_level, item->AC);
-			newbon->HP += CalcRecommendedLevelBonus(lvl, rec_level, item->HP);
-			newbon->Mana += CalcRecommendedLevelBonus(lvl, rec_level, item->Mana);
-			newbon->Endurance += CalcRecommendedLevelBonus(lvl, rec_level, item->Endur);
-			newbon->ATK += CalcRecommendedLevelBonus(lvl, rec_level, item->Attack);
-			newbon->STR += CalcRecommendedLevelBonus(lvl, rec_level, (item->AStr + item->HeroicStr));
-			newbon->STA += CalcRecommendedLevelBonus(lvl, rec_level, (item->ASta + item->HeroicSta));
-			newbon->DEX += CalcRecommendedLevelBonus(lvl, rec_level, (item->ADex + item->HeroicDex));
-			newbon->AGI += CalcRecommendedLevelBonus(lvl, rec_level, (item->AAgi + item->HeroicAgi));
-			newbon->INT += CalcRecommendedLevelBonus(lvl, rec_level, (item->AInt + item->HeroicInt));
-			newbon->WIS += CalcRecommendedLevelBonus(lvl, rec_level, (item->AWis + item->HeroicWis));
-			newbon->CHA += CalcRecommendedLevelBonus(lvl, rec_level, (item->ACha + item->HeroicCha));
-
-			newbon->MR += CalcRecommendedLevelBonus(lvl, rec_level, (item->MR + item->HeroicMR));
-			newbon->FR += CalcRecommendedLevelBonus(lvl, rec_level, (item->FR + item->HeroicFR));
-			newbon->CR += CalcRecommendedLevelBonus(lvl, rec_level, (item->CR + item->HeroicCR));
-			newbon->PR += CalcRecommendedLevelBonus(lvl, rec_level, (item->PR + item->HeroicPR));
-			newbon->DR += CalcRecommendedLevelBonus(lvl, rec_level, (item->DR + item->HeroicDR));
+			newbon->AC += CalcRecommendedLevelBonus(lvl, rec_level, stats->AC);
+			newbon->HP += CalcRecommendedLevelBonus(lvl, rec_level, stats->HP);
+			newbon->Mana += CalcRecommendedLevelBonus(lvl, rec_level, stats->Mana);
+			newbon->Endurance += CalcRecommendedLevelBonus(lvl, rec_level, stats->Endur);
+			newbon->ATK += CalcRecommendedLevelBonus(lvl, rec_level, stats->Attack);
+			newbon->STR += CalcRecommendedLevelBonus(lvl, rec_level, (stats->AStr + stats->HeroicStr));
+			newbon->STA += CalcRecommendedLevelBonus(lvl, rec_level, (stats->ASta + stats->HeroicSta));
+			newbon->DEX += CalcRecommendedLevelBonus(lvl, rec_level, (stats->ADex + stats->HeroicDex));
+			newbon->AGI += CalcRecommendedLevelBonus(lvl, rec_level, (stats->AAgi + stats->HeroicAgi));
+			newbon->INT += CalcRecommendedLevelBonus(lvl, rec_level, (stats->AInt + stats->HeroicInt));
+			newbon->WIS += CalcRecommendedLevelBonus(lvl, rec_level, (stats->AWis + stats->HeroicWis));
+			newbon->CHA += CalcRecommendedLevelBonus(lvl, rec_level, (stats->ACha + stats->HeroicCha));
+
+			newbon->MR += CalcRecommendedLevelBonus(lvl, rec_level, (stats->MR + stats->HeroicMR));
+			newbon->FR += CalcRecommendedLevelBonus(lvl, rec_level, (stats->FR + stats->HeroicFR));
+			newbon->CR += CalcRecommendedLevelBonus(lvl, rec_level, (stats->CR + stats->HeroicCR));
+			newbon->PR += CalcRecommendedLevelBonus(lvl, rec_level, (stats->PR + stats->HeroicPR));
+			newbon->DR += CalcRecommendedLevelBonus(lvl, rec_level, (stats->DR + stats->HeroicDR));
 			newbon->Corrup +=
-				CalcRecommendedLevelBonus(lvl, rec_level, (item->SVCorruption + item->HeroicSVCorrup));
-
-			newbon->STRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicStr);
-			newbon->STACapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicSta);
-			newbon->DEXCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicDex);
-			newbon->AGICapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicAgi);
-			newbon->INTCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicInt);
-			newbon->WISCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicWis);
-			newbon->CHACapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicCha);
-			newbon->MRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicMR);
-			newbon->CRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicFR);
-			newbon->FRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicCR);
-			newbon->PRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicPR);
-			newbon->DRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicDR);
-			newbon->CorrupCapMod += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicSVCorrup);
-
-			newbon->HeroicSTR += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicStr);
-			newbon->HeroicSTA += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicSta);
-			newbon->HeroicDEX += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicDex);
-			newbon->HeroicAGI += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicAgi);
-			newbon->HeroicINT += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicInt);
-			newbon->HeroicWIS += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicWis);
-			newbon->HeroicCHA += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicCha);
-			newbon->HeroicMR += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicMR);
-			newbon->HeroicFR += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicFR);
-			newbon->HeroicCR += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicCR);
-			newbon->HeroicPR += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicPR);
-			newbon->HeroicDR += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicDR);
-			newbon->HeroicCorrup += CalcRecommendedLevelBonus(lvl, rec_level, item->HeroicSVCorrup);
+				CalcRecommendedLevelBonus(lvl, rec_level, (stats->SVCorruption + stats->HeroicSVCorrup));
+
+			newbon->STRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicStr);
+			newbon->STACapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicSta);
+			newbon->DEXCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicDex);
+			newbon->AGICapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicAgi);
+			newbon->INTCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicInt);
+			newbon->WISCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicWis);
+			newbon->CHACapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicCha);
+			newbon->MRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicMR);
+			newbon->CRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicFR);
+			newbon->FRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicCR);
+			newbon->PRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicPR);
+			newbon->DRCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicDR);
+			newbon->CorrupCapMod += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicSVCorrup);
+
+			newbon->HeroicSTR += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicStr);
+			newbon->HeroicSTA += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicSta);
+			newbon->HeroicDEX += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicDex);
+			newbon->HeroicAGI += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicAgi);
+			newbon->HeroicINT += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicInt);
+			newbon->HeroicWIS += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicWis);
+			newbon->HeroicCHA += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicCha);
+			newbon->HeroicMR += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicMR);
+			newbon->HeroicFR += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicFR);
+			newbon->HeroicCR += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicCR);
+			newbon->HeroicPR += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicPR);
+			newbon->HeroicDR += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicDR);
+			newbon->HeroicCorrup += CalcRecommendedLevelBonus(lvl, rec_level, stats->HeroicSVCorrup);
 		}
 
 		// FatherNitwit: New style haste, shields, and regens
-		if (newbon->haste < (int32)item->Haste) {
-			newbon->haste = item->Haste;
+		if (newbon->haste < (int32)stats->Haste) {
+			newbon->haste = stats->Haste;
 		}
-		if (item->Regen > 0)
-			newbon->HPRegen += item->Regen;
+		if (stats->Regen > 0)
+			newbon->HPRegen += stats->Regen;
 
-		if (item->ManaRegen > 0)
-			newbon->ManaRegen += item->ManaRegen;
+		if (stats->ManaRegen > 0)
+			newbon->ManaRegen += stats->ManaRegen;
 
-		if (item->EnduranceRegen > 0)
-			newbon->EnduranceRegen += item->EnduranceRegen;
+		if (stats->EnduranceRegen > 0)
+			newbon->EnduranceRegen += stats->EnduranceRegen;
 
-		if (item->DamageShield > 0) {
-			if ((newbon->DamageShield + item->DamageShield) > RuleI(Character, ItemDamageShieldCap))
+		if (stats->DamageShield > 0) {
+			if ((newbon->DamageShield + stats->DamageShield) > RuleI(Character, ItemDamageShieldCap))
 				newbon->DamageShield = RuleI(Character, ItemDamageShieldCap);
 			else
-				newbon->DamageShield += item->DamageShield;
+				newbon->DamageShield += stats->DamageShield;
 		}
-		if (item->SpellShield > 0) {
-			if ((newbon->SpellShield + item->SpellShield) > RuleI(Character, ItemSpellShieldingCap))
+		if (stats->SpellShield > 0) {
+			if ((newbon->SpellShield + stats->SpellShield) > RuleI(Character, ItemSpellShieldingCap))
 				newbon->SpellShield = RuleI(Character, ItemSpellShieldingCap);
 			else
-				newbon->SpellShield += item->SpellShield;
+				newbon->SpellShield += stats->SpellShield;
 		}
-		if (item->Shielding > 0) {
-			if ((newbon->MeleeMitigation + item->Shielding) > RuleI(Character, ItemShieldingCap))
+		if (stats->Shielding > 0) {
+			if ((newbon->MeleeMitigation + stats->Shielding) > RuleI(Character, ItemShieldingCap))
 				newbon->MeleeMitigation = RuleI(Character, ItemShieldingCap);
 			else
-				newbon->MeleeMitigation += item->Shielding;
+				newbon->MeleeMitigation += stats->Shielding;
 		}
-		if (item->StunResist > 0) {
-			if ((newbon->StunResist + item->StunResist) > RuleI(Character, ItemStunResistCap))
+		if (stats->StunResist > 0) {
+			if ((newbon->StunResist + stats->StunResist) > RuleI(Character, ItemStunResistCap))
 				newbon->StunResist = RuleI(Character, ItemStunResistCap);
 			else
-				newbon->StunResist += item->StunResist;
+				newbon->StunResist += stats->StunResist;
 		}
-		if (item->StrikeThrough > 0) {
-			if ((newbon->StrikeThrough + item->StrikeThrough) > RuleI(Character, ItemStrikethroughCap))
+		if (stats->StrikeThrough > 0) {
+			if ((newbon->StrikeThrough + stats->StrikeThrough) > RuleI(Character, ItemStrikethroughCap))
 				newbon->StrikeThrough = RuleI(Character, ItemStrikethroughCap);
 			else
-				newbon->StrikeThrough += item->StrikeThrough;
+				newbon->StrikeThrough += stats->StrikeThrough;
 		}
-		if (item->Avoidance > 0) {
-			if ((newbon->AvoidMeleeChance + item->Avoidance) > RuleI(Character, ItemAvoidanceCap))
+		if (stats->Avoidance > 0) {
+			if ((newbon->AvoidMeleeChance + stats->Avoidance) > RuleI(Character, ItemAvoidanceCap))
 				newbon->AvoidMeleeChance = RuleI(Character, ItemAvoidanceCap);
 			else
-				newbon->AvoidMeleeChance += item->Avoidance;
+				newbon->AvoidMeleeChance += stats->Avoidance;
 		}
-		if (item->Accuracy > 0) {
-			if ((newbon->HitChance + item->Accuracy) > RuleI(Character, ItemAccuracyCap))
+		if (stats->Accuracy > 0) {
+			if ((newbon->HitChance + stats->Accuracy) > RuleI(Character, ItemAccuracyCap))
 				newbon->HitChance = RuleI(Character, ItemAccuracyCap);
 			else
-				newbon->HitChance += item->Accuracy;
+				newbon->HitChance += stats->Accuracy;
 		}
-		if (item->CombatEffects > 0) {
-			if ((newbon->ProcChance + item->CombatEffects) > RuleI(Character, ItemCombatEffectsCap))
+		if (stats->CombatEffects > 0) {
+			if ((newbon->ProcChance + stats->CombatEffects) > RuleI(Character, ItemCombatEffectsCap))
 				newbon->ProcChance = RuleI(Character, ItemCombatEffectsCap);
 			else
-				newbon->ProcChance += item->CombatEffects;
+				newbon->ProcChance += stats->CombatEffects;
 		}
-		if (item->DotShielding > 0) {
-			if ((newbon->DoTShielding + item->DotShielding) > RuleI(Character, ItemDoTShieldingCap))
+		if (stats->DotShielding > 0) {
+			if ((newbon->DoTShielding + stats->DotShielding) > RuleI(Character, ItemDoTShieldingCap))
 				newbon->DoTShielding = RuleI(Character, ItemDoTShieldingCap);
 			else
-				newbon->DoTShielding += item->DotShielding;
+				newbon->DoTShielding += stats->DotShielding;
 		}
 
-		if (item->HealAmt > 0) {
-			if ((newbon->HealAmt + item->HealAmt) > RuleI(Character, ItemHealAmtCap))
+		if (stats->HealAmt > 0) {
+			if ((newbon->HealAmt + stats->HealAmt) > RuleI(Character, ItemHealAmtCap))
 				newbon->HealAmt = RuleI(Character, ItemHealAmtCap);
 			else
-				newbon->HealAmt += item->HealAmt;
+				newbon->HealAmt += stats->HealAmt;
 		}
-		if (item->SpellDmg > 0) {
-			if ((newbon->SpellDmg + item->SpellDmg) > RuleI(Character, ItemSpellDmgCap))
+		if (stats->SpellDmg > 0) {
+			if ((newbon->SpellDmg + stats->SpellDmg) > RuleI(Character, ItemSpellDmgCap))
 				newbon->SpellDmg = RuleI(Character, ItemSpellDmgCap);
 			else
-				newbon->SpellDmg += item->SpellDmg;
+				newbon->SpellDmg += stats->SpellDmg;
 		}
-		if (item->Clairvoyance > 0) {
-			if ((newbon->Clairvoyance + item->Clairvoyance) > RuleI(Character, ItemClairvoyanceCap))
+		if (stats->Clairvoyance > 0) {
+			if ((newbon->Clairvoyance + stats->Clairvoyance) > RuleI(Character, ItemClairvoyanceCap))
 				newbon->Clairvoyance = RuleI(Character, ItemClairvoyanceCap);
 			else
-				newbon->Clairvoyance += item->Clairvoyance;
+				newbon->Clairvoyance += stats->Clairvoyance;
 		}
 
-		if (item->DSMitigation > 0) {
-			if ((newbon->DSMitigation + item->DSMitigation) > RuleI(Character, ItemDSMitigationCap))
+		if (stats->DSMitigation > 0) {
+			if ((newbon->DSMitigation + stats->DSMitigation) > RuleI(Character, ItemDSMitigationCap))
 				newbon->DSMitigation = RuleI(Character, ItemDSMitigationCap);
 			else
-				newbon->DSMitigation += item->DSMitigation;
+				newbon->DSMitigation += stats->DSMitigation;
 		}
-		if (item->Worn.Effect > 0 && item->Worn.Type == EQEmu::item::ItemEffectWorn) { // latent effects
-			ApplySpellsBonuses(item->Worn.Effect, item->Worn.Level, newbon, 0, item->Worn.Type);
+		if (stats->WornEffect > 0 && stats->WornType == EQEmu::item::ItemEffectWorn) { // latent effects
+			ApplySpellsBonuses(stats->WornEffect, stats->WornLevel, newbon, 0, stats->WornType);
 		}
 
-		if (item->Focus.Effect > 0 && (item->Focus.Type == EQEmu::item::ItemEffectFocus)) { // focus effects
-			ApplySpellsBonuses(item->Focus.Effect, item->Focus.Level, newbon, 0);
+		if (stats->FocusEffect > 0 && (stats->FocusType == EQEmu::item::ItemEffectFocus)) { // focus effects
+			ApplySpellsBonuses(stats->FocusEffect, stats->FocusLevel, newbon, 0);
 		}
 
-		switch (item->BardType) {
+		switch (stats->BardType) {
 		case 51: /* All (e.g. Singing Short Sword) */
-			if (item->BardValue > newbon->singingMod)
-				newbon->singingMod = item->BardValue;
-			if (item->BardValue > newbon->brassMod)
-				newbon->brassMod = item->BardValue;
-			if (item->BardValue > newbon->stringedMod)
-				newbon->stringedMod = item->BardValue;
-			if (item->BardValue > newbon->percussionMod)
-				newbon->percussionMod = item->BardValue;
-			if (item->BardValue > newbon->windMod)
-				newbon->windMod = item->BardValue;
+			if (stats->BardValue > newbon->singingMod)
+				newbon->singingMod = stats->BardValue;
+			if (stats->BardValue > newbon->brassMod)
+				newbon->brassMod = stats->BardValue;
+			if (stats->BardValue > newbon->stringedMod)
+				newbon->stringedMod = stats->BardValue;
+			if (stats->BardValue > newbon->percussionMod)
+				newbon->percussionMod = stats->BardValue;
+			if (stats->BardValue > newbon->windMod)
+				newbon->windMod = stats->BardValue;
 			break;
 		case 50: /* Singing */
-			if (item->BardValue > newbon->singingMod)
-				newbon->singingMod = item->BardValue;
+			if (stats->BardValue > newbon->singingMod)
+				newbon->singingMod = stats->BardValue;
 			break;
 		case 23: /* Wind */
-			if (item->BardValue > newbon->windMod)
-				newbon->windMod = item->BardValue;
+			if (stats->BardValue > newbon->windMod)
+				newbon->windMod = stats->BardValue;
 			break;
 		case 24: /* stringed */
-			if (item->BardValue > newbon->stringedMod)
-				newbon->stringedMod = item->BardValue;
+			if (stats->BardValue > newbon->stringedMod)
+				newbon->stringedMod = stats->BardValue;
 			break;
 		case 25: /* brass */
-			if (item->BardValue > newbon->brassMod)
-				newbon->brassMod = item->BardValue;
+			if (stats->BardValue > newbon->brassMod)
+				newbon->brassMod = stats->BardValue;
 			break;
 		case 26: /* Percussion */
-			if (item->BardValue > newbon->percussionMod)
-				newbon->percussionMod = item->BardValue;
+			if (stats->BardValue > newbon->percussionMod)
+				newbon->percussionMod = stats->BardValue;
 			break;
 		}
 	
 		// Add Item Faction Mods
-		if (item->FactionMod1) {
-			if (item->FactionAmt1 > 0 && item->FactionAmt1 > GetItemFactionBonus(item->FactionMod1)) {
-				AddItemFactionBonus(item->FactionMod1, item->FactionAmt1);
+		if (stats->FactionMod1) {
+			if (stats->FactionAmt1 > 0 && stats->FactionAmt1 > GetItemFactionBonus(stats->FactionMod1)) {
+				AddItemFactionBonus(stats->FactionMod1, stats->FactionAmt1);
 			}
-			else if (item->FactionAmt1 < 0 && item->FactionAmt1 < GetItemFactionBonus(item->FactionMod1)) {
-				AddItemFactionBonus(item->FactionMod1, item->FactionAmt1);
+			else if (stats->FactionAmt1 < 0 && stats->FactionAmt1 < GetItemFactionBonus(stats->FactionMod1)) {
+				AddItemFactionBonus(stats->FactionMod1, stats->FactionAmt1);
 			}
 		}
-		if (item->FactionMod2) {
-			if (item->FactionAmt2 > 0 && item->FactionAmt2 > GetItemFactionBonus(item->FactionMod2)) {
-				AddItemFactionBonus(item->FactionMod2, item->FactionAmt2);
+		if (stats->FactionMod2) {
+			if (stats->FactionAmt2 > 0 && stats->FactionAmt2 > GetItemFactionBonus(stats->FactionMod2)) {
+				AddItemFactionBonus(stats->FactionMod2, stats->FactionAmt2);
 			}
-			else if (item->FactionAmt2 < 0 && item->FactionAmt2 < GetItemFactionBonus(item->FactionMod2)) {
-				AddItemFactionBonus(item->FactionMod2, item->FactionAmt2);
+			else if (stats->FactionAmt2 < 0 && stats->FactionAmt2 < GetItemFactionBonus(stats->FactionMod2)) {
+				AddItemFactionBonus(stats->FactionMod2, stats->FactionAmt2);
 			}
 		}
-		if (item->FactionMod3) {
-			if (item->FactionAmt3 > 0 && item->FactionAmt3 > GetItemFactionBonus(item->FactionMod3)) {
-				AddItemFactionBonus(item->FactionMod3, item->FactionAmt3);
+		if (stats->FactionMod3) {
+			if (stats->FactionAmt3 > 0 && stats->FactionAmt3 > GetItemFactionBonus(stats->FactionMod3)) {
+				AddItemFactionBonus(stats->FactionMod3, stats->FactionAmt3);
 			}
-			else if (item->FactionAmt3 < 0 && item->FactionAmt3 < GetItemFactionBonus(item->FactionMod3)) {
-				AddItemFactionBonus(item->FactionMod3, item->FactionAmt3);
+			else if (stats->FactionAmt3 < 0 && stats->FactionAmt3 < GetItemFactionBonus(stats->FactionMod3)) {
+				AddItemFactionBonus(stats->FactionMod3, stats->FactionAmt3);
 			}
 		}
-		if (item->FactionMod4) {
-			if (item->FactionAmt4 > 0 && item->FactionAmt4 > GetItemFactionBonus(item->FactionMod4)) {
-				AddItemFactionBonus(item->FactionMod4, item->FactionAmt4);
+		if (stats->FactionMod4) {
+			if (stats->FactionAmt4 > 0 && stats->FactionAmt4 > GetItemFactionBonus(stats->FactionMod4)) {
+				AddItemFactionBonus(stats->FactionMod4, stats->FactionAmt4);
 			}
-			else if (item->FactionAmt4 < 0 && item->FactionAmt4 < GetItemFactionBonus(item->FactionMod4)) {
-				AddItemFactionBonus(item->FactionMod4, item->FactionAmt4);
+			else if (stats->FactionAmt4 < 0 && stats->FactionAmt4 < GetItemFactionBonus(stats->FactionMod4)) {
+				AddItemFactionBonus(stats->FactionMod4, stats->FactionAmt4);
 			}
 		}
 
-		if (item->ExtraDmgSkill != 0 && item->ExtraDmgSkill <= EQEmu::skills::HIGHEST_SKILL) {
-			if ((newbon->SkillDamageAmount[item->ExtraDmgSkill] + item->ExtraDmgAmt) >
+		if (stats->ExtraDmgSkill != 0 && stats->ExtraDmgSkill <= EQEmu::skills::HIGHEST_SKILL) {
+			if ((newbon->SkillDamageAmount[stats->ExtraDmgSkill] + stats->ExtraDmgAmt) >
 				RuleI(Character, ItemExtraDmgCap))
-				newbon->SkillDamageAmount[item->ExtraDmgSkill] = RuleI(Character, ItemExtraDmgCap);
+				newbon->SkillDamageAmount[stats->ExtraDmgSkill] = RuleI(Character, ItemExtraDmgCap);
 			else
-				newbon->SkillDamageAmount[item->ExtraDmgSkill] += item->ExtraDmgAmt;
+				newbon->SkillDamageAmount[stats->ExtraDmgSkill] += stats->ExtraDmgAmt;
 		}
 	}
 
 	// Process when ammo_slot_item = true or false
-	if (item->SkillModValue != 0 && item->SkillModType <= EQEmu::skills::HIGHEST_SKILL) {
-		if ((item->SkillModValue > 0 && newbon->skillmod[item->SkillModType] < item->SkillModValue) ||
-			(item->SkillModValue < 0 && newbon->skillmod[item->SkillModType] > item->SkillModValue)) {
+	if (stats->SkillModValue != 0 && stats->SkillModType <= EQEmu::skills::HIGHEST_SKILL) {
+		if ((stats->SkillModValue > 0 && newbon->skillmod[stats->SkillModType] < stats->SkillModValue) ||
+			(stats->SkillModValue < 0 && newbon->skillmod[stats->SkillModType] > stats->SkillModValue)) {
 
-			newbon->skillmod[item->SkillModType] = item->SkillModValue;
-			newbon->skillmodmax[item->SkillModType] = item->SkillModMax;
+			newbon->skillmod[stats->SkillModType] = stats->SkillModValue;
+			newbon->skillmodmax[stats->SkillModType] = stats->SkillModMax;
 		}
 	}
 
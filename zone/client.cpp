@@ -160,7 +160,9 @@ Client::Client(EQStreamInterface* ieqs)
 	npc_close_scan_timer(6000),
 	hp_self_update_throttle_timer(300),
 	hp_other_update_throttle_timer(500),
-	position_update_timer(10000)
+	position_update_timer(10000),
+	inventory_journal_retry_timer(0),
+	inventory_journal_failures(0)
 {
 
 	for (int client_filter = 0; client_filter < _FilterCount; client_filter++)
@@ -589,6 +591,9 @@ bool Client::Save(uint8 iCommitNow) {
 	if(!ClientDataLoaded())
 		return false;
 
+	/* Write queued inventory slot saves first, the snapshot below reads inventory back */
+	FlushInventoryJournal();
+
 	/* Wrote current basics to PP for saves */
 	m_pp.x = m_Position.x;
 	m_pp.y = m_Position.y;
@@ -1584,6 +1589,8 @@ void Client::UpdateWho(uint8 remove) {
 	scl->ClientVersion = static_cast<unsigned int>(ClientVersion());
 	scl->tellsoff = tellsoff;
 	scl->guild_id = guild_id;
+	Raid *raid = GetRaid();
+	scl->raid_id = raid ? raid->GetID() : 0;
 	scl->LFG = LFG;
 	if(LFG) {
 		scl->LFGFromLevel = LFGFromLevel;
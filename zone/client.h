@@ -343,6 +343,7 @@ public:
 	inline bool InZone() const { return (client_state == CLIENT_CONNECTED || client_state == CLIENT_LINKDEAD); }
 	inline void Kick() { client_state = CLIENT_KICKED; }
 	inline void Disconnect() { eqs->Close(); client_state = DISCONNECTED; }
+	inline bool IsZoning() const { return zoning; }
 	inline bool IsLD() const { return (bool) (client_state == CLIENT_LINKDEAD); }
 	void WorldKick();
 	inline uint8 GetAnon() const { return m_pp.anon; }
@@ -826,6 +827,9 @@ public:
 	bool PushItemOnCursor(const EQEmu::ItemInstance& inst, bool client_update = false);
 	void SendCursorBuffer();
 	void DeleteItemInInventory(int16 slot_id, int8 quantity = 0, bool client_update = false, bool update_db = true);
+	bool SaveInventorySlot(const EQEmu::ItemInstance* inst, int16 slot_id);
+	bool SaveCursorQueue();
+	bool FlushInventoryJournal(Client* with = nullptr);
 	bool SwapItem(MoveItem_Struct* move_in);
 	void SwapItemResync(MoveItem_Struct* move_slots);
 	void QSSwapItemAuditor(MoveItem_Struct* move_in, bool postaction_call = false);
@@ -1489,6 +1493,8 @@ private:
 	Timer hp_self_update_throttle_timer; /* This is to prevent excessive packet sending under trains/fast combat */
 	Timer hp_other_update_throttle_timer; /* This is to keep clients from DOSing the server with macros that change client targets constantly */
 	Timer position_update_timer; /* Timer used when client hasn't updated within a 10 second window */
+	Timer inventory_journal_retry_timer; /* Backs off the per pass journal flush while the database keeps failing it */
+	uint32 inventory_journal_failures;
 
 	glm::vec3 m_Proximity;
 	glm::vec4 last_major_update_position;
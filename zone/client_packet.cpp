@@ -552,6 +552,7 @@ void Client::CompleteConnect()
 			raid->LearnMembers();
 			raid->VerifyRaid();
 			raid->GetRaidDetails();
+			UpdateWho(); // the update on zone in went out before the raid was loaded
 			/*
 			Only leader should get this; send to all for now till
 			I figure out correct creation; can probably also send a no longer leader packet for non leaders
@@ -13698,6 +13699,9 @@ void Client::Handle_OP_TradeAcceptClick(const EQApplicationPacket *app)
 					other->FinishTrade(this);
 				}
 
+				// both sides of the trade are written in the same transaction
+				FlushInventoryJournal(other);
+
 				other->trade->Reset();
 				trade->Reset();
 			}
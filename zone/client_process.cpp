@@ -617,26 +617,37 @@ bool Client::Process() {
 		}
 	}
 
+	// everything this pass (and the tic work above) changed in inventory goes out in one batch,
+	// after a failed flush only once the retry timer is up
+	if (!m_inv.JournalEmpty() && (inventory_journal_failures == 0 || inventory_journal_retry_timer.Check()))
+		FlushInventoryJournal();
+
 	//At this point, we are still connected, everything important has taken
 	//place, now check to see if anybody wants to aggro us.
 	// only if client is not feigned
 	if (zone->CanDoCombat() && ret && !GetFeigned() && client_scan_npc_aggro_timer.Check()) {
-		int npc_scan_count = 0;
-		for (auto it = close_mobs.begin(); it != close_mobs.end(); ++it) {
-			Mob *mob = it->first;
+		if (RuleB(Aggro, UseBroadphase)) {
+			// resolved together with every other client at the end of EntityList::MobProcess
+			entity_list.GetAggroBroadphase().QueueClientScan(this);
+		}
+		else {
+			int npc_scan_count = 0;
+			for (auto it = close_mobs.begin(); it != close_mobs.end(); ++it) {
+				Mob *mob = it->first;
 
-			if (!mob)
-				continue;
+				if (!mob)
+					continue;
 
-			if (mob->IsClient())
-				continue;
+				if (mob->IsClient())
+					continue;
 
-			if (mob->CheckWillAggro(this) && !mob->CheckAggro(this)) {
-				mob->AddToHateList(this, 25);
+				if (mob->CheckWillAggro(this) && !mob->CheckAggro(this)) {
+					mob->AddToHateList(this, 25);
+				}
+				npc_scan_count++;
 			}
-			npc_scan_count++;
+			Log(Logs::General, Logs::Aggro, "Checking Reverse Aggro (client->npc) scanned_npcs (%i)", npc_scan_count);
 		}
-		Log(Logs::General, Logs::Aggro, "Checking Reverse Aggro (client->npc) scanned_npcs (%i)", npc_scan_count);
 	}
 
 	if (client_state != CLIENT_LINKDEAD && (client_state == CLIENT_ERROR || client_state == DISCONNECTED || client_state == CLIENT_KICKED || !eqs->CheckState(ESTABLISHED)))
@@ -772,7 +783,7 @@ void Client::BulkSendInventoryItems()
 			int16 free_slot_id = m_inv.FindFreeSlot(inst->IsClassBag(), true, inst->GetItem()->Size, is_arrow);
 			Log(Logs::Detail, Logs::Inventory, "Incomplete Trade Transaction: Moving %s from slot %i to %i", inst->GetItem()->Name, slot_id, free_slot_id);
 			PutItemInInventory(free_slot_id, *inst, false);
-			database.SaveInventory(character_id, nullptr, slot_id);
+			SaveInventorySlot(nullptr, slot_id);
 			safe_delete(inst);
 		}
 	}
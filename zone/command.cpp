@@ -43,15 +43,21 @@
 #define strcasecmp _stricmp
 #endif
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 #include "../common/global_define.h"
 #include "../common/eq_packet.h"
 #include "../common/features.h"
 #include "../common/guilds.h"
 #include "../common/patches/patches.h"
+#include "../common/patches/item_serialization_cache.h"
 #include "../common/ptimer.h"
 #include "../common/rulesys.h"
 #include "../common/serverinfo.h"
 #include "../common/string_util.h"
+#include "../common/util/slab_pool.h"
 #include "../say_link.h"
 #include "../common/eqemu_logsys.h"
 
@@ -63,6 +69,8 @@
 #include "qglobals.h"
 #include "queryserv.h"
 #include "quest_parser_collection.h"
+#include "quest_profiler.h"
+#include "questmgr.h"
 #include "string_ids.h"
 #include "titles.h"
 #include "water_map.h"
@@ -153,6 +161,7 @@ int command_init(void)
 		command_add("aggro", "(range) [-v] - Display aggro information for all mobs 'range' distance from your target. -v is verbose faction info.", 80, command_aggro) ||
 		command_add("aggrozone", "[aggro] - Aggro every mob in the zone with X aggro. Default is 0. Not recommend if you're not invulnerable.", 100, command_aggrozone) ||
 		command_add("ai", "[factionid/spellslist/con/guard/roambox/stop/start] - Modify AI on NPC target", 100, command_ai) ||
+		command_add("aistats", "[reset] - Show active and sleeping NPC counts and mob process tick time for this zone", 200, command_aistats) ||
 		command_add("appearance", "[type] [value] - Send an appearance packet for you or your target", 150, command_appearance) ||
 		command_add("apply_shared_memory", "[shared_memory_name] - Tells every zone and world to apply a specific shared memory segment by name.", 250, command_apply_shared_memory) ||
 		command_add("attack", "[targetname] - Make your NPC target attack targetname", 150, command_attack) ||
@@ -255,6 +264,7 @@ int command_init(void)
 		command_add("lock", "- Lock the worldserver", 150, command_lock) ||
 		command_add("logs",  "Manage anything to do with logs",  250, command_logs) ||
 		command_add("logtest",  "Performs log performance testing.",  250, command_logtest) ||
+		command_add("loscache", "[reset|clear] - Show line of sight cache statistics for this zone", 200, command_loscache) ||
 		command_add("makepet", "[level] [class] [race] [texture] - Make a pet", 50, command_makepet) ||
 		command_add("mana", "- Fill your or your target's mana", 50, command_mana) ||
 		command_add("maxskills", "Maxes skills for you.", 200, command_max_all_skills) ||
@@ -309,6 +319,8 @@ int command_init(void)
 		command_add("pvp", "[on/off] - Set your or your player target's PVP status", 100, command_pvp) ||
 		command_add("qglobal", "[on/off/view] - Toggles qglobal functionality on an NPC", 100, command_qglobal) ||
 		command_add("questerrors", "Shows quest errors.", 100, command_questerrors) ||
+		command_add("questprofile", "[count|reset] - Show the quest event handlers that used the most time", 200, command_questprofile) ||
+		command_add("questtimers", "[reset] - Show active quest timers, pending signals and how many fired per tick", 200, command_questtimers) ||
 		command_add("race", "[racenum] - Change your or your target's race. Use racenum 0 to return to normal", 50, command_race) ||
 		command_add("raidloot", "LEADER|GROUPLEADER|SELECTED|ALL - Sets your raid loot settings if you have permission to do so.", 0, command_raidloot) ||
 		command_add("randomfeatures", "- Temporarily randomizes the Facial Features of your target", 80, command_randomfeatures) ||
@@ -318,7 +330,7 @@ int command_init(void)
 		command_add("reloademote", "Reloads NPC Emotes", 80, command_reloademote) ||
 		command_add("reloadlevelmods", nullptr, 255, command_reloadlevelmods) ||
 		command_add("reloadperlexportsettings", nullptr, 255, command_reloadperlexportsettings) ||
-		command_add("reloadqst", " - Clear quest cache (any argument causes it to also stop all timers)", 150, command_reloadqst) ||
+		command_add("reloadqst", " [changed] - Clear quest cache (changed only reloads edited scripts, any other argument also stops all timers)", 150, command_reloadqst) ||
 		command_add("reloadrulesworld", "Executes a reload of all rules in world specifically.", 80, command_reloadworldrules) ||
 		command_add("reloadstatic", "- Reload Static Zone Data", 150, command_reloadstatic) ||
 		command_add("reloadtitles", "- Reload player titles from the database",  150, command_reloadtitles) ||
@@ -410,7 +422,7 @@ int command_init(void)
 		command_add("zonelock", "[list/lock/unlock] - Set/query lock flag for zoneservers", 100, command_zonelock) ||
 		command_add("zoneshutdown", "[shortname] - Shut down a zone server", 150, command_zoneshutdown) ||
 		command_add("zonespawn", "- Not implemented", 250, command_zonespawn) ||
-		command_add("zonestatus", "- Show connected zoneservers, synonymous with /servers", 150, command_zonestatus) ||
+		command_add("zonestatus", "[pools] - Show connected zoneservers, synonymous with /servers. pools shows this zone's object pool, heap fragmentation, item serialization cache and shared npc type stats", 150, command_zonestatus) ||
 		command_add("zopp",  "Troubleshooting command - Sends a fake item packet to you. No server reference is created.",  250, command_zopp) ||
 		command_add("zsafecoords", "[x] [y] [z] - Set safe coords", 80, command_zsafecoords) ||
 		command_add("zsave", " - Saves zheader to the database", 80, command_zsave) ||
@@ -1773,6 +1785,21 @@ void command_gassign(Client *c, const Seperator *sep)
 		c->Message(0, "Usage: #gassign [num] - must have an npc target!");
 }
 
+void command_aistats(Client *c, const Seperator *sep)
+{
+	if (strcasecmp(sep->arg[1], "reset") == 0) {
+		entity_list.ResetMobProcessStats();
+		c->Message(0, "Mob process timing reset.");
+		return;
+	}
+
+	c->Message(0, "NPC AI sleep is %s (radius %i, sleeping tick %i ms)", RuleB(NPC, AISleepEnabled) ? "enabled" : "disabled",
+		RuleI(NPC, AISleepRadius), RuleI(NPC, AISleepTickInterval));
+	c->Message(0, "Active NPCs: %u Sleeping NPCs: %u", entity_list.GetAIActiveCount(), entity_list.GetAISleepingCount());
+	c->Message(0, "Mob process tick: last %.3f ms avg %.3f ms max %.3f ms", entity_list.GetMobProcessTime() * 1000.0,
+		entity_list.GetMobProcessTimeAvg() * 1000.0, entity_list.GetMobProcessTimeMax() * 1000.0);
+}
+
 void command_ai(Client *c, const Seperator *sep)
 {
 	Mob *target=c->GetTarget();
@@ -2963,7 +2990,12 @@ void command_viewnpctype(Client *c, const Seperator *sep)
 
 void command_reloadqst(Client *c, const Seperator *sep)
 {
-	if (sep->arg[1][0] == 0)
+	if (strcasecmp(sep->arg[1], "changed") == 0)
+	{
+		uint32 reloaded = parse->ReloadChangedQuests();
+		c->Message(0, "Reloaded %u changed quest script%s.", reloaded, reloaded == 1 ? "" : "s");
+	}
+	else if (sep->arg[1][0] == 0)
 	{
 		c->Message(0, "Clearing quest memory cache.");
 		entity_list.ClearAreas();
@@ -4900,6 +4932,38 @@ bool helper_guild_edit(Client *c, uint32 dbid, uint32 eqid, uint8 rank, const ch
 
 void command_zonestatus(Client *c, const Seperator *sep)
 {
+	if (!strcasecmp(sep->arg[1], "pools")) {
+		c->Message(0, "Object pools for %s (%u):", zone->GetShortName(), zone->GetZoneID());
+		for (auto &s : EQ::SlabPool::GetAllStats()) {
+			c->Message(0, "%s: live %u peak %u block %u bytes, %u slabs (%u KB reserved, %u KB live, %u blocks in thread free lists), fragmentation %.1f%%, allocs %llu, heap fallbacks %llu, slabs released %llu",
+				s.name.c_str(), (uint32)s.live, (uint32)s.peak, (uint32)s.block_size, (uint32)s.slabs,
+				(uint32)(s.ReservedBytes() / 1024), (uint32)(s.LiveBytes() / 1024), (uint32)s.cached, s.Fragmentation() * 100.0,
+				(unsigned long long)s.allocs, (unsigned long long)s.fallbacks, (unsigned long long)s.released);
+		}
+
+		auto isc = EQEmu::ItemSerializationCache::GetStats();
+		c->Message(0, "Item serialization cache: %u entries, %u hits, %u misses since the last item reload",
+			(uint32)isc.entries, isc.hits, isc.misses);
+
+		if (!zone->npctypes_bulk_skipped.empty()) {
+			uint32 skipped, built;
+			int64 saved = zone->GetSharedNPCTypeSavings(skipped, built);
+			c->Message(0, "Shared npc types: %u spawn group types not bulk loaded, %u of them built from the table, %d KB saved",
+				skipped, built, static_cast<int>(saved / 1024));
+		}
+
+#ifdef __GLIBC__
+		// fordblks is free memory still held by the allocator, a rough measure of heap fragmentation
+		struct mallinfo mi = mallinfo();
+		uint32 arena = static_cast<uint32>(mi.arena) + static_cast<uint32>(mi.hblkhd);
+		uint32 free_bytes = static_cast<uint32>(mi.fordblks);
+		c->Message(0, "Heap: %u KB mapped, %u KB in use, %u KB free in %u chunks (%.1f%% free)",
+			arena / 1024, static_cast<uint32>(mi.uordblks + mi.hblkhd) / 1024, free_bytes / 1024, static_cast<uint32>(mi.ordblks),
+			arena ? static_cast<float>(free_bytes) * 100.0f / static_cast<float>(arena) : 0.0f);
+#endif
+		return;
+	}
+
 	if (!worldserver.Connected())
 		c->Message(0, "Error: World server disconnected");
 	else {
@@ -7136,7 +7200,7 @@ void Client::Undye() {
 
 		if(inst != nullptr) {
 			inst->SetColor(inst->GetItem()->Color);
-			database.SaveInventory(CharacterID(), inst, slot2);
+			SaveInventorySlot(inst, slot2);
 		}
 
 		m_pp.item_tint.Slot[cur_slot].Color = 0;
@@ -10305,6 +10369,49 @@ void command_questerrors(Client *c, const Seperator *sep)
 	}
 }
 
+void command_questtimers(Client *c, const Seperator *sep)
+{
+	if (strcasecmp(sep->arg[1], "reset") == 0) {
+		quest_manager.ResetTimerStats();
+		c->Message(0, "Quest timer stats reset.");
+		return;
+	}
+
+	c->Message(0, "Active quest timers: %u Pending signals: %u Queued for delivery: %u", (uint32)quest_manager.GetQuestTimerCount(),
+		(uint32)quest_manager.GetSignalTimerCount(), (uint32)entity_list.GetPendingSignalCount());
+	c->Message(0, "Fired last tick: %u timers %u signals, most in one tick: %u", quest_manager.GetLastTimersFired(),
+		quest_manager.GetLastSignalsFired(), quest_manager.GetMaxTimersFired());
+	c->Message(0, "Fired total: %llu timers %llu signals", (unsigned long long)quest_manager.GetTotalTimersFired(),
+		(unsigned long long)quest_manager.GetTotalSignalsFired());
+}
+
+void command_questprofile(Client *c, const Seperator *sep)
+{
+	if (strcasecmp(sep->arg[1], "reset") == 0) {
+		quest_profiler.Reset();
+		c->Message(0, "Quest profile reset.");
+		return;
+	}
+
+	size_t count = sep->IsNumber(1) ? static_cast<size_t>(atoi(sep->arg[1])) : 10;
+	if (count == 0)
+		count = 10;
+
+	if (!RuleB(Zone, QuestProfiling))
+		c->Message(0, "Zone:QuestProfiling is off, quest events are not being timed.");
+
+	std::vector<QuestProfiler::Row> rows;
+	quest_profiler.GetTop(count, rows);
+
+	c->Message(0, "Quest events: %llu run, %.2f ms total, %u aborted", (unsigned long long)quest_profiler.GetCalls(),
+		quest_profiler.GetTotalTime() / 1000.0, quest_profiler.GetAborts());
+	for (auto &row : rows) {
+		c->Message(0, "%s::%s calls: %llu total: %.2f ms avg: %.3f ms p95: %.3f ms max: %.3f ms aborted: %u",
+			row.package.c_str(), row.event, (unsigned long long)row.calls, row.total_us / 1000.0,
+			row.total_us / 1000.0 / row.calls, row.p95_us / 1000.0, row.max_us / 1000.0, row.aborts);
+	}
+}
+
 void command_enablerecipe(Client *c, const Seperator *sep)
 {
 	uint32 recipe_id = 0;
@@ -10633,6 +10740,26 @@ void command_logtest(Client *c, const Seperator *sep){
 	}
 }
 
+void command_loscache(Client *c, const Seperator *sep)
+{
+	if (strcasecmp(sep->arg[1], "reset") == 0) {
+		zone->los_cache.ResetStats();
+		c->Message(0, "LoS cache statistics reset.");
+		return;
+	}
+
+	if (strcasecmp(sep->arg[1], "clear") == 0) {
+		zone->los_cache.Invalidate();
+		c->Message(0, "LoS cache cleared.");
+		return;
+	}
+
+	c->Message(0, "LoS cache: %u entries, TTL %i ms, grid %.2f", (uint32)zone->los_cache.GetSize(), RuleI(Map, LoSCacheTTL), RuleR(Map, LoSCacheGridSize));
+	c->Message(0, "Hits: %llu Misses: %llu Hit ratio: %.1f%% Invalidations: %llu",
+		(unsigned long long)zone->los_cache.GetHits(), (unsigned long long)zone->los_cache.GetMisses(),
+		zone->los_cache.GetHitRatio() * 100.0f, (unsigned long long)zone->los_cache.GetInvalidations());
+}
+
 void command_crashtest(Client *c, const Seperator *sep)
 {
 	c->Message(0, "Alright, now we get an GPF ;) ");
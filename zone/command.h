@@ -52,6 +52,7 @@ void command_advnpcspawn(Client *c, const Seperator *sep);
 void command_aggro(Client *c, const Seperator *sep);
 void command_aggrozone(Client *c, const Seperator *sep);
 void command_ai(Client *c, const Seperator *sep);
+void command_aistats(Client *c, const Seperator *sep);
 void command_appearance(Client *c, const Seperator *sep);
 void command_apply_shared_memory(Client *c, const Seperator *sep);
 void command_attack(Client *c, const Seperator *sep);
@@ -158,6 +159,7 @@ void command_loc(Client *c, const Seperator *sep);
 void command_lock(Client *c, const Seperator *sep);
 void command_logs(Client *c, const Seperator *sep);
 void command_logtest(Client *c, const Seperator *sep);
+void command_loscache(Client *c, const Seperator *sep);
 void command_makepet(Client *c, const Seperator *sep);
 void command_mana(Client *c, const Seperator *sep);
 void command_manastat(Client *c, const Seperator *sep);
@@ -215,6 +217,8 @@ void command_pvp(Client *c, const Seperator *sep);
 void command_qglobal(Client *c, const Seperator *sep);
 void command_qtest(Client *c, const Seperator *sep);
 void command_questerrors(Client *c, const Seperator *sep);
+void command_questprofile(Client *c, const Seperator *sep);
+void command_questtimers(Client *c, const Seperator *sep);
 void command_race(Client *c, const Seperator *sep);
 void command_raidloot(Client* c, const Seperator *sep);
 void command_randomfeatures(Client *c, const Seperator *sep);
@@ -57,6 +57,8 @@ extern Zone* zone;
 extern WorldServer worldserver;
 extern npcDecayTimes_Struct npcCorpseDecayTimes[100];
 
+EQ_SLAB_POOLED_IMPL(Corpse, "Corpse", 32)
+
 void Corpse::SendEndLootErrorPacket(Client* client) {
 	auto outapp = new EQApplicationPacket(OP_LootComplete, 0);
 	client->QueuePacket(outapp);
@@ -338,6 +340,9 @@ Corpse::Corpse(Client* client, int32 in_rezexp) : Mob (
 				MoveItemToCorpse(client, item, i, removed_list);
 		}
 
+		// queued saves can't go out inside the transaction below, START TRANSACTION would commit it early
+		client->FlushInventoryJournal();
+
 		database.TransactionBegin();
 
 		// I have an untested process that avoids this snarl up when all possessions inventory is removed..but this isn't broke
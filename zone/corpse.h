@@ -19,6 +19,8 @@
 #ifndef CORPSE_H
 #define CORPSE_H
 
+#include "../common/util/slab_pool.h"
+
 #include "mob.h"
 #include "client.h"
 
@@ -48,6 +50,8 @@ class Corpse : public Mob {
 	Corpse(uint32 in_corpseid, uint32 in_charid, const char* in_charname, ItemList* in_itemlist, uint32 in_copper, uint32 in_silver, uint32 in_gold, uint32 in_plat, const glm::vec4& position, float in_size, uint8 in_gender, uint16 in_race, uint8 in_class, uint8 in_deity, uint8 in_level, uint8 in_texture, uint8 in_helmtexture, uint32 in_rezexp, bool wasAtGraveyard = false);
 
 	~Corpse();
+
+	EQ_SLAB_POOLED()
 	static Corpse* LoadCharacterCorpseEntity(uint32 in_dbid, uint32 in_charid, std::string in_charname, const glm::vec4& position, std::string time_of_death, bool rezzed, bool was_at_graveyard);
 
 	/* Corpse: General */
@@ -27,6 +27,7 @@
 #include "mob.h"
 #include "string_ids.h"
 #include "worldserver.h"
+#include "zone.h"
 #include "zonedb.h"
 
 #include <iostream>
@@ -38,6 +39,7 @@
 #define CLOSE_INVDOOR 0x02
 
 extern EntityList entity_list;
+extern Zone *zone;
 extern WorldServer worldserver;
 
 Doors::Doors(const Door* door) :
@@ -61,7 +63,7 @@ m_Destination(door->dest_x, door->dest_y, door->dest_z, door->dest_heading)
 	door_param = door->door_param;
 	size = door->size;
 	invert_state = door->invert_state;
-	SetOpenState(false);
+	is_open = false;
 
 	close_timer.Disable();
 
@@ -95,7 +97,7 @@ m_Destination(glm::vec4())
 	door_param = 0;
 	size = dsize;
 	invert_state = 0;
-	SetOpenState(false);
+	is_open = false;
 
 	close_timer.Disable();
 
@@ -465,18 +467,18 @@ void Doors::NPCOpen(NPC* sender, bool alt_mode)
 			if (!is_open) {
 				if (!disable_timer)
 					close_timer.Start();
-				is_open = true;
+				SetOpenState(true);
 			}
 			else {
 				close_timer.Disable();
 				if (!disable_timer)
-					is_open = false;
+					SetOpenState(false);
 			}
 		}
 		else { // alternative function
 			if (!disable_timer)
 				close_timer.Start();
-			is_open = true;
+			SetOpenState(true);
 		}
 	}
 }
@@ -494,18 +496,18 @@ void Doors::ForceOpen(Mob *sender, bool alt_mode)
 		if (!is_open) {
 			if (!disable_timer)
 				close_timer.Start();
-			is_open = true;
+			SetOpenState(true);
 		}
 		else {
 			close_timer.Disable();
 			if (!disable_timer)
-				is_open = false;
+				SetOpenState(false);
 		}
 	}
 	else { // alternative function
 		if (!disable_timer)
 			close_timer.Start();
-		is_open = true;
+		SetOpenState(true);
 	}
 }
 
@@ -522,11 +524,11 @@ void Doors::ForceClose(Mob *sender, bool alt_mode)
 		if (!is_open) {
 			if (!disable_timer)
 				close_timer.Start();
-			is_open = true;
+			SetOpenState(true);
 		}
 		else {
 			close_timer.Disable();
-			is_open = false;
+			SetOpenState(false);
 		}
 	}
 	else { // alternative function
@@ -535,6 +537,15 @@ void Doors::ForceClose(Mob *sender, bool alt_mode)
 	}
 }
 
+void Doors::SetOpenState(bool st)
+{
+	// a door swinging changes what can be seen through it
+	if (is_open != st && zone)
+		zone->los_cache.Invalidate();
+
+	is_open = st;
+}
+
 void Doors::ToggleState(Mob *sender)
 {
 	if(GetTriggerDoorID() > 0 || GetLockpick() != 0 || GetKeyItem() != 0 || opentype == 58 || opentype == 40) { // borrowed some NPCOpen criteria
@@ -547,12 +558,12 @@ void Doors::ToggleState(Mob *sender)
 
 	if(!is_open) {
 		md->action = invert_state == 0 ? OPEN_DOOR : OPEN_INVDOOR;
-		is_open=true;
+		SetOpenState(true);
 	}
 	else
 	{
 		md->action = invert_state == 0 ? CLOSE_DOOR : CLOSE_INVDOOR;
-		is_open=false;
+		SetOpenState(false);
 	}
 
 	entity_list.QueueClients(sender,outapp,false);
@@ -32,7 +32,7 @@ public:
 	const glm::vec4& GetPosition() const{ return m_Position; }
 	int		GetIncline() { return incline; }
 	bool	triggered;
-	void	SetOpenState(bool st) { is_open = st; }
+	void	SetOpenState(bool st);
 	bool	IsDoorOpen() { return is_open; }
 
 	uint8	GetTriggerDoorID() { return trigger_door; }
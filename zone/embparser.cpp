@@ -23,13 +23,20 @@
 #include "../common/misc_functions.h"
 #include "../common/string_util.h"
 #include "../common/features.h"
+#include "../common/rulesys.h"
+#include "../common/timer.h"
+#include "../common/util/directory.h"
 #include "masterentity.h"
 #include "embparser.h"
+#include "quest_profiler.h"
 #include "questmgr.h"
 #include "qglobals.h"
 #include "zone.h"
 #include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <sstream>
+#include <sys/stat.h>
 
 extern Zone* zone;
 
@@ -120,7 +127,7 @@ const char *QuestEventSubroutines[_LargestEventID] = {
 	"EVENT_USE_SKILL",
 };
 
-PerlembParser::PerlembParser() : perl(nullptr) {
+PerlembParser::PerlembParser() : perl(nullptr), plugin_scan_failed_(false), export_package_(nullptr) {
 	global_npc_quest_status_ = questUnloaded;
 	player_quest_status_ = questUnloaded;
 	global_player_quest_status_ = questUnloaded;
@@ -150,6 +157,9 @@ void PerlembParser::ReloadQuests() {
 	}
 
 	errors_.clear();
+	package_exports_.clear();
+	export_package_ = nullptr;
+	ScanPluginExports();
 	npc_quest_status_.clear();
 	global_npc_quest_status_ = questUnloaded;
 	player_quest_status_ = questUnloaded;
@@ -184,6 +194,9 @@ int PerlembParser::EventCommon(QuestEventID event, uint32 objid, const char * da
 		return 0;
 	}
 
+	auto exports = package_exports_.find(package_name);
+	export_package_ = exports != package_exports_.end() ? &exports->second : nullptr;
+
 	int char_id = 0;
 	ExportCharID(package_name, char_id, npcmob, mob);
 	
@@ -212,6 +225,8 @@ int PerlembParser::EventCommon(QuestEventID event, uint32 objid, const char * da
 		ExportEventVariables(package_name, event, objid, data, npcmob, item_inst, mob, extradata, extra_pointers);
 	}
 
+	export_package_ = nullptr;
+
 	if(isPlayerQuest || isGlobalPlayerQuest){
 		return SendCommands(package_name.c_str(), sub_name, 0, mob, mob, nullptr);
 	}
@@ -230,27 +245,27 @@ int PerlembParser::EventCommon(QuestEventID event, uint32 objid, const char * da
 	}
 }
 
-int PerlembParser::EventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int PerlembParser::EventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 							std::vector<EQEmu::Any> *extra_pointers) {
 	return EventCommon(evt, npc->GetNPCTypeID(), data.c_str(), npc, nullptr, init, extra_data, false, extra_pointers);
 }
 
-int PerlembParser::EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int PerlembParser::EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 								  std::vector<EQEmu::Any> *extra_pointers) {
 	return EventCommon(evt, npc->GetNPCTypeID(), data.c_str(), npc, nullptr, init, extra_data, true, extra_pointers);
 }
 
-int PerlembParser::EventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int PerlembParser::EventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 								std::vector<EQEmu::Any> *extra_pointers) {
 	return EventCommon(evt, 0, data.c_str(), nullptr, nullptr, client, extra_data, false, extra_pointers);
 }
 
-int PerlembParser::EventGlobalPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int PerlembParser::EventGlobalPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 									std::vector<EQEmu::Any> *extra_pointers) {
 	return EventCommon(evt, 0, data.c_str(), nullptr, nullptr, client, extra_data, true, extra_pointers);
 }
 
-int PerlembParser::EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+int PerlembParser::EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 							std::vector<EQEmu::Any> *extra_pointers) {
 	// needs pointer validation on 'item' argument
 	return EventCommon(evt, item->GetID(), nullptr, nullptr, item, client, extra_data, false, extra_pointers);
@@ -397,6 +412,7 @@ void PerlembParser::LoadNPCScript(std::string filename, int npc_id) {
 		return;
 	}
 
+	ScanPackageExports(package_name.str(), filename);
 	npc_quest_status_[npc_id] = questLoaded;
 }
 
@@ -421,6 +437,7 @@ void PerlembParser::LoadGlobalNPCScript(std::string filename) {
 		return;
 	}
 
+	ScanPackageExports("qst_global_npc", filename);
 	global_npc_quest_status_ = questLoaded;
 }
 
@@ -445,6 +462,7 @@ void PerlembParser::LoadPlayerScript(std::string filename) {
 		return;
 	}
 
+	ScanPackageExports("qst_player", filename);
 	player_quest_status_ = questLoaded;
 }
 
@@ -469,6 +487,7 @@ void PerlembParser::LoadGlobalPlayerScript(std::string filename) {
 		return;
 	}
 
+	ScanPackageExports("qst_global_player", filename);
 	global_player_quest_status_ = questLoaded;
 }
 
@@ -500,6 +519,7 @@ void PerlembParser::LoadItemScript(std::string filename, EQEmu::ItemInstance *it
 		return;
 	}
 
+	ScanPackageExports(package_name.str(), filename);
 	item_quest_status_[item->GetID()] = questLoaded;
 }
 
@@ -528,9 +548,49 @@ void PerlembParser::LoadSpellScript(std::string filename, uint32 spell_id) {
 		return;
 	}
 
+	ScanPackageExports(package_name.str(), filename);
 	spell_quest_status_[spell_id] = questLoaded;
 }
 
+void PerlembParser::UnloadNPCScript(std::string filename, int npc_id) {
+	npc_quest_status_.erase(npc_id);
+	UnloadPackage("qst_npc_" + std::to_string(npc_id), filename);
+}
+
+void PerlembParser::UnloadGlobalNPCScript(std::string filename) {
+	global_npc_quest_status_ = questUnloaded;
+	UnloadPackage("qst_global_npc", filename);
+}
+
+void PerlembParser::UnloadPlayerScript(std::string filename) {
+	player_quest_status_ = questUnloaded;
+	UnloadPackage("qst_player", filename);
+}
+
+void PerlembParser::UnloadGlobalPlayerScript(std::string filename) {
+	global_player_quest_status_ = questUnloaded;
+	UnloadPackage("qst_global_player", filename);
+}
+
+void PerlembParser::UnloadPackage(const std::string &package_name, const std::string &filename) {
+	//the cached globs die with the package
+	package_exports_.erase(package_name);
+
+	if(!perl)
+		return;
+
+	try {
+		perl->unload_file(package_name.c_str(), filename.c_str());
+	}
+	catch(const char *err)
+	{
+		std::string error = "Error unloading quest file " + filename;
+		error += ": ";
+		error += err;
+		AddError(error);
+	}
+}
+
 void PerlembParser::AddVar(std::string name, std::string val) {
 	vars_[name] = val;
 }
@@ -546,9 +606,13 @@ std::string PerlembParser::GetVar(std::string name) {
 
 void PerlembParser::ExportHash(const char *pkgprefix, const char *hashname, std::map<std::string, std::string> &vals)
 {
-	if(!perl)
+	if(!perl || !WantsExport(hashname))
 		return;
 
+	if(export_package_) {
+		export_package_->hashes.insert(hashname);
+	}
+
 	try
 	{
 		perl->sethash(
@@ -569,7 +633,9 @@ void PerlembParser::ExportVar(const char * pkgprefix, const char * varname, int
 		return;
 
 	try {
-		perl->seti(std::string(pkgprefix).append("::").append(varname).c_str(), value);
+		GV *gv = GetExportGV(pkgprefix, varname);
+		if(gv)
+			perl->seti(gv, value);
 
 	} catch(const char * err) {
 		std::string error = "Error exporting var: ";
@@ -585,7 +651,9 @@ void PerlembParser::ExportVar(const char * pkgprefix, const char * varname, unsi
 		return;
 
 	try {
-		perl->seti(std::string(pkgprefix).append("::").append(varname).c_str(), value);
+		GV *gv = GetExportGV(pkgprefix, varname);
+		if(gv)
+			perl->seti(gv, value);
 
 	} catch(const char * err) {
 		std::string error = "Error exporting var: ";
@@ -601,7 +669,9 @@ void PerlembParser::ExportVar(const char * pkgprefix, const char * varname, floa
 		return;
 
 	try {
-		perl->setd(std::string(pkgprefix).append("::").append(varname).c_str(), value);
+		GV *gv = GetExportGV(pkgprefix, varname);
+		if(gv)
+			perl->setd(gv, value);
 	} catch(const char * err) {
 		std::string error = "Error exporting var: ";
         error += err;
@@ -633,7 +703,9 @@ void PerlembParser::ExportVar(const char *pkgprefix, const char *varname, const
 
 	try
 	{
-		perl->setstr(std::string(pkgprefix).append("::").append(varname).c_str(), value);
+		GV *gv = GetExportGV(pkgprefix, varname);
+		if(gv)
+			perl->setstr(gv, value);
 	}
 	catch(const char * err)
 	{
@@ -643,11 +715,283 @@ void PerlembParser::ExportVar(const char *pkgprefix, const char *varname, const
 	}
 }
 
+/*
+	Glob to export varname through, or nullptr if the package being exported to
+	never reads it. Packages without a scan (nothing loaded them through us)
+	get everything, same as before the scan existed.
+*/
+GV *PerlembParser::GetExportGV(const char *pkgprefix, const char *varname)
+{
+	if(!export_package_) {
+		return perl->getgv(std::string(pkgprefix).append("::").append(varname).c_str());
+	}
+
+	std::string name(varname);
+	auto iter = export_package_->globs.find(name);
+	if(iter != export_package_->globs.end()) {
+		return iter->second;
+	}
+
+	GV *gv = nullptr;
+	if(WantsExport(varname)) {
+		gv = perl->getgv(std::string(pkgprefix).append("::").append(varname).c_str());
+	}
+
+	export_package_->globs[name] = gv;
+	return gv;
+}
+
+bool PerlembParser::WantsExport(const char *varname) const
+{
+	if(!export_package_ || export_package_->export_all || plugin_scan_failed_) {
+		return true;
+	}
+
+	std::string name(varname);
+	return export_package_->names.count(name) != 0 || plugin_exports_.count(name) != 0;
+}
+
+/*
+	True when a quest source may pull in code the scan never sees: a require
+	anywhere, or outside of strings and comments a do FILE, a string eval or a
+	use of anything but a lowercase pragma. Strings are only told apart by
+	their quotes, so q{}, regexes and heredocs can only cause false positives,
+	which just fall back to exporting everything.
+*/
+static bool HasPerlIncludes(const std::string &src)
+{
+	size_t len = src.length();
+	auto is_ident = [](char c) { return isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+	size_t pos = 0;
+	while((pos = src.find("require", pos)) != std::string::npos) {
+		if((pos == 0 || !is_ident(src[pos - 1])) && (pos + 7 >= len || !is_ident(src[pos + 7]))) {
+			return true;
+		}
+		pos += 7;
+	}
+
+	char quote = 0;
+	for(size_t i = 0; i < len; ++i) {
+		char c = src[i];
+		if(quote) {
+			if(c == '\\') {
+				++i;
+			} else if(c == quote) {
+				quote = 0;
+			}
+			continue;
+		}
+
+		if(c == '#' && (i == 0 || src[i - 1] != '$')) {
+			while(i < len && src[i] != '\n') {
+				++i;
+			}
+			continue;
+		}
+
+		if(c == '\'' || c == '"') {
+			quote = c;
+			continue;
+		}
+
+		if(!is_ident(c) || (i > 0 && (is_ident(src[i - 1]) || src[i - 1] == '$' || src[i - 1] == '@' ||
+			src[i - 1] == '%' || src[i - 1] == '&' || src[i - 1] == ':'))) {
+			continue;
+		}
+
+		size_t j = i;
+		while(j < len && is_ident(src[j])) {
+			++j;
+		}
+
+		std::string word = src.substr(i, j - i);
+		i = j - 1;
+		if(word != "do" && word != "eval" && word != "use") {
+			continue;
+		}
+
+		while(j < len && isspace(static_cast<unsigned char>(src[j]))) {
+			++j;
+		}
+
+		if(j >= len) {
+			continue;
+		}
+
+		if(word == "use") {
+			if(isupper(static_cast<unsigned char>(src[j]))) {
+				return true;
+			}
+		} else if(src[j] == '"' || src[j] == '\'' || src[j] == '$' || src[j] == '(' || is_ident(src[j])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+	Collects identifiers a perl source could read as package variables. With
+	sigils set that is every $name, @name, %name, ${name} and $#name; quoted
+	bare words are always taken since that is how plugin::val('name') style
+	helpers reach into the calling package. Returns false if the file could not
+	be read, builds variable names at runtime (${"..."}) or, with sigils set,
+	includes other files, in which case the caller has to assume every name is
+	used.
+*/
+static bool ScanPerlVariableNames(const std::string &filename, bool sigils, std::unordered_set<std::string> &names)
+{
+	std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+	if(!in) {
+		return false;
+	}
+
+	std::string src((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	size_t len = src.length();
+	if(sigils && HasPerlIncludes(src)) {
+		return false;
+	}
+
+	auto is_ident_start = [](char c) { return isalpha(static_cast<unsigned char>(c)) || c == '_'; };
+	auto is_ident = [](char c) { return isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+	auto read_ident = [&](size_t &j) -> std::string {
+		std::string ident;
+		while(j < len && is_ident_start(src[j])) {
+			size_t start = j;
+			while(j < len && is_ident(src[j])) {
+				++j;
+			}
+			//package qualified names only matter by their last part
+			ident = src.substr(start, j - start);
+			if(j + 1 < len && src[j] == ':' && src[j + 1] == ':') {
+				j += 2;
+			} else {
+				break;
+			}
+		}
+		return ident;
+	};
+
+	for(size_t i = 0; i < len; ++i) {
+		char c = src[i];
+		if(sigils && (c == '$' || c == '@' || c == '%')) {
+			size_t j = i + 1;
+			if(j < len && c == '$' && src[j] == '#') {
+				++j;
+			}
+
+			if(j < len && src[j] == '{') {
+				++j;
+				while(j < len && isspace(static_cast<unsigned char>(src[j]))) {
+					++j;
+				}
+
+				if(j < len && (src[j] == '"' || src[j] == '\'')) {
+					return false;
+				}
+			}
+
+			std::string ident = read_ident(j);
+			if(!ident.empty()) {
+				names.insert(ident);
+			}
+		} else if(c == '\'' || c == '"') {
+			size_t j = i + 1;
+			if(j < len && src[j] == '$') {
+				++j;
+			}
+
+			std::string ident = read_ident(j);
+			if(!ident.empty() && j < len && src[j] == c) {
+				names.insert(ident);
+			}
+		}
+	}
+
+	return true;
+}
+
+void PerlembParser::ScanPackageExports(const std::string &package_name, const std::string &filename)
+{
+	PackageExports &exports = package_exports_[package_name];
+	PackageExports previous;
+	previous.globs.swap(exports.globs);
+	previous.hashes.swap(exports.hashes);
+	exports.names.clear();
+	exports.export_all = true;
+
+	if(RuleB(Zone, PerlExportUsageScan)) {
+		exports.export_all = !ScanPerlVariableNames(filename, true, exports.names);
+	}
+
+	// a reloaded script must not read what an earlier load of it was last handed for names it no longer gets
+	export_package_ = &exports;
+	std::string clear;
+	for(auto &glob : previous.globs) {
+		if(glob.second && !WantsExport(glob.first.c_str())) {
+			clear.append("undef $").append(package_name).append("::").append(glob.first).append(";");
+		}
+	}
+	for(auto &hash : previous.hashes) {
+		if(!WantsExport(hash.c_str())) {
+			clear.append("undef %").append(package_name).append("::").append(hash).append(";");
+		}
+	}
+	export_package_ = nullptr;
+
+	if(!clear.empty()) {
+		try {
+			perl->eval(clear.c_str());
+		} catch(const char *err) {
+			AddError(std::string("Error clearing unused exports of ") + package_name + ": " + err);
+		}
+	}
+
+	Log(Logs::Detail, Logs::Quests, "Perl package %s references %u variables%s", package_name.c_str(),
+		static_cast<uint32>(exports.names.size()), exports.export_all ? ", exporting all" : "");
+}
+
+/*
+	Plugins run with the quest's package as caller and fetch its variables by
+	name, so anything a plugin asks for is treated as read by every package.
+*/
+void PerlembParser::ScanPluginExports()
+{
+	plugin_exports_.clear();
+	plugin_scan_failed_ = false;
+
+#ifdef EMBPERL_PLUGIN
+	// plugin.pl is optional, the plugin loader only warns when it is missing
+	struct stat st;
+	if(stat(Config->PluginPlFile.c_str(), &st) == 0 && !ScanPerlVariableNames(Config->PluginPlFile, false, plugin_exports_)) {
+		plugin_scan_failed_ = true;
+	}
+
+	EQ::Directory dir(Config->PluginDir);
+	std::vector<std::string> files;
+	dir.GetFiles(files);
+	for(auto &file : files) {
+		if(file.length() > 3 && file.compare(file.length() - 3, 3, ".pl") == 0 &&
+			!ScanPerlVariableNames(Config->PluginDir + "/" + file, false, plugin_exports_)) {
+			plugin_scan_failed_ = true;
+		}
+	}
+
+	if(plugin_scan_failed_) {
+		Log(Logs::General, Logs::Quests, "A perl plugin could not be scanned, every package gets every variable");
+	}
+#endif
+}
+
 int PerlembParser::SendCommands(const char *pkgprefix, const char *event, uint32 npcid, Mob* other, Mob* mob, EQEmu::ItemInstance* item_inst) {
 	if(!perl)
 		return 0;
 
 	int ret_value = 0;
+	BenchTimer timer;
+	bool sub_running = false;
 	if(mob && mob->IsClient())
 		quest_manager.StartQuest(other, mob->CastToClient(), item_inst);
 	else
@@ -725,7 +1069,11 @@ int PerlembParser::SendCommands(const char *pkgprefix, const char *event, uint32
 #endif
 
 		//now call the requested sub
+		timer.reset();
+		sub_running = true;
 		ret_value = perl->dosub(std::string(pkgprefix).append("::").append(event).c_str());
+		sub_running = false;
+		quest_profiler.Record(pkgprefix, event, static_cast<uint64>(timer.elapsed() * 1000000.0));
 
 #ifdef EMBPERL_XS_CLASSES
 		{
@@ -742,6 +1090,10 @@ int PerlembParser::SendCommands(const char *pkgprefix, const char *event, uint32
 
 	} catch(const char * err) {
 
+		//a handler that died still ran, a missing one did not
+		if(sub_running && !strstr(err, "Undefined subroutine"))
+			quest_profiler.Record(pkgprefix, event, static_cast<uint64>(timer.elapsed() * 1000000.0));
+
 		//try to reduce some of the console spam...
 		//todo: tweak this to be more accurate at deciding what to filter (we don't want to gag legit errors)
 		if(!strstr(err,"Undefined subroutine")) {
@@ -918,116 +1270,32 @@ void PerlembParser::ExportCharID(const std::string &package_name, int &char_id,
 
 void PerlembParser::ExportQGlobals(bool isPlayerQuest, bool isGlobalPlayerQuest, bool isGlobalNPC, bool isItemQuest,
 	bool isSpellQuest, std::string &package_name, NPC *npcmob, Mob *mob, int char_id) {
+	NPC *npc = nullptr;
+
 	//NPC quest
 	if(!isPlayerQuest && !isGlobalPlayerQuest && !isItemQuest && !isSpellQuest)
 	{
 		//only export for npcs that are global enabled.
-		if(npcmob && npcmob->GetQglobal())
-		{
-			std::map<std::string, std::string> globhash;
-			QGlobalCache *npc_c = nullptr;
-			QGlobalCache *char_c = nullptr;
-			QGlobalCache *zone_c = nullptr;
+		if(!npcmob || !npcmob->GetQglobal())
+			return;
 
-			//retrieve our globals
-			npc_c = npcmob->GetQGlobals();
-			if(mob && mob->IsClient())
-				char_c = mob->CastToClient()->GetQGlobals();
-			zone_c = zone->GetQGlobals();
-
-			if(!npc_c)
-			{
-				npc_c = npcmob->CreateQGlobals();
-				npc_c->LoadByNPCID(npcmob->GetNPCTypeID());
-			}
-
-			if(!char_c)
-			{
-				if(mob && mob->IsClient())
-				{
-					char_c = mob->CastToClient()->CreateQGlobals();
-					char_c->LoadByCharID(mob->CastToClient()->CharacterID());
-				}
-			}
-
-			if(!zone_c)
-			{
-				zone_c = zone->CreateQGlobals();
-				zone_c->LoadByZoneID(zone->GetZoneID());
-				zone_c->LoadByGlobalContext();
-			}
-
-			std::list<QGlobal> globalMap;
-			if(npc_c)
-			{
-				QGlobalCache::Combine(globalMap, npc_c->GetBucket(), npcmob->GetNPCTypeID(), char_id, zone->GetZoneID());
-			}
-
-			if(char_c)
-			{
-				QGlobalCache::Combine(globalMap, char_c->GetBucket(), npcmob->GetNPCTypeID(), char_id, zone->GetZoneID());
-			}
-
-			if(zone_c)
-			{
-				QGlobalCache::Combine(globalMap, zone_c->GetBucket(), npcmob->GetNPCTypeID(), char_id, zone->GetZoneID());
-			}
-
-			auto iter = globalMap.begin();
-			while(iter != globalMap.end())
-			{
-				globhash[(*iter).name] = (*iter).value;
-				ExportVar(package_name.c_str(), (*iter).name.c_str(), (*iter).value.c_str());
-				++iter;
-			}
-			ExportHash(package_name.c_str(), "qglobals", globhash);
-		}
+		npc = npcmob;
 	}
-	else
-	{
-		std::map<std::string, std::string> globhash;
-		QGlobalCache *char_c = nullptr;
-		QGlobalCache *zone_c = nullptr;
 
-		//retrieve our globals
-		if(mob && mob->IsClient())
-			char_c = mob->CastToClient()->GetQGlobals();
-		zone_c = zone->GetQGlobals();
+	Client *client = (mob && mob->IsClient()) ? mob->CastToClient() : nullptr;
+	QGlobalView view(npc, client, zone);
+	view.SetCharID(char_id);
 
-		if(!char_c)
-		{
-			if(mob && mob->IsClient())
-			{
-				char_c = mob->CastToClient()->CreateQGlobals();
-				char_c->LoadByCharID(mob->CastToClient()->CharacterID());
-			}
-		}
-
-		if(!zone_c)
-		{
-			zone_c = zone->CreateQGlobals();
-			zone_c->LoadByZoneID(zone->GetZoneID());
-			zone_c->LoadByGlobalContext();
+	bool export_hash = WantsExport("qglobals");
+	std::map<std::string, std::string> globhash;
+	view.ForEach([&](const QGlobal &g) {
+		if(export_hash) {
+			globhash[g.name] = g.value;
 		}
+		ExportVar(package_name.c_str(), g.name.c_str(), g.value.c_str());
+	});
 
-		std::list<QGlobal> globalMap;
-		if(char_c)
-		{
-			QGlobalCache::Combine(globalMap, char_c->GetBucket(), 0, char_id, zone->GetZoneID());
-		}
-
-		if(zone_c)
-		{
-			QGlobalCache::Combine(globalMap, zone_c->GetBucket(), 0, char_id, zone->GetZoneID());
-		}
-
-		auto iter = globalMap.begin();
-		while(iter != globalMap.end())
-		{
-			globhash[(*iter).name] = (*iter).value;
-			ExportVar(package_name.c_str(), (*iter).name.c_str(), (*iter).value.c_str());
-			++iter;
-		}
+	if(export_hash) {
 		ExportHash(package_name.c_str(), "qglobals", globhash);
 	}
 }
@@ -1043,7 +1311,7 @@ void PerlembParser::ExportMobVariables(bool isPlayerQuest, bool isGlobalPlayerQu
 	}
 
 	if(!isPlayerQuest && !isGlobalPlayerQuest && !isItemQuest) {
-		if (mob && npcmob && mob->IsClient()) {
+		if (mob && npcmob && mob->IsClient() && WantsExport("faction")) {
 			Client* client = mob->CastToClient();
 
 			fac = client->GetFactionLevel(client->CharacterID(), npcmob->GetID(), client->GetRace(),
@@ -1104,7 +1372,7 @@ void PerlembParser::ExportZoneVariables(std::string &package_name) {
 #define HASITEM_ISNULLITEM(item) ((item==-1) || (item==0))
 
 void PerlembParser::ExportItemVariables(std::string &package_name, Mob *mob) {
-	if(mob && mob->IsClient())
+	if(mob && mob->IsClient() && WantsExport("hasitem"))
 	{
 		std::string hashname = package_name + std::string("::hasitem");
 
@@ -1124,7 +1392,7 @@ void PerlembParser::ExportItemVariables(std::string &package_name, Mob *mob) {
 		}
 	}
 
-	if(mob && mob->IsClient()) {
+	if(mob && mob->IsClient() && WantsExport("oncursor")) {
 		std::string hashname = package_name + std::string("::oncursor");
 		perl->eval(std::string("%").append(hashname).append(" = ();").c_str());
 		char *hi_decl = nullptr;
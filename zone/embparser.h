@@ -25,6 +25,8 @@
 #include <string>
 #include <queue>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include "embperl.h"
 
 class Mob;
@@ -48,15 +50,15 @@ public:
 	PerlembParser();
 	~PerlembParser();
 	
-	virtual int EventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	virtual int EventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	virtual int EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	virtual int EventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventGlobalPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	virtual int EventGlobalPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+	virtual int EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
 	virtual int EventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
@@ -74,6 +76,10 @@ public:
 	virtual void LoadGlobalPlayerScript(std::string filename);
 	virtual void LoadItemScript(std::string filename, EQEmu::ItemInstance *item);
 	virtual void LoadSpellScript(std::string filename, uint32 spell_id);
+	virtual void UnloadNPCScript(std::string filename, int npc_id);
+	virtual void UnloadGlobalNPCScript(std::string filename);
+	virtual void UnloadPlayerScript(std::string filename);
+	virtual void UnloadGlobalPlayerScript(std::string filename);
 
 	virtual void AddVar(std::string name, std::string val);
 	virtual std::string GetVar(std::string name);
@@ -81,6 +87,18 @@ public:
 	virtual uint32 GetIdentifier() { return 0xf8b05c11; }
 
 private:
+	/*
+		Which variables a loaded package can actually read. Filled in by scanning
+		the script source when it is loaded; globs for the names that pass are
+		resolved once and reused for every later event.
+	*/
+	struct PackageExports {
+		bool export_all;
+		std::unordered_set<std::string> names;
+		std::unordered_map<std::string, GV*> globs;
+		std::unordered_set<std::string> hashes;	// exported with ExportHash
+	};
+
 	Embperl *perl;
 	
 	void ExportHash(const char *pkgprefix, const char *hashname, std::map<std::string, std::string> &vals);
@@ -89,6 +107,11 @@ private:
 	void ExportVar(const char *pkgprefix, const char *varname, uint32 value);
 	void ExportVar(const char *pkgprefix, const char *varname, float value);
 	void ExportVarComplex(const char *pkgprefix, const char *varname, const char *value);
+	GV *GetExportGV(const char *pkgprefix, const char *varname);
+	bool WantsExport(const char *varname) const;
+	void ScanPackageExports(const std::string &package_name, const std::string &filename);
+	void ScanPluginExports();
+	void UnloadPackage(const std::string &package_name, const std::string &filename);
 
 	int EventCommon(QuestEventID event, uint32 objid, const char * data, NPC* npcmob, EQEmu::ItemInstance* item_inst, Mob* mob, 
 		uint32 extradata, bool global, std::vector<EQEmu::Any> *extra_pointers);
@@ -120,6 +143,11 @@ private:
 	std::map<std::string, std::string> vars_;
 	SV *_empty_sv;
 	std::map<std::string, int> clear_vars_;
+
+	std::unordered_map<std::string, PackageExports> package_exports_;
+	std::unordered_set<std::string> plugin_exports_;
+	bool plugin_scan_failed_;
+	PackageExports *export_package_;
 };
 
 #endif
@@ -135,6 +135,21 @@ public:
 		sv_setpv(t, val);
 	}
 
+	//look up (creating if needed) the glob behind a package variable, so repeated
+	//exports to the same variable can skip building and hashing its name
+	GV *getgv(const char *varname) const {
+		return gv_fetchpv(varname, GV_ADD, SVt_PV);
+	}
+	void seti(GV *gv, int val) const {
+		sv_setiv(GvSVn(gv), val);
+	}
+	void setd(GV *gv, float val) const {
+		sv_setnv(GvSVn(gv), val);
+	}
+	void setstr(GV *gv, const char *val) const {
+		sv_setpv(GvSVn(gv), val);
+	}
+
 	// put key-value pairs in hash
 	void sethash(const char *varname, std::map<std::string,std::string> &vals)
 	{
@@ -160,6 +175,8 @@ public:
 	//loads a file and compiles it into our interpreter (assuming it hasn't already been read in)
 	//idea borrowed from perlembed
 	int eval_file(const char * packagename, const char * filename);
+	//throws away a package and forgets its file was required, so eval_file will compile it again
+	int unload_file(const char * packagename, const char * filename);
 
 	inline bool InUse() const { return(in_use); }
 
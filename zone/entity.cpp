@@ -286,6 +286,16 @@ Bot *Entity::CastToBot()
 #endif
 
 EntityList::EntityList()
+	: ai_wake_cell_size(600.0f),
+	ai_active_count(0),
+	ai_sleeping_count(0),
+	mob_process_time(0.0),
+	mob_process_time_avg(0.0),
+	mob_process_time_max(0.0),
+	mob_process_report_start(0),
+	mob_process_report_ticks(0),
+	mob_process_report_time(0.0),
+	mob_process_report_max(0.0)
 {
 	// set up ids between 1 and 1500
 	// neither client or server performs well if you have
@@ -469,6 +479,14 @@ void EntityList::CorpseProcess()
 void EntityList::MobProcess()
 {
 	bool mob_dead;
+	BenchTimer process_timer;
+
+	bool ai_sleep = RuleB(NPC, AISleepEnabled);
+	if (ai_sleep)
+		BuildAIWakeCells();
+
+	ai_active_count = 0;
+	ai_sleeping_count = 0;
 
 	auto it = mob_list.begin();
 	while (it != mob_list.end()) {
@@ -477,6 +495,25 @@ void EntityList::MobProcess()
 
 		size_t sz = mob_list.size();
 
+		if (mob->IsNPC()) {
+			NPC *npc = mob->CastToNPC();
+			bool skip = false;
+			if (ai_sleep)
+				skip = npc->CheckAISleep(IsInAIWakeArea(mob));
+			else if (npc->IsAISleeping())
+				npc->WakeAI();
+
+			if (npc->IsAISleeping())
+				ai_sleeping_count++;
+			else
+				ai_active_count++;
+
+			if (skip) {
+				++it;
+				continue;
+			}
+		}
+
 #ifdef IDLE_WHEN_EMPTY
 		if (numclients > 0 || 
 			mob->GetWanderType() == 4 || mob->GetWanderType() == 6) {
@@ -540,6 +577,69 @@ void EntityList::MobProcess()
 			entity_list.RemoveMob(id);
 		}
 	}
+
+	aggro_broadphase.Process();
+
+	mob_process_time = process_timer.elapsed();
+	mob_process_time_avg = mob_process_time_avg * 0.95 + mob_process_time * 0.05;
+	if (mob_process_time > mob_process_time_max)
+		mob_process_time_max = mob_process_time;
+
+	// one line a minute so the effect of AI sleep on tick time shows up in the logs of a live zone
+	if (mob_process_report_start == 0)
+		mob_process_report_start = Timer::GetCurrentTime();
+	++mob_process_report_ticks;
+	mob_process_report_time += mob_process_time;
+	if (mob_process_time > mob_process_report_max)
+		mob_process_report_max = mob_process_time;
+
+	if (Timer::GetCurrentTime() - mob_process_report_start >= 60000) {
+		Log(Logs::General, Logs::AI, "Mob process: %u ticks, avg %.3f ms, max %.3f ms, %u active and %u sleeping NPCs, AI sleep %s",
+			mob_process_report_ticks, mob_process_report_time * 1000.0 / mob_process_report_ticks, mob_process_report_max * 1000.0,
+			ai_active_count, ai_sleeping_count, ai_sleep ? "on" : "off");
+		mob_process_report_start = Timer::GetCurrentTime();
+		mob_process_report_ticks = 0;
+		mob_process_report_time = 0.0;
+		mob_process_report_max = 0.0;
+	}
+}
+
+void EntityList::ResetMobProcessStats()
+{
+	mob_process_time = 0.0;
+	mob_process_time_avg = 0.0;
+	mob_process_time_max = 0.0;
+}
+
+/*
+	Marks every grid cell touching a client's neighborhood. With the cell size
+	equal to the sleep radius, any NPC within that radius of a client is
+	guaranteed to be in a marked cell, so the per NPC test is a single lookup.
+*/
+void EntityList::BuildAIWakeCells()
+{
+	ai_wake_cells.clear();
+	ai_wake_cell_size = static_cast<float>(std::max(RuleI(NPC, AISleepRadius), 50));
+
+	for (auto &it : client_list) {
+		Client *c = it.second;
+		int cx = static_cast<int>(std::floor(c->GetX() / ai_wake_cell_size));
+		int cy = static_cast<int>(std::floor(c->GetY() / ai_wake_cell_size));
+		for (int x = cx - 1; x <= cx + 1; ++x) {
+			for (int y = cy - 1; y <= cy + 1; ++y)
+				ai_wake_cells.insert((static_cast<uint64>(static_cast<uint32>(x)) << 32) | static_cast<uint32>(y));
+		}
+	}
+}
+
+bool EntityList::IsInAIWakeArea(Mob *mob) const
+{
+	if (ai_wake_cells.empty())
+		return false;
+
+	int cx = static_cast<int>(std::floor(mob->GetX() / ai_wake_cell_size));
+	int cy = static_cast<int>(std::floor(mob->GetY() / ai_wake_cell_size));
+	return ai_wake_cells.count((static_cast<uint64>(static_cast<uint32>(cx)) << 32) | static_cast<uint32>(cy)) != 0;
 }
 
 void EntityList::BeaconProcess()
@@ -677,6 +777,7 @@ void EntityList::AddNPC(NPC *npc, bool SendSpawnPacket, bool dontqueue)
 
 	npc_list.insert(std::pair<uint16, NPC *>(npc->GetID(), npc));
 	mob_list.insert(std::pair<uint16, Mob *>(npc->GetID(), npc));
+	npc_type_index.Add(npc->GetNPCTypeID(), npc->GetID());
 
 	/* Zone controller process EVENT_SPAWN_ZONE */
 	if (RuleB(Zone, UseZoneController)) {
@@ -1060,17 +1161,30 @@ Entity *EntityList::GetID(uint16 get_id)
 
 NPC *EntityList::GetNPCByNPCTypeID(uint32 npc_id)
 {
-	if (npc_id == 0 || npc_list.empty())
+	if (npc_id == 0)
 		return nullptr;
 
-	auto it = npc_list.begin();
-	while (it != npc_list.end()) {
-		if (it->second->GetNPCTypeID() == npc_id)
-			return it->second;
-		++it;
-	}
+	auto ids = npc_type_index.Find(npc_id);
+	if (!ids)
+		return nullptr;
 
-	return nullptr;
+	return GetNPCByID(ids->front());
+}
+
+// every spawned npc of this type, oldest spawn first
+void EntityList::GetNPCsByNPCTypeID(uint32 npc_id, std::vector<NPC *> &npcs)
+{
+	npcs.clear();
+
+	auto ids = npc_type_index.Find(npc_id);
+	if (!ids)
+		return;
+
+	for (auto id : *ids) {
+		NPC *npc = GetNPCByID(id);
+		if (npc)
+			npcs.push_back(npc);
+	}
 }
 
 Mob *EntityList::GetMob(uint16 get_id)
@@ -1119,15 +1233,18 @@ Mob *EntityList::GetMobByNpcTypeID(uint32 get_id)
 
 bool EntityList::IsMobSpawnedByNpcTypeID(uint32 get_id)
 {
-	if (get_id == 0 || npc_list.empty())
+	if (get_id == 0)
 		return false;
 
-	auto it = npc_list.begin();
-	while (it != npc_list.end()) {
+	auto ids = npc_type_index.Find(get_id);
+	if (!ids)
+		return false;
+
+	for (auto id : *ids) {
 		// Mobs will have a 0 as their GetID() if they're dead
-		if (it->second->GetNPCTypeID() == get_id && it->second->GetID() != 0)
+		NPC *npc = GetNPCByID(id);
+		if (npc && npc->GetID() != 0)
 			return true;
-		++it;
 	}
 
 	return false;
@@ -2177,6 +2294,8 @@ void EntityList::RemoveAllNPCs()
 	// doesn't clear the data
 	npc_list.clear();
 	npc_limit_list.clear();
+	npc_type_index.Clear();
+	signal_queue.Clear();
 }
 
 void EntityList::RemoveAllMercs()
@@ -2334,6 +2453,9 @@ bool EntityList::RemoveNPC(uint16 delete_id)
 		// remove from the list
 		npc_list.erase(it);
 
+		npc_type_index.Remove(delete_id);
+		signal_queue.Remove(delete_id);
+
 		// remove from limit list if needed
 		if (npc_limit_list.count(delete_id))
 			npc_limit_list.erase(delete_id);
@@ -2474,6 +2596,7 @@ void EntityList::Clear()
 	entity_list.RemoveAllObjects();
 	entity_list.RemoveAllRaids();
 	entity_list.RemoveAllLocalities();
+	aggro_broadphase.Clear();
 }
 
 void EntityList::UpdateWho(bool iSendFullUpdate)
@@ -2589,11 +2712,10 @@ void EntityList::Depop(bool StartSpawnTimer)
 
 void EntityList::DepopAll(int NPCTypeID, bool StartSpawnTimer)
 {
-	for (auto it = npc_list.begin(); it != npc_list.end(); ++it) {
-		NPC *pnpc = it->second;
-		if (pnpc && (pnpc->GetNPCTypeID() == (uint32)NPCTypeID))
-			pnpc->Depop(StartSpawnTimer);
-	}
+	std::vector<NPC *> npcs;
+	GetNPCsByNPCTypeID(static_cast<uint32>(NPCTypeID), npcs);
+	for (auto pnpc : npcs)
+		pnpc->Depop(StartSpawnTimer);
 }
 
 void EntityList::SendTraders(Client *client)
@@ -3143,16 +3265,61 @@ void EntityList::AggroZone(Mob *who, uint32 hate)
 	}
 }
 
-// Signal Quest command function
+/*
+ * Signal Quest command function
+ *
+ * Signals go straight to the npcs as before until NPC:SignalsPerTick of them
+ * were delivered this quest tick. The rest are queued and ProcessSignals hands
+ * them out on the following ticks, anything sent while some are queued waits
+ * behind them. Delivery keeps send order: one npc sees its signals in the
+ * order they were sent and a fan-out reaches the npcs in spawn order. With
+ * NPC:CoalesceSignals a queued signal an npc is still waiting on is not queued
+ * a second time.
+ */
 void EntityList::SignalMobsByNPCID(uint32 snpc, int signal_id)
 {
-	auto it = npc_list.begin();
-	while (it != npc_list.end()) {
-		NPC *pit = it->second;
-		if (pit->GetNPCTypeID() == snpc)
-			pit->SignalNPC(signal_id);
-		++it;
+	auto ids = npc_type_index.Find(snpc);
+	if (!ids)
+		return;
+
+	size_t budget = static_cast<size_t>(std::max(RuleI(NPC, SignalsPerTick), 0));
+	bool coalesce = RuleB(NPC, CoalesceSignals);
+	// delivering cannot change the index, SignalNPC only queues on the npc
+	for (auto id : *ids) {
+		if (signal_queue.TakeInline(budget)) {
+			NPC *npc = GetNPCByID(id);
+			if (npc)
+				npc->SignalNPC(signal_id);
+		}
+		else {
+			signal_queue.Push(id, signal_id, coalesce);
+		}
+	}
+}
+
+// keeps the by-type lookups finding a spawned npc whose type id changes
+void EntityList::ChangeNPCType(NPC *npc, uint32 npc_type_id)
+{
+	npc->SetNPCTypeID(npc_type_id);
+	npc_type_index.Change(npc->GetID(), npc_type_id);
+}
+
+void EntityList::ProcessSignals()
+{
+	signal_queue.BeginTick();
+	if (signal_queue.Empty())
+		return;
+
+	signal_queue.Pop(static_cast<size_t>(std::max(RuleI(NPC, SignalsPerTick), 0)), signal_batch);
+	for (auto &s : signal_batch) {
+		NPC *npc = GetNPCByID(static_cast<uint16>(s.target));
+		if (npc)
+			npc->SignalNPC(s.signal_id);
 	}
+
+	if (!signal_queue.Empty())
+		Log(Logs::Detail, Logs::Quests, "Signals delivered (%u) still queued (%u)", (uint32)signal_batch.size(),
+			(uint32)signal_queue.Size());
 }
 
 bool EntityList::MakeTrackPacket(Client *client)
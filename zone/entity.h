@@ -19,6 +19,7 @@
 #define ENTITY_H
 
 #include <unordered_map>
+#include <unordered_set>
 #include <queue>
 
 #include "../common/types.h"
@@ -26,7 +27,10 @@
 #include "../common/servertalk.h"
 #include "../common/bodytypes.h"
 #include "../common/eq_constants.h"
+#include "../common/util/npc_type_index.h"
+#include "../common/util/signal_queue.h"
 
+#include "aggro_broadphase.h"
 #include "position.h"
 #include "zonedump.h"
 
@@ -156,6 +160,7 @@ public:
 		return nullptr;
 	}
 	NPC *GetNPCByNPCTypeID(uint32 npc_id);
+	void GetNPCsByNPCTypeID(uint32 npc_id, std::vector<NPC *> &npcs);
 	inline Merc *GetMercByID(uint16 id)
 	{
 		auto it = merc_list.find(id);
@@ -272,6 +277,7 @@ public:
 	bool	RemoveClient(uint16 delete_id);
 	bool	RemoveClient(Client* delete_client);
 	bool	RemoveNPC(uint16 delete_id);
+	void	ChangeNPCType(NPC *npc, uint32 npc_type_id);
 	bool	RemoveMerc(uint16 delete_id);
 	bool	RemoveGroup(uint32 delete_id);
 	bool	RemoveRaid(uint32 delete_id);
@@ -375,6 +381,8 @@ public:
 	char*	MakeNameUnique(char* name);
 	static char* RemoveNumbers(char* name);
 	void	SignalMobsByNPCID(uint32 npc_type, int signal_id);
+	void	ProcessSignals();
+	inline size_t GetPendingSignalCount() const { return signal_queue.Size(); }
 	void	CountNPC(uint32* NPCCount, uint32* NPCLootCount, uint32* gmspawntype_count);
 	void	RemoveEntity(uint16 id);
 	void	SendPetitionToAdmins(Petition* pet);
@@ -469,6 +477,15 @@ public:
 	void	DepopAll(int NPCTypeID, bool StartSpawnTimer = true);
 
 	uint16 GetFreeID();
+	inline AggroBroadphase &GetAggroBroadphase() { return aggro_broadphase; }
+
+	inline uint32 GetAIActiveCount() const { return ai_active_count; }
+	inline uint32 GetAISleepingCount() const { return ai_sleeping_count; }
+	inline double GetMobProcessTime() const { return mob_process_time; }
+	inline double GetMobProcessTimeAvg() const { return mob_process_time_avg; }
+	inline double GetMobProcessTimeMax() const { return mob_process_time_max; }
+	void	ResetMobProcessStats();
+
 	void RefreshAutoXTargets(Client *c);
 	void RefreshClientXTargets(Client *c);
 	void SendAlternateAdvancementStats();
@@ -480,6 +497,8 @@ protected:
 private:
 	void	AddToSpawnQueue(uint16 entityid, NewSpawn_Struct** app);
 	void	CheckSpawnQueue();
+	void	BuildAIWakeCells();
+	bool	IsInAIWakeArea(Mob *mob) const;
 
 	//used for limiting spawns
 	class SpawnLimitRecord { public: uint32 spawngroup_id; uint32 npc_type; };
@@ -504,6 +523,25 @@ private:
 	std::list<Raid *> raid_list;
 	std::list<Area> area_list;
 	std::queue<uint16> free_ids;
+	AggroBroadphase aggro_broadphase;
+
+	//npc type id -> entity ids, in spawn order
+	EQ::NPCTypeIndex npc_type_index;
+	EQ::SignalQueue signal_queue;
+	std::vector<EQ::SignalQueue::Signal> signal_batch;
+
+	//NPC AI sleep, cells within NPC:AISleepRadius of any client
+	std::unordered_set<uint64> ai_wake_cells;
+	float	ai_wake_cell_size;
+	uint32	ai_active_count;
+	uint32	ai_sleeping_count;
+	double	mob_process_time;
+	double	mob_process_time_avg;
+	double	mob_process_time_max;
+	uint32	mob_process_report_start;
+	uint32	mob_process_report_ticks;
+	double	mob_process_report_time;
+	double	mob_process_report_max;
 
 	// Please Do Not Declare Any EntityList Class Members After This Comment
 #ifdef BOTS
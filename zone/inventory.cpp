@@ -673,10 +673,9 @@ void Client::DropItem(int16 slot_id, bool recurse)
 	// Save client inventory change to database
 	if (slot_id == EQEmu::inventory::slotCursor) {
 		SendCursorBuffer();
-		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-		database.SaveCursor(CharacterID(), s, e);
+		SaveCursorQueue();
 	} else {
-		database.SaveInventory(CharacterID(), nullptr, slot_id);
+		SaveInventorySlot(nullptr, slot_id);
 	}
 
 	if(!inst)
@@ -846,15 +845,14 @@ void Client::DeleteItemInInventory(int16 slot_id, int8 quantity, bool client_upd
 
 	const EQEmu::ItemInstance* inst = nullptr;
 	if (slot_id == EQEmu::inventory::slotCursor) {
-		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
 		if(update_db)
-			database.SaveCursor(character_id, s, e);
+			SaveCursorQueue();
 	}
 	else {
 		// Save change to database
 		inst = m_inv[slot_id];
 		if(update_db)
-			database.SaveInventory(character_id, inst, slot_id);
+			SaveInventorySlot(inst, slot_id);
 	}
 
 	if(client_update && IsValidSlot(slot_id)) {
@@ -891,6 +889,76 @@ void Client::DeleteItemInInventory(int16 slot_id, int8 quantity, bool client_upd
 	}
 }
 
+// Saves a slot now, or journals it for the next FlushInventoryJournal when Inventory:JournalSaves is on
+bool Client::SaveInventorySlot(const EQEmu::ItemInstance* inst, int16 slot_id)
+{
+	if (!RuleB(Inventory, JournalSaves))
+		return database.SaveInventory(CharacterID(), inst, slot_id);
+
+	m_inv.JournalSlot(slot_id);
+	return true;
+}
+
+bool Client::SaveCursorQueue()
+{
+	if (!RuleB(Inventory, JournalSaves)) {
+		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
+		return database.SaveCursor(CharacterID(), s, e);
+	}
+
+	m_inv.JournalCursor();
+	return true;
+}
+
+/*
+ * Writes the journaled slots of this client, and of with when given (both
+ * sides of a trade), in one transaction so a crash can't persist half of an
+ * item move. On failure everything is rolled back and stays journaled.
+ */
+bool Client::FlushInventoryJournal(Client* with)
+{
+	if (with == this)
+		with = nullptr;
+
+	if (m_inv.JournalEmpty() && (!with || with->m_inv.JournalEmpty()))
+		return true;
+
+	uint32 slot_count = m_inv.GetJournalSlots().size() + (with ? with->m_inv.GetJournalSlots().size() : 0);
+	uint32 query_count = 0;
+	uint32 with_query_count = 0;
+
+	database.TransactionBegin();
+	bool success = database.SaveInventoryJournal(CharacterID(), &m_inv, &query_count);
+	if (success && with)
+		success = database.SaveInventoryJournal(with->CharacterID(), &with->m_inv, &with_query_count);
+
+	if (success) {
+		database.TransactionCommit();
+		m_inv.ClearJournal();
+		if (with)
+			with->m_inv.ClearJournal();
+
+		if (inventory_journal_failures) {
+			Log(Logs::General, Logs::Error, "Inventory journal flush for %s succeeded after %u failed attempts", GetName(), inventory_journal_failures);
+			inventory_journal_failures = 0;
+			inventory_journal_retry_timer.Disable();
+		}
+	}
+	else {
+		database.TransactionRollback();
+
+		// one error per failure streak, retries back off from 1s doubling up to 30s
+		if (inventory_journal_failures++ == 0)
+			Log(Logs::General, Logs::Error, "Inventory journal flush failed for %s, retrying with backoff", GetName());
+		inventory_journal_retry_timer.Start(std::min(1000u << std::min(inventory_journal_failures - 1, 5u), 30000u));
+	}
+
+	Log(Logs::Detail, Logs::Inventory, "Inventory journal flush for %s%s%s: %u slots, %u queries",
+		GetName(), (with ? " and " : ""), (with ? with->GetName() : ""), slot_count, query_count + with_query_count + 2);
+
+	return success;
+}
+
 bool Client::PushItemOnCursor(const EQEmu::ItemInstance& inst, bool client_update)
 {
 	Log(Logs::Detail, Logs::Inventory, "Putting item %s (%d) on the cursor", inst.GetItem()->Name, inst.GetItem()->ID);
@@ -900,8 +968,7 @@ bool Client::PushItemOnCursor(const EQEmu::ItemInstance& inst, bool client_updat
 		SendItemPacket(EQEmu::inventory::slotCursor, &inst, ItemPacketLimbo);
 	}
 
-	auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-	return database.SaveCursor(CharacterID(), s, e);
+	return SaveCursorQueue();
 }
 
 // Puts an item into the person's inventory
@@ -925,11 +992,10 @@ bool Client::PutItemInInventory(int16 slot_id, const EQEmu::ItemInstance& inst,
 	}
 		
 	if (slot_id == EQEmu::inventory::slotCursor) {
-		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-		return database.SaveCursor(this->CharacterID(), s, e);
+		return SaveCursorQueue();
 	}
 	else {
-		return database.SaveInventory(this->CharacterID(), &inst, slot_id);
+		return SaveInventorySlot(&inst, slot_id);
 	}
 
 	CalcBonuses();
@@ -944,12 +1010,11 @@ void Client::PutLootInInventory(int16 slot_id, const EQEmu::ItemInstance &inst,
 
 	if (slot_id == EQEmu::inventory::slotCursor) {
 		m_inv.PushCursor(inst);
-		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-		database.SaveCursor(this->CharacterID(), s, e);
+		SaveCursorQueue();
 	}
 	else {
 		m_inv.PutItem(slot_id, inst);
-		database.SaveInventory(this->CharacterID(), &inst, slot_id);
+		SaveInventorySlot(&inst, slot_id);
 	}
 
 	// Subordinate items in cursor buffer must be sent via ItemPacketSummonItem or we just overwrite the visible cursor and desync the client
@@ -1118,11 +1183,10 @@ void Client::MoveItemCharges(EQEmu::ItemInstance &from, int16 to_slot, uint8 typ
 		from.SetCharges(from.GetCharges() - charges_to_move);
 		SendLootItemInPacket(tmp_inst, to_slot);
 		if (to_slot == EQEmu::inventory::slotCursor) {
-			auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-			database.SaveCursor(this->CharacterID(), s, e);
+			SaveCursorQueue();
 		}
 		else {
-			database.SaveInventory(this->CharacterID(), tmp_inst, to_slot);
+			SaveInventorySlot(tmp_inst, to_slot);
 		}
 	}
 }
@@ -1699,12 +1763,11 @@ bool Client::SwapItem(MoveItem_Struct* move_in) {
 				{
 					SendCursorBuffer();
 				}
-				auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-				database.SaveCursor(character_id, s, e);
+				SaveCursorQueue();
 			}
 			else
 			{
-				database.SaveInventory(character_id, m_inv[src_slot_id], src_slot_id);
+				SaveInventorySlot(m_inv[src_slot_id], src_slot_id);
 			}
 
 			if(RuleB(QueryServ, PlayerLogMoves)) { QSSwapItemAuditor(move_in, true); } // QS Audit
@@ -1777,7 +1840,7 @@ bool Client::SwapItem(MoveItem_Struct* move_in) {
 				if (src_inst->GetCharges() < 1)
 				{
 					Log(Logs::Detail, Logs::Inventory, "Dest (%d) now has %d charges, source (%d) was entirely consumed. (%d moved)", dst_slot_id, dst_inst->GetCharges(), src_slot_id, usedcharges);
-					database.SaveInventory(CharacterID(),nullptr,src_slot_id);
+					SaveInventorySlot(nullptr,src_slot_id);
 					m_inv.DeleteItem(src_slot_id);
 					all_to_stack = true;
 				} else {
@@ -1873,19 +1936,17 @@ bool Client::SwapItem(MoveItem_Struct* move_in) {
 		{
 			SendCursorBuffer();
 		}
-		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-		database.SaveCursor(character_id, s, e);
+		SaveCursorQueue();
 	}
 	else {
-		database.SaveInventory(character_id, m_inv.GetItem(src_slot_id), src_slot_id);
+		SaveInventorySlot(m_inv.GetItem(src_slot_id), src_slot_id);
 	}
 
 	if (dst_slot_id == EQEmu::inventory::slotCursor) {
-		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-		database.SaveCursor(character_id, s, e);
+		SaveCursorQueue();
 	}
 	else {
-		database.SaveInventory(character_id, m_inv.GetItem(dst_slot_id), dst_slot_id);
+		SaveInventorySlot(m_inv.GetItem(dst_slot_id), dst_slot_id);
 	}
 
 	if(RuleB(QueryServ, PlayerLogMoves)) { QSSwapItemAuditor(move_in, true); } // QS Audit
@@ -2101,7 +2162,7 @@ void Client::DyeArmor(EQEmu::TintProfile* dye){
 					uint32 armor_color = ((uint32)dye->Slot[i].Red << 16) | ((uint32)dye->Slot[i].Green << 8) | ((uint32)dye->Slot[i].Blue);
 					inst->SetColor(armor_color); 
 					database.SaveCharacterMaterialColor(this->CharacterID(), i, armor_color);
-					database.SaveInventory(CharacterID(),inst,slot2);
+					SaveInventorySlot(inst,slot2);
 					if(dye->Slot[i].UseTint)
 						m_pp.item_tint.Slot[i].UseTint = 0xFF;
 					else
@@ -2396,8 +2457,7 @@ void Client::DisenchantSummonedBags(bool client_update)
 			}
 			local.clear();
 
-			auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-			database.SaveCursor(this->CharacterID(), s, e);
+			SaveCursorQueue();
 		}
 		else {
 			safe_delete(new_inst); // deletes disenchanted bag if not used
@@ -2495,8 +2555,7 @@ void Client::RemoveNoRent(bool client_update)
 		}
 		local.clear();
 
-		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-		database.SaveCursor(this->CharacterID(), s, e);
+		SaveCursorQueue();
 	}
 }
 
@@ -2508,7 +2567,7 @@ void Client::RemoveDuplicateLore(bool client_update)
 		if (inst == nullptr) { continue; }
 		if(CheckLoreConflict(inst->GetItem())) {
 			Log(Logs::Detail, Logs::Inventory, "Lore Duplication Error: Deleting %s from slot %i", inst->GetItem()->Name, slot_id);
-			database.SaveInventory(character_id, nullptr, slot_id);
+			SaveInventorySlot(nullptr, slot_id);
 		}
 		else {
 			m_inv.PutItem(slot_id, *inst);
@@ -2521,7 +2580,7 @@ void Client::RemoveDuplicateLore(bool client_update)
 		if (inst == nullptr) { continue; }
 		if (CheckLoreConflict(inst->GetItem())) {
 			Log(Logs::Detail, Logs::Inventory, "Lore Duplication Error: Deleting %s from slot %i", inst->GetItem()->Name, slot_id);
-			database.SaveInventory(character_id, nullptr, slot_id);
+			SaveInventorySlot(nullptr, slot_id);
 		}
 		else {
 			m_inv.PutItem(slot_id, *inst);
@@ -2534,7 +2593,7 @@ void Client::RemoveDuplicateLore(bool client_update)
 		if (inst) {
 			if (CheckLoreConflict(inst->GetItem())) {
 				Log(Logs::Detail, Logs::Inventory, "Lore Duplication Error: Deleting %s from slot %i", inst->GetItem()->Name, EQEmu::inventory::slotPowerSource);
-				database.SaveInventory(character_id, nullptr, EQEmu::inventory::slotPowerSource);
+				SaveInventorySlot(nullptr, EQEmu::inventory::slotPowerSource);
 			}
 			else {
 				m_inv.PutItem(EQEmu::inventory::slotPowerSource, *inst);
@@ -2548,7 +2607,7 @@ void Client::RemoveDuplicateLore(bool client_update)
 		if (inst == nullptr) { continue; }
 		if(CheckLoreConflict(inst->GetItem())) {
 			Log(Logs::Detail, Logs::Inventory, "Lore Duplication Error: Deleting %s from slot %i", inst->GetItem()->Name, slot_id);
-			database.SaveInventory(character_id, nullptr, slot_id);
+			SaveInventorySlot(nullptr, slot_id);
 		}
 		else {
 			m_inv.PutItem(slot_id, *inst);
@@ -2561,7 +2620,7 @@ void Client::RemoveDuplicateLore(bool client_update)
 		if (inst == nullptr) { continue; }
 		if(CheckLoreConflict(inst->GetItem())) {
 			Log(Logs::Detail, Logs::Inventory, "Lore Duplication Error: Deleting %s from slot %i", inst->GetItem()->Name, slot_id);
-			database.SaveInventory(character_id, nullptr, slot_id);
+			SaveInventorySlot(nullptr, slot_id);
 		}
 		else {
 			m_inv.PutItem(slot_id, *inst);
@@ -2574,7 +2633,7 @@ void Client::RemoveDuplicateLore(bool client_update)
 		if (inst == nullptr) { continue; }
 		if(CheckLoreConflict(inst->GetItem())) {
 			Log(Logs::Detail, Logs::Inventory, "Lore Duplication Error: Deleting %s from slot %i", inst->GetItem()->Name, slot_id);
-			database.SaveInventory(character_id, nullptr, slot_id);
+			SaveInventorySlot(nullptr, slot_id);
 		}
 		else {
 			m_inv.PutItem(slot_id, *inst);
@@ -2623,8 +2682,7 @@ void Client::RemoveDuplicateLore(bool client_update)
 		}
 		local_2.clear();
 
-		auto s = m_inv.cursor_cbegin(), e = m_inv.cursor_cend();
-		database.SaveCursor(this->CharacterID(), s, e);
+		SaveCursorQueue();
 	}
 }
 
@@ -2637,7 +2695,7 @@ void Client::MoveSlotNotAllowed(bool client_update)
 			int16 free_slot_id = m_inv.FindFreeSlot(inst->IsClassBag(), true, inst->GetItem()->Size, is_arrow);
 			Log(Logs::Detail, Logs::Inventory, "Slot Assignment Error: Moving %s from slot %i to %i", inst->GetItem()->Name, slot_id, free_slot_id);
 			PutItemInInventory(free_slot_id, *inst, client_update);
-			database.SaveInventory(character_id, nullptr, slot_id);
+			SaveInventorySlot(nullptr, slot_id);
 			safe_delete(inst);
 		}
 	}
@@ -2648,7 +2706,7 @@ void Client::MoveSlotNotAllowed(bool client_update)
 		int16 free_slot_id = m_inv.FindFreeSlot(inst->IsClassBag(), true, inst->GetItem()->Size, is_arrow);
 		Log(Logs::Detail, Logs::Inventory, "Slot Assignment Error: Moving %s from slot %i to %i", inst->GetItem()->Name, EQEmu::inventory::slotPowerSource, free_slot_id);
 		PutItemInInventory(free_slot_id, *inst, (ClientVersion() >= EQEmu::versions::ClientVersion::SoF) ? client_update : false);
-		database.SaveInventory(character_id, nullptr, EQEmu::inventory::slotPowerSource);
+		SaveInventorySlot(nullptr, EQEmu::inventory::slotPowerSource);
 		safe_delete(inst);
 	}
 
@@ -2881,15 +2939,15 @@ void Client::SetBandolier(const EQApplicationPacket *app)
 						BandolierItems[BandolierSlot]->SetCharges(Charges-1);
 						// Take one charge out and put the rest back
 						m_inv.PutItem(slot, *BandolierItems[BandolierSlot]);
-						database.SaveInventory(character_id, BandolierItems[BandolierSlot], slot);
+						SaveInventorySlot(BandolierItems[BandolierSlot], slot);
 						BandolierItems[BandolierSlot]->SetCharges(1);
 					}
 					else { // Remove the item from the inventory
-						database.SaveInventory(character_id, 0, slot);
+						SaveInventorySlot(0, slot);
 					}
 				}
 				else { // Remove the item from the inventory
-					database.SaveInventory(character_id, 0, slot);
+					SaveInventorySlot(0, slot);
 				}
 			}
 			else { // The player doesn't have the required weapon with them.
@@ -2903,7 +2961,7 @@ void Client::SetBandolier(const EQApplicationPacket *app)
 						InvItem->GetItem()->Name, WeaponSlot);
 						Log(Logs::Detail, Logs::Inventory, "returning item %s in weapon slot %i to inventory", InvItem->GetItem()->Name, WeaponSlot);
 						if (MoveItemToInventory(InvItem)) {
-							database.SaveInventory(character_id, 0, WeaponSlot);
+							SaveInventorySlot(0, WeaponSlot);
 							Log(Logs::General, Logs::Error, "returning item %s in weapon slot %i to inventory", InvItem->GetItem()->Name, WeaponSlot);
 						}
 						else {
@@ -2936,7 +2994,7 @@ void Client::SetBandolier(const EQApplicationPacket *app)
 
 				safe_delete(BandolierItems[BandolierSlot]);
 				// Update the database, save the item now in the weapon slot
-				database.SaveInventory(character_id, m_inv.GetItem(WeaponSlot), WeaponSlot);
+				SaveInventorySlot(m_inv.GetItem(WeaponSlot), WeaponSlot);
 
 				if(InvItem) {
 					// If there was already an item in that weapon slot that we replaced, find a place to put it
@@ -2955,7 +3013,7 @@ void Client::SetBandolier(const EQApplicationPacket *app)
 				Log(Logs::Detail, Logs::Inventory, "Bandolier has no item for slot %i, returning item %s to inventory", WeaponSlot, InvItem->GetItem()->Name);
 				// If there was an item in that weapon slot, put it in the inventory
 				if (MoveItemToInventory(InvItem)) {
-					database.SaveInventory(character_id, 0, WeaponSlot);
+					SaveInventorySlot(0, WeaponSlot);
 				}
 				else {
 					Log(Logs::General, Logs::Error, "Char: %s, ERROR returning %s to inventory", GetName(), InvItem->GetItem()->Name);
@@ -3014,7 +3072,7 @@ bool Client::MoveItemToInventory(EQEmu::ItemInstance *ItemToReturn, bool UpdateC
 				if(UpdateClient)
 					SendItemPacket(i, InvItem, ItemPacketTrade);
 
-				database.SaveInventory(character_id, m_inv.GetItem(i), i);
+				SaveInventorySlot(m_inv.GetItem(i), i);
 
 				ItemToReturn->SetCharges(ItemToReturn->GetCharges() - ChargesToMove);
 
@@ -3044,7 +3102,7 @@ bool Client::MoveItemToInventory(EQEmu::ItemInstance *ItemToReturn, bool UpdateC
 						if(UpdateClient)
 							SendItemPacket(BaseSlotID + BagSlot, m_inv.GetItem(BaseSlotID + BagSlot), ItemPacketTrade);
 
-						database.SaveInventory(character_id, m_inv.GetItem(BaseSlotID + BagSlot), BaseSlotID + BagSlot);
+						SaveInventorySlot(m_inv.GetItem(BaseSlotID + BagSlot), BaseSlotID + BagSlot);
 
 						ItemToReturn->SetCharges(ItemToReturn->GetCharges() - ChargesToMove);
 
@@ -3069,7 +3127,7 @@ bool Client::MoveItemToInventory(EQEmu::ItemInstance *ItemToReturn, bool UpdateC
 			if(UpdateClient)
 				SendItemPacket(i, ItemToReturn, ItemPacketTrade);
 
-			database.SaveInventory(character_id, m_inv.GetItem(i), i);
+			SaveInventorySlot(m_inv.GetItem(i), i);
 
 			Log(Logs::Detail, Logs::Inventory, "Char: %s Storing in main inventory slot %i", GetName(), i);
 
@@ -3092,7 +3150,7 @@ bool Client::MoveItemToInventory(EQEmu::ItemInstance *ItemToReturn, bool UpdateC
 					if(UpdateClient)
 						SendItemPacket(BaseSlotID + BagSlot, ItemToReturn, ItemPacketTrade);
 
-					database.SaveInventory(character_id, m_inv.GetItem(BaseSlotID + BagSlot), BaseSlotID + BagSlot);
+					SaveInventorySlot(m_inv.GetItem(BaseSlotID + BagSlot), BaseSlotID + BagSlot);
 
 					Log(Logs::Detail, Logs::Inventory, "Char: %s Storing in bag slot %i", GetName(), BaseSlotID + BagSlot);
 
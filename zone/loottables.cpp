@@ -17,6 +17,7 @@
 */
 
 #include "../common/global_define.h"
+#include "../common/loot_alias_table.h"
 #include "../common/loottable.h"
 #include "../common/misc_functions.h"
 #include "../common/data_verification.h"
@@ -104,6 +105,23 @@ void ZoneDatabase::AddLootTableToNPC(NPC* npc,uint32 loottable_id, ItemList* ite
 	}
 }
 
+// Walks the entries with roll, skipping missing items, returns NumEntries when the roll falls past them all
+static uint32 PickLootDropEntry(const LootDrop_Struct* lds, float roll) {
+	for(uint32 j = 0; j < lds->NumEntries; ++j) {
+		if(!database.GetItem(lds->Entries[j].item_id)) {
+			continue;
+		}
+
+		if(roll < lds->Entries[j].chance) {
+			return j;
+		}
+
+		roll -= lds->Entries[j].chance;
+	}
+
+	return lds->NumEntries;
+}
+
 // Called by AddLootTableToNPC
 // maxdrops = size of the array npcd
 void ZoneDatabase::AddLootDropToNPC(NPC* npc,uint32 lootdrop_id, ItemList* itemlist, uint8 droplimit, uint8 mindrop) {
@@ -137,80 +155,44 @@ void ZoneDatabase::AddLootDropToNPC(NPC* npc,uint32 lootdrop_id, ItemList* iteml
 		droplimit = mindrop;
 	}
 
-	float roll_t = 0.0f;
-	float roll_t_min = 0.0f;
-	bool active_item_list = false;
-	for(uint32 i = 0; i < lds->NumEntries; ++i) {
-		const EQEmu::ItemData* db_item = GetItem(lds->Entries[i].item_id);
-		if(db_item) {
-			roll_t += lds->Entries[i].chance;
-			active_item_list = true;
-		}
-	}
-
-	roll_t_min = roll_t;
-	roll_t = EQEmu::ClampLower(roll_t, 100.0f);
-
-	if(!active_item_list) {
+	const LootDropItemSummary& summary = GetLootDropItemSummary(lootdrop_id, lds);
+	if(!summary.any_item_found) {
 		return;
 	}
 
-	for(int i = 0; i < mindrop; ++i) {
-		float roll = (float)zone->random.Real(0.0, roll_t_min);
-		for(uint32 j = 0; j < lds->NumEntries; ++j) {
-			const EQEmu::ItemData* db_item = GetItem(lds->Entries[j].item_id);
-			if(db_item) {
-				if(roll < lds->Entries[j].chance) {
-					npc->AddLootDrop(db_item, itemlist, lds->Entries[j].item_charges, lds->Entries[j].minlevel,
-									 lds->Entries[j].maxlevel, lds->Entries[j].equip_item > 0 ? true : false, false);
-
-					int charges = (int)lds->Entries[i].multiplier;
-					charges = EQEmu::ClampLower(charges, 1);
-
-					for(int k = 1; k < charges; ++k) {
-						float c_roll = (float)zone->random.Real(0.0, 100.0);
-						if(c_roll <= lds->Entries[i].chance) {
-							npc->AddLootDrop(db_item, itemlist, lds->Entries[j].item_charges, lds->Entries[j].minlevel,
-											 lds->Entries[j].maxlevel, lds->Entries[j].equip_item > 0 ? true : false, false);
-						}
-					}
+	float roll_t_min = summary.chance_total;
+	float roll_t = EQEmu::ClampLower(roll_t_min, 100.0f);
+	bool all_items_found = summary.all_items_found;
+
+	// the alias tables were built with every entry in, a drop pointing at missing items has to walk its entries instead
+	uint32 bins = lds->NumEntries + 1;
+	for(int i = 0; i < droplimit; ++i) {
+		bool min_draw = i < mindrop;
+		uint32 j;
+		if(all_items_found) {
+			j = EQEmu::DrawLootDropAlias(min_draw ? EQEmu::GetLootDropMinAlias(lds) : EQEmu::GetLootDropAlias(lds), bins,
+				zone->random.Real(0.0, bins));
+		}
+		else {
+			j = PickLootDropEntry(lds, (float)zone->random.Real(0.0, min_draw ? roll_t_min : roll_t));
+		}
 
-					j = lds->NumEntries;
-					break;
-				}
-				else {
-					roll -= lds->Entries[j].chance;
-				}
-			}
+		if(j >= lds->NumEntries) {
+			continue;
 		}
-	}
 
-	for(int i = mindrop; i < droplimit; ++i) {
-		float roll = (float)zone->random.Real(0.0, roll_t);
-		for(uint32 j = 0; j < lds->NumEntries; ++j) {
-			const EQEmu::ItemData* db_item = GetItem(lds->Entries[j].item_id);
-			if(db_item) {
-				if(roll < lds->Entries[j].chance) {
-					npc->AddLootDrop(db_item, itemlist, lds->Entries[j].item_charges, lds->Entries[j].minlevel,
-										lds->Entries[j].maxlevel, lds->Entries[j].equip_item > 0 ? true : false, false);
-
-					int charges = (int)lds->Entries[i].multiplier;
-					charges = EQEmu::ClampLower(charges, 1);
-
-					for(int k = 1; k < charges; ++k) {
-						float c_roll = (float)zone->random.Real(0.0, 100.0);
-						if(c_roll <= lds->Entries[i].chance) {
-							npc->AddLootDrop(db_item, itemlist, lds->Entries[j].item_charges, lds->Entries[j].minlevel,
-											lds->Entries[j].maxlevel, lds->Entries[j].equip_item > 0 ? true : false, false);
-						}
-					}
+		const EQEmu::ItemData* db_item = GetItem(lds->Entries[j].item_id);
+		npc->AddLootDrop(db_item, itemlist, lds->Entries[j].item_charges, lds->Entries[j].minlevel,
+						 lds->Entries[j].maxlevel, lds->Entries[j].equip_item > 0 ? true : false, false);
 
-					j = lds->NumEntries;
-					break;
-				}
-				else {
-					roll -= lds->Entries[j].chance;
-				}
+		int charges = (int)lds->Entries[j].multiplier;
+		charges = EQEmu::ClampLower(charges, 1);
+
+		for(int k = 1; k < charges; ++k) {
+			float c_roll = (float)zone->random.Real(0.0, 100.0);
+			if(c_roll <= lds->Entries[j].chance) {
+				npc->AddLootDrop(db_item, itemlist, lds->Entries[j].item_charges, lds->Entries[j].minlevel,
+								 lds->Entries[j].maxlevel, lds->Entries[j].equip_item > 0 ? true : false, false);
 			}
 		}
 	} // We either ran out of items or reached our limit.
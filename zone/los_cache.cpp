@@ -0,0 +1,115 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "../common/global_define.h"
+#include "../common/rulesys.h"
+#include "../common/timer.h"
+
+#include "los_cache.h"
+#include "map.h"
+
+#include <algorithm>
+#include <cmath>
+
+LoSCache::LoSCache() : hits(0), misses(0), invalidations(0)
+{
+}
+
+// 21 bits per axis, plenty for any zone at the minimum grid size
+uint64 LoSCache::Quantize(const glm::vec3 &v, float step)
+{
+	const int64 bias = 1 << 20;
+	const int64 mask = (1 << 21) - 1;
+
+	int64 x = static_cast<int64>(std::floor(v.x / step)) + bias;
+	int64 y = static_cast<int64>(std::floor(v.y / step)) + bias;
+	int64 z = static_cast<int64>(std::floor(v.z / step)) + bias;
+
+	return (static_cast<uint64>(x & mask) << 42) | (static_cast<uint64>(y & mask) << 21) | static_cast<uint64>(z & mask);
+}
+
+bool LoSCache::CheckLoS(const Map *map, const glm::vec3 &start, const glm::vec3 &end)
+{
+	if (!map)
+		return false;
+
+	uint32 ttl = RuleI(Map, LoSCacheTTL);
+	if (ttl == 0)
+		return map->CheckLoS(start, end);
+
+	float step = std::max(RuleR(Map, LoSCacheGridSize), 0.25f);
+	uint32 now = Timer::GetCurrentTime();
+
+	Key key;
+	key.start = Quantize(start, step);
+	key.end = Quantize(end, step);
+
+	auto it = cache.find(key);
+	if (it != cache.end() && it->second.expires > now) {
+		++hits;
+		return it->second.result;
+	}
+
+	++misses;
+	bool result = map->CheckLoS(start, end);
+
+	if (it != cache.end()) {
+		it->second.result = result;
+		it->second.expires = now + ttl;
+		return result;
+	}
+
+	if (cache.size() >= static_cast<size_t>(RuleI(Map, LoSCacheMaxEntries)))
+		PurgeExpired();
+
+	if (cache.size() < static_cast<size_t>(RuleI(Map, LoSCacheMaxEntries))) {
+		Entry e;
+		e.result = result;
+		e.expires = now + ttl;
+		cache.insert(std::make_pair(key, e));
+	}
+
+	return result;
+}
+
+void LoSCache::Invalidate()
+{
+	if (cache.empty())
+		return;
+
+	cache.clear();
+	++invalidations;
+}
+
+void LoSCache::PurgeExpired()
+{
+	uint32 now = Timer::GetCurrentTime();
+	for (auto it = cache.begin(); it != cache.end();) {
+		if (it->second.expires <= now)
+			it = cache.erase(it);
+		else
+			++it;
+	}
+}
+
+void LoSCache::ResetStats()
+{
+	hits = 0;
+	misses = 0;
+	invalidations = 0;
+}
@@ -0,0 +1,78 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef LOS_CACHE_H
+#define LOS_CACHE_H
+
+#include "../common/types.h"
+#include "position.h"
+
+#include <unordered_map>
+
+class Map;
+
+/*
+ * Short lived line of sight result cache.
+ *
+ * The same attacker/target pairs get raycast over and over during a fight
+ * (aggro checks, spell casting, melee, pets, hate list spell casting). Results
+ * are keyed on both endpoints snapped to a small grid and live for a short TTL,
+ * so a repeated test costs a hash lookup instead of a trip through the map
+ * mesh. Anything that changes zone geometry (doors) must call Invalidate().
+ */
+class LoSCache
+{
+public:
+	LoSCache();
+
+	bool	CheckLoS(const Map *map, const glm::vec3 &start, const glm::vec3 &end);
+	void	Invalidate();
+	void	PurgeExpired();
+	void	ResetStats();
+
+	inline size_t GetSize() const { return cache.size(); }
+	inline uint64 GetHits() const { return hits; }
+	inline uint64 GetMisses() const { return misses; }
+	inline uint64 GetInvalidations() const { return invalidations; }
+	inline float GetHitRatio() const { return (hits + misses) ? static_cast<float>(hits) / static_cast<float>(hits + misses) : 0.0f; }
+
+private:
+	struct Key {
+		uint64 start;
+		uint64 end;
+
+		bool operator==(const Key &o) const { return start == o.start && end == o.end; }
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key &k) const { return std::hash<uint64>()(k.start ^ (k.end * 0x9E3779B97F4A7C15ULL)); }
+	};
+
+	struct Entry {
+		bool result;
+		uint32 expires;
+	};
+
+	static uint64 Quantize(const glm::vec3 &v, float step);
+
+	std::unordered_map<Key, Entry, KeyHash> cache;
+	uint64 hits;
+	uint64 misses;
+	uint64 invalidations;
+};
+
+#endif /* LOS_CACHE_H */
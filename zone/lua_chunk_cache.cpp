@@ -0,0 +1,158 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "lua_chunk_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <functional>
+#include <sys/stat.h>
+
+#ifdef _WINDOWS
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef LUA_EQEMU
+#include "lua.hpp"
+#endif
+
+#define LUA_CHUNK_CACHE_MAGIC "EQLUAC1"
+
+struct LuaChunkCacheHeader {
+	char magic[8];
+	int64 mtime;
+	int64 size;
+	uint32 path_length;
+	uint32 code_length;
+};
+
+std::string LuaChunkCache::GetCacheFile(const std::string &cache_dir, const std::string &filename) {
+	char cache_name[32];
+	snprintf(cache_name, sizeof(cache_name), "/%016llx.luac", static_cast<unsigned long long>(std::hash<std::string>()(filename)));
+	return cache_dir + cache_name;
+}
+
+bool LuaChunkCache::Read(const std::string &cache_file, const std::string &filename, int64 mtime, int64 size, std::string &code) {
+	std::ifstream in(cache_file.c_str(), std::ios::in | std::ios::binary);
+	if(!in) {
+		return false;
+	}
+
+	LuaChunkCacheHeader header;
+	if(!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		memcmp(header.magic, LUA_CHUNK_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+		header.mtime != mtime ||
+		header.size != size ||
+		header.path_length != filename.length() ||
+		header.code_length == 0)
+	{
+		return false;
+	}
+
+	std::string path(header.path_length, '\0');
+	if(!in.read(&path[0], path.length()) || path != filename) {
+		return false;
+	}
+
+	std::string data(header.code_length, '\0');
+	if(!in.read(&data[0], data.length())) {
+		return false;
+	}
+
+	code.swap(data);
+	return true;
+}
+
+bool LuaChunkCache::Write(const std::string &cache_file, const std::string &filename, int64 mtime, int64 size, const std::string &code) {
+	std::string temp_file = cache_file + "." + std::to_string(getpid());
+	std::ofstream out(temp_file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!out) {
+		return false;
+	}
+
+	LuaChunkCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, LUA_CHUNK_CACHE_MAGIC, sizeof(header.magic));
+	header.mtime = mtime;
+	header.size = size;
+	header.path_length = static_cast<uint32>(filename.length());
+	header.code_length = static_cast<uint32>(code.length());
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(filename.data(), filename.length());
+	out.write(code.data(), code.length());
+	out.close();
+
+	if(!out) {
+		remove(temp_file.c_str());
+		return false;
+	}
+
+	// rename won't replace an existing file everywhere
+	remove(cache_file.c_str());
+	if(rename(temp_file.c_str(), cache_file.c_str()) != 0) {
+		remove(temp_file.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+#ifdef LUA_EQEMU
+
+static int WriteLuaChunk(lua_State *L, const void *p, size_t sz, void *ud) {
+	static_cast<std::string*>(ud)->append(static_cast<const char*>(p), sz);
+	return 0;
+}
+
+int LuaChunkCache::Load(lua_State *L, const std::string &filename, const std::string &cache_dir, bool &hit) {
+	hit = false;
+
+	struct stat st;
+	if(stat(filename.c_str(), &st) != 0) {
+		return luaL_loadfile(L, filename.c_str());
+	}
+
+	std::string cache_file = GetCacheFile(cache_dir, filename);
+	std::string chunk_name = "@" + filename;
+	std::string code;
+	if(Read(cache_file, filename, static_cast<int64>(st.st_mtime), static_cast<int64>(st.st_size), code)) {
+		if(luaL_loadbuffer(L, code.data(), code.length(), chunk_name.c_str()) == 0) {
+			hit = true;
+			return 0;
+		}
+		lua_pop(L, 1);
+		code.clear();
+	}
+
+	int status = luaL_loadfile(L, filename.c_str());
+	if(status != 0) {
+		return status;
+	}
+
+	if(lua_dump(L, WriteLuaChunk, &code) == 0 && !code.empty()) {
+		Write(cache_file, filename, static_cast<int64>(st.st_mtime), static_cast<int64>(st.st_size), code);
+	}
+
+	return status;
+}
+
+#endif
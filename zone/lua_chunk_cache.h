@@ -0,0 +1,48 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef LUA_CHUNK_CACHE_H
+#define LUA_CHUNK_CACHE_H
+
+#include "../common/types.h"
+
+#include <string>
+
+struct lua_State;
+
+/*
+	Compiled lua chunks cached on disk. Cache files are named by a hash of the
+	script path and record the path, mtime and size of the source they were
+	built from; any mismatch, a short file or a chunk that fails to load just
+	recompiles and rewrites it. Several zones can share one cache directory,
+	so files are written to a temp name and renamed into place.
+*/
+namespace LuaChunkCache
+{
+	std::string GetCacheFile(const std::string &cache_dir, const std::string &filename);
+
+	// code is only filled in when the cache file was built from this exact source
+	bool Read(const std::string &cache_file, const std::string &filename, int64 mtime, int64 size, std::string &code);
+	bool Write(const std::string &cache_file, const std::string &filename, int64 mtime, int64 size, const std::string &code);
+
+#ifdef LUA_EQEMU
+	// luaL_loadfile through the cache in cache_dir (which must exist), hit tells whether the cached chunk was used
+	int Load(lua_State *L, const std::string &filename, const std::string &cache_dir, bool &hit);
+#endif
+}
+
+#endif
@@ -10,13 +10,18 @@
 #include <vector>
 #include <algorithm>
 
+#include "../common/eqemu_logsys.h"
+#include "../common/rulesys.h"
 #include "../common/spdat.h"
+#include "../common/timer.h"
 #include "masterentity.h"
+#include "quest_profiler.h"
 #include "questmgr.h"
 #include "zone.h"
 #include "zone_config.h"
 
 #include "lua_parser.h"
+#include "lua_chunk_cache.h"
 #include "lua_bit.h"
 #include "lua_entity.h"
 #include "lua_item.h"
@@ -139,7 +144,16 @@ std::map<std::string, bool> lua_encounters_loaded;
 std::map<std::string, Encounter *> lua_encounters;
 
 LuaParser::LuaParser() {
+	chunk_cache_hits_ = 0;
+	chunk_cache_misses_ = 0;
 	for(int i = 0; i < _LargestEventID; ++i) {
+		NPCEventTableSize[i] = 0;
+		PlayerEventTableSize[i] = 0;
+		ItemEventTableSize[i] = 0;
+		SpellEventTableSize[i] = 0;
+		EncounterEventTableSize[i] = 0;
+		NPCEventTableDepth[i] = 0;
+		PlayerEventTableDepth[i] = 0;
 		NPCArgumentDispatch[i] = handle_npc_null;
 		PlayerArgumentDispatch[i] = handle_player_null;
 		ItemArgumentDispatch[i] = handle_item_null;
@@ -241,7 +255,7 @@ LuaParser::~LuaParser() {
 	}
 }
 
-int LuaParser::EventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int LuaParser::EventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
@@ -260,7 +274,7 @@ int LuaParser::EventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data,
 	return _EventNPC(package_name, evt, npc, init, data, extra_data, extra_pointers);
 }
 
-int LuaParser::EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int LuaParser::EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 							  std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
@@ -278,11 +292,143 @@ int LuaParser::EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, std::string
 	return _EventNPC("global_npc", evt, npc, init, data, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventNPC(std::string package_name, QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+//instruction budget of the outermost quest event, events it fires draw from the same budget
+static const int LuaBudgetStep = 1000;
+static int lua_call_depth = 0;
+static int64 lua_budget_left = 0;
+static bool lua_budget_hit = false;
+
+static void LuaBudgetHook(lua_State *L, lua_Debug *ar) {
+	lua_budget_left -= std::min(RuleI(Zone, LuaInstructionBudget), LuaBudgetStep);
+	if(lua_budget_left <= 0) {
+		lua_budget_hit = true;
+		luaL_error(L, "quest event exceeded its instruction budget of %d", RuleI(Zone, LuaInstructionBudget));
+	}
+}
+
+/*
+	Every quest event handler is called through here, it is timed for
+	#questprofile and, when Zone:LuaInstructionBudget is set, runs under a count
+	hook that raises an error once the budget is spent. LuaJIT only runs hooks
+	in the interpreter, a loop that has been compiled to a trace is not counted.
+*/
+int LuaParser::CallEvent(const std::string &package_name, QuestEventID evt, int nargs, int nresults) {
+	BenchTimer timer;
+
+	int budget = RuleI(Zone, LuaInstructionBudget);
+	bool armed = lua_call_depth == 0 && budget > 0;
+	if(armed) {
+		lua_budget_left = budget;
+		lua_budget_hit = false;
+		lua_sethook(L, LuaBudgetHook, LUA_MASKCOUNT, std::min(budget, LuaBudgetStep));
+	}
+
+	++lua_call_depth;
+	int err = lua_pcall(L, nargs, nresults, 0);
+	--lua_call_depth;
+
+	bool aborted = false;
+	if(armed) {
+		lua_sethook(L, nullptr, 0, 0);
+		aborted = lua_budget_hit;
+	}
+
+	quest_profiler.Record(package_name, LuaEvents[evt], static_cast<uint64>(timer.elapsed() * 1000000.0), aborted);
+	return err;
+}
+
+/*
+ * Event tables used to start empty and rehash as the argument handler filled
+ * them in. The first time an event fires its field count is remembered and
+ * later tables for it are created at that size.
+ */
+void LuaParser::LearnEventTableSize(uint8 &size) {
+	if(size != 0) {
+		return;
+	}
+
+	int table = lua_gettop(L);
+	int fields = 0;
+	lua_pushnil(L);
+	while(lua_next(L, table) != 0) {
+		++fields;
+		lua_pop(L, 1);
+	}
+
+	size = static_cast<uint8>(std::min(fields, 255));
+}
+
+/*
+ * With Zone:LuaReuseEventTables NPC and player events keep their tables in
+ * the registry, one per event and nesting depth, and empty them for the next
+ * event instead of creating a new one each time. A script that holds on to
+ * an event table after its handler returns finds it emptied, which is why
+ * this is a rule. Returns the key to hand to ReleaseEventTable, 0 when the
+ * table is a fresh one.
+ */
+int LuaParser::PushEventTable(uint8 &depth, int slot, int size) {
+	if(!RuleB(Zone, LuaReuseEventTables) || depth >= MaxEventTableDepth) {
+		lua_createtable(L, 0, size);
+		return 0;
+	}
+
+	int key = slot * MaxEventTableDepth + depth + 1;
+	++depth;
+
+	lua_getfield(L, LUA_REGISTRYINDEX, "__event_tables");
+	if(!lua_istable(L, -1)) {
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, LUA_REGISTRYINDEX, "__event_tables");
+	}
+
+	lua_rawgeti(L, -1, key);
+	if(!lua_istable(L, -1)) {
+		lua_pop(L, 1);
+		lua_createtable(L, 0, size);
+		lua_pushvalue(L, -1);
+		lua_rawseti(L, -3, key);
+	}
+
+	lua_remove(L, -2);
+	return key;
+}
+
+void LuaParser::ReleaseEventTable(uint8 &depth, int key) {
+	if(key == 0) {
+		return;
+	}
+
+	if(depth > 0) {
+		--depth;
+	}
+
+	lua_getfield(L, LUA_REGISTRYINDEX, "__event_tables");
+	if(lua_istable(L, -1)) {
+		lua_rawgeti(L, -1, key);
+		if(lua_istable(L, -1)) {
+			// clearing fields that already exist is allowed while walking the table
+			int table = lua_gettop(L);
+			lua_pushnil(L);
+			while(lua_next(L, table) != 0) {
+				lua_pop(L, 1);
+				lua_pushvalue(L, -1);
+				lua_pushnil(L);
+				lua_rawset(L, table);
+			}
+		}
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+}
+
+int LuaParser::_EventNPC(const std::string &package_name, QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						 std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func) {
 	const char *sub_name = LuaEvents[evt];
 
 	int start = lua_gettop(L);
+	int event_table = 0;
 
 	try {
 		int npop = 1;
@@ -294,7 +440,7 @@ int LuaParser::_EventNPC(std::string package_name, QuestEventID evt, NPC* npc, M
 			npop = 2;
 		}
 
-		lua_createtable(L, 0, 0);
+		event_table = PushEventTable(NPCEventTableDepth[evt], evt, NPCEventTableSize[evt]);
 		//always push self
 		Lua_NPC l_npc(npc);
 		luabind::adl::object l_npc_o = luabind::adl::object(L, l_npc);
@@ -303,13 +449,15 @@ int LuaParser::_EventNPC(std::string package_name, QuestEventID evt, NPC* npc, M
 
 		auto arg_function = NPCArgumentDispatch[evt];
 		arg_function(this, L, npc, init, data, extra_data, extra_pointers);
+		LearnEventTableSize(NPCEventTableSize[evt]);
 		Client *c = (init && init->IsClient()) ? init->CastToClient() : nullptr;
 
 		quest_manager.StartQuest(npc, c, nullptr);
-		if(lua_pcall(L, 1, 1, 0)) {
+		if(CallEvent(package_name, evt, 1, 1)) {
 			std::string error = lua_tostring(L, -1);
 			AddError(error);
 			quest_manager.EndQuest();
+			ReleaseEventTable(NPCEventTableDepth[evt], event_table);
 			return 0;
 		}
 		quest_manager.EndQuest();
@@ -317,6 +465,7 @@ int LuaParser::_EventNPC(std::string package_name, QuestEventID evt, NPC* npc, M
 		if(lua_isnumber(L, -1)) {
 			int ret = static_cast<int>(lua_tointeger(L, -1));
 			lua_pop(L, npop);
+			ReleaseEventTable(NPCEventTableDepth[evt], event_table);
 			return ret;
 		}
 
@@ -334,10 +483,11 @@ int LuaParser::_EventNPC(std::string package_name, QuestEventID evt, NPC* npc, M
 		}
 	}
 
+	ReleaseEventTable(NPCEventTableDepth[evt], event_table);
 	return 0;
 }
 
-int LuaParser::EventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int LuaParser::EventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
@@ -355,7 +505,7 @@ int LuaParser::EventPlayer(QuestEventID evt, Client *client, std::string data, u
 	return _EventPlayer("player", evt, client, data, extra_data, extra_pointers);
 }
 
-int LuaParser::EventGlobalPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int LuaParser::EventGlobalPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
@@ -373,10 +523,11 @@ int LuaParser::EventGlobalPlayer(QuestEventID evt, Client *client, std::string d
 	return _EventPlayer("global_player", evt, client, data, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventPlayer(std::string package_name, QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int LuaParser::_EventPlayer(const std::string &package_name, QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 							std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func) {
 	const char *sub_name = LuaEvents[evt];
 	int start = lua_gettop(L);
+	int event_table = 0;
 
 	try {
 		int npop = 1;
@@ -388,7 +539,7 @@ int LuaParser::_EventPlayer(std::string package_name, QuestEventID evt, Client *
 			npop = 2;
 		}
 
-		lua_createtable(L, 0, 0);
+		event_table = PushEventTable(PlayerEventTableDepth[evt], _LargestEventID + evt, PlayerEventTableSize[evt]);
 		//push self
 		Lua_Client l_client(client);
 		luabind::adl::object l_client_o = luabind::adl::object(L, l_client);
@@ -397,12 +548,14 @@ int LuaParser::_EventPlayer(std::string package_name, QuestEventID evt, Client *
 
 		auto arg_function = PlayerArgumentDispatch[evt];
 		arg_function(this, L, client, data, extra_data, extra_pointers);
+		LearnEventTableSize(PlayerEventTableSize[evt]);
 
 		quest_manager.StartQuest(client, client, nullptr);
-		if(lua_pcall(L, 1, 1, 0)) {
+		if(CallEvent(package_name, evt, 1, 1)) {
 			std::string error = lua_tostring(L, -1);
 			AddError(error);
 			quest_manager.EndQuest();
+			ReleaseEventTable(PlayerEventTableDepth[evt], event_table);
 			return 0;
 		}
 		quest_manager.EndQuest();
@@ -410,6 +563,7 @@ int LuaParser::_EventPlayer(std::string package_name, QuestEventID evt, Client *
 		if(lua_isnumber(L, -1)) {
 			int ret = static_cast<int>(lua_tointeger(L, -1));
 			lua_pop(L, npop);
+			ReleaseEventTable(PlayerEventTableDepth[evt], event_table);
 			return ret;
 		}
 
@@ -427,10 +581,11 @@ int LuaParser::_EventPlayer(std::string package_name, QuestEventID evt, Client *
 		}
 	}
 
+	ReleaseEventTable(PlayerEventTableDepth[evt], event_table);
 	return 0;
 }
 
-int LuaParser::EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+int LuaParser::EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
@@ -450,8 +605,8 @@ int LuaParser::EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *
 	return _EventItem(package_name, evt, client, item, mob, data, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventItem(std::string package_name, QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob,
-						  std::string data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func) {
+int LuaParser::_EventItem(const std::string &package_name, QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob,
+						  const std::string &data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func) {
 	const char *sub_name = LuaEvents[evt];
 
 	int start = lua_gettop(L);
@@ -465,7 +620,7 @@ int LuaParser::_EventItem(std::string package_name, QuestEventID evt, Client *cl
 			lua_getfield(L, -1, sub_name);
 		}
 
-		lua_createtable(L, 0, 0);
+		lua_createtable(L, 0, ItemEventTableSize[evt]);
 		//always push self
 		Lua_ItemInst l_item(item);
 		luabind::adl::object l_item_o = luabind::adl::object(L, l_item);
@@ -480,9 +635,10 @@ int LuaParser::_EventItem(std::string package_name, QuestEventID evt, Client *cl
 		//redo this arg function
 		auto arg_function = ItemArgumentDispatch[evt];
 		arg_function(this, L, client, item, mob, data, extra_data, extra_pointers);
+		LearnEventTableSize(ItemEventTableSize[evt]);
 
 		quest_manager.StartQuest(client, client, item);
-		if(lua_pcall(L, 1, 1, 0)) {
+		if(CallEvent(package_name, evt, 1, 1)) {
 			std::string error = lua_tostring(L, -1);
 			AddError(error);
 			quest_manager.EndQuest();
@@ -529,7 +685,7 @@ int LuaParser::EventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spe
 	return _EventSpell(package_name, evt, npc, client, spell_id, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventSpell(std::string package_name, QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
+int LuaParser::_EventSpell(const std::string &package_name, QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 						   std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func) {
 	const char *sub_name = LuaEvents[evt];
 
@@ -545,7 +701,7 @@ int LuaParser::_EventSpell(std::string package_name, QuestEventID evt, NPC* npc,
 			npop = 2;
 		}
 
-		lua_createtable(L, 0, 0);
+		lua_createtable(L, 0, SpellEventTableSize[evt]);
 
 		//always push self even if invalid
 		if(IsValidSpell(spell_id)) {
@@ -561,9 +717,10 @@ int LuaParser::_EventSpell(std::string package_name, QuestEventID evt, NPC* npc,
 
 		auto arg_function = SpellArgumentDispatch[evt];
 		arg_function(this, L, npc, client, spell_id, extra_data, extra_pointers);
+		LearnEventTableSize(SpellEventTableSize[evt]);
 
 		quest_manager.StartQuest(npc, client, nullptr);
-		if(lua_pcall(L, 1, 1, 0)) {
+		if(CallEvent(package_name, evt, 1, 1)) {
 			std::string error = lua_tostring(L, -1);
 			AddError(error);
 			quest_manager.EndQuest();
@@ -594,7 +751,7 @@ int LuaParser::_EventSpell(std::string package_name, QuestEventID evt, NPC* npc,
 	return 0;
 }
 
-int LuaParser::EventEncounter(QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers) {
+int LuaParser::EventEncounter(QuestEventID evt, std::string encounter_name, const std::string &data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
 		return 0;
@@ -609,7 +766,7 @@ int LuaParser::EventEncounter(QuestEventID evt, std::string encounter_name, std:
 	return _EventEncounter(package_name, evt, encounter_name, data, extra_data, extra_pointers);
 }
 
-int LuaParser::_EventEncounter(std::string package_name, QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
+int LuaParser::_EventEncounter(const std::string &package_name, QuestEventID evt, std::string encounter_name, const std::string &data, uint32 extra_data,
 							   std::vector<EQEmu::Any> *extra_pointers) {
 	const char *sub_name = LuaEvents[evt];
 
@@ -619,7 +776,7 @@ int LuaParser::_EventEncounter(std::string package_name, QuestEventID evt, std::
 		lua_getfield(L, LUA_REGISTRYINDEX, package_name.c_str());
 		lua_getfield(L, -1, sub_name);
 
-		lua_createtable(L, 0, 0);
+		lua_createtable(L, 0, EncounterEventTableSize[evt]);
 		lua_pushstring(L, encounter_name.c_str());
 		lua_setfield(L, -2, "name");
 
@@ -627,9 +784,10 @@ int LuaParser::_EventEncounter(std::string package_name, QuestEventID evt, std::
 
 		auto arg_function = EncounterArgumentDispatch[evt];
 		arg_function(this, L, enc, data, extra_data, extra_pointers);
+		LearnEventTableSize(EncounterEventTableSize[evt]);
 
 		quest_manager.StartQuest(enc, nullptr, nullptr, encounter_name);
-		if(lua_pcall(L, 1, 1, 0)) {
+		if(CallEvent(package_name, evt, 1, 1)) {
 			std::string error = lua_tostring(L, -1);
 			AddError(error);
 			quest_manager.EndQuest();
@@ -672,6 +830,33 @@ bool LuaParser::HasQuestSub(uint32 npc_id, QuestEventID evt) {
 	return HasFunction(subname, package_name);
 }
 
+bool LuaParser::HasNPCDispatchSub(uint32 npc_id, QuestEventID evt) {
+	if(lua_encounter_events_registered.empty()) {
+		return false;
+	}
+
+	evt = ConvertLuaEvent(evt);
+	if(evt >= _LargestEventID) {
+		return false;
+	}
+
+	auto has_event = [&](const std::string &package_name) -> bool {
+		auto iter = lua_encounter_events_registered.find(package_name);
+		if(iter == lua_encounter_events_registered.end()) {
+			return false;
+		}
+
+		for(auto &e : iter->second) {
+			if(e.event_id == evt) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	return has_event("npc_" + std::to_string(npc_id)) || has_event("npc_-1");
+}
+
 bool LuaParser::HasGlobalQuestSub(QuestEventID evt) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
@@ -781,6 +966,32 @@ void LuaParser::LoadEncounterScript(std::string filename, std::string encounter_
 	LoadScript(filename, package_name);
 }
 
+void LuaParser::UnloadNPCScript(std::string filename, int npc_id) {
+	UnloadScript("npc_" + std::to_string(npc_id));
+}
+
+void LuaParser::UnloadGlobalNPCScript(std::string filename) {
+	UnloadScript("global_npc");
+}
+
+void LuaParser::UnloadPlayerScript(std::string filename) {
+	UnloadScript("player");
+}
+
+void LuaParser::UnloadGlobalPlayerScript(std::string filename) {
+	UnloadScript("global_player");
+}
+
+//the package env lives in the registry, clearing it lets the old chunk be collected
+void LuaParser::UnloadScript(const std::string &package_name) {
+	loaded_.erase(package_name);
+
+	if(L) {
+		lua_pushnil(L);
+		lua_setfield(L, LUA_REGISTRYINDEX, package_name.c_str());
+	}
+}
+
 void LuaParser::AddVar(std::string name, std::string val) {
 	vars_[name] = val;
 }
@@ -799,6 +1010,12 @@ void LuaParser::Init() {
 }
 
 void LuaParser::ReloadQuests() {
+	if(chunk_cache_hits_ || chunk_cache_misses_) {
+		Log(Logs::General, Logs::Quests, "Lua chunk cache: %u hits, %u misses since the last reload", chunk_cache_hits_, chunk_cache_misses_);
+		chunk_cache_hits_ = 0;
+		chunk_cache_misses_ = 0;
+	}
+
 	loaded_.clear();
 	errors_.clear();
 	mods_.clear();
@@ -818,6 +1035,12 @@ void LuaParser::ReloadQuests() {
 		lua_close(L);
 	}
 
+	// the reused event tables went with the old state
+	for(int i = 0; i < _LargestEventID; ++i) {
+		NPCEventTableDepth[i] = 0;
+		PlayerEventTableDepth[i] = 0;
+	}
+
 	L = luaL_newstate();
 	luaL_openlibs(L);
 
@@ -983,6 +1206,26 @@ void LuaParser::ReloadQuests() {
 	}
 }
 
+// luaL_loadfile, through the on disk chunk cache when Zone:LuaBytecodeCache is set
+int LuaParser::LoadChunk(const std::string &filename) {
+	if(!RuleB(Zone, LuaBytecodeCache)) {
+		return luaL_loadfile(L, filename.c_str());
+	}
+
+	std::string cache_dir = Config->SharedMemDir + "lua_cache";
+	LogSys.MakeDirectory(cache_dir);
+
+	bool hit = false;
+	int status = LuaChunkCache::Load(L, filename, cache_dir, hit);
+	if(hit) {
+		++chunk_cache_hits_;
+	} else {
+		++chunk_cache_misses_;
+	}
+
+	return status;
+}
+
 void LuaParser::LoadScript(std::string filename, std::string package_name) {
 	auto iter = loaded_.find(package_name);
 	if(iter != loaded_.end()) {
@@ -990,7 +1233,7 @@ void LuaParser::LoadScript(std::string filename, std::string package_name) {
 	}
 
 	auto top = lua_gettop(L);
-	if(luaL_loadfile(L, filename.c_str())) {
+	if(LoadChunk(filename)) {
 		std::string error = lua_tostring(L, -1);
 		AddError(error);
 		lua_pop(L, 1);
@@ -1111,14 +1354,14 @@ void LuaParser::MapFunctions(lua_State *L) {
 	}
 }
 
-int LuaParser::DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int LuaParser::DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 								 std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
 		return 0;
 	}
 
-	if(!npc)
+	if(!npc || lua_encounter_events_registered.empty())
 		return 0;
 
 	std::string package_name = "npc_" + std::to_string(npc->GetNPCTypeID());
@@ -1157,7 +1400,7 @@ int LuaParser::DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, std::stri
     return ret;
 }
 
-int LuaParser::DispatchEventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int LuaParser::DispatchEventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 									std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
@@ -1186,7 +1429,7 @@ int LuaParser::DispatchEventPlayer(QuestEventID evt, Client *client, std::string
     return ret;
 }
 
-int LuaParser::DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+int LuaParser::DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 								  std::vector<EQEmu::Any> *extra_pointers) {
 	evt = ConvertLuaEvent(evt);
 	if(evt >= _LargestEventID) {
@@ -36,19 +36,19 @@ class LuaParser : public QuestInterface {
 public:
 	~LuaParser();
 
-	virtual int EventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	virtual int EventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	virtual int EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	virtual int EventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventGlobalPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	virtual int EventGlobalPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+	virtual int EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
 	virtual int EventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int EventEncounter(QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
+	virtual int EventEncounter(QuestEventID evt, std::string encounter_name, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
 
 	virtual bool HasQuestSub(uint32 npc_id, QuestEventID evt);
@@ -58,6 +58,7 @@ public:
 	virtual bool SpellHasQuestSub(uint32 spell_id, QuestEventID evt);
 	virtual bool ItemHasQuestSub(EQEmu::ItemInstance *itm, QuestEventID evt);
 	virtual bool EncounterHasQuestSub(std::string encounter_name, QuestEventID evt);
+	virtual bool HasNPCDispatchSub(uint32 npc_id, QuestEventID evt);
 
 	virtual void LoadNPCScript(std::string filename, int npc_id);
 	virtual void LoadGlobalNPCScript(std::string filename);
@@ -66,6 +67,10 @@ public:
 	virtual void LoadItemScript(std::string filename, EQEmu::ItemInstance *item);
 	virtual void LoadSpellScript(std::string filename, uint32 spell_id);
 	virtual void LoadEncounterScript(std::string filename, std::string encounter_name);
+	virtual void UnloadNPCScript(std::string filename, int npc_id);
+	virtual void UnloadGlobalNPCScript(std::string filename);
+	virtual void UnloadPlayerScript(std::string filename);
+	virtual void UnloadGlobalPlayerScript(std::string filename);
 
 	virtual void AddVar(std::string name, std::string val);
 	virtual std::string GetVar(std::string name);
@@ -73,11 +78,11 @@ public:
 	virtual void ReloadQuests();
     virtual uint32 GetIdentifier() { return 0xb0712acc; }
 
-	virtual int DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	virtual int DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int DispatchEventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	virtual int DispatchEventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	virtual int DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+	virtual int DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
 	virtual int DispatchEventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
@@ -105,23 +110,31 @@ private:
 	LuaParser(const LuaParser&);
 	LuaParser& operator=(const LuaParser&);
 
-	int _EventNPC(std::string package_name, QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	int _EventNPC(const std::string &package_name, QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func = nullptr);
-	int _EventPlayer(std::string package_name, QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	int _EventPlayer(const std::string &package_name, QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func = nullptr);
-	int _EventItem(std::string package_name, QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data,
+	int _EventItem(const std::string &package_name, QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data,
 		uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func = nullptr);
-	int _EventSpell(std::string package_name, QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
+	int _EventSpell(const std::string &package_name, QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers, luabind::adl::object *l_func = nullptr);
-	int _EventEncounter(std::string package_name, QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
+	int _EventEncounter(const std::string &package_name, QuestEventID evt, std::string encounter_name, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
 
+	void LearnEventTableSize(uint8 &size);
+	int PushEventTable(uint8 &depth, int slot, int size);
+	void ReleaseEventTable(uint8 &depth, int key);
+	int CallEvent(const std::string &package_name, QuestEventID evt, int nargs, int nresults);
 	void LoadScript(std::string filename, std::string package_name);
+	int LoadChunk(const std::string &filename);
+	void UnloadScript(const std::string &package_name);
 	void MapFunctions(lua_State *L);
 	QuestEventID ConvertLuaEvent(QuestEventID evt);
 
 	std::map<std::string, std::string> vars_;
 	std::map<std::string, bool> loaded_;
+	uint32 chunk_cache_hits_;
+	uint32 chunk_cache_misses_;
 	std::vector<LuaMod> mods_;
 	lua_State *L;
 
@@ -131,6 +144,17 @@ private:
 	SpellArgumentHandler SpellArgumentDispatch[_LargestEventID];
 	EncounterArgumentHandler EncounterArgumentDispatch[_LargestEventID];
 
+	uint8 NPCEventTableSize[_LargestEventID];
+	uint8 PlayerEventTableSize[_LargestEventID];
+	uint8 ItemEventTableSize[_LargestEventID];
+	uint8 SpellEventTableSize[_LargestEventID];
+	uint8 EncounterEventTableSize[_LargestEventID];
+
+	// nesting depth of each NPC and player event, picks which reused table an event gets
+	static const int MaxEventTableDepth = 8;
+	uint8 NPCEventTableDepth[_LargestEventID];
+	uint8 PlayerEventTableDepth[_LargestEventID];
+
 };
 
 #endif
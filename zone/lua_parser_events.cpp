@@ -26,8 +26,20 @@
 #include "zone.h"
 #include "lua_parser_events.h"
 
+#include <stdlib.h>
+
+// events pack several numbers space separated into data, read them without Seperator's per arg buffers
+static void ParseEventInts(const std::string &data, int *out, int count) {
+	const char *p = data.c_str();
+	for(int i = 0; i < count; ++i) {
+		char *end = nullptr;
+		out[i] = static_cast<int>(strtol(p, &end, 10));
+		p = end;
+	}
+}
+
 //NPC
-void handle_npc_event_say(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_event_say(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	npc->DoQuestPause(init);
 
@@ -43,7 +55,7 @@ void handle_npc_event_say(QuestInterface *parse, lua_State* L, NPC* npc, Mob *in
 	lua_setfield(L, -2, "language");
 }
 
-void handle_npc_event_trade(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_event_trade(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Client l_client(reinterpret_cast<Client*>(init));
 	luabind::adl::object l_client_o = luabind::adl::object(L, l_client);
@@ -82,7 +94,7 @@ void handle_npc_event_trade(QuestInterface *parse, lua_State* L, NPC* npc, Mob *
 	lua_setfield(L, -2, "trade");
 }
 
-void handle_npc_event_hp(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_event_hp(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	if(extra_data == 1) {
 		lua_pushinteger(L, -1);
@@ -99,7 +111,7 @@ void handle_npc_event_hp(QuestInterface *parse, lua_State* L, NPC* npc, Mob *ini
 	}
 }
 
-void handle_npc_single_mob(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_single_mob(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Mob l_mob(init);
 	luabind::adl::object l_mob_o = luabind::adl::object(L, l_mob);
@@ -107,7 +119,7 @@ void handle_npc_single_mob(QuestInterface *parse, lua_State* L, NPC* npc, Mob *i
 	lua_setfield(L, -2, "other");
 }
 
-void handle_npc_single_client(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_single_client(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Client l_client(reinterpret_cast<Client*>(init));
 	luabind::adl::object l_client_o = luabind::adl::object(L, l_client);
@@ -115,7 +127,7 @@ void handle_npc_single_client(QuestInterface *parse, lua_State* L, NPC* npc, Mob
 	lua_setfield(L, -2, "other");
 }
 
-void handle_npc_single_npc(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_single_npc(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_NPC l_npc(reinterpret_cast<NPC*>(init));
 	luabind::adl::object l_npc_o = luabind::adl::object(L, l_npc);
@@ -123,7 +135,7 @@ void handle_npc_single_npc(QuestInterface *parse, lua_State* L, NPC* npc, Mob *i
 	lua_setfield(L, -2, "other");
 }
 
-void handle_npc_task_accepted(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_task_accepted(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Client l_client(reinterpret_cast<Client*>(init));
 	luabind::adl::object l_client_o = luabind::adl::object(L, l_client);
@@ -134,7 +146,7 @@ void handle_npc_task_accepted(QuestInterface *parse, lua_State* L, NPC* npc, Mob
 	lua_setfield(L, -2, "task_id");
 }
 
-void handle_npc_popup(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_popup(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Mob l_mob(init);
 	luabind::adl::object l_mob_o = luabind::adl::object(L, l_mob);
@@ -145,7 +157,7 @@ void handle_npc_popup(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init,
 	lua_setfield(L, -2, "popup_id");
 }
 
-void handle_npc_waypoint(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_waypoint(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Mob l_mob(init);
 	luabind::adl::object l_mob_o = luabind::adl::object(L, l_mob);
@@ -156,7 +168,7 @@ void handle_npc_waypoint(QuestInterface *parse, lua_State* L, NPC* npc, Mob *ini
 	lua_setfield(L, -2, "wp");
 }
 
-void handle_npc_hate(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_hate(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Mob l_mob(init);
 	luabind::adl::object l_mob_o = luabind::adl::object(L, l_mob);
@@ -168,30 +180,31 @@ void handle_npc_hate(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, s
 }
 
 
-void handle_npc_signal(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_signal(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, std::stoi(data));
 	lua_setfield(L, -2, "signal");
 }
 
-void handle_npc_timer(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_timer(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushstring(L, data.c_str());
 	lua_setfield(L, -2, "timer");
 }
 
-void handle_npc_death(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_death(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Mob l_mob(init);
 	luabind::adl::object l_mob_o = luabind::adl::object(L, l_mob);
 	l_mob_o.push(L);
 	lua_setfield(L, -2, "other");
 
-	Seperator sep(data.c_str());
-	lua_pushinteger(L, std::stoi(sep.arg[0]));
+	int arg[3];
+	ParseEventInts(data, arg, 3);
+	lua_pushinteger(L, arg[0]);
 	lua_setfield(L, -2, "damage");
 
-	int spell_id = std::stoi(sep.arg[1]);
+	int spell_id = arg[1];
 	if(IsValidSpell(spell_id)) {
 		Lua_Spell l_spell(&spells[spell_id]);
 		luabind::adl::object l_spell_o = luabind::adl::object(L, l_spell);
@@ -204,11 +217,11 @@ void handle_npc_death(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init,
 		lua_setfield(L, -2, "spell");
 	}
 
-	lua_pushinteger(L, std::stoi(sep.arg[2]));
+	lua_pushinteger(L, arg[2]);
 	lua_setfield(L, -2, "skill_id");
 }
 
-void handle_npc_cast(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_cast(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	int spell_id = std::stoi(data);
 	if(IsValidSpell(spell_id)) {
@@ -224,7 +237,7 @@ void handle_npc_cast(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, s
 	}
 }
 
-void handle_npc_area(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_area(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, *EQEmu::any_cast<int*>(extra_pointers->at(0)));
 	lua_setfield(L, -2, "area_id");
@@ -233,12 +246,12 @@ void handle_npc_area(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, s
 	lua_setfield(L, -2, "area_type");
 }
 
-void handle_npc_null(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+void handle_npc_null(QuestInterface *parse, lua_State* L, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 }
 
 //Player
-void handle_player_say(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_say(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 					   std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushstring(L, data.c_str());
 	lua_setfield(L, -2, "message");
@@ -247,33 +260,35 @@ void handle_player_say(QuestInterface *parse, lua_State* L, Client* client, std:
 	lua_setfield(L, -2, "language");
 }
 
-void handle_player_environmental_damage(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_environmental_damage(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 	std::vector<EQEmu::Any> *extra_pointers){
-	Seperator sep(data.c_str());
-	lua_pushinteger(L, std::stoi(sep.arg[0]));
+	int arg[3];
+	ParseEventInts(data, arg, 3);
+	lua_pushinteger(L, arg[0]);
 	lua_setfield(L, -2, "env_damage");
 
-	lua_pushinteger(L, std::stoi(sep.arg[1]));
+	lua_pushinteger(L, arg[1]);
 	lua_setfield(L, -2, "env_damage_type");
 
-	lua_pushinteger(L, std::stoi(sep.arg[2]));
+	lua_pushinteger(L, arg[2]);
 	lua_setfield(L, -2, "env_final_damage");
 }
 
-void handle_player_death(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_death(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						 std::vector<EQEmu::Any> *extra_pointers) {
-	Seperator sep(data.c_str());
+	int arg[4];
+	ParseEventInts(data, arg, 4);
 
-	Mob *o = entity_list.GetMobID(std::stoi(sep.arg[0]));
+	Mob *o = entity_list.GetMobID(arg[0]);
 	Lua_Mob l_mob(o);
 	luabind::adl::object l_mob_o = luabind::adl::object(L, l_mob);
 	l_mob_o.push(L);
 	lua_setfield(L, -2, "other");
 
-	lua_pushinteger(L, std::stoi(sep.arg[1]));
+	lua_pushinteger(L, arg[1]);
 	lua_setfield(L, -2, "damage");
 
-	int spell_id = std::stoi(sep.arg[2]);
+	int spell_id = arg[2];
 	if(IsValidSpell(spell_id)) {
 		Lua_Spell l_spell(&spells[spell_id]);
 		luabind::adl::object l_spell_o = luabind::adl::object(L, l_spell);
@@ -286,17 +301,17 @@ void handle_player_death(QuestInterface *parse, lua_State* L, Client* client, st
 		lua_setfield(L, -2, "spell");
 	}
 
-	lua_pushinteger(L, std::stoi(sep.arg[3]));
+	lua_pushinteger(L, arg[3]);
 	lua_setfield(L, -2, "skill");
 }
 
-void handle_player_timer(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_timer(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						 std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushstring(L, data.c_str());
 	lua_setfield(L, -2, "timer");
 }
 
-void handle_player_discover_item(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_discover_item(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 								 std::vector<EQEmu::Any> *extra_pointers) {
 	const EQEmu::ItemData *item = database.GetItem(extra_data);
 	if(item) {
@@ -312,7 +327,7 @@ void handle_player_discover_item(QuestInterface *parse, lua_State* L, Client* cl
 	}
 }
 
-void handle_player_fish_forage_success(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_fish_forage_success(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 									   std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_ItemInst l_item(EQEmu::any_cast<EQEmu::ItemInstance*>(extra_pointers->at(0)));
 	luabind::adl::object l_item_o = luabind::adl::object(L, l_item);
@@ -320,7 +335,7 @@ void handle_player_fish_forage_success(QuestInterface *parse, lua_State* L, Clie
 	lua_setfield(L, -2, "item");
 }
 
-void handle_player_click_object(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_click_object(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 								std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Object l_object(EQEmu::any_cast<Object*>(extra_pointers->at(0)));
 	luabind::adl::object l_object_o = luabind::adl::object(L, l_object);
@@ -328,7 +343,7 @@ void handle_player_click_object(QuestInterface *parse, lua_State* L, Client* cli
 	lua_setfield(L, -2, "object");
 }
 
-void handle_player_click_door(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_click_door(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 							  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Door l_door(EQEmu::any_cast<Doors*>(extra_pointers->at(0)));
 	luabind::adl::object l_door_o = luabind::adl::object(L, l_door);
@@ -336,19 +351,19 @@ void handle_player_click_door(QuestInterface *parse, lua_State* L, Client* clien
 	lua_setfield(L, -2, "door");
 }
 
-void handle_player_signal(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_signal(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						  std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, std::stoi(data));
 	lua_setfield(L, -2, "signal");
 }
 
-void handle_player_popup_response(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_popup_response(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 								  std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, std::stoi(data));
 	lua_setfield(L, -2, "popup_id");
 }
 
-void handle_player_pick_up(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_pick_up(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						   std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_ItemInst l_item(EQEmu::any_cast<EQEmu::ItemInstance*>(extra_pointers->at(0)));
 	luabind::adl::object l_item_o = luabind::adl::object(L, l_item);
@@ -356,7 +371,7 @@ void handle_player_pick_up(QuestInterface *parse, lua_State* L, Client* client,
 	lua_setfield(L, -2, "item");
 }
 
-void handle_player_cast(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_cast(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 	int spell_id = std::stoi(data);
 	if(IsValidSpell(spell_id)) {
@@ -372,19 +387,19 @@ void handle_player_cast(QuestInterface *parse, lua_State* L, Client* client, std
 	lua_setfield(L, -2, "spell");
 }
 
-void handle_player_task_fail(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_task_fail(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 							 std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, std::stoi(data));
 	lua_setfield(L, -2, "task_id");
 }
 
-void handle_player_zone(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_zone(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, std::stoi(data));
 	lua_setfield(L, -2, "zone_id");
 }
 
-void handle_player_duel_win(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_duel_win(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 							std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Client l_client(EQEmu::any_cast<Client*>(extra_pointers->at(1)));
 	luabind::adl::object l_client_o = luabind::adl::object(L, l_client);
@@ -392,7 +407,7 @@ void handle_player_duel_win(QuestInterface *parse, lua_State* L, Client* client,
 	lua_setfield(L, -2, "other");
 }
 
-void handle_player_duel_loss(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_duel_loss(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 							 std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Client l_client(EQEmu::any_cast<Client*>(extra_pointers->at(0)));
 	luabind::adl::object l_client_o = luabind::adl::object(L, l_client);
@@ -400,7 +415,7 @@ void handle_player_duel_loss(QuestInterface *parse, lua_State* L, Client* client
 	lua_setfield(L, -2, "other");
 }
 
-void handle_player_loot(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_loot(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_ItemInst l_item(EQEmu::any_cast<EQEmu::ItemInstance*>(extra_pointers->at(0)));
 	luabind::adl::object l_item_o = luabind::adl::object(L, l_item);
@@ -413,30 +428,32 @@ void handle_player_loot(QuestInterface *parse, lua_State* L, Client* client, std
 	lua_setfield(L, -2, "corpse");
 }
 
-void handle_player_task_stage_complete(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_task_stage_complete(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 									   std::vector<EQEmu::Any> *extra_pointers) {
-	Seperator sep(data.c_str());
-	lua_pushinteger(L, std::stoi(sep.arg[0]));
+	int arg[2];
+	ParseEventInts(data, arg, 2);
+	lua_pushinteger(L, arg[0]);
 	lua_setfield(L, -2, "task_id");
 
-	lua_pushinteger(L, std::stoi(sep.arg[1]));
+	lua_pushinteger(L, arg[1]);
 	lua_setfield(L, -2, "activity_id");
 }
 
-void handle_player_task_update(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_task_update(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 								 std::vector<EQEmu::Any> *extra_pointers) {
-	Seperator sep(data.c_str());
-	lua_pushinteger(L, std::stoi(sep.arg[0]));
+	int arg[3];
+	ParseEventInts(data, arg, 3);
+	lua_pushinteger(L, arg[0]);
 	lua_setfield(L, -2, "count");
 
-	lua_pushinteger(L, std::stoi(sep.arg[1]));
+	lua_pushinteger(L, arg[1]);
 	lua_setfield(L, -2, "activity_id");
 
-	lua_pushinteger(L, std::stoi(sep.arg[2]));
+	lua_pushinteger(L, arg[2]);
 	lua_setfield(L, -2, "task_id");
 }
 
-void handle_player_command(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_command(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						   std::vector<EQEmu::Any> *extra_pointers) {
 	Seperator sep(data.c_str(), ' ', 10, 100, true);
 	std::string command(sep.arg[0] + 1);
@@ -455,7 +472,7 @@ void handle_player_command(QuestInterface *parse, lua_State* L, Client* client,
 	lua_setfield(L, -2, "args");
 }
 
-void handle_player_combine(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_combine(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						   std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, extra_data);
 	lua_setfield(L, -2, "recipe_id");
@@ -464,7 +481,7 @@ void handle_player_combine(QuestInterface *parse, lua_State* L, Client* client,
 	lua_setfield(L, -2, "recipe_name");	
 }
 
-void handle_player_feign(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_feign(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_NPC l_npc(EQEmu::any_cast<NPC*>(extra_pointers->at(0)));
 	luabind::adl::object l_npc_o = luabind::adl::object(L, l_npc);
@@ -472,7 +489,7 @@ void handle_player_feign(QuestInterface *parse, lua_State* L, Client* client, st
 	lua_setfield(L, -2, "other");
 }
 
-void handle_player_area(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_area(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, *EQEmu::any_cast<int*>(extra_pointers->at(0)));
 	lua_setfield(L, -2, "area_id");
@@ -481,7 +498,7 @@ void handle_player_area(QuestInterface *parse, lua_State* L, Client* client, std
 	lua_setfield(L, -2, "area_type");
 }
 
-void handle_player_respawn(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_respawn(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, std::stoi(data));
 	lua_setfield(L, -2, "option");
@@ -490,7 +507,7 @@ void handle_player_respawn(QuestInterface *parse, lua_State* L, Client* client,
 	lua_setfield(L, -2, "resurrect");
 }
 
-void handle_player_packet(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_packet(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_Packet l_packet(EQEmu::any_cast<EQApplicationPacket*>(extra_pointers->at(0)));
 	luabind::adl::object l_packet_o = luabind::adl::object(L, l_packet);
@@ -501,33 +518,34 @@ void handle_player_packet(QuestInterface *parse, lua_State* L, Client* client, s
 	lua_setfield(L, -2, "connecting");
 }
 
-void handle_player_null(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data,
+void handle_player_null(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data,
 						std::vector<EQEmu::Any> *extra_pointers) {
 }
 
-void handle_player_use_skill(QuestInterface *parse, lua_State* L, Client* client, std::string data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers) {
-	Seperator sep(data.c_str());
-	lua_pushinteger(L, std::stoi(sep.arg[0]));
+void handle_player_use_skill(QuestInterface *parse, lua_State* L, Client* client, const std::string &data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers) {
+	int arg[2];
+	ParseEventInts(data, arg, 2);
+	lua_pushinteger(L, arg[0]);
 	lua_setfield(L, -2, "skill_id");
 
-	lua_pushinteger(L, std::stoi(sep.arg[1]));
+	lua_pushinteger(L, arg[1]);
 	lua_setfield(L, -2, "skill_level");
 }
 
 //Item
-void handle_item_click(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_click(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					   std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, extra_data);
 	lua_setfield(L, -2, "slot_id");
 }
 
-void handle_item_timer(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_timer(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					  std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushstring(L, data.c_str());
 	lua_setfield(L, -2, "timer");
 }
 
-void handle_item_proc(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_proc(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					   std::vector<EQEmu::Any> *extra_pointers) {
 
 	Lua_Mob l_mob(mob);
@@ -548,7 +566,7 @@ void handle_item_proc(QuestInterface *parse, lua_State* L, Client* client, EQEmu
 	}
 }
 
-void handle_item_loot(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_loot(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					  std::vector<EQEmu::Any> *extra_pointers) {
 	if(mob && mob->IsCorpse()) {
 		Lua_Corpse l_corpse(mob->CastToCorpse());
@@ -563,13 +581,13 @@ void handle_item_loot(QuestInterface *parse, lua_State* L, Client* client, EQEmu
 	}
 }
 
-void handle_item_equip(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_equip(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					   std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushinteger(L, extra_data);
 	lua_setfield(L, -2, "slot_id");
 }
 
-void handle_item_augment(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_augment(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_ItemInst l_item(EQEmu::any_cast<EQEmu::ItemInstance*>(extra_pointers->at(0)));
 	luabind::adl::object l_item_o = luabind::adl::object(L, l_item);
@@ -580,7 +598,7 @@ void handle_item_augment(QuestInterface *parse, lua_State* L, Client* client, EQ
 	lua_setfield(L, -2, "slot_id");
 }
 
-void handle_item_augment_insert(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_augment_insert(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_ItemInst l_item(EQEmu::any_cast<EQEmu::ItemInstance*>(extra_pointers->at(0)));
 	luabind::adl::object l_item_o = luabind::adl::object(L, l_item);
@@ -591,7 +609,7 @@ void handle_item_augment_insert(QuestInterface *parse, lua_State* L, Client* cli
 	lua_setfield(L, -2, "slot_id");
 }
 
-void handle_item_augment_remove(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_augment_remove(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					  std::vector<EQEmu::Any> *extra_pointers) {
 	Lua_ItemInst l_item(EQEmu::any_cast<EQEmu::ItemInstance*>(extra_pointers->at(0)));
 	luabind::adl::object l_item_o = luabind::adl::object(L, l_item);
@@ -605,7 +623,7 @@ void handle_item_augment_remove(QuestInterface *parse, lua_State* L, Client* cli
 	lua_setfield(L, -2, "destroyed");
 }
 
-void handle_item_null(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, std::string data, uint32 extra_data,
+void handle_item_null(QuestInterface *parse, lua_State* L, Client* client, EQEmu::ItemInstance* item, Mob *mob, const std::string &data, uint32 extra_data,
 					  std::vector<EQEmu::Any> *extra_pointers) {
 }
 
@@ -714,13 +732,13 @@ void handle_spell_null(QuestInterface *parse, lua_State* L, NPC* npc, Client* cl
 					   std::vector<EQEmu::Any> *extra_pointers) {
 }
 
-void handle_encounter_timer(QuestInterface *parse, lua_State* L, Encounter* encounter, std::string data, uint32 extra_data,
+void handle_encounter_timer(QuestInterface *parse, lua_State* L, Encounter* encounter, const std::string &data, uint32 extra_data,
 							std::vector<EQEmu::Any> *extra_pointers) {
 	lua_pushstring(L, data.c_str());
 	lua_setfield(L, -2, "timer");
 }
 
-void handle_encounter_load(QuestInterface *parse, lua_State* L, Encounter* encounter, std::string data, uint32 extra_data,
+void handle_encounter_load(QuestInterface *parse, lua_State* L, Encounter* encounter, const std::string &data, uint32 extra_data,
 									 std::vector<EQEmu::Any> *extra_pointers) {
 	if (encounter) {
 		Lua_Encounter l_enc(encounter);
@@ -735,7 +753,7 @@ void handle_encounter_load(QuestInterface *parse, lua_State* L, Encounter* encou
 	}
 }
 
-void handle_encounter_unload(QuestInterface *parse, lua_State* L, Encounter* encounter, std::string data, uint32 extra_data,
+void handle_encounter_unload(QuestInterface *parse, lua_State* L, Encounter* encounter, const std::string &data, uint32 extra_data,
 	std::vector<EQEmu::Any> *extra_pointers) {
 	if (extra_pointers) {
 		std::string *str = EQEmu::any_cast<std::string*>(extra_pointers->at(0));
@@ -744,7 +762,7 @@ void handle_encounter_unload(QuestInterface *parse, lua_State* L, Encounter* enc
 	}
 }
 
-void handle_encounter_null(QuestInterface *parse, lua_State* L, Encounter* encounter, std::string data, uint32 extra_data,
+void handle_encounter_null(QuestInterface *parse, lua_State* L, Encounter* encounter, const std::string &data, uint32 extra_data,
 						   std::vector<EQEmu::Any> *extra_pointers) {
 
 }
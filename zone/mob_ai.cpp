@@ -1581,9 +1581,11 @@ void NPC::AI_DoMovement() {
 					SendPosition();
 
 					//kick off event_waypoint arrive
-					char temp[16];
-					sprintf(temp, "%d", cur_wp);
-					parse->EventNPC(EVENT_WAYPOINT_ARRIVE, CastToNPC(), nullptr, temp, 0);
+					if (parse->HasAnySub(CastToNPC(), EVENT_WAYPOINT_ARRIVE)) {
+						char temp[16];
+						sprintf(temp, "%d", cur_wp);
+						parse->EventNPC(EVENT_WAYPOINT_ARRIVE, CastToNPC(), nullptr, temp, 0);
+					}
 					// start moving directly to next waypoint if we're at a 0 pause waypoint and we didn't get quest halted.
 					if (!AI_walking_timer->Enabled())
 						AI_SetupNextWaypoint();
@@ -1716,9 +1718,11 @@ void NPC::AI_SetupNextWaypoint() {
 
 		if (!DistractedFromGrid) {
 			//kick off event_waypoint depart
-			char temp[16];
-			sprintf(temp, "%d", cur_wp);
-			parse->EventNPC(EVENT_WAYPOINT_DEPART, CastToNPC(), nullptr, temp, 0);
+			if (parse->HasAnySub(CastToNPC(), EVENT_WAYPOINT_DEPART)) {
+				char temp[16];
+				sprintf(temp, "%d", cur_wp);
+				parse->EventNPC(EVENT_WAYPOINT_DEPART, CastToNPC(), nullptr, temp, 0);
+			}
 
 			//setup our next waypoint, if we are still on our normal grid
 			//remember that the quest event above could have done anything it wanted with our grid
@@ -1763,7 +1767,8 @@ void Mob::AI_Event_Engaged(Mob* attacker, bool iYellForHelp) {
 			{
 				if(!CastToNPC()->GetCombatEvent() && GetHP() > 0)
 				{
-					parse->EventNPC(EVENT_COMBAT, CastToNPC(), attacker, "1", 0);
+					if (parse->HasAnySub(CastToNPC(), EVENT_COMBAT))
+						parse->EventNPC(EVENT_COMBAT, CastToNPC(), attacker, "1", 0);
 					uint16 emoteid = GetEmoteID();
 					if(emoteid != 0)
 						CastToNPC()->DoNPCEmote(ENTERCOMBAT,emoteid);
@@ -1803,7 +1808,8 @@ void Mob::AI_Event_NoLongerEngaged() {
 			if(entity_list.GetNPCByID(this->GetID()))
 			{
 			uint16 emoteid = CastToNPC()->GetEmoteID();
-			parse->EventNPC(EVENT_COMBAT, CastToNPC(), nullptr, "0", 0);
+			if (parse->HasAnySub(CastToNPC(), EVENT_COMBAT))
+				parse->EventNPC(EVENT_COMBAT, CastToNPC(), nullptr, "0", 0);
 			if(emoteid != 0)
 				CastToNPC()->DoNPCEmote(LEAVECOMBAT,emoteid);
 			CastToNPC()->SetCombatEvent(false);
@@ -2262,6 +2268,9 @@ void NPC::CheckSignal() {
 	if (!signal_q.empty()) {
 		int signal_id = signal_q.front();
 		signal_q.pop_front();
+		if (!parse->HasAnySub(this, EVENT_SIGNAL))
+			return;
+
 		char buf[32];
 		snprintf(buf, 31, "%d", signal_id);
 		buf[31] = '\0';
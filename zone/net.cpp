@@ -370,6 +370,18 @@ int main(int argc, char** argv) {
 		}
 	}
 
+	// only worth mapping when zones read from it, which needs the rules loaded
+	if (RuleB(Zone, SharedNPCTypes)) {
+		Log(Logs::General, Logs::Zone_Server, "Loading npc types");
+		if (database.LoadNPCTypes(hotfix_name)) {
+			auto table = database.GetNPCTypeTable();
+			Log(Logs::General, Logs::Zone_Server, "Mapped %u npc types in %u KB", table->GetCount(), static_cast<uint32>(table->GetSize() / 1024));
+		}
+		else {
+			Log(Logs::General, Logs::Error, "Loading npc types FAILED! npc types will be read from the database.");
+		}
+	}
+
 #ifdef BOTS
 	Log(Logs::General, Logs::Zone_Server, "Loading bot commands");
 	int botretval = bot_command_init();
@@ -450,6 +462,9 @@ int main(int argc, char** argv) {
 		frame_time = std::chrono::duration_cast<std::chrono::milliseconds>(frame_now - frame_prev).count();
 		frame_prev = frame_now;
 
+		// no item or spell pointer is on the stack here, so this is where a new generation gets mapped
+		worldserver.ProcessSharedMemGeneration();
+
 		if (!eqsf_open && Config->ZonePort != 0) {
 			Log(Logs::General, Logs::Zone_Server, "Starting EQ Network server on port %d", Config->ZonePort);
 
@@ -517,8 +532,12 @@ int main(int argc, char** argv) {
 					}
 				}
 
-				if (quest_timers.Check())
+				if (quest_timers.Check()) {
 					quest_manager.Process();
+					entity_list.ProcessSignals();
+					parse->ProcessPreload();
+					parse->ProcessWatch();
+				}
 
 			}
 		}
@@ -526,6 +545,7 @@ int main(int argc, char** argv) {
 		if (InterserverTimer.Check()) {
 			InterserverTimer.Start();
 			database.ping();
+			database.ReleaseRetiredSharedMemory(RuleI(World, SharedMemoryRetireMS));
 			entity_list.UpdateWho();
 		}
 	};
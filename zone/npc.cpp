@@ -57,6 +57,8 @@ extern Zone* zone;
 extern volatile bool is_zone_loaded;
 extern EntityList entity_list;
 
+EQ_SLAB_POOLED_IMPL(NPC, "NPC", 32)
+
 NPC::NPC(const NPCType* d, Spawn2* in_respawn, const glm::vec4& position, int iflymode, bool IsCorpse)
 : Mob(d->name,
 		d->lastname,
@@ -116,6 +118,7 @@ NPC::NPC(const NPCType* d, Spawn2* in_respawn, const glm::vec4& position, int if
 	knightattack_timer(1000),
 	assist_timer(AIassistcheck_delay),
 	qglobal_purge_timer(30000),
+	ai_sleep_timer(1000),
 	sendhpupdate_timer(2000),
 	enraged_timer(1000),
 	taunt_timer(TauntReuseTime * 1000),
@@ -150,6 +153,8 @@ NPC::NPC(const NPCType* d, Spawn2* in_respawn, const glm::vec4& position, int if
 	save_wp = 0;
 	spawn_group = 0;
 	swarmInfoPtr = nullptr;
+	ai_sleeping = false;
+	ai_awake_until = 0;
 	spellscale = d->spellscale;
 	healscale = d->healscale;
 
@@ -814,6 +819,7 @@ void NPC::Depop(bool StartSpawnTimer) {
 	if(emoteid != 0)
 		this->DoNPCEmote(ONDESPAWN,emoteid);
 	p_depop = true;
+	WakeAI();
 	if (StartSpawnTimer) {
 		if (respawn2 != 0) {
 			respawn2->DeathReset();
@@ -1173,7 +1179,7 @@ uint32 ZoneDatabase::CreateNewNPCCommand(const char *zone, uint32 zone_version,
 	uint32 spawngroupid = results.LastInsertedID();
 
 	spawn->SetSp2(spawngroupid);
-	spawn->SetNPCTypeID(npc_type_id);
+	entity_list.ChangeNPCType(spawn, npc_type_id);
 
 	query = StringFormat("INSERT INTO spawn2 (zone, version, x, y, z, respawntime, heading, spawngroupID) "
 			     "VALUES('%s', %u, %f, %f, %f, %i, %f, %i)",
@@ -2346,6 +2352,50 @@ int32 NPC::CalcMaxMana() {
 void NPC::SignalNPC(int _signal_id)
 {
 	signal_q.push_back(_signal_id);
+	WakeAI();
+}
+
+void NPC::WakeAI()
+{
+	ai_sleeping = false;
+	ai_awake_until = Timer::GetCurrentTime() + RuleI(NPC, AISleepWakeGrace);
+}
+
+/*
+	Only NPCs that would do nothing but wait on timers are allowed to sleep.
+	Roamers, anything moving, casting, fighting, fleeing or owned stays awake
+	so waypoints, pathing and combat behave exactly as before. The wake area
+	only covers clients, so NPCs that aggro other NPCs never sleep either.
+*/
+bool NPC::CanAISleep()
+{
+	if (p_depop || IsEngaged() || IsMoving() || IsCasting() || IsFeared())
+		return false;
+
+	if (GetGrid() != 0 || GetOwnerID() != 0 || GetSwarmOwner() != 0 || HasVirus() || WillAggroNPCs())
+		return false;
+
+	if (!signal_q.empty() || IsMezzed() || IsStunned())
+		return false;
+
+	return Timer::GetCurrentTime() >= ai_awake_until;
+}
+
+// returns true when this tick can be skipped
+bool NPC::CheckAISleep(bool client_near)
+{
+	if (client_near || !CanAISleep()) {
+		ai_sleeping = false;
+		return false;
+	}
+
+	if (!ai_sleeping) {
+		ai_sleeping = true;
+		ai_sleep_timer.Start(RuleI(NPC, AISleepTickInterval));
+		return false;
+	}
+
+	return !ai_sleep_timer.Check();
 }
 
 NPC_Emote_Struct* NPC::GetNPCEmote(uint16 emoteid, uint8 event_) {
@@ -19,6 +19,7 @@
 #define NPC_H
 
 #include "../common/rulesys.h"
+#include "../common/util/slab_pool.h"
 
 #include "mob.h"
 #include "qglobals.h"
@@ -108,6 +109,8 @@ public:
 
 	virtual ~NPC();
 
+	EQ_SLAB_POOLED()
+
 	//abstract virtual function implementations requird by base abstract class
 	virtual bool Death(Mob* killerMob, int32 damage, uint16 spell_id, EQEmu::skills::SkillType attack_skill);
 	virtual void Damage(Mob* from, int32 damage, uint16 spell_id, EQEmu::skills::SkillType attack_skill, bool avoidable = true, int8 buffslot = -1, bool iBuffTic = false, eSpecialAttacks special = eSpecialAttacks::None);
@@ -249,6 +252,11 @@ public:
 
 	void	SignalNPC(int _signal_id);
 
+	inline bool	IsAISleeping() const { return ai_sleeping; }
+	void	WakeAI();
+	bool	CanAISleep();
+	bool	CheckAISleep(bool client_near);
+
 	inline int32	GetNPCFactionID()	const { return npc_faction_id; }
 	inline int32			GetPrimaryFaction()	const { return primary_faction; }
 	int32	GetNPCHate(Mob* in_ent) {return hate_list.GetEntHateAmount(in_ent);}
@@ -446,6 +454,10 @@ protected:
 	Timer	assist_timer;		//ask for help from nearby mobs
 	Timer	qglobal_purge_timer;
 
+	bool	ai_sleeping;
+	uint32	ai_awake_until;
+	Timer	ai_sleep_timer;		//low frequency process tick while asleep
+
 	bool	combat_event;	//true if we are in combat, false otherwise
 	Timer	sendhpupdate_timer;
 	Timer	enraged_timer;
@@ -7,56 +7,104 @@
 void QGlobalCache::AddGlobal(uint32 id, QGlobal global)
 {
 	global.id = id;
-	qGlobalBucket.push_back(global);
+	auto iter = qGlobalBucket.insert(qGlobalBucket.end(), global);
+	nameIndex[iter->name].push_back(iter);
+	entryIndex[&(*iter)] = iter;
+
+	if (iter->expdate != 0xFFFFFFFF) {
+		Expiry e;
+		e.expdate = iter->expdate;
+		e.global = &(*iter);
+		expiryHeap.push(e);
+	}
+
+	// globals that get removed and set again leave stale heap entries behind, don't let them pile up
+	if (expiryHeap.size() > qGlobalBucket.size() * 2 + 64)
+		RebuildExpiryHeap();
 }
 
-void QGlobalCache::RemoveGlobal(std::string name, uint32 npcID, uint32 charID, uint32 zoneID)
+void QGlobalCache::RebuildExpiryHeap()
 {
-	auto iter = qGlobalBucket.begin();
-	while(iter != qGlobalBucket.end())
-	{
-		if(name.compare((*iter).name) == 0)
-		{
-			if((npcID == (*iter).npc_id || (*iter).npc_id == 0) &&
-				(charID == (*iter).char_id || (*iter).char_id == 0) &&
-				(zoneID == (*iter).zone_id || (*iter).zone_id == 0))
-			{
-				qGlobalBucket.erase(iter);
-				return;
+	std::vector<Expiry> entries;
+	entries.reserve(qGlobalBucket.size());
+	for (auto &g : qGlobalBucket) {
+		if (g.expdate == 0xFFFFFFFF)
+			continue;
+
+		Expiry e;
+		e.expdate = g.expdate;
+		e.global = &g;
+		entries.push_back(e);
+	}
+
+	expiryHeap = std::priority_queue<Expiry, std::vector<Expiry>, std::greater<Expiry>>(std::greater<Expiry>(), std::move(entries));
+}
+
+void QGlobalCache::Erase(BucketIter iter)
+{
+	auto name_iter = nameIndex.find(iter->name);
+	if (name_iter != nameIndex.end()) {
+		auto &entries = name_iter->second;
+		for (auto e = entries.begin(); e != entries.end(); ++e) {
+			if (*e == iter) {
+				entries.erase(e);
+				break;
 			}
 		}
-		++iter;
+
+		if (entries.empty())
+			nameIndex.erase(name_iter);
 	}
+
+	entryIndex.erase(&(*iter));
+	qGlobalBucket.erase(iter);
 }
 
-void QGlobalCache::Combine(std::list<QGlobal> &cacheA, std::list<QGlobal> cacheB, uint32 npcID, uint32 charID, uint32 zoneID)
+void QGlobalCache::RemoveGlobal(std::string name, uint32 npcID, uint32 charID, uint32 zoneID)
 {
-	auto iter = cacheB.begin();
-	while(iter != cacheB.end())
-	{
-		QGlobal cur = (*iter);
+	auto name_iter = nameIndex.find(name);
+	if (name_iter == nameIndex.end())
+		return;
 
-		if((cur.npc_id == npcID || cur.npc_id == 0) && (cur.char_id == charID || cur.char_id == 0) &&
-			(cur.zone_id == zoneID || cur.zone_id == 0))
+	for (auto iter : name_iter->second) {
+		if((npcID == (*iter).npc_id || (*iter).npc_id == 0) &&
+			(charID == (*iter).char_id || (*iter).char_id == 0) &&
+			(zoneID == (*iter).zone_id || (*iter).zone_id == 0))
 		{
-			if(Timer::GetTimeSeconds() < cur.expdate)
-			{
-				cacheA.push_back(cur);
-			}
+			Erase(iter);
+			return;
 		}
-		++iter;
 	}
 }
 
-void QGlobalCache::GetQGlobals(std::list<QGlobal> &globals, NPC *n, Client *c, Zone *z) {
-	globals.clear();
+const QGlobal *QGlobalCache::FindGlobal(const std::string &name, uint32 npcID, uint32 charID, uint32 zoneID, uint32 now) const
+{
+	auto name_iter = nameIndex.find(name);
+	if (name_iter == nameIndex.end())
+		return nullptr;
+
+	for (auto iter : name_iter->second) {
+		if (iter->AppliesTo(npcID, charID, zoneID) && now < iter->expdate)
+			return &(*iter);
+	}
+
+	return nullptr;
+}
 
+void QGlobalCache::Combine(std::list<QGlobal> &cacheA, const std::list<QGlobal> &cacheB, uint32 npcID, uint32 charID, uint32 zoneID)
+{
+	uint32 now = Timer::GetTimeSeconds();
+	for (auto &cur : cacheB) {
+		if (cur.AppliesTo(npcID, charID, zoneID) && now < cur.expdate)
+			cacheA.push_back(cur);
+	}
+}
+
+QGlobalView::QGlobalView(NPC *n, Client *c, Zone *z) : npc_id(0), char_id(0), zone_id(0)
+{
 	QGlobalCache *npc_c = nullptr;
 	QGlobalCache *char_c = nullptr;
 	QGlobalCache *zone_c = nullptr;
-	uint32 npc_id = 0;
-	uint32 char_id = 0;
-	uint32 zone_id = 0;
 
 	if(n) {
 		npc_id = n->GetNPCTypeID();
@@ -89,50 +137,54 @@ void QGlobalCache::GetQGlobals(std::list<QGlobal> &globals, NPC *n, Client *c, Z
 		zone_c->LoadByGlobalContext();
 	}
 
-	if(npc_c) {
-		QGlobalCache::Combine(globals, npc_c->GetBucket(), npc_id, char_id, zone_id);
-	}
+	caches[0] = npc_c;
+	caches[1] = char_c;
+	caches[2] = zone_c;
+	now = Timer::GetTimeSeconds();
+}
 
-	if(char_c) {
-		QGlobalCache::Combine(globals, char_c->GetBucket(), npc_id, char_id, zone_id);
-	}
+const QGlobal *QGlobalView::Find(const std::string &name) const
+{
+	for (int i = 0; i < 3; ++i) {
+		if (!caches[i])
+			continue;
 
-	if(zone_c) {
-		QGlobalCache::Combine(globals, zone_c->GetBucket(), npc_id, char_id, zone_id);
+		const QGlobal *g = caches[i]->FindGlobal(name, npc_id, char_id, zone_id, now);
+		if (g)
+			return g;
 	}
+
+	return nullptr;
+}
+
+void QGlobalCache::GetQGlobals(std::list<QGlobal> &globals, NPC *n, Client *c, Zone *z) {
+	globals.clear();
+
+	QGlobalView view(n, c, z);
+	view.ForEach([&globals](const QGlobal &g) { globals.push_back(g); });
 }
 
 bool QGlobalCache::GetQGlobal(QGlobal &g, std::string name, NPC *n, Client *c, Zone *z) {
-	std::list<QGlobal> globals;
-	QGlobalCache::GetQGlobals(globals, n, c, z);
-
-	auto iter = globals.begin();
-	while(iter != globals.end()) {
-		if(iter->name.compare(name) == 0) {
-			g = (*iter);
-			return true;
-		}
-		++iter;
-	}
+	QGlobalView view(n, c, z);
+	const QGlobal *found = view.Find(name);
+	if (!found)
+		return false;
 
-	return false;
+	g = *found;
+	return true;
 }
 
 void QGlobalCache::PurgeExpiredGlobals()
 {
-	if(!qGlobalBucket.size())
-		return;
-
-	auto iter = qGlobalBucket.begin();
-	while(iter != qGlobalBucket.end())
-	{
-		QGlobal cur = (*iter);
-		if(Timer::GetTimeSeconds() > cur.expdate)
-		{
-			iter = qGlobalBucket.erase(iter);
-			continue;
-		}
-		++iter;
+	uint32 now = Timer::GetTimeSeconds();
+	while (!expiryHeap.empty() && expiryHeap.top().expdate < now) {
+		const QGlobal *global = expiryHeap.top().global;
+		expiryHeap.pop();
+
+		// the global may be gone already, or the address reused by a newer one that isn't due yet
+		auto iter = entryIndex.find(global);
+		if (iter != entryIndex.end() && now > iter->second->expdate)
+			Erase(iter->second);
 	}
 }
 
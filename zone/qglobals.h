@@ -1,7 +1,14 @@
 #ifndef __QGLOBALS__H
 #define __QGLOBALS__H
 
+#include "../common/types.h"
+
+#include <functional>
 #include <list>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class NPC;
 class Client;
@@ -19,17 +26,39 @@ struct QGlobal
 	std::string value;
 	uint32 expdate;
 	uint32 id;
+
+	inline bool AppliesTo(uint32 npcID, uint32 charID, uint32 zoneID) const {
+		return (npc_id == npcID || npc_id == 0) && (char_id == charID || char_id == 0) && (zone_id == zoneID || zone_id == 0);
+	}
 };
 
+/*
+ * Globals are kept in insertion order (quests see them in that order) with a
+ * name index on top for lookups and removal, and a min heap on expire date so
+ * purging only touches globals that actually expired.
+ */
 class QGlobalCache
 {
 public:
+	QGlobalCache() { }
+
 	void AddGlobal(uint32 id, QGlobal global);
 	void RemoveGlobal(std::string name, uint32 npcID, uint32 charID, uint32 zoneID);
-	std::list<QGlobal> GetBucket() { return qGlobalBucket; }
+	const std::list<QGlobal> &GetBucket() const { return qGlobalBucket; }
+
+	// first unexpired global called name that is visible to npc/char/zone
+	const QGlobal *FindGlobal(const std::string &name, uint32 npcID, uint32 charID, uint32 zoneID, uint32 now) const;
+
+	template<typename F>
+	void ForEachGlobal(uint32 npcID, uint32 charID, uint32 zoneID, uint32 now, F fn) const {
+		for (auto &g : qGlobalBucket) {
+			if (g.AppliesTo(npcID, charID, zoneID) && now < g.expdate)
+				fn(g);
+		}
+	}
 
 	//assumes cacheA is already a valid or empty list and doesn't check for valid items.
-	static void Combine(std::list<QGlobal> &cacheA, std::list<QGlobal> cacheB, uint32 npcID, uint32 charID, uint32 zoneID);
+	static void Combine(std::list<QGlobal> &cacheA, const std::list<QGlobal> &cacheB, uint32 npcID, uint32 charID, uint32 zoneID);
 	static void GetQGlobals(std::list<QGlobal> &globals, NPC *n, Client *c, Zone *z);
 	static bool GetQGlobal(QGlobal &g, std::string name, NPC *n, Client *c, Zone *z);
 
@@ -39,8 +68,60 @@ public:
 	void LoadByZoneID(uint32 zoneID); //zone
 	void LoadByGlobalContext(); //zone
 protected:
+	typedef std::list<QGlobal>::iterator BucketIter;
+
+	struct Expiry {
+		uint32 expdate;
+		const QGlobal *global;
+
+		bool operator>(const Expiry &o) const { return expdate > o.expdate; }
+	};
+
 	void LoadBy(const std::string &query);
+	void Erase(BucketIter iter);
+	void RebuildExpiryHeap();
+
 	std::list<QGlobal> qGlobalBucket;
+	std::unordered_map<std::string, std::vector<BucketIter>> nameIndex;
+	std::unordered_map<const QGlobal *, BucketIter> entryIndex;
+	// entries are not removed when a global is, they're skipped when they surface
+	std::priority_queue<Expiry, std::vector<Expiry>, std::greater<Expiry>> expiryHeap;
+
+private:
+	// the indexes point into qGlobalBucket
+	QGlobalCache(const QGlobalCache&);
+	QGlobalCache& operator=(const QGlobalCache&);
+};
+
+/*
+ * Everything a single quest event can see: the npc, character and zone caches
+ * resolved (and loaded on first use) once, then read in place. This replaces
+ * combining all three into a freshly copied list on every event.
+ */
+class QGlobalView
+{
+public:
+	QGlobalView(NPC *n, Client *c, Zone *z);
+
+	// perl passes a negative npc type id as charid when no client is involved
+	void SetCharID(uint32 charID) { char_id = charID; }
+
+	template<typename F>
+	void ForEach(F fn) const {
+		for (int i = 0; i < 3; ++i) {
+			if (caches[i])
+				caches[i]->ForEachGlobal(npc_id, char_id, zone_id, now, fn);
+		}
+	}
+
+	const QGlobal *Find(const std::string &name) const;
+
+private:
+	const QGlobalCache *caches[3];
+	uint32 npc_id;
+	uint32 char_id;
+	uint32 zone_id;
+	uint32 now;
 };
 
 #endif
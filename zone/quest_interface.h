@@ -33,19 +33,19 @@ namespace EQEmu
 
 class QuestInterface {
 public:
-	virtual int EventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	virtual int EventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
-	virtual int EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	virtual int EventGlobalNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
-	virtual int EventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	virtual int EventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
-	virtual int EventGlobalPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	virtual int EventGlobalPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
-	virtual int EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+	virtual int EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
 	virtual int EventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
-	virtual int EventEncounter(QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
+	virtual int EventEncounter(QuestEventID evt, std::string encounter_name, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
 	
 	virtual bool HasQuestSub(uint32 npcid, QuestEventID evt) { return false; }
@@ -55,6 +55,8 @@ public:
 	virtual bool SpellHasQuestSub(uint32 spell_id, QuestEventID evt) { return false; }
 	virtual bool ItemHasQuestSub(EQEmu::ItemInstance *itm, QuestEventID evt) { return false; }
 	virtual bool EncounterHasQuestSub(std::string encounter_name, QuestEventID evt) { return false; }
+	//handlers registered at runtime (lua encounters) that DispatchEventNPC would reach
+	virtual bool HasNPCDispatchSub(uint32 npcid, QuestEventID evt) { return false; }
 
 	virtual void LoadNPCScript(std::string filename, int npc_id) { }
 	virtual void LoadGlobalNPCScript(std::string filename) { }
@@ -64,11 +66,17 @@ public:
 	virtual void LoadSpellScript(std::string filename, uint32 spell_id) { }
 	virtual void LoadEncounterScript(std::string filename, std::string encounter_name) { }
 
-	virtual int DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	//drop a single script so the next Load call compiles it again, used by incremental reloads
+	virtual void UnloadNPCScript(std::string filename, int npc_id) { }
+	virtual void UnloadGlobalNPCScript(std::string filename) { }
+	virtual void UnloadPlayerScript(std::string filename) { }
+	virtual void UnloadGlobalPlayerScript(std::string filename) { }
+
+	virtual int DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
-	virtual int DispatchEventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	virtual int DispatchEventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
-	virtual int DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+	virtual int DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
 	virtual int DispatchEventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers) { return 0; }
@@ -20,6 +20,7 @@
 #include "../common/global_define.h"
 #include "../common/misc_functions.h"
 #include "../common/features.h"
+#include "../common/rulesys.h"
 
 #include "quest_parser_collection.h"
 #include "quest_interface.h"
@@ -27,7 +28,9 @@
 #include "questmgr.h"
 #include "zone_config.h"
 
+#include <algorithm>
 #include <stdio.h>
+#include <sys/stat.h>
 
 extern Zone* zone;
 extern void MapOpcodes();
@@ -36,21 +39,30 @@ QuestParserCollection::QuestParserCollection() {
 	_player_quest_status = QuestUnloaded;
 	_global_player_quest_status = QuestUnloaded;
 	_global_npc_quest_status = QuestUnloaded;
+	_preload_pos = 0;
 }
 
 QuestParserCollection::~QuestParserCollection() {
+	CancelPreload();
+	CancelWatch();
 }
 
 void QuestParserCollection::RegisterQuestInterface(QuestInterface *qi, std::string ext) {
 	_interfaces[qi->GetIdentifier()] = qi;
 	_extensions[qi->GetIdentifier()] = ext;
 	_load_precedence.push_back(qi);
+
+	QuestSearchEntry entry;
+	entry.qi = qi;
+	entry.ext = ext;
+	_search_order.push_back(entry);
 }
 
 void QuestParserCollection::ClearInterfaces() {
 	_interfaces.clear();
 	_extensions.clear();
 	_load_precedence.clear();
+	_search_order.clear();
 }
 
 void QuestParserCollection::AddVar(std::string name, std::string val) {
@@ -70,12 +82,32 @@ void QuestParserCollection::Init() {
 }
 
 void QuestParserCollection::ReloadQuests(bool reset_timers) {
+	BenchTimer timer;
+
 	if(reset_timers) {
 		quest_manager.ClearAllTimers();
 	}
 
+	// scripts that were in use get compiled again in the background instead of on their next event
+	std::set<uint32> reload_npcs;
+	if(RuleB(Zone, PreloadQuests)) {
+		for(auto &status : _npc_quest_status) {
+			if(status.second != QuestFailedToLoad) {
+				reload_npcs.insert(status.first);
+			}
+		}
+	}
+	CancelPreload();
+	CancelWatch();
+
 	MapOpcodes();
 	_npc_quest_status.clear();
+	_npc_quest_files.clear();
+	_global_npc_quest_file = QuestFileStamp();
+	_player_quest_file = QuestFileStamp();
+	_global_player_quest_file = QuestFileStamp();
+	_npc_sub_masks.clear();
+	_global_npc_sub_mask.reset();
 	_player_quest_status = QuestUnloaded;
 	_global_player_quest_status = QuestUnloaded;
 	_global_npc_quest_status = QuestUnloaded;
@@ -87,60 +119,433 @@ void QuestParserCollection::ReloadQuests(bool reset_timers) {
 		(*iter)->ReloadQuests();
 		++iter;
 	}
+
+	Log(Logs::General, Logs::Quests, "Quest reload took %.2f ms", timer.elapsed() * 1000.0);
+
+	if(!reload_npcs.empty()) {
+		PreloadNPCQuests(reload_npcs);
+	}
 }
 
-bool QuestParserCollection::HasQuestSub(uint32 npcid, QuestEventID evt) {
-	return HasQuestSubLocal(npcid, evt) || HasQuestSubGlobal(evt);
+void QuestParserCollection::StampQuestFile(const std::string &filename, QuestFileStamp &stamp) {
+	stamp.filename = filename;
+	stamp.mtime = 0;
+	stamp.size = 0;
+
+	struct stat st;
+	if(!filename.empty() && stat(filename.c_str(), &st) == 0) {
+		stamp.mtime = static_cast<int64>(st.st_mtime);
+		stamp.size = static_cast<int64>(st.st_size);
+	}
 }
 
-bool QuestParserCollection::HasQuestSubLocal(uint32 npcid, QuestEventID evt) {
-	auto iter = _npc_quest_status.find(npcid);
+bool QuestParserCollection::QuestFileChanged(const QuestFileStamp &stamp, const std::string &filename) {
+	if(stamp.filename != filename) {
+		return true;
+	}
 
-	if(iter != _npc_quest_status.end()) {
-		//loaded or failed to load
-		if(iter->second != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(iter->second);
-			if(qiter->second->HasQuestSub(npcid, evt)) {
-				return true;
+	if(filename.empty()) {
+		return false;
+	}
+
+	QuestFileStamp current;
+	StampQuestFile(filename, current);
+	return current.mtime != stamp.mtime || current.size != stamp.size;
+}
+
+/*
+	Which of the given npc scripts would load differently now: edited, deleted,
+	or shadowed by a new file earlier in the search order. Only reads the
+	filesystem so the watch thread can run it.
+*/
+std::vector<uint32> QuestParserCollection::FindChangedNPCQuests(const std::map<uint32, NPCQuestFile> &files,
+																const std::vector<QuestSearchEntry> &order, const std::string &quest_dir, const std::string &zone_name) {
+	std::vector<uint32> changed;
+	std::vector<std::string> paths;
+	std::string filename;
+
+	for(auto &iter : files) {
+		const NPCQuestFile &file = iter.second;
+		GetNPCQuestPaths(quest_dir, zone_name, iter.first, file.npc_name, paths);
+
+		filename.clear();
+		size_t count = file.has_name ? paths.size() : 1;
+		for(size_t i = 0; i < count; ++i) {
+			if(FindQuestFile(order, paths[i], filename)) {
+				break;
 			}
 		}
-	} else {
-		std::string filename;
-		QuestInterface *qi = GetQIByNPCQuest(npcid, filename);
-		if(qi) {
-			_npc_quest_status[npcid] = qi->GetIdentifier();
 
-			qi->LoadNPCScript(filename, npcid);
-			if(qi->HasQuestSub(npcid, evt)) {
-				return true;
+		if(QuestFileChanged(file.stamp, filename)) {
+			changed.push_back(iter.first);
+		}
+	}
+
+	return changed;
+}
+
+void QuestParserCollection::ReloadNPCQuest(uint32 npcid) {
+	auto status = _npc_quest_status.find(npcid);
+	auto file = _npc_quest_files.find(npcid);
+	if(status != _npc_quest_status.end() && status->second != QuestFailedToLoad && file != _npc_quest_files.end()) {
+		auto qiter = _interfaces.find(status->second);
+		qiter->second->UnloadNPCScript(file->second.stamp.filename, npcid);
+	}
+
+	if(status != _npc_quest_status.end()) {
+		_npc_quest_status.erase(status);
+	}
+	_npc_sub_masks.erase(npcid);
+
+	LoadNPCQuest(npcid);
+}
+
+/*
+	The global npc and player scripts are few enough to just resolve again on
+	the main thread. Player scripts are only dropped, their next event loads them.
+*/
+uint32 QuestParserCollection::ReloadChangedGlobalQuests() {
+	uint32 reloaded = 0;
+	std::string filename;
+
+	if(_global_npc_quest_status != QuestUnloaded) {
+		filename.clear();
+		GetQIByGlobalNPCQuest(filename);
+		if(QuestFileChanged(_global_npc_quest_file, filename)) {
+			if(_global_npc_quest_status != QuestFailedToLoad) {
+				_interfaces[_global_npc_quest_status]->UnloadGlobalNPCScript(_global_npc_quest_file.filename);
+			}
+			_global_npc_quest_status = QuestUnloaded;
+			_global_npc_sub_mask.reset();
+			LoadGlobalNPCQuest();
+			++reloaded;
+		}
+	}
+
+	if(_player_quest_status != QuestUnloaded && _player_quest_status != QuestFailedToLoad) {
+		filename.clear();
+		GetQIByPlayerQuest(filename);
+		if(QuestFileChanged(_player_quest_file, filename)) {
+			_interfaces[_player_quest_status]->UnloadPlayerScript(_player_quest_file.filename);
+			_player_quest_status = QuestUnloaded;
+			++reloaded;
+		}
+	}
+
+	if(_global_player_quest_status != QuestUnloaded && _global_player_quest_status != QuestFailedToLoad) {
+		filename.clear();
+		GetQIByGlobalPlayerQuest(filename);
+		if(QuestFileChanged(_global_player_quest_file, filename)) {
+			_interfaces[_global_player_quest_status]->UnloadGlobalPlayerScript(_global_player_quest_file.filename);
+			_global_player_quest_status = QuestUnloaded;
+			++reloaded;
+		}
+	}
+
+	return reloaded;
+}
+
+uint32 QuestParserCollection::ApplyChangedQuests(const std::vector<uint32> &npc_ids) {
+	uint32 reloaded = ReloadChangedGlobalQuests();
+	for(auto npcid : npc_ids) {
+		ReloadNPCQuest(npcid);
+		++reloaded;
+	}
+	return reloaded;
+}
+
+/*
+	#reloadqst changed: recompiles only the npc, global npc and player scripts
+	whose file changed into the running interpreters. Items, spells, encounters,
+	plugins and lua modules still need a full reload.
+*/
+uint32 QuestParserCollection::ReloadChangedQuests() {
+	BenchTimer timer;
+
+	CancelWatch();
+	if(!zone) {
+		return 0;
+	}
+
+	auto changed = FindChangedNPCQuests(_npc_quest_files, _search_order, Config->QuestDir, zone->GetShortName());
+	uint32 reloaded = ApplyChangedQuests(changed);
+
+	Log(Logs::General, Logs::Quests, "Incremental quest reload: %u of %u scripts reloaded in %.2f ms", reloaded,
+		static_cast<uint32>(_npc_quest_files.size()), timer.elapsed() * 1000.0);
+	return reloaded;
+}
+
+/*
+	Watch mode, Zone:QuestWatchInterval seconds apart the tracked npc scripts are
+	checked on a worker thread and whatever changed is reloaded here on the
+	main thread, the only part that stalls the zone.
+*/
+void QuestParserCollection::ProcessWatch() {
+	if(_watch_job.valid()) {
+		if(_watch_job.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return;
+		}
+
+		auto changed = _watch_job.get();
+
+		BenchTimer timer;
+		uint32 reloaded = ApplyChangedQuests(changed);
+		if(reloaded > 0) {
+			Log(Logs::General, Logs::Quests, "Quest watch reloaded %u scripts, zone stalled %.2f ms", reloaded, timer.elapsed() * 1000.0);
+		}
+		return;
+	}
+
+	int interval = RuleI(Zone, QuestWatchInterval);
+	if(interval <= 0 || !zone) {
+		_watch_timer.Disable();
+		return;
+	}
+
+	if(!_watch_timer.Enabled()) {
+		_watch_timer.Start(interval * 1000);
+		return;
+	}
+
+	if(!_watch_timer.Check()) {
+		return;
+	}
+	_watch_timer.Start(interval * 1000);
+
+	auto files = _npc_quest_files;
+	auto order = _search_order;
+	std::string quest_dir = Config->QuestDir;
+	std::string zone_name = zone->GetShortName();
+	_watch_job = std::async(std::launch::async, [order, quest_dir, zone_name](std::map<uint32, NPCQuestFile> files) {
+		return FindChangedNPCQuests(files, order, quest_dir, zone_name);
+	}, std::move(files));
+}
+
+void QuestParserCollection::CancelWatch() {
+	if(_watch_job.valid()) {
+		_watch_job.wait();
+		_watch_job = std::future<std::vector<uint32>>();
+	}
+}
+
+/*
+	Resolving a script means probing up to six paths for every registered
+	extension, which a worker thread does for the whole list. Compiling has to
+	stay on the main thread (neither interpreter is thread safe), so finished
+	results are loaded a few per tick by ProcessPreload. Anything an event needs
+	before then is still loaded on demand, preloading just skips those.
+*/
+void QuestParserCollection::PreloadNPCQuests(const std::set<uint32> &npc_ids) {
+	if(!zone) {
+		return;
+	}
+
+	CancelPreload();
+
+	std::vector<NPCQuestPreload> jobs;
+	for(auto npcid : npc_ids) {
+		if(_npc_quest_status.count(npcid) != 0) {
+			continue;
+		}
+
+		NPCQuestPreload job;
+		job.npcid = npcid;
+		job.has_name = GetNPCQuestName(npcid, job.npc_name);
+		job.qi = nullptr;
+		jobs.push_back(job);
+	}
+
+	if(jobs.empty()) {
+		return;
+	}
+
+	Log(Logs::General, Logs::Quests, "Preloading quests for %u npc types", static_cast<uint32>(jobs.size()));
+
+	auto order = _search_order;
+	std::string quest_dir = Config->QuestDir;
+	std::string zone_name = zone->GetShortName();
+	_preload_job = std::async(std::launch::async, [order, quest_dir, zone_name](std::vector<NPCQuestPreload> jobs) {
+		std::vector<std::string> paths;
+		for(auto &job : jobs) {
+			GetNPCQuestPaths(quest_dir, zone_name, job.npcid, job.npc_name, paths);
+
+			// without an npc type only the id named script in the zone directory is looked at, same as GetQIByNPCQuest
+			size_t count = job.has_name ? paths.size() : 1;
+			for(size_t i = 0; i < count && !job.qi; ++i) {
+				job.qi = FindQuestFile(order, paths[i], job.filename);
 			}
+		}
+		return jobs;
+	}, std::move(jobs));
+}
+
+void QuestParserCollection::ProcessPreload() {
+	if(_preload_job.valid()) {
+		if(_preload_job.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return;
+		}
+
+		_preload_queue = _preload_job.get();
+		_preload_pos = 0;
+	}
+
+	if(_preload_pos >= _preload_queue.size()) {
+		return;
+	}
+
+	if(_global_npc_quest_status == QuestUnloaded) {
+		LoadGlobalNPCQuest();
+	}
+
+	int budget = std::max(RuleI(Zone, PreloadQuestsPerTick), 1);
+	while(budget > 0 && _preload_pos < _preload_queue.size()) {
+		NPCQuestPreload &job = _preload_queue[_preload_pos++];
+		if(_npc_quest_status.count(job.npcid) != 0) {
+			continue;
+		}
+
+		NPCQuestFile &file = _npc_quest_files[job.npcid];
+		file.has_name = job.has_name;
+		file.npc_name = job.npc_name;
+		StampQuestFile(job.qi ? job.filename : std::string(), file.stamp);
+
+		if(job.qi) {
+			_npc_quest_status[job.npcid] = job.qi->GetIdentifier();
+			job.qi->LoadNPCScript(job.filename, job.npcid);
+			BuildNPCSubMask(job.qi, job.npcid);
+			--budget;
 		} else {
-			_npc_quest_status[npcid] = QuestFailedToLoad;
+			_npc_quest_status[job.npcid] = QuestFailedToLoad;
+		}
+	}
+
+	if(_preload_pos >= _preload_queue.size()) {
+		Log(Logs::General, Logs::Quests, "Quest preload finished for %u npc types", static_cast<uint32>(_preload_queue.size()));
+		_preload_queue.clear();
+		_preload_pos = 0;
+	}
+}
+
+void QuestParserCollection::CancelPreload() {
+	if(_preload_job.valid()) {
+		_preload_job.wait();
+		_preload_job = std::future<std::vector<NPCQuestPreload>>();
+	}
+
+	_preload_queue.clear();
+	_preload_pos = 0;
+}
+
+bool QuestParserCollection::HasQuestSub(uint32 npcid, QuestEventID evt) {
+	return HasQuestSubLocal(npcid, evt) || HasQuestSubGlobal(evt);
+}
+
+/*
+	Cheap test for callers that have to build event arguments: true if the npc's
+	script, the global npc script or a runtime registered handler would see evt.
+	Scripts are loaded (and their masks built) on first use same as EventNPC does.
+*/
+bool QuestParserCollection::HasAnySub(NPC *npc, QuestEventID evt) {
+	if(!npc || evt >= _LargestEventID) {
+		return false;
+	}
+
+	if(HasQuestSubGlobal(evt) || HasQuestSubLocal(npc->GetNPCTypeID(), evt)) {
+		return true;
+	}
+
+	for(auto qi : _load_precedence) {
+		if(qi->HasNPCDispatchSub(npc->GetNPCTypeID(), evt)) {
+			return true;
 		}
 	}
 	return false;
 }
 
+bool QuestParserCollection::HasQuestSubLocal(uint32 npcid, QuestEventID evt) {
+	if(evt >= _LargestEventID) {
+		return false;
+	}
+
+	auto iter = _npc_sub_masks.find(npcid);
+	if(iter == _npc_sub_masks.end()) {
+		if(_npc_quest_status.count(npcid) != 0) {
+			return false;
+		}
+
+		LoadNPCQuest(npcid);
+		iter = _npc_sub_masks.find(npcid);
+		if(iter == _npc_sub_masks.end()) {
+			return false;
+		}
+	}
+	return iter->second.test(evt);
+}
+
 bool QuestParserCollection::HasQuestSubGlobal(QuestEventID evt) {
+	if(evt >= _LargestEventID) {
+		return false;
+	}
+
 	if(_global_npc_quest_status == QuestUnloaded) {
-		std::string filename;
-		QuestInterface *qi = GetQIByGlobalNPCQuest(filename);
-		if(qi) {
-			qi->LoadGlobalNPCScript(filename);
-			_global_npc_quest_status = qi->GetIdentifier();
-			if(qi->HasGlobalQuestSub(evt)) {
-				return true;
-			}
-		}
+		LoadGlobalNPCQuest();
+	}
+	return _global_npc_sub_mask.test(evt);
+}
+
+/*
+	Loads npcid's script if there is one and records which events it defines.
+	Failed or missing scripts leave no mask behind, so lookups only need one find.
+*/
+void QuestParserCollection::LoadNPCQuest(uint32 npcid) {
+	std::string filename;
+	QuestInterface *qi = GetQIByNPCQuest(npcid, filename);
+
+	NPCQuestFile &file = _npc_quest_files[npcid];
+	file.has_name = GetNPCQuestName(npcid, file.npc_name);
+	StampQuestFile(qi ? filename : std::string(), file.stamp);
+
+	if(qi) {
+		_npc_quest_status[npcid] = qi->GetIdentifier();
+		qi->LoadNPCScript(filename, npcid);
+		BuildNPCSubMask(qi, npcid);
 	} else {
-		if(_global_npc_quest_status != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(_global_npc_quest_status);
-			if(qiter->second->HasGlobalQuestSub(evt)) {
-				return true;
-			}
+		_npc_quest_status[npcid] = QuestFailedToLoad;
+	}
+}
+
+void QuestParserCollection::LoadGlobalNPCQuest() {
+	std::string filename;
+	QuestInterface *qi = GetQIByGlobalNPCQuest(filename);
+	if(qi) {
+		_global_npc_quest_status = qi->GetIdentifier();
+		qi->LoadGlobalNPCScript(filename);
+		StampQuestFile(filename, _global_npc_quest_file);
+		BuildGlobalNPCSubMask(qi);
+	} else {
+		StampQuestFile(std::string(), _global_npc_quest_file);
+		_global_npc_quest_status = QuestFailedToLoad;
+		_global_npc_sub_mask.reset();
+	}
+}
+
+void QuestParserCollection::BuildNPCSubMask(QuestInterface *qi, uint32 npcid) {
+	QuestEventMask mask;
+	for(int i = 0; i < _LargestEventID; ++i) {
+		if(qi->HasQuestSub(npcid, static_cast<QuestEventID>(i))) {
+			mask.set(i);
+		}
+	}
+	_npc_sub_masks[npcid] = mask;
+}
+
+void QuestParserCollection::BuildGlobalNPCSubMask(QuestInterface *qi) {
+	_global_npc_sub_mask.reset();
+	for(int i = 0; i < _LargestEventID; ++i) {
+		if(qi->HasGlobalQuestSub(static_cast<QuestEventID>(i))) {
+			_global_npc_sub_mask.set(i);
 		}
 	}
-	return false;
 }
 
 bool QuestParserCollection::PlayerHasQuestSub(QuestEventID evt) {
@@ -154,6 +559,7 @@ bool QuestParserCollection::PlayerHasQuestSubLocal(QuestEventID evt) {
 		if(qi) {
 			_player_quest_status = qi->GetIdentifier();
 			qi->LoadPlayerScript(filename);
+			StampQuestFile(filename, _player_quest_file);
 			return qi->PlayerHasQuestSub(evt);
 		}
 	} else if(_player_quest_status != QuestFailedToLoad) {
@@ -170,6 +576,7 @@ bool QuestParserCollection::PlayerHasQuestSubGlobal(QuestEventID evt) {
 		if(qi) {
 			_global_player_quest_status = qi->GetIdentifier();
 			qi->LoadGlobalPlayerScript(filename);
+			StampQuestFile(filename, _global_player_quest_file);
 			return qi->GlobalPlayerHasQuestSub(evt);
 		}
 	} else if(_global_player_quest_status != QuestFailedToLoad) {
@@ -237,7 +644,7 @@ bool QuestParserCollection::ItemHasQuestSub(EQEmu::ItemInstance *itm, QuestEvent
 	return false;
 }
 
-int QuestParserCollection::EventNPC(QuestEventID evt, NPC *npc, Mob *init, std::string data, uint32 extra_data,
+int QuestParserCollection::EventNPC(QuestEventID evt, NPC *npc, Mob *init, const std::string &data, uint32 extra_data,
 									std::vector<EQEmu::Any> *extra_pointers) {
 	int rd = DispatchEventNPC(evt, npc, init, data, extra_data, extra_pointers);
 	int rl = EventNPCLocal(evt, npc, init, data, extra_data, extra_pointers);
@@ -255,50 +662,27 @@ int QuestParserCollection::EventNPC(QuestEventID evt, NPC *npc, Mob *init, std::
 	return 0;
 }
 
-int QuestParserCollection::EventNPCLocal(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int QuestParserCollection::EventNPCLocal(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 										 std::vector<EQEmu::Any> *extra_pointers) {
-	auto iter = _npc_quest_status.find(npc->GetNPCTypeID());
-	if(iter != _npc_quest_status.end()) {
-		//loaded or failed to load
-		if(iter->second != QuestFailedToLoad) {
-			auto qiter = _interfaces.find(iter->second);
-			return qiter->second->EventNPC(evt, npc, init, data, extra_data, extra_pointers);
-		}
-	} else if (_npc_quest_status[npc->GetNPCTypeID()] != QuestFailedToLoad){
-		std::string filename;
-		QuestInterface *qi = GetQIByNPCQuest(npc->GetNPCTypeID(), filename);
-		if(qi) {
-			_npc_quest_status[npc->GetNPCTypeID()] = qi->GetIdentifier();
-			qi->LoadNPCScript(filename, npc->GetNPCTypeID());
-			return qi->EventNPC(evt, npc, init, data, extra_data, extra_pointers);
-		} else {
-			_npc_quest_status[npc->GetNPCTypeID()] = QuestFailedToLoad;
-		}
+	if(!HasQuestSubLocal(npc->GetNPCTypeID(), evt)) {
+		return 0;
 	}
-	return 0;
+
+	auto qiter = _interfaces.find(_npc_quest_status[npc->GetNPCTypeID()]);
+	return qiter->second->EventNPC(evt, npc, init, data, extra_data, extra_pointers);
 }
 
-int QuestParserCollection::EventNPCGlobal(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int QuestParserCollection::EventNPCGlobal(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 										  std::vector<EQEmu::Any> *extra_pointers) {
-	if(_global_npc_quest_status != QuestUnloaded && _global_npc_quest_status != QuestFailedToLoad) {
-		auto qiter = _interfaces.find(_global_npc_quest_status);
-		return qiter->second->EventGlobalNPC(evt, npc, init, data, extra_data, extra_pointers);
-	} 
-	else if(_global_npc_quest_status != QuestFailedToLoad){
-		std::string filename;
-		QuestInterface *qi = GetQIByGlobalNPCQuest(filename);
-		if(qi) {
-			_global_npc_quest_status = qi->GetIdentifier();
-			qi->LoadGlobalNPCScript(filename);
-			return qi->EventGlobalNPC(evt, npc, init, data, extra_data, extra_pointers);
-		} else {
-			_global_npc_quest_status = QuestFailedToLoad;
-		}
+	if(!HasQuestSubGlobal(evt)) {
+		return 0;
 	}
-	return 0;
+
+	auto qiter = _interfaces.find(_global_npc_quest_status);
+	return qiter->second->EventGlobalNPC(evt, npc, init, data, extra_data, extra_pointers);
 }
 
-int QuestParserCollection::EventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int QuestParserCollection::EventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 									   std::vector<EQEmu::Any> *extra_pointers) {
 	int rd = DispatchEventPlayer(evt, client, data, extra_data, extra_pointers);
 	int rl = EventPlayerLocal(evt, client, data, extra_data, extra_pointers);
@@ -316,7 +700,7 @@ int QuestParserCollection::EventPlayer(QuestEventID evt, Client *client, std::st
 	return 0;
 }
 
-int QuestParserCollection::EventPlayerLocal(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int QuestParserCollection::EventPlayerLocal(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 											std::vector<EQEmu::Any> *extra_pointers) {
 	if(_player_quest_status == QuestUnloaded) {
 		std::string filename;
@@ -324,6 +708,7 @@ int QuestParserCollection::EventPlayerLocal(QuestEventID evt, Client *client, st
 		if(qi) {
 			_player_quest_status = qi->GetIdentifier();
 			qi->LoadPlayerScript(filename);
+			StampQuestFile(filename, _player_quest_file);
 			return qi->EventPlayer(evt, client, data, extra_data, extra_pointers);
 		}
 	} else { 
@@ -335,7 +720,7 @@ int QuestParserCollection::EventPlayerLocal(QuestEventID evt, Client *client, st
 	return 0;
 }
 
-int QuestParserCollection::EventPlayerGlobal(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int QuestParserCollection::EventPlayerGlobal(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 											 std::vector<EQEmu::Any> *extra_pointers) {
 	if(_global_player_quest_status == QuestUnloaded) {
 		std::string filename;
@@ -343,6 +728,7 @@ int QuestParserCollection::EventPlayerGlobal(QuestEventID evt, Client *client, s
 		if(qi) {
 			_global_player_quest_status = qi->GetIdentifier();
 			qi->LoadGlobalPlayerScript(filename);
+			StampQuestFile(filename, _global_player_quest_file);
 			return qi->EventGlobalPlayer(evt, client, data, extra_data, extra_pointers);
 		}
 	} else { 
@@ -354,7 +740,7 @@ int QuestParserCollection::EventPlayerGlobal(QuestEventID evt, Client *client, s
 	return 0;
 }
 
-int QuestParserCollection::EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+int QuestParserCollection::EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 									 std::vector<EQEmu::Any> *extra_pointers) {
 	// needs pointer validation check on 'item' argument
 	
@@ -439,7 +825,7 @@ int QuestParserCollection::EventSpell(QuestEventID evt, NPC* npc, Client *client
 	return 0;
 }
 
-int QuestParserCollection::EventEncounter(QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
+int QuestParserCollection::EventEncounter(QuestEventID evt, std::string encounter_name, const std::string &data, uint32 extra_data,
 										  std::vector<EQEmu::Any> *extra_pointers) {
 	auto iter = _encounter_quest_status.find(encounter_name);
 	if(iter != _encounter_quest_status.end()) {
@@ -462,154 +848,83 @@ int QuestParserCollection::EventEncounter(QuestEventID evt, std::string encounte
 	return 0;
 }
 
-QuestInterface *QuestParserCollection::GetQIByNPCQuest(uint32 npcid, std::string &filename) {
-	//first look for /quests/zone/npcid.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/";
-	filename += itoa(npcid);
+QuestInterface *QuestParserCollection::FindQuestFile(const std::vector<QuestSearchEntry> &order, const std::string &base,
+													std::string &filename) {
 	std::string tmp;
-	FILE *f = nullptr;
-
-	auto iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
+	for(auto &entry : order) {
+		tmp = base;
 		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
+		tmp += entry.ext;
+		FILE *f = fopen(tmp.c_str(), "r");
 		if(f) {
 			fclose(f);
 			filename = tmp;
-			return (*iter);
+			return entry.qi;
 		}
-
-		++iter;
 	}
+	return nullptr;
+}
 
-	//second look for /quests/zone/npcname.ext (precedence)
-	const NPCType *npc_type = database.LoadNPCTypesData(npcid);
-	if (!npc_type && npcid != ZONE_CONTROLLER_NPC_ID) {
-		return nullptr;
-	}
+/*
+	Every base path an npc script can live at, in the order they are searched:
+	zone/npcid, zone/npcname, global/npcid, global/npcname, zone/default and
+	global/default. Doesn't touch the zone or database so the preload thread can use it.
+*/
+void QuestParserCollection::GetNPCQuestPaths(const std::string &quest_dir, const std::string &zone_name, uint32 npcid,
+											 const std::string &npc_name, std::vector<std::string> &paths) {
+	std::string zone_dir = quest_dir + zone_name + "/";
+	std::string global_dir = quest_dir + QUEST_GLOBAL_DIRECTORY + "/";
+	std::string id = std::to_string(npcid);
+
+	paths.clear();
+	paths.push_back(zone_dir + id);
+	paths.push_back(zone_dir + npc_name);
+	paths.push_back(global_dir + id);
+	paths.push_back(global_dir + npc_name);
+	paths.push_back(zone_dir + "default");
+	paths.push_back(global_dir + "default");
+}
 
-	std::string npc_name;
-	if (npcid == ZONE_CONTROLLER_NPC_ID){
+bool QuestParserCollection::GetNPCQuestName(uint32 npcid, std::string &npc_name) {
+	if (npcid == ZONE_CONTROLLER_NPC_ID) {
 		npc_name = "zone_controller";
-	}
-	else{
-		npc_name = npc_type->name;
-	} 
-	int sz = static_cast<int>(npc_name.length());
-	for(int i = 0; i < sz; ++i) {
-		if(npc_name[i] == '`') {
-			npc_name[i] = '-';
-		}
-	}
-
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/";
-	filename += npc_name;
-
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+		return true;
 	}
 
-	//third look for /quests/global/npcid.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += itoa(npcid);
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	const NPCType *npc_type = database.LoadNPCTypesData(npcid);
+	if (!npc_type) {
+		return false;
 	}
 
-	//fourth look for /quests/global/npcname.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += npc_name;
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
+	npc_name = npc_type->name;
+	std::replace(npc_name.begin(), npc_name.end(), '`', '-');
+	return true;
+}
 
-		++iter;
+QuestInterface *QuestParserCollection::GetQIByNPCQuest(uint32 npcid, std::string &filename) {
+	//first look for /quests/zone/npcid.ext (precedence), this one doesn't need the npc type
+	std::string base = Config->QuestDir;
+	base += zone->GetShortName();
+	base += "/";
+	base += itoa(npcid);
+
+	QuestInterface *qi = FindQuestFile(_search_order, base, filename);
+	if(qi) {
+		return qi;
 	}
 
-	//fifth look for /quests/zone/default.ext (precedence)
-	filename = Config->QuestDir;
-	filename += zone->GetShortName();
-	filename += "/";
-	filename += "default";
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
-		}
-
-		++iter;
+	std::string npc_name;
+	if(!GetNPCQuestName(npcid, npc_name)) {
+		return nullptr;
 	}
 
-	//last look for /quests/global/default.ext (precedence)
-	filename = Config->QuestDir;
-	filename += QUEST_GLOBAL_DIRECTORY;
-	filename += "/";
-	filename += "default";
-	iter = _load_precedence.begin();
-	while(iter != _load_precedence.end()) {
-		tmp = filename;
-		auto ext = _extensions.find((*iter)->GetIdentifier());
-		tmp += ".";
-		tmp += ext->second;
-		f = fopen(tmp.c_str(), "r");
-		if(f) {
-			fclose(f);
-			filename = tmp;
-			return (*iter);
+	std::vector<std::string> paths;
+	GetNPCQuestPaths(Config->QuestDir, zone->GetShortName(), npcid, npc_name, paths);
+	for(size_t i = 1; i < paths.size(); ++i) {
+		qi = FindQuestFile(_search_order, paths[i], filename);
+		if(qi) {
+			return qi;
 		}
-
-		++iter;
 	}
 
 	return nullptr;
@@ -992,7 +1307,7 @@ void QuestParserCollection::GetErrors(std::list<std::string> &err) {
 	}
 }
 
-int QuestParserCollection::DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+int QuestParserCollection::DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 											 std::vector<EQEmu::Any> *extra_pointers) {
     int ret = 0;
 	auto iter = _load_precedence.begin();
@@ -1006,7 +1321,7 @@ int QuestParserCollection::DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *ini
     return ret;
 }
 
-int QuestParserCollection::DispatchEventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+int QuestParserCollection::DispatchEventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 												std::vector<EQEmu::Any> *extra_pointers) {
     int ret = 0;
 	auto iter = _load_precedence.begin();
@@ -1020,7 +1335,7 @@ int QuestParserCollection::DispatchEventPlayer(QuestEventID evt, Client *client,
     return ret;
 }
 
-int QuestParserCollection::DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data,
+int QuestParserCollection::DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data,
 											  uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers) {
     int ret = 0;
 	auto iter = _load_precedence.begin();
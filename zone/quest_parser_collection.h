@@ -20,6 +20,7 @@
 #define _EQE_QUESTPARSERCOLLECTION_H
 
 #include "../common/types.h"
+#include "../common/timer.h"
 
 #include "encounter.h"
 #include "beacon.h"
@@ -36,8 +37,13 @@
 
 #include "zone_config.h"
 
+#include <bitset>
+#include <future>
 #include <list>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 #define QuestFailedToLoad 0xFFFFFFFF
 #define QuestUnloaded 0x00
@@ -65,21 +71,26 @@ public:
 	void AddVar(std::string name, std::string val);
 	void Init();
 	void ReloadQuests(bool reset_timers = true);
+	void PreloadNPCQuests(const std::set<uint32> &npc_ids);
+	void ProcessPreload();
+	uint32 ReloadChangedQuests();
+	void ProcessWatch();
 
 	bool HasQuestSub(uint32 npcid, QuestEventID evt);
+	bool HasAnySub(NPC *npc, QuestEventID evt);
 	bool PlayerHasQuestSub(QuestEventID evt);
 	bool SpellHasQuestSub(uint32 spell_id, QuestEventID evt);
 	bool ItemHasQuestSub(EQEmu::ItemInstance *itm, QuestEventID evt);
 
-	int EventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	int EventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers = nullptr);
-	int EventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	int EventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers = nullptr);
-	int EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+	int EventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers = nullptr);
 	int EventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers = nullptr);
-	int EventEncounter(QuestEventID evt, std::string encounter_name, std::string data, uint32 extra_data,
+	int EventEncounter(QuestEventID evt, std::string encounter_name, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers = nullptr);
 	
 	void GetErrors(std::list<std::string> &err);
@@ -111,10 +122,60 @@ private:
 	bool PlayerHasQuestSubLocal(QuestEventID evt);
 	bool PlayerHasQuestSubGlobal(QuestEventID evt);
 
-	int EventNPCLocal(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers);
-	int EventNPCGlobal(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers);
-	int EventPlayerLocal(QuestEventID evt, Client *client, std::string data, uint32 extra_data,	std::vector<EQEmu::Any> *extra_pointers);
-	int EventPlayerGlobal(QuestEventID evt, Client *client, std::string data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers);
+	int EventNPCLocal(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers);
+	int EventNPCGlobal(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers);
+	int EventPlayerLocal(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,	std::vector<EQEmu::Any> *extra_pointers);
+	int EventPlayerGlobal(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data, std::vector<EQEmu::Any> *extra_pointers);
+
+	typedef std::bitset<_LargestEventID> QuestEventMask;
+
+	struct QuestSearchEntry {
+		QuestInterface *qi;
+		std::string ext;
+	};
+
+	//the file a script was loaded from, empty when none was found
+	struct QuestFileStamp {
+		std::string filename;
+		int64 mtime;
+		int64 size;
+
+		QuestFileStamp() : mtime(0), size(0) { }
+	};
+
+	struct NPCQuestFile {
+		QuestFileStamp stamp;
+		bool has_name;
+		std::string npc_name;
+	};
+
+	struct NPCQuestPreload {
+		uint32 npcid;
+		bool has_name;
+		std::string npc_name;
+		QuestInterface *qi;
+		std::string filename;
+	};
+
+	static QuestInterface *FindQuestFile(const std::vector<QuestSearchEntry> &order, const std::string &base, std::string &filename);
+	static void GetNPCQuestPaths(const std::string &quest_dir, const std::string &zone_name, uint32 npcid,
+		const std::string &npc_name, std::vector<std::string> &paths);
+	bool GetNPCQuestName(uint32 npcid, std::string &npc_name);
+	void CancelPreload();
+
+	static void StampQuestFile(const std::string &filename, QuestFileStamp &stamp);
+	static bool QuestFileChanged(const QuestFileStamp &stamp, const std::string &filename);
+	static std::vector<uint32> FindChangedNPCQuests(const std::map<uint32, NPCQuestFile> &files,
+		const std::vector<QuestSearchEntry> &order, const std::string &quest_dir, const std::string &zone_name);
+	void ReloadNPCQuest(uint32 npcid);
+	uint32 ReloadChangedGlobalQuests();
+	uint32 ApplyChangedQuests(const std::vector<uint32> &npc_ids);
+	void CancelWatch();
+
+	void LoadNPCQuest(uint32 npcid);
+	void LoadGlobalNPCQuest();
+	void BuildNPCSubMask(QuestInterface *qi, uint32 npcid);
+	void BuildGlobalNPCSubMask(QuestInterface *qi);
 
 	QuestInterface *GetQIByNPCQuest(uint32 npcid, std::string &filename);
 	QuestInterface *GetQIByGlobalNPCQuest(std::string &filename);
@@ -124,11 +185,11 @@ private:
 	QuestInterface *GetQIByItemQuest(std::string item_script, std::string &filename);
 	QuestInterface *GetQIByEncounterQuest(std::string encounter_name, std::string &filename);
 	
-	int DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, std::string data, uint32 extra_data,
+	int DispatchEventNPC(QuestEventID evt, NPC* npc, Mob *init, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	int DispatchEventPlayer(QuestEventID evt, Client *client, std::string data, uint32 extra_data,
+	int DispatchEventPlayer(QuestEventID evt, Client *client, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
-	int DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, std::string data, uint32 extra_data,
+	int DispatchEventItem(QuestEventID evt, Client *client, EQEmu::ItemInstance *item, Mob *mob, const std::string &data, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
 	int DispatchEventSpell(QuestEventID evt, NPC* npc, Client *client, uint32 spell_id, uint32 extra_data,
 		std::vector<EQEmu::Any> *extra_pointers);
@@ -136,11 +197,26 @@ private:
 	std::map<uint32, QuestInterface*> _interfaces;
 	std::map<uint32, std::string> _extensions;
 	std::list<QuestInterface*> _load_precedence;
+	std::vector<QuestSearchEntry> _search_order;
+
+	std::future<std::vector<NPCQuestPreload>> _preload_job;
+	std::vector<NPCQuestPreload> _preload_queue;
+	size_t _preload_pos;
+
+	std::map<uint32, NPCQuestFile> _npc_quest_files;
+	QuestFileStamp _global_npc_quest_file;
+	QuestFileStamp _player_quest_file;
+	QuestFileStamp _global_player_quest_file;
+	std::future<std::vector<uint32>> _watch_job;
+	Timer _watch_timer;
 
 	//0x00 = Unloaded
 	//0xFFFFFFFF = Failed to Load
 	std::map<uint32, uint32> _npc_quest_status;
 	uint32 _global_npc_quest_status;
+	//events each loaded npc script (and the global npc script) actually defines, filled in at load time
+	std::unordered_map<uint32, QuestEventMask> _npc_sub_masks;
+	QuestEventMask _global_npc_sub_mask;
 	uint32 _player_quest_status;
 	uint32 _global_player_quest_status;
 	std::map<uint32, uint32> _spell_quest_status;
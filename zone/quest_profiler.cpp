@@ -0,0 +1,128 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "../common/global_define.h"
+#include "../common/eqemu_logsys.h"
+#include "../common/rulesys.h"
+
+#include "quest_profiler.h"
+
+#include <algorithm>
+#include <string.h>
+
+QuestProfiler quest_profiler;
+
+QuestProfiler::QuestProfiler() : calls(0), total_us(0), aborts(0)
+{
+}
+
+int QuestProfiler::Bucket(uint64 elapsed_us)
+{
+	int bucket = 0;
+	while (elapsed_us > 1 && bucket < HistogramBuckets - 1) {
+		elapsed_us >>= 1;
+		++bucket;
+	}
+	return bucket;
+}
+
+// upper bound of the bucket holding the requested fraction of calls
+uint64 QuestProfiler::Percentile(const Entry &e, double fraction)
+{
+	uint64 wanted = static_cast<uint64>(e.calls * fraction);
+	uint64 seen = 0;
+	for (int i = 0; i < HistogramBuckets; ++i) {
+		seen += e.histogram[i];
+		if (seen > wanted)
+			return std::min(static_cast<uint64>(2) << i, e.max_us);
+	}
+	return e.max_us;
+}
+
+// aborted and slow handlers are logged whether or not Zone:QuestProfiling keeps the per script accounting
+void QuestProfiler::Record(const std::string &package, const char *event, uint64 elapsed_us, bool aborted)
+{
+	if (aborted) {
+		Log(Logs::General, Logs::Quests, "Quest %s::%s aborted after %.2f ms, it ran past its execution budget",
+			package.c_str(), event, elapsed_us / 1000.0);
+	} else {
+		int slow_ms = RuleI(Zone, QuestSlowScriptMS);
+		if (slow_ms > 0 && elapsed_us >= static_cast<uint64>(slow_ms) * 1000)
+			Log(Logs::General, Logs::Quests, "Slow quest %s::%s took %.2f ms", package.c_str(), event, elapsed_us / 1000.0);
+	}
+
+	if (!RuleB(Zone, QuestProfiling))
+		return;
+
+	auto &events = packages[package];
+	auto it = events.find(event);
+	if (it == events.end()) {
+		Entry e;
+		memset(&e, 0, sizeof(Entry));
+		it = events.insert(std::make_pair(event, e)).first;
+	}
+
+	Entry &e = it->second;
+	++e.calls;
+	e.total_us += elapsed_us;
+	e.max_us = std::max(e.max_us, elapsed_us);
+	++e.histogram[Bucket(elapsed_us)];
+
+	++calls;
+	total_us += elapsed_us;
+
+	if (aborted) {
+		++e.aborts;
+		++aborts;
+	}
+}
+
+void QuestProfiler::GetTop(size_t count, std::vector<Row> &rows) const
+{
+	rows.clear();
+	for (auto &package : packages) {
+		for (auto &event : package.second) {
+			const Entry &e = event.second;
+			Row row;
+			row.package = package.first;
+			row.event = event.first;
+			row.calls = e.calls;
+			row.total_us = e.total_us;
+			row.max_us = e.max_us;
+			row.p95_us = Percentile(e, 0.95);
+			row.aborts = e.aborts;
+			rows.push_back(row);
+		}
+	}
+
+	auto by_total = [](const Row &a, const Row &b) { return a.total_us > b.total_us; };
+	if (rows.size() > count) {
+		std::partial_sort(rows.begin(), rows.begin() + count, rows.end(), by_total);
+		rows.resize(count);
+	} else {
+		std::sort(rows.begin(), rows.end(), by_total);
+	}
+}
+
+void QuestProfiler::Reset()
+{
+	packages.clear();
+	calls = 0;
+	total_us = 0;
+	aborts = 0;
+}
@@ -0,0 +1,85 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2017 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef QUEST_PROFILER_H
+#define QUEST_PROFILER_H
+
+#include "../common/types.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Wall clock accounting of quest event handlers, keyed by script package and
+ * event name.
+ *
+ * Both parsers report every handler they run here. Aborted and slow handlers
+ * are always logged, the per script accounting is only kept while
+ * Zone:QuestProfiling is on. Times are inclusive, an event fired from inside
+ * another handler is also counted in its caller. The event names are the
+ * parsers' static name tables so an entry is only allocated the first time a
+ * package runs a given event.
+ */
+class QuestProfiler
+{
+public:
+	// log2 microsecond buckets, the last one catches everything past ~8 seconds
+	static const int HistogramBuckets = 24;
+
+	struct Row {
+		std::string package;
+		const char *event;
+		uint64 calls;
+		uint64 total_us;
+		uint64 max_us;
+		uint64 p95_us;
+		uint32 aborts;
+	};
+
+	QuestProfiler();
+
+	void	Record(const std::string &package, const char *event, uint64 elapsed_us, bool aborted = false);
+	void	GetTop(size_t count, std::vector<Row> &rows) const;
+	void	Reset();
+
+	inline uint64 GetCalls() const { return calls; }
+	inline uint64 GetTotalTime() const { return total_us; }
+	inline uint32 GetAborts() const { return aborts; }
+
+private:
+	struct Entry {
+		uint64 calls;
+		uint64 total_us;
+		uint64 max_us;
+		uint32 aborts;
+		uint32 histogram[HistogramBuckets];
+	};
+
+	static int Bucket(uint64 elapsed_us);
+	static uint64 Percentile(const Entry &e, double fraction);
+
+	std::unordered_map<std::string, std::map<const char *, Entry>> packages;
+	uint64 calls;
+	uint64 total_us;
+	uint32 aborts;
+};
+
+extern QuestProfiler quest_profiler;
+
+#endif /* QUEST_PROFILER_H */
@@ -36,6 +36,7 @@
 #include "zone.h"
 #include "zonedb.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits.h>
 #include <list>
@@ -71,49 +72,188 @@ QuestManager quest_manager;
 QuestManager::QuestManager() {
 	HaveProximitySays = false;
 	item_timers = 0;
+	next_timer_handle = 0;
+	next_timer_seq = 0;
+	timer_clock = 0;
+	timer_clock_last = Timer::GetCurrentTime();
+	ResetTimerStats();
 }
 
 QuestManager::~QuestManager() {
 }
 
-void QuestManager::Process() {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->Timer_.Enabled() && cur->Timer_.Check()) {
-			if(entity_list.IsMobInZone(cur->mob)) {
-				if(cur->mob->IsNPC()) {
-					parse->EventNPC(EVENT_TIMER, cur->mob->CastToNPC(), nullptr, cur->name, 0);
-				} else if (cur->mob->IsEncounter()) {
-					parse->EventEncounter(EVENT_TIMER, cur->mob->CastToEncounter()->GetEncounterName(), cur->name, 0, nullptr);
-				} else {
-					//this is inheriently unsafe if we ever make it so more than npc/client start timers
-					parse->EventPlayer(EVENT_TIMER, cur->mob->CastToClient(), cur->name, 0);
-				}
+// Timer::GetCurrentTime wraps, deadlines are kept on a 64 bit clock built from its deltas
+uint64 QuestManager::TimerClock() {
+	uint32 now = Timer::GetCurrentTime();
+	timer_clock += static_cast<uint32>(now - timer_clock_last);
+	timer_clock_last = now;
+	return timer_clock;
+}
 
-				//we MUST reset our iterator since the quest could have removed/added any
-				//number of timers... worst case we have to check a bunch of timers twice
-				cur = QTimerList.begin();
-				end = QTimerList.end();	//dunno if this is needed, cant hurt...
-			} else {
-				cur = QTimerList.erase(cur);
-			}
-		} else
-			++cur;
+void QuestManager::ArmQuestTimer(uint32 handle, QuestTimer &t) {
+	TimerDeadline d;
+	// Timer::Check fires once strictly more than timer_time has passed
+	d.deadline = TimerClock() + t.Timer_.GetRemainingTime() + 1;
+	d.seq = t.seq;
+	d.handle = handle;
+	d.generation = ++t.generation;
+	quest_timer_heap.push(d);
+
+	// re-arming leaves the old entries behind until they surface, rebuild if they start to dominate
+	if (quest_timer_heap.size() > quest_timers.size() * 2 + 64) {
+		std::vector<TimerDeadline> entries;
+		entries.reserve(quest_timers.size());
+		while (!quest_timer_heap.empty()) {
+			const TimerDeadline &top = quest_timer_heap.top();
+			auto iter = quest_timers.find(top.handle);
+			if (iter != quest_timers.end() && iter->second.generation == top.generation)
+				entries.push_back(top);
+			quest_timer_heap.pop();
+		}
+
+		for (auto &e : entries)
+			quest_timer_heap.push(e);
 	}
+}
 
-	auto cur_iter = STimerList.begin();
-	while(cur_iter != STimerList.end()) {
-		if(!cur_iter->Timer_.Enabled()) {
-			cur_iter = STimerList.erase(cur_iter);
-		} else if(cur_iter->Timer_.Check()) {
-			entity_list.SignalMobsByNPCID(cur_iter->npc_id, cur_iter->signal_id);
-			cur_iter = STimerList.erase(cur_iter);
+void QuestManager::StartQuestTimer(Mob *mob, const std::string &name, int milliseconds) {
+	// timers without an owner could never fire
+	if (!mob)
+		return;
+
+	auto &timers = quest_timer_index[mob];
+	auto existing = timers.find(name);
+	if (existing != timers.end()) {
+		auto iter = quest_timers.find(existing->second);
+		if (iter != quest_timers.end()) {
+			iter->second.Timer_.Enable();
+			iter->second.Timer_.Start(milliseconds, false);
+			ArmQuestTimer(existing->second, iter->second);
+			return;
+		}
+	}
+
+	uint32 handle = ++next_timer_handle;
+	auto iter = quest_timers.insert(std::make_pair(handle, QuestTimer(milliseconds, mob, name, next_timer_seq++))).first;
+	timers[name] = handle;
+	ArmQuestTimer(handle, iter->second);
+}
+
+void QuestManager::EraseQuestTimer(uint32 handle) {
+	auto iter = quest_timers.find(handle);
+	if (iter == quest_timers.end())
+		return;
+
+	auto index = quest_timer_index.find(iter->second.mob);
+	if (index != quest_timer_index.end()) {
+		index->second.erase(iter->second.name);
+		if (index->second.empty())
+			quest_timer_index.erase(index);
+	}
+
+	quest_timers.erase(iter);
+}
+
+void QuestManager::StopQuestTimer(Mob *mob, const std::string &name) {
+	if (!mob)
+		return;
+
+	auto index = quest_timer_index.find(mob);
+	if (index == quest_timer_index.end())
+		return;
+
+	auto timer = index->second.find(name);
+	if (timer != index->second.end())
+		EraseQuestTimer(timer->second);
+}
+
+void QuestManager::StopQuestTimers(Mob *mob) {
+	if (!mob)
+		return;
+
+	auto index = quest_timer_index.find(mob);
+	if (index == quest_timer_index.end())
+		return;
+
+	for (auto &timer : index->second)
+		quest_timers.erase(timer.second);
+
+	quest_timer_index.erase(index);
+}
+
+void QuestManager::ResetTimerStats() {
+	last_timers_fired = 0;
+	last_signals_fired = 0;
+	max_timers_fired = 0;
+	total_timers_fired = 0;
+	total_signals_fired = 0;
+}
+
+void QuestManager::Process() {
+	uint64 now = TimerClock();
+
+	due_timers.clear();
+	while (!quest_timer_heap.empty() && quest_timer_heap.top().deadline <= now) {
+		const TimerDeadline &top = quest_timer_heap.top();
+		auto iter = quest_timers.find(top.handle);
+		if (iter != quest_timers.end() && iter->second.generation == top.generation)
+			due_timers.push_back(top);
+		quest_timer_heap.pop();
+	}
+	std::sort(due_timers.begin(), due_timers.end());
+
+	last_timers_fired = 0;
+	for (auto &due : due_timers) {
+		// an earlier timer's quest may have stopped or restarted this one
+		auto iter = quest_timers.find(due.handle);
+		if (iter == quest_timers.end() || iter->second.generation != due.generation)
+			continue;
+
+		QuestTimer &cur = iter->second;
+		if (!cur.Timer_.Enabled() || !cur.Timer_.Check()) {
+			ArmQuestTimer(due.handle, cur);
+			continue;
+		}
+
+		if (!entity_list.IsMobInZone(cur.mob)) {
+			EraseQuestTimer(due.handle);
+			continue;
+		}
+
+		// re-arm before firing, the quest is free to stop or restart it
+		ArmQuestTimer(due.handle, cur);
+
+		Mob *mob = cur.mob;
+		std::string name = cur.name;
+		++last_timers_fired;
+		if(mob->IsNPC()) {
+			parse->EventNPC(EVENT_TIMER, mob->CastToNPC(), nullptr, name, 0);
+		} else if (mob->IsEncounter()) {
+			parse->EventEncounter(EVENT_TIMER, mob->CastToEncounter()->GetEncounterName(), name, 0, nullptr);
 		} else {
-			++cur_iter;
+			//this is inheriently unsafe if we ever make it so more than npc/client start timers
+			parse->EventPlayer(EVENT_TIMER, mob->CastToClient(), name, 0);
 		}
 	}
+
+	due_signals.clear();
+	while (!signal_timer_heap.empty() && signal_timer_heap.top().deadline <= now) {
+		due_signals.push_back(signal_timer_heap.top());
+		signal_timer_heap.pop();
+	}
+	std::sort(due_signals.begin(), due_signals.end());
+
+	for (auto &due : due_signals)
+		entity_list.SignalMobsByNPCID(due.npc_id, due.signal_id);
+
+	last_signals_fired = static_cast<uint32>(due_signals.size());
+	max_timers_fired = std::max(max_timers_fired, last_timers_fired + last_signals_fired);
+	total_timers_fired += last_timers_fired;
+	total_signals_fired += last_signals_fired;
+
+	if (last_timers_fired || last_signals_fired)
+		Log(Logs::Detail, Logs::Quests, "Quest timers fired (%u) signals fired (%u) active timers (%u) pending signals (%u)",
+			last_timers_fired, last_signals_fired, (uint32)quest_timers.size(), (uint32)signal_timer_heap.size());
 }
 
 void QuestManager::StartQuest(Mob *_owner, Client *_initiator, EQEmu::ItemInstance* _questitem, std::string encounter) {
@@ -130,22 +270,16 @@ void QuestManager::EndQuest() {
 	running_quest run = quests_running_.top();
 	if(run.depop_npc && run.owner->IsNPC()) {
 		//clear out any timers for them...
-		std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-		end = QTimerList.end();
-		while (cur != end) {
-			if (cur->mob == run.owner)
-				cur = QTimerList.erase(cur);
-			else
-				++cur;
-		}
+		StopQuestTimers(run.owner);
 		run.owner->Depop();
 	}
 	quests_running_.pop();
 }
 
 void QuestManager::ClearAllTimers() {
-	QTimerList.clear();
+	quest_timers.clear();
+	quest_timer_index.clear();
+	quest_timer_heap = std::priority_queue<TimerDeadline, std::vector<TimerDeadline>, std::greater<TimerDeadline>>();
 }
 
 //quest perl functions
@@ -410,20 +544,7 @@ void QuestManager::settimer(const char *timer_name, int seconds) {
 		return;
 	}
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if(cur->mob && cur->mob == owner && cur->name == timer_name)
-		{
-			cur->Timer_.Enable();
-			cur->Timer_.Start(seconds * 1000, false);
-			return;
-		}
-		++cur;
-	}
-
-	QTimerList.push_back(QuestTimer(seconds * 1000, owner, timer_name));
+	StartQuestTimer(owner, timer_name, seconds * 1000);
 }
 
 void QuestManager::settimerMS(const char *timer_name, int milliseconds) {
@@ -434,20 +555,7 @@ void QuestManager::settimerMS(const char *timer_name, int milliseconds) {
 		return;
 	}
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if(cur->mob && cur->mob == owner && cur->name == timer_name)
-		{
-			cur->Timer_.Enable();
-			cur->Timer_.Start(milliseconds, false);
-			return;
-		}
-		++cur;
-	}
-
-	QTimerList.push_back(QuestTimer(milliseconds, owner, timer_name));
+	StartQuestTimer(owner, timer_name, milliseconds);
 }
 
 void QuestManager::settimerMS(const char *timer_name, int milliseconds, EQEmu::ItemInstance *inst) {
@@ -457,20 +565,7 @@ void QuestManager::settimerMS(const char *timer_name, int milliseconds, EQEmu::I
 }
 
 void QuestManager::settimerMS(const char *timer_name, int milliseconds, Mob *mob) {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->mob && cur->mob == mob && cur->name == timer_name)
-		{
-			cur->Timer_.Enable();
-			cur->Timer_.Start(milliseconds, false);
-			return;
-		}
-		++cur;
-	}
-
-	QTimerList.push_back(QuestTimer(milliseconds, mob, timer_name));
+	StartQuestTimer(mob, timer_name, milliseconds);
 }
 
 void QuestManager::stoptimer(const char *timer_name) {
@@ -481,16 +576,7 @@ void QuestManager::stoptimer(const char *timer_name) {
 		return;
 	}
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->mob && cur->mob == owner && cur->name == timer_name) {
-			QTimerList.erase(cur);
-			return;
-		}
-		++cur;
-	}
+	StopQuestTimer(owner, timer_name);
 }
 
 void QuestManager::stoptimer(const char *timer_name, EQEmu::ItemInstance *inst) {
@@ -500,16 +586,7 @@ void QuestManager::stoptimer(const char *timer_name, EQEmu::ItemInstance *inst)
 }
 
 void QuestManager::stoptimer(const char *timer_name, Mob *mob) {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->mob && cur->mob == mob && cur->name == timer_name) {
-			QTimerList.erase(cur);
-			return;
-		}
-		++cur;
-	}
+	StopQuestTimer(mob, timer_name);
 }
 
 void QuestManager::stopalltimers() {
@@ -520,15 +597,7 @@ void QuestManager::stopalltimers() {
 		return;
 	}
 
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end, tmp;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if(cur->mob && cur->mob == owner)
-			cur = QTimerList.erase(cur);
-		else
-			++cur;
-	}
+	StopQuestTimers(owner);
 }
 
 void QuestManager::stopalltimers(EQEmu::ItemInstance *inst) {
@@ -538,15 +607,7 @@ void QuestManager::stopalltimers(EQEmu::ItemInstance *inst) {
 }
 
 void QuestManager::stopalltimers(Mob *mob) {
-	std::list<QuestTimer>::iterator cur = QTimerList.begin(), end, tmp;
-
-	end = QTimerList.end();
-	while (cur != end) {
-		if (cur->mob && cur->mob == mob)
-			cur = QTimerList.erase(cur);
-		else
-			++cur;
-	}
+	StopQuestTimers(mob);
 }
 
 void QuestManager::emote(const char *str) {
@@ -1320,13 +1381,12 @@ void QuestManager::itemlink(int item_id) {
 }
 
 void QuestManager::signalwith(int npc_id, int signal_id, int wait_ms) {
-	if(wait_ms > 0) {
-		STimerList.push_back(SignalTimer(wait_ms, npc_id, signal_id));
-		return;
-	} else {
-		STimerList.push_back(SignalTimer(0, npc_id, signal_id));
-		return;
-	}
+	SignalTimer t;
+	t.deadline = TimerClock() + static_cast<uint32>(std::max(wait_ms, 0)) + 1;
+	t.seq = next_timer_seq++;
+	t.npc_id = npc_id;
+	t.signal_id = signal_id;
+	signal_timer_heap.push(t);
 }
 
 void QuestManager::signal(int npc_id, int wait_ms) {
@@ -22,7 +22,11 @@
 #include "tasks.h"
 
 #include <list>
+#include <queue>
 #include <stack>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class Client;
 class Mob;
@@ -54,6 +58,15 @@ public:
 	void ClearTimers(Mob *who);
 	void ClearAllTimers();
 
+	inline size_t GetQuestTimerCount() const { return quest_timers.size(); }
+	inline size_t GetSignalTimerCount() const { return signal_timer_heap.size(); }
+	inline uint32 GetLastTimersFired() const { return last_timers_fired; }
+	inline uint32 GetLastSignalsFired() const { return last_signals_fired; }
+	inline uint32 GetMaxTimersFired() const { return max_timers_fired; }
+	inline uint64 GetTotalTimersFired() const { return total_timers_fired; }
+	inline uint64 GetTotalSignalsFired() const { return total_signals_fired; }
+	void ResetTimerStats();
+
 	//quest functions
 	void echo(int colour, const char *str);
 	void say(const char *str);
@@ -287,23 +300,65 @@ private:
 	int QGVarDuration(const char *fmt);
 	int InsertQuestGlobal(int charid, int npcid, int zoneid, const char *name, const char *value, int expdate);
 
+	/*
+	 * Quest and signal timers sit on deadline ordered heaps so Process only
+	 * touches timers that are due. Timers keep a stable handle for their whole
+	 * life (settimer on an existing timer re-arms the same handle) and heap
+	 * entries from an older arming are skipped by generation. Everything that
+	 * comes due in one tick fires in creation order, like the old list walk.
+	 */
 	class QuestTimer {
 	public:
-		inline QuestTimer(int duration, Mob *_mob, std::string _name)
-			: mob(_mob), name(_name), Timer_(duration) { Timer_.Start(duration, false); }
+		inline QuestTimer(int duration, Mob *_mob, std::string _name, uint64 _seq)
+			: mob(_mob), name(_name), Timer_(duration), seq(_seq), generation(0) { Timer_.Start(duration, false); }
 		Mob*   mob;
 		std::string name;
 		Timer Timer_;
+		uint64 seq;
+		uint32 generation;
 	};
-	class SignalTimer {
-	public:
-		inline SignalTimer(int duration, int _npc_id, int _signal_id) : npc_id(_npc_id), signal_id(_signal_id), Timer_(duration) { Timer_.Start(duration, false); }
+	struct TimerDeadline {
+		uint64 deadline;
+		uint64 seq;
+		uint32 handle;
+		uint32 generation;
+
+		bool operator>(const TimerDeadline &o) const { return deadline > o.deadline || (deadline == o.deadline && seq > o.seq); }
+		bool operator<(const TimerDeadline &o) const { return seq < o.seq; }
+	};
+	struct SignalTimer {
+		uint64 deadline;
+		uint64 seq;
 		int npc_id;
 		int signal_id;
-		Timer Timer_;
+
+		bool operator>(const SignalTimer &o) const { return deadline > o.deadline || (deadline == o.deadline && seq > o.seq); }
+		bool operator<(const SignalTimer &o) const { return seq < o.seq; }
 	};
-	std::list<QuestTimer>	QTimerList;
-	std::list<SignalTimer>	STimerList;
+
+	uint64 TimerClock();
+	void StartQuestTimer(Mob *mob, const std::string &name, int milliseconds);
+	void ArmQuestTimer(uint32 handle, QuestTimer &t);
+	void EraseQuestTimer(uint32 handle);
+	void StopQuestTimer(Mob *mob, const std::string &name);
+	void StopQuestTimers(Mob *mob);
+
+	std::unordered_map<uint32, QuestTimer> quest_timers;
+	std::unordered_map<Mob*, std::unordered_map<std::string, uint32>> quest_timer_index;
+	std::priority_queue<TimerDeadline, std::vector<TimerDeadline>, std::greater<TimerDeadline>> quest_timer_heap;
+	std::priority_queue<SignalTimer, std::vector<SignalTimer>, std::greater<SignalTimer>> signal_timer_heap;
+	std::vector<TimerDeadline> due_timers;
+	std::vector<SignalTimer> due_signals;
+	uint32 next_timer_handle;
+	uint64 next_timer_seq;
+	uint64 timer_clock;
+	uint32 timer_clock_last;
+
+	uint32 last_timers_fired;
+	uint32 last_signals_fired;
+	uint32 max_timers_fired;
+	uint64 total_timers_fired;
+	uint64 total_signals_fired;
 	size_t item_timers;
 
 };
@@ -108,6 +108,11 @@ SpawnGroup::~SpawnGroup() {
 	list_.clear();
 }
 
+void SpawnGroup::GetNPCTypes(std::set<uint32> &npc_types) const {
+	for (auto entry : list_)
+		npc_types.insert(entry->NPCType);
+}
+
 SpawnGroupList::~SpawnGroupList() {
 	std::map<uint32, SpawnGroup*>::iterator cur,end;
 	cur = groups.begin();
@@ -139,6 +144,11 @@ bool SpawnGroupList::RemoveSpawnGroup(uint32 in_id) {
 	return(true);
 }
 
+void SpawnGroupList::GetNPCTypes(std::set<uint32> &npc_types) const {
+	for (auto &group : groups)
+		group.second->GetNPCTypes(npc_types);
+}
+
 bool ZoneDatabase::LoadSpawnGroups(const char *zone_name, uint16 version, SpawnGroupList *spawn_group_list)
 {
 	std::string query = StringFormat("SELECT DISTINCT(spawngroupID), spawngroup.name, spawngroup.spawn_limit, "
@@ -22,6 +22,7 @@
 
 #include <map>
 #include <list>
+#include <set>
 
 class SpawnEntry
 {
@@ -42,6 +43,7 @@ public:
 	~SpawnGroup();
 	uint32 GetNPCType();
 	void AddSpawnEntry( SpawnEntry* newEntry );
+	void GetNPCTypes(std::set<uint32> &npc_types) const;
 	uint32 id;
 	float roamdist;
 	float roambox[4];
@@ -64,6 +66,7 @@ public:
 	void AddSpawnGroup(SpawnGroup* newGroup);
 	SpawnGroup* GetSpawnGroup(uint32 id);
 	bool RemoveSpawnGroup(uint32 in_id);
+	void GetNPCTypes(std::set<uint32> &npc_types) const;
 private:
 	//LinkedList<SpawnGroup*> list_;
 	std::map<uint32, SpawnGroup*> groups;
@@ -296,7 +296,7 @@ bool Mob::CastSpell(uint16 spell_id, uint16 target_id, CastingSlot slot,
 		char temp[64];
 		sprintf(temp, "%d", spell_id);
 		parse->EventPlayer(EVENT_CAST_BEGIN, CastToClient(), temp, 0);
-	} else if(IsNPC()) {
+	} else if(IsNPC() && parse->HasAnySub(CastToNPC(), EVENT_CAST_BEGIN)) {
 		char temp[64];
 		sprintf(temp, "%d", spell_id);
 		parse->EventNPC(EVENT_CAST_BEGIN, CastToNPC(), nullptr, temp, 0);
@@ -1378,7 +1378,7 @@ void Mob::CastedSpellFinished(uint16 spell_id, uint32 target_id, CastingSlot slo
 		char temp[64];
 		sprintf(temp, "%d", spell_id);
 		parse->EventPlayer(EVENT_CAST, CastToClient(), temp, 0);
-	} else if(IsNPC()) {
+	} else if(IsNPC() && parse->HasAnySub(CastToNPC(), EVENT_CAST)) {
 		char temp[64];
 		sprintf(temp, "%d", spell_id);
 		parse->EventNPC(EVENT_CAST, CastToNPC(), nullptr, temp, 0);
@@ -3547,9 +3547,11 @@ bool Mob::SpellOnTarget(uint16 spell_id, Mob *spelltar, bool reflect, bool use_r
 	/* Send the EVENT_CAST_ON event */
 	if(spelltar->IsNPC())
 	{
-		char temp1[100];
-		sprintf(temp1, "%d", spell_id);
-		parse->EventNPC(EVENT_CAST_ON, spelltar->CastToNPC(), this, temp1, 0);
+		if (parse->HasAnySub(spelltar->CastToNPC(), EVENT_CAST_ON)) {
+			char temp1[100];
+			sprintf(temp1, "%d", spell_id);
+			parse->EventNPC(EVENT_CAST_ON, spelltar->CastToNPC(), this, temp1, 0);
+		}
 	}
 	else if (spelltar->IsClient())
 	{
@@ -951,7 +951,7 @@ void Client::FinishTrade(Mob* tradingWith, bool finalizer, void* event_entry, st
 		EQEmu::ItemInstance *insts[4] = { 0 };
 		for (int i = EQEmu::legacy::TRADE_BEGIN; i <= EQEmu::legacy::TRADE_NPC_END; ++i) {
 			insts[i - EQEmu::legacy::TRADE_BEGIN] = m_inv.PopItem(i);
-			database.SaveInventory(CharacterID(), nullptr, i);
+			SaveInventorySlot(nullptr, i);
 		}
 
 		parse->EventNPC(EVENT_TRADE, tradingWith->CastToNPC(), this, "", 0, &item_list);
@@ -1387,7 +1387,7 @@ void Client::NukeTraderItem(uint16 Slot,int16 Charges,uint16 Quantity,Client* Cu
 	//
 	const EQEmu::ItemInstance* Inst = m_inv[Slot];
 
-	database.SaveInventory(CharacterID(), Inst, Slot);
+	SaveInventorySlot(Inst, Slot);
 
 	EQApplicationPacket* outapp2;
 
@@ -2629,7 +2629,7 @@ void Client::SellToBuyer(const EQApplicationPacket *app) {
 				return;
 			}
 
-			database.SaveInventory(CharacterID(), 0, SellerSlot);
+			SaveInventorySlot(0, SellerSlot);
 
 			safe_delete(ItemToTransfer);
 
@@ -2684,7 +2684,7 @@ void Client::SellToBuyer(const EQApplicationPacket *app) {
 					return;
 				}
 				// Delete the entire stack from the seller's inventory
-				database.SaveInventory(CharacterID(), 0, SellerSlot);
+				SaveInventorySlot(0, SellerSlot);
 
 				safe_delete(ItemToTransfer);
 
@@ -2708,7 +2708,7 @@ void Client::SellToBuyer(const EQApplicationPacket *app) {
 
 				m_inv.PutItem(SellerSlot, *ItemToTransfer);
 
-				database.SaveInventory(CharacterID(), ItemToTransfer, SellerSlot);
+				SaveInventorySlot(ItemToTransfer, SellerSlot);
 
 				ItemToTransfer->SetCharges(QuantityToRemoveFromStack);
 
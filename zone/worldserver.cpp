@@ -70,6 +70,8 @@ WorldServer::WorldServer()
 	cur_groupid = 0;
 	last_groupid = 0;
 	oocmuted = false;
+	shared_mem_generation = 0;
+	pending_shared_mem_generation = 0;
 }
 
 WorldServer::~WorldServer() {
@@ -1888,45 +1890,71 @@ void WorldServer::HandleMessage(uint16 opcode, const EQ::Net::Packet &p)
 		break;
 	}
 
-	case ServerOP_ChangeSharedMem:
+	case ServerOP_SharedMemGeneration:
 	{
-		std::string hotfix_name = std::string((char*)pack->pBuffer);
-		Log(Logs::General, Logs::Zone_Server, "Loading items");
-		if (!database.LoadItems(hotfix_name)) {
-			Log(Logs::General, Logs::Error, "Loading items FAILED!");
+		// remapping here could pull shared memory data out from under whatever is running, wait for the tick
+		auto gen = (ServerSharedMemGeneration_Struct*)pack->pBuffer;
+		if (gen->generation != shared_mem_generation) {
+			pending_shared_mem_generation = gen->generation;
+			pending_shared_mem_prefix = std::string(gen->prefix, strnlen(gen->prefix, sizeof(gen->prefix)));
 		}
+		break;
+	}
+	default: {
+		std::cout << " Unknown ZSopcode:" << (int)pack->opcode;
+		std::cout << " size:" << pack->size << std::endl;
+		break;
+	}
+	}
+}
 
-		Log(Logs::General, Logs::Zone_Server, "Loading npc faction lists");
-		if (!database.LoadNPCFactionLists(hotfix_name)) {
-			Log(Logs::General, Logs::Error, "Loading npcs faction lists FAILED!");
-		}
+void WorldServer::ProcessSharedMemGeneration()
+{
+	if (pending_shared_mem_generation == 0 || pending_shared_mem_generation == shared_mem_generation)
+		return;
 
-		Log(Logs::General, Logs::Zone_Server, "Loading loot tables");
-		if (!database.LoadLoot(hotfix_name)) {
-			Log(Logs::General, Logs::Error, "Loading loot FAILED!");
-		}
+	std::string prefix = pending_shared_mem_prefix;
+	shared_mem_generation = pending_shared_mem_generation;
+	Log(Logs::General, Logs::Zone_Server, "Switching to shared memory generation %u ('%s')", shared_mem_generation, prefix.c_str());
 
-		Log(Logs::General, Logs::Zone_Server, "Loading skill caps");
-		if (!database.LoadSkillCaps(std::string(hotfix_name))) {
-			Log(Logs::General, Logs::Error, "Loading skill caps FAILED!");
-		}
+	Log(Logs::General, Logs::Zone_Server, "Loading items");
+	if (!database.LoadItems(prefix)) {
+		Log(Logs::General, Logs::Error, "Loading items FAILED!");
+	}
 
-		Log(Logs::General, Logs::Zone_Server, "Loading spells");
-		if (!database.LoadSpells(hotfix_name, &SPDAT_RECORDS, &spells)) {
-			Log(Logs::General, Logs::Error, "Loading spells FAILED!");
-		}
+	Log(Logs::General, Logs::Zone_Server, "Loading npc faction lists");
+	if (!database.LoadNPCFactionLists(prefix)) {
+		Log(Logs::General, Logs::Error, "Loading npcs faction lists FAILED!");
+	}
 
-		Log(Logs::General, Logs::Zone_Server, "Loading base data");
-		if (!database.LoadBaseData(hotfix_name)) {
-			Log(Logs::General, Logs::Error, "Loading base data FAILED!");
+	if (RuleB(Zone, SharedNPCTypes)) {
+		Log(Logs::General, Logs::Zone_Server, "Loading npc types");
+		if (!database.LoadNPCTypes(prefix)) {
+			Log(Logs::General, Logs::Error, "Loading npc types FAILED!");
+		}
+		else if (zone) {
+			zone->ResetNPCTypeCache();
 		}
-		break;
 	}
-	default: {
-		std::cout << " Unknown ZSopcode:" << (int)pack->opcode;
-		std::cout << " size:" << pack->size << std::endl;
-		break;
+
+	Log(Logs::General, Logs::Zone_Server, "Loading loot tables");
+	if (!database.LoadLoot(prefix)) {
+		Log(Logs::General, Logs::Error, "Loading loot FAILED!");
+	}
+
+	Log(Logs::General, Logs::Zone_Server, "Loading skill caps");
+	if (!database.LoadSkillCaps(std::string(prefix))) {
+		Log(Logs::General, Logs::Error, "Loading skill caps FAILED!");
 	}
+
+	Log(Logs::General, Logs::Zone_Server, "Loading spells");
+	if (!database.LoadSpells(prefix, &SPDAT_RECORDS, &spells)) {
+		Log(Logs::General, Logs::Error, "Loading spells FAILED!");
+	}
+
+	Log(Logs::General, Logs::Zone_Server, "Loading base data");
+	if (!database.LoadBaseData(prefix)) {
+		Log(Logs::General, Logs::Error, "Loading base data FAILED!");
 	}
 }
 
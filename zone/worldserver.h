@@ -61,6 +61,9 @@ public:
 
 	void RequestTellQueue(const char *who);
 
+	// switches to the shared memory generation world last announced, called at the top of a tick
+	void ProcessSharedMemGeneration();
+
 private:
 	virtual void OnConnected();
 
@@ -72,6 +75,10 @@ private:
 	uint32 cur_groupid;
 	uint32 last_groupid;
 
+	uint32 shared_mem_generation;
+	uint32 pending_shared_mem_generation;
+	std::string pending_shared_mem_prefix;
+
 	std::unique_ptr<EQ::Net::ServertalkClient> m_connection;
 };
 #endif
@@ -684,6 +684,10 @@ void Zone::Shutdown(bool quite)
 		zone->npctable.erase(itr);
 	}
 
+	for (auto npc_type : zone->retired_npctypes)
+		delete npc_type;
+	zone->retired_npctypes.clear();
+
 	while(!zone->merctable.empty()) {
 		itr=zone->merctable.begin();
 		delete itr->second;
@@ -752,6 +756,7 @@ Zone::Zone(uint32 in_zoneid, uint32 in_instanceid, const char* in_short_name)
 	clientauth_timer(AUTHENTICATION_TIMEOUT * 1000),
 	spawn2_timer(1000),
 	qglobal_purge_timer(30000),
+	los_cache_purge_timer(10000),
 	hotzone_timer(120000),
 	m_SafePoint(0.0f,0.0f,0.0f),
 	m_Graveyard(0.0f,0.0f,0.0f,0.0f)
@@ -765,6 +770,7 @@ Zone::Zone(uint32 in_zoneid, uint32 in_instanceid, const char* in_short_name)
 	pathing = nullptr;
 	qGlobals = nullptr;
 	default_ruleset = 0;
+	all_npctypes_from_db = false;
 
 	is_zone_time_localized = false;
 
@@ -993,6 +999,21 @@ bool Zone::Init(bool iStaticZone) {
 
 	LoadTickItems();
 
+	if (!npctypes_bulk_skipped.empty()) {
+		uint32 skipped, built;
+		int64 saved = GetSharedNPCTypeSavings(skipped, built);
+		Log(Logs::General, Logs::Status, "Shared npc types: skipped the bulk load of %u types, %u built from the table so far, %d KB saved",
+			skipped, built, static_cast<int>(saved / 1024));
+	}
+
+	if (RuleB(Zone, PreloadQuests)) {
+		std::set<uint32> npc_types;
+		spawn_group_list.GetNPCTypes(npc_types);
+		if (RuleB(Zone, UseZoneController))
+			npc_types.insert(ZONE_CONTROLLER_NPC_ID);
+		parse->PreloadNPCQuests(npc_types);
+	}
+
 	//MODDING HOOK FOR ZONE INIT
 	mod_init();
 
@@ -1271,6 +1292,9 @@ bool Zone::Process() {
 		}
 	}
 
+	if (los_cache_purge_timer.Check())
+		los_cache.PurgeExpired();
+
 	if (clientauth_timer.Check()) {
 		LinkedListIterator<ZoneClientAuth_Struct*> iterator2(client_auth_list);
 
@@ -1429,7 +1453,7 @@ bool Zone::Depop(bool StartSpawnTimer) {
 	std::map<uint32,NPCType *>::iterator itr;
 	entity_list.Depop(StartSpawnTimer);
 
-	/* Refresh npctable (cache), getting current info from database. */
+	/* Refresh npctable (cache), getting current info from shared memory or the database. */
 	while(!npctable.empty()) {
 		itr = npctable.begin();
 		delete itr->second;
@@ -1439,8 +1463,36 @@ bool Zone::Depop(bool StartSpawnTimer) {
 	return true;
 }
 
+/*
+	A new npc_types shared memory table was mapped. Cached types are dropped so
+	they are built again from it, and types that were sent to the database
+	after an edit go back to the table, which was rebuilt after the edit.
+	Spawned NPCs keep pointing at their NPCType, so the old ones are only
+	deleted when the zone shuts down.
+*/
+void Zone::ResetNPCTypeCache() {
+	all_npctypes_from_db = false;
+	npctypes_from_db.clear();
+	for (auto &e : npctable)
+		retired_npctypes.push_back(e.second);
+	npctable.clear();
+}
+
+int64 Zone::GetSharedNPCTypeSavings(uint32 &skipped, uint32 &built) const {
+	skipped = static_cast<uint32>(npctypes_bulk_skipped.size());
+	built = 0;
+	for (auto id : npctypes_bulk_skipped) {
+		if (npctable.count(id))
+			++built;
+	}
+
+	// types outside the bulk set are built on demand either way
+	return (static_cast<int64>(skipped) - built) * static_cast<int64>(sizeof(NPCType));
+}
+
 void Zone::ClearNPCTypeCache(int id) {
 	if (id <= 0) {
+		all_npctypes_from_db = true;
 		auto iter = npctable.begin();
 		while (iter != npctable.end()) {
 			delete iter->second;
@@ -1449,6 +1501,7 @@ void Zone::ClearNPCTypeCache(int id) {
 		npctable.clear();
 	}
 	else {
+		npctypes_from_db.insert(id);
 		auto iter = npctable.begin();
 		while (iter != npctable.end()) {
 			if (iter->first == (uint32)id) {
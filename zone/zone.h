@@ -28,6 +28,7 @@
 #include "spawn2.h"
 #include "spawngroup.h"
 #include "aa_ability.h"
+#include "los_cache.h"
 
 struct ZonePoint
 {
@@ -143,6 +144,9 @@ public:
 	void	Repop(uint32 delay = 0);
 	void	RepopClose(const glm::vec4& client_position, uint32 repop_distance);
 	void	ClearNPCTypeCache(int id);
+	void	ResetNPCTypeCache();
+	// with Zone:SharedNPCTypes, bytes of NPCType the skipped bulk load would have kept that were never built from the table
+	int64	GetSharedNPCTypeSavings(uint32 &skipped, uint32 &built) const;
 	void	SpawnStatus(Mob* client);
 	void	ShowEnabledSpawnStatus(Mob* client);
 	void	ShowDisabledSpawnStatus(Mob* client);
@@ -183,6 +187,10 @@ public:
 	void LoadAdventureFlavor();
 
 	std::map<uint32,NPCType *> npctable;
+	std::set<uint32> npctypes_from_db;	//cleared from the cache, read from the database instead of shared memory
+	bool	all_npctypes_from_db;
+	std::vector<NPCType *> retired_npctypes;	//dropped from the cache by a shared memory switch, spawned NPCs may still point at them
+	std::set<uint32> npctypes_bulk_skipped;	//types the spawn bulk load would have read, left to the shared memory table
 	std::map<uint32,NPCType *> merctable;
 	std::map<uint32,std::list<MerchantList> > merchanttable;
 	std::map<uint32,std::list<TempMerchantList> > tmpmerchanttable;
@@ -211,6 +219,7 @@ public:
 	void	ReloadWorld(uint32 Option);
 
 	Map*	zonemap;
+	LoSCache los_cache;
 	WaterMap* watermap;
 	PathManager *pathing;
 	NewZone_Struct	newzone_data;
@@ -338,6 +347,7 @@ private:
 	Timer	autoshutdown_timer;
 	Timer	clientauth_timer;
 	Timer	qglobal_purge_timer;
+	Timer	los_cache_purge_timer;
 	Timer*	Weather_Timer;
 	Timer*	Instance_Timer;
 	Timer*	Instance_Shutdown_Timer;
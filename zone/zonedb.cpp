@@ -1848,6 +1848,121 @@ bool ZoneDatabase::NoRentExpired(const char* name){
 	return (seconds>1800);
 }
 
+static NPCType *MakeNPCType(const EQEmu::NPCTypeRecord &r, const char *name, const char *lastname, const char *special_abilities,
+	const char *ammo_idfile)
+{
+	NPCType *t = new NPCType;
+	memset(t, 0, sizeof *t);
+
+	t->npc_id = r.npc_id;
+	strn0cpy(t->name, name, 50);
+	strn0cpy(t->lastname, lastname, 32);
+	strn0cpy(t->special_abilities, special_abilities, 512);
+	strn0cpy(t->ammo_idfile, ammo_idfile, 30);
+
+	t->level = r.level;
+	t->race = r.race;
+	t->class_ = r.class_;
+	t->max_hp = r.max_hp;
+	t->cur_hp = r.max_hp;
+	t->Mana = r.mana;
+	t->gender = r.gender;
+	t->texture = r.texture;
+	t->helmtexture = r.helmtexture;
+	t->herosforgemodel = r.herosforgemodel;
+	t->size = r.size;
+	t->loottable_id = r.loottable_id;
+	t->merchanttype = r.merchanttype;
+	t->alt_currency_type = r.alt_currency_type;
+	t->adventure_template = r.adventure_template;
+	t->trap_template = r.trap_template;
+	t->attack_speed = r.attack_speed;
+	t->STR = r.STR;
+	t->STA = r.STA;
+	t->DEX = r.DEX;
+	t->AGI = r.AGI;
+	t->INT = r.INT;
+	t->WIS = r.WIS;
+	t->CHA = r.CHA;
+	t->MR = r.MR;
+	t->CR = r.CR;
+	t->DR = r.DR;
+	t->FR = r.FR;
+	t->PR = r.PR;
+	t->Corrup = r.Corrup;
+	t->PhR = r.PhR;
+	t->min_dmg = r.min_dmg;
+	t->max_dmg = r.max_dmg;
+	t->attack_count = r.attack_count;
+	t->npc_spells_id = r.npc_spells_id;
+	t->npc_spells_effects_id = r.npc_spells_effects_id;
+	t->d_melee_texture1 = r.d_melee_texture1;
+	t->d_melee_texture2 = r.d_melee_texture2;
+	t->prim_melee_type = r.prim_melee_type;
+	t->sec_melee_type = r.sec_melee_type;
+	t->ranged_type = r.ranged_type;
+	t->runspeed = r.runspeed;
+	t->findable = r.findable;
+	t->trackable = r.trackable;
+	t->hp_regen = r.hp_regen;
+	t->mana_regen = r.mana_regen;
+	t->aggroradius = r.aggroradius;
+	t->assistradius = r.assistradius;
+	t->bodytype = r.bodytype;
+	t->npc_faction_id = r.npc_faction_id;
+	t->luclinface = r.luclinface;
+	t->hairstyle = r.hairstyle;
+	t->haircolor = r.haircolor;
+	t->eyecolor1 = r.eyecolor1;
+	t->eyecolor2 = r.eyecolor2;
+	t->beardcolor = r.beardcolor;
+	t->beard = r.beard;
+	t->drakkin_heritage = r.drakkin_heritage;
+	t->drakkin_tattoo = r.drakkin_tattoo;
+	t->drakkin_details = r.drakkin_details;
+	t->armor_tint = r.armor_tint;
+	t->see_invis = r.see_invis;
+	t->see_invis_undead = r.see_invis_undead;
+	t->qglobal = r.qglobal;
+	t->AC = r.AC;
+	t->npc_aggro = r.npc_aggro;
+	t->spawn_limit = r.spawn_limit;
+	t->see_hide = r.see_hide;
+	t->see_improved_hide = r.see_improved_hide;
+	t->ATK = r.ATK;
+	t->accuracy_rating = r.accuracy_rating;
+	t->avoidance_rating = r.avoidance_rating;
+	t->slow_mitigation = r.slow_mitigation;
+	t->maxlevel = r.maxlevel;
+	t->scalerate = r.scalerate;
+	t->private_corpse = r.private_corpse;
+	t->unique_spawn_by_name = r.unique_spawn_by_name;
+	t->underwater = r.underwater;
+	t->emoteid = r.emoteid;
+	t->spellscale = r.spellscale;
+	t->healscale = r.healscale;
+	t->no_target_hotkey = r.no_target_hotkey;
+	t->raid_target = r.raid_target;
+	t->attack_delay = r.attack_delay;
+	t->light = r.light;
+	t->armtexture = r.armtexture;
+	t->bracertexture = r.bracertexture;
+	t->handtexture = r.handtexture;
+	t->legtexture = r.legtexture;
+	t->feettexture = r.feettexture;
+	t->ignore_despawn = r.ignore_despawn;
+	t->show_name = r.show_name;
+	t->untargetable = r.untargetable;
+
+	return t;
+}
+
+/*
+	npc types come from the shared memory table written by shared_memory when
+	it is loaded, so the bulk spawn query is skipped and single types are a
+	lookup. Types cleared from the cache (#npctype_cache, quest ClearNPCTypeCache)
+	and types newer than the table are read from the database.
+*/
 const NPCType* ZoneDatabase::LoadNPCTypesData(uint32 npc_type_id, bool bulk_load /*= false*/)
 {
 	const NPCType *npc = nullptr;
@@ -1857,6 +1972,26 @@ const NPCType* ZoneDatabase::LoadNPCTypesData(uint32 npc_type_id, bool bulk_load
 	if(itr != zone->npctable.end())
 		return itr->second;
 
+	const EQEmu::NPCTypeTable *table = GetNPCTypeTable();
+	if (table && RuleB(Zone, SharedNPCTypes)) {
+		if (bulk_load) {
+			zone->npctypes_bulk_skipped.clear();
+			zone->spawn_group_list.GetNPCTypes(zone->npctypes_bulk_skipped);
+			return nullptr;
+		}
+
+		const EQEmu::NPCTypeRecord *record = nullptr;
+		if (!zone->all_npctypes_from_db && zone->npctypes_from_db.count(npc_type_id) == 0)
+			record = table->Find(npc_type_id);
+
+		if (record) {
+			NPCType *temp_npctype_data = MakeNPCType(*record, table->GetString(record->name), table->GetString(record->lastname),
+				table->GetString(record->special_abilities), table->GetString(record->ammo_idfile));
+			zone->npctable[temp_npctype_data->npc_id] = temp_npctype_data;
+			return temp_npctype_data;
+		}
+	}
+
 	std::string where_condition = "";
 
 	if (bulk_load){
@@ -1870,296 +2005,28 @@ const NPCType* ZoneDatabase::LoadNPCTypesData(uint32 npc_type_id, bool bulk_load
 		where_condition = StringFormat("WHERE id = %u", npc_type_id);
 	}
 
-	std::string query = StringFormat("SELECT "
-		"npc_types.id, "
-		"npc_types.name, "
-		"npc_types.level, "
-		"npc_types.race, "
-		"npc_types.class, "
-		"npc_types.hp, "
-		"npc_types.mana, "
-		"npc_types.gender, "
-		"npc_types.texture, "
-		"npc_types.helmtexture, "
-		"npc_types.herosforgemodel, "
-		"npc_types.size, "
-		"npc_types.loottable_id, "
-		"npc_types.merchant_id, "
-		"npc_types.alt_currency_id, "
-		"npc_types.adventure_template_id, "
-		"npc_types.trap_template, "
-		"npc_types.attack_speed, "
-		"npc_types.STR, "
-		"npc_types.STA, "
-		"npc_types.DEX, "
-		"npc_types.AGI, "
-		"npc_types._INT, "
-		"npc_types.WIS, "
-		"npc_types.CHA, "
-		"npc_types.MR, "
-		"npc_types.CR, "
-		"npc_types.DR, "
-		"npc_types.FR, "
-		"npc_types.PR, "
-		"npc_types.Corrup, "
-		"npc_types.PhR, "
-		"npc_types.mindmg, "
-		"npc_types.maxdmg, "
-		"npc_types.attack_count, "
-		"npc_types.special_abilities, "
-		"npc_types.npc_spells_id, "
-		"npc_types.npc_spells_effects_id, "
-		"npc_types.d_melee_texture1, "
-		"npc_types.d_melee_texture2, "
-		"npc_types.ammo_idfile, "
-		"npc_types.prim_melee_type, "
-		"npc_types.sec_melee_type, "
-		"npc_types.ranged_type, "
-		"npc_types.runspeed, "
-		"npc_types.findable, "
-		"npc_types.trackable, "
-		"npc_types.hp_regen_rate, "
-		"npc_types.mana_regen_rate, "
-		"npc_types.aggroradius, "
-		"npc_types.assistradius, "
-		"npc_types.bodytype, "
-		"npc_types.npc_faction_id, "
-		"npc_types.face, "
-		"npc_types.luclin_hairstyle, "
-		"npc_types.luclin_haircolor, "
-		"npc_types.luclin_eyecolor, "
-		"npc_types.luclin_eyecolor2, "
-		"npc_types.luclin_beardcolor, "
-		"npc_types.luclin_beard, "
-		"npc_types.drakkin_heritage, "
-		"npc_types.drakkin_tattoo, "
-		"npc_types.drakkin_details, "
-		"npc_types.armortint_id, "
-		"npc_types.armortint_red, "
-		"npc_types.armortint_green, "
-		"npc_types.armortint_blue, "
-		"npc_types.see_invis, "
-		"npc_types.see_invis_undead, "
-		"npc_types.lastname, "
-		"npc_types.qglobal, "
-		"npc_types.AC, "
-		"npc_types.npc_aggro, "
-		"npc_types.spawn_limit, "
-		"npc_types.see_hide, "
-		"npc_types.see_improved_hide, "
-		"npc_types.ATK, "
-		"npc_types.Accuracy, "
-		"npc_types.Avoidance, "
-		"npc_types.slow_mitigation, "
-		"npc_types.maxlevel, "
-		"npc_types.scalerate, "
-		"npc_types.private_corpse, "
-		"npc_types.unique_spawn_by_name, "
-		"npc_types.underwater, "
-		"npc_types.emoteid, "
-		"npc_types.spellscale, "
-		"npc_types.healscale, "
-		"npc_types.no_target_hotkey, "
-		"npc_types.raid_target, "
-		"npc_types.attack_delay, "
-		"npc_types.light, "
-		"npc_types.armtexture, "
-		"npc_types.bracertexture, "
-		"npc_types.handtexture, "
-		"npc_types.legtexture, "
-		"npc_types.feettexture, "
-		"npc_types.ignore_despawn, "
-		"npc_types.show_name, "
-		"npc_types.untargetable "
-		"FROM npc_types %s",
-		where_condition.c_str()
-	);
-
-    auto results = QueryDatabase(query);
-    if (!results.Success()) {
-        return nullptr;
-    }
-
-    for (auto row = results.begin(); row != results.end(); ++row) {
-		NPCType *temp_npctype_data;
-		temp_npctype_data = new NPCType;
-		memset (temp_npctype_data, 0, sizeof *temp_npctype_data);
-
-		temp_npctype_data->npc_id = atoi(row[0]);
-
-		strn0cpy(temp_npctype_data->name, row[1], 50);
-
-		temp_npctype_data->level = atoi(row[2]);
-		temp_npctype_data->race = atoi(row[3]);
-		temp_npctype_data->class_ = atoi(row[4]);
-		temp_npctype_data->max_hp = atoi(row[5]);
-		temp_npctype_data->cur_hp = temp_npctype_data->max_hp;
-		temp_npctype_data->Mana = atoi(row[6]);
-		temp_npctype_data->gender = atoi(row[7]);
-		temp_npctype_data->texture = atoi(row[8]);
-		temp_npctype_data->helmtexture = atoi(row[9]);
-		temp_npctype_data->herosforgemodel = atoul(row[10]);
-		temp_npctype_data->size = atof(row[11]);
-        temp_npctype_data->loottable_id = atoi(row[12]);
-		temp_npctype_data->merchanttype = atoi(row[13]);
-		temp_npctype_data->alt_currency_type = atoi(row[14]);
-		temp_npctype_data->adventure_template = atoi(row[15]);
-		temp_npctype_data->trap_template = atoi(row[16]);
-		temp_npctype_data->attack_speed = atof(row[17]);
-		temp_npctype_data->STR = atoi(row[18]);
-		temp_npctype_data->STA = atoi(row[19]);
-		temp_npctype_data->DEX = atoi(row[20]);
-		temp_npctype_data->AGI = atoi(row[21]);
-		temp_npctype_data->INT = atoi(row[22]);
-		temp_npctype_data->WIS = atoi(row[23]);
-		temp_npctype_data->CHA = atoi(row[24]);
-		temp_npctype_data->MR = atoi(row[25]);
-		temp_npctype_data->CR = atoi(row[26]);
-		temp_npctype_data->DR = atoi(row[27]);
-		temp_npctype_data->FR = atoi(row[28]);
-		temp_npctype_data->PR = atoi(row[29]);
-		temp_npctype_data->Corrup = atoi(row[30]);
-		temp_npctype_data->PhR = atoi(row[31]);
-		temp_npctype_data->min_dmg = atoi(row[32]);
-		temp_npctype_data->max_dmg = atoi(row[33]);
-		temp_npctype_data->attack_count = atoi(row[34]);
-
-		if (row[35] != nullptr)
-			strn0cpy(temp_npctype_data->special_abilities, row[35], 512);
-		else
-			temp_npctype_data->special_abilities[0] = '\0';
-
-		temp_npctype_data->npc_spells_id = atoi(row[36]);
-		temp_npctype_data->npc_spells_effects_id = atoi(row[37]);
-		temp_npctype_data->d_melee_texture1 = atoi(row[38]);
-		temp_npctype_data->d_melee_texture2 = atoi(row[39]);
-		strn0cpy(temp_npctype_data->ammo_idfile, row[40], 30);
-		temp_npctype_data->prim_melee_type = atoi(row[41]);
-		temp_npctype_data->sec_melee_type = atoi(row[42]);
-		temp_npctype_data->ranged_type = atoi(row[43]);
-		temp_npctype_data->runspeed= atof(row[44]);
-		temp_npctype_data->findable = atoi(row[45]) == 0? false : true;
-		temp_npctype_data->trackable = atoi(row[46]) == 0? false : true;
-		temp_npctype_data->hp_regen = atoi(row[47]);
-		temp_npctype_data->mana_regen = atoi(row[48]);
-
-		// set default value for aggroradius
-        temp_npctype_data->aggroradius = (int32)atoi(row[49]);
-		if (temp_npctype_data->aggroradius <= 0)
-			temp_npctype_data->aggroradius = 70;
-
-		temp_npctype_data->assistradius = (int32)atoi(row[50]);
-		if (temp_npctype_data->assistradius <= 0)
-			temp_npctype_data->assistradius = temp_npctype_data->aggroradius;
-
-		if (row[51] && strlen(row[51]))
-            temp_npctype_data->bodytype = (uint8)atoi(row[51]);
-        else
-            temp_npctype_data->bodytype = 0;
-
-		temp_npctype_data->npc_faction_id = atoi(row[52]);
-
-		temp_npctype_data->luclinface = atoi(row[53]);
-		temp_npctype_data->hairstyle = atoi(row[54]);
-		temp_npctype_data->haircolor = atoi(row[55]);
-		temp_npctype_data->eyecolor1 = atoi(row[56]);
-		temp_npctype_data->eyecolor2 = atoi(row[57]);
-		temp_npctype_data->beardcolor = atoi(row[58]);
-		temp_npctype_data->beard = atoi(row[59]);
-		temp_npctype_data->drakkin_heritage = atoi(row[60]);
-		temp_npctype_data->drakkin_tattoo = atoi(row[61]);
-		temp_npctype_data->drakkin_details = atoi(row[62]);
-
-		uint32 armor_tint_id = atoi(row[63]);
-
-		temp_npctype_data->armor_tint.Head.Color = (atoi(row[64]) & 0xFF) << 16;
-        temp_npctype_data->armor_tint.Head.Color |= (atoi(row[65]) & 0xFF) << 8;
-		temp_npctype_data->armor_tint.Head.Color |= (atoi(row[66]) & 0xFF);
-		temp_npctype_data->armor_tint.Head.Color |= (temp_npctype_data->armor_tint.Head.Color) ? (0xFF << 24) : 0;
-
-		if (armor_tint_id != 0) {
-			std::string armortint_query = StringFormat(
-				"SELECT red1h, grn1h, blu1h, "
-				"red2c, grn2c, blu2c, "
-				"red3a, grn3a, blu3a, "
-				"red4b, grn4b, blu4b, "
-				"red5g, grn5g, blu5g, "
-				"red6l, grn6l, blu6l, "
-				"red7f, grn7f, blu7f, "
-				"red8x, grn8x, blu8x, "
-				"red9x, grn9x, blu9x "
-				"FROM npc_types_tint WHERE id = %d",
-				armor_tint_id);
-            auto armortint_results = QueryDatabase(armortint_query);
-            if (!armortint_results.Success() || armortint_results.RowCount() == 0)
-                armor_tint_id = 0;
-            else {
-                auto armorTint_row = armortint_results.begin();
-
-				for (int index = EQEmu::textures::textureBegin; index <= EQEmu::textures::LastTexture; index++) {
-                    temp_npctype_data->armor_tint.Slot[index].Color = atoi(armorTint_row[index * 3]) << 16;
-					temp_npctype_data->armor_tint.Slot[index].Color |= atoi(armorTint_row[index * 3 + 1]) << 8;
-					temp_npctype_data->armor_tint.Slot[index].Color |= atoi(armorTint_row[index * 3 + 2]);
-					temp_npctype_data->armor_tint.Slot[index].Color |= (temp_npctype_data->armor_tint.Slot[index].Color) ? (0xFF << 24) : 0;
-                }
-            }
-        }
-		// Try loading npc_types tint fields if armor tint is 0 or query failed to get results
-		if (armor_tint_id == 0) {
-			for (int index = EQEmu::textures::armorChest; index < EQEmu::textures::materialCount; index++) {
-				temp_npctype_data->armor_tint.Slot[index].Color = temp_npctype_data->armor_tint.Slot[0].Color; // odd way to 'zero-out' the array...
-			}
-		}
+	auto results = QueryDatabase(GetNPCTypesQuery(where_condition));
+	if (!results.Success()) {
+		return nullptr;
+	}
 
-		temp_npctype_data->see_invis = atoi(row[67]);
-		temp_npctype_data->see_invis_undead = atoi(row[68]) == 0? false: true;	// Set see_invis_undead flag
-
-		if (row[69] != nullptr)
-			strn0cpy(temp_npctype_data->lastname, row[69], 32);
-
-		temp_npctype_data->qglobal = atoi(row[70]) == 0? false: true;	// qglobal
-		temp_npctype_data->AC = atoi(row[71]);
-		temp_npctype_data->npc_aggro = atoi(row[72]) == 0? false: true;
-		temp_npctype_data->spawn_limit = atoi(row[73]);
-		temp_npctype_data->see_hide = atoi(row[74]) == 0? false: true;
-		temp_npctype_data->see_improved_hide = atoi(row[75]) == 0? false: true;
-		temp_npctype_data->ATK = atoi(row[76]);
-		temp_npctype_data->accuracy_rating = atoi(row[77]);
-		temp_npctype_data->avoidance_rating = atoi(row[78]);
-		temp_npctype_data->slow_mitigation = atoi(row[79]);
-		temp_npctype_data->maxlevel = atoi(row[80]);
-		temp_npctype_data->scalerate = atoi(row[81]);
-		temp_npctype_data->private_corpse = atoi(row[82]) == 1 ? true: false;
-		temp_npctype_data->unique_spawn_by_name = atoi(row[83]) == 1 ? true: false;
-		temp_npctype_data->underwater = atoi(row[84]) == 1 ? true: false;
-		temp_npctype_data->emoteid = atoi(row[85]);
-		temp_npctype_data->spellscale = atoi(row[86]);
-		temp_npctype_data->healscale = atoi(row[87]);
-		temp_npctype_data->no_target_hotkey = atoi(row[88]) == 1 ? true: false;
-		temp_npctype_data->raid_target = atoi(row[89]) == 0 ? false: true;
-		temp_npctype_data->attack_delay = atoi(row[90]) * 100; // TODO: fix DB
-		temp_npctype_data->light = (atoi(row[91]) & 0x0F);
-
-		temp_npctype_data->armtexture = atoi(row[92]);
-		temp_npctype_data->bracertexture = atoi(row[93]);
-		temp_npctype_data->handtexture = atoi(row[94]);
-		temp_npctype_data->legtexture = atoi(row[95]);
-		temp_npctype_data->feettexture = atoi(row[96]);
-		temp_npctype_data->ignore_despawn = atoi(row[97]) == 1 ? true : false;
-		temp_npctype_data->show_name = atoi(row[98]) != 0 ? true : false;
-		temp_npctype_data->untargetable = atoi(row[99]) != 0 ? true : false;
+	EQEmu::NPCTypeRecord record;
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		EQEmu::NPCTypeTableBuilder strings;
+		ReadNPCTypeRow(row, record, strings);
 
 		// If NPC with duplicate NPC id already in table,
-		// free item we attempted to add.
-		if (zone->npctable.find(temp_npctype_data->npc_id) != zone->npctable.end()) {
-			std::cerr << "Error loading duplicate NPC " << temp_npctype_data->npc_id << std::endl;
-			delete temp_npctype_data;
+		// skip the row we attempted to add.
+		if (zone->npctable.find(record.npc_id) != zone->npctable.end()) {
+			std::cerr << "Error loading duplicate NPC " << record.npc_id << std::endl;
 			return nullptr;
 		}
 
-        zone->npctable[temp_npctype_data->npc_id] = temp_npctype_data;
-        npc = temp_npctype_data;
-    }
+		NPCType *temp_npctype_data = MakeNPCType(record, strings.GetString(record.name), strings.GetString(record.lastname),
+			strings.GetString(record.special_abilities), strings.GetString(record.ammo_idfile));
+		zone->npctable[temp_npctype_data->npc_id] = temp_npctype_data;
+		npc = temp_npctype_data;
+	}
 
 	return npc;
 }